@@ -22,6 +22,7 @@
 #include "../sys/alloc.h"
 #endif
 #include <algorithm>
+#include <type_traits>
 
 namespace embree
 {
@@ -272,6 +273,11 @@ namespace embree
     static const size_t MAX_TASKS = 64;
     static const size_t BITS = 8;
     static const size_t BUCKETS = (1 << BITS);
+    static const size_t DIGITS = (8*sizeof(Key)+BITS-1)/BITS;
+    static const size_t WC_ITEMS = CACHELINE_SIZE/sizeof(Ty);   //!< number of items buffered per bucket for software write combining
+    static const bool WRITE_COMBINING = WC_ITEMS >= 16;          //!< write combining only pays off for 32 bit items
+    static const size_t KEY_LANES = sizeof(Key)/4;               //!< number of 32 bit SIMD lanes per key
+    static const bool SIMD_COUNT = std::is_integral<Ty>::value && sizeof(Ty) == sizeof(Key) && (KEY_LANES == 1 || KEY_LANES == 2); //!< plain 32 or 64 bit keys get counted using SIMD
     typedef unsigned int TyRadixCount[BUCKETS];
     
     template<typename T>
@@ -279,6 +285,15 @@ namespace embree
       return (Key)v0 < (Key)v1;
     }
 
+    static __forceinline size_t digit(const Ty& v, const size_t shift)
+    {
+#if defined(__X86_64__) || defined(__aarch64__)
+      return ((size_t)(Key)v >> shift) & (BUCKETS-1);
+#else
+      return ((Key)v >> (Key)shift) & (BUCKETS-1);
+#endif
+    }
+
   private:
     ParallelRadixSort (const ParallelRadixSort& other) DELETED; // do not implement
     ParallelRadixSort& operator= (const ParallelRadixSort& other) DELETED; // do not implement
@@ -286,7 +301,7 @@ namespace embree
     
   public:
     ParallelRadixSort (Ty* const src, Ty* const tmp, const size_t N)
-      : radixCount(nullptr), src(src), tmp(tmp), N(N) {}
+      : radixCount(nullptr), wcBuffer(nullptr), src(src), tmp(tmp), N(N) {}
 
     void sort(const size_t blockSize)
     {
@@ -311,41 +326,119 @@ namespace embree
     {
       alignedFree(radixCount); 
       radixCount = nullptr;
+      alignedFree(wcBuffer);
+      wcBuffer = nullptr;
     }
     
   private:
-    
-    void tbbRadixIteration0(const Key shift, 
+
+    /* sums up count arrays using SIMD */
+    static __forceinline void addCounts(unsigned int* __restrict dst, const unsigned int* __restrict src)
+    {
+      for (size_t i=0; i<BUCKETS; i+=VSIZEX)
+        vintx::store(&dst[i], vintx::load(&dst[i]) + vintx::load(&src[i]));
+    }
+
+    /* counts the digits of items [begin,end) into 4 interleaved arrays to avoid stalls on repeated increments of the same bucket */
+    template<bool keyBits>
+      static __forceinline void countDigits(const size_t shift, const Ty* __restrict const src, const size_t begin, const size_t end,
+                                            unsigned int (&counts)[4][BUCKETS], Key& keyOr, Key& keyAnd)
+    {
+      size_t i=begin;
+
+      /* extract the digits of plain integer keys using SIMD into a small buffer, counting from
+       * that buffer afterwards avoids stalls on store forwarding from vector to scalar registers */
+      if (SIMD_COUNT)
+      {
+        static const size_t CHUNK = 64;
+        const unsigned int* __restrict const lanes = (const unsigned int*) src;
+        const size_t lane = shift/32;  // little endian lane holding the digit
+        const int laneShift = int(shift%32);
+        __aligned(64) unsigned int d[CHUNK*KEY_LANES];
+        vintx vor(zero), vand(-1);
+        for (; i+CHUNK<=end; i+=CHUNK)
+        {
+          for (size_t k=0; k<CHUNK*KEY_LANES; k+=VSIZEX)
+          {
+            const vintx v = vintx::loadu(&lanes[i*KEY_LANES+k]);
+            if (keyBits) { vor = vor | v; vand = vand & v; }
+            vintx::store(&d[k], srl(v,laneShift) & vintx(BUCKETS-1));
+          }
+          for (size_t k=0; k<CHUNK; k+=4)
+          {
+            counts[0][d[(k+0)*KEY_LANES+lane]]++;
+            counts[1][d[(k+1)*KEY_LANES+lane]]++;
+            counts[2][d[(k+2)*KEY_LANES+lane]]++;
+            counts[3][d[(k+3)*KEY_LANES+lane]]++;
+          }
+        }
+
+        if (keyBits)
+        {
+          __aligned(64) unsigned int o[VSIZEX], a[VSIZEX];
+          vintx::store(o,vor); vintx::store(a,vand);
+          for (size_t k=0; k<VSIZEX; k++) {
+            keyOr  |= Key(o[k]) << (32*(k%KEY_LANES));
+            keyAnd &= Key(a[k]) << (32*(k%KEY_LANES)) | ~(Key(0xFFFFFFFF) << (32*(k%KEY_LANES)));
+          }
+        }
+      }
+
+      for (; i+3<end; i+=4)
+      {
+        if (keyBits) {
+          keyOr  |= (Key)src[i+0] | (Key)src[i+1] | (Key)src[i+2] | (Key)src[i+3];
+          keyAnd &= (Key)src[i+0] & (Key)src[i+1] & (Key)src[i+2] & (Key)src[i+3];
+        }
+        counts[0][digit(src[i+0],shift)]++;
+        counts[1][digit(src[i+1],shift)]++;
+        counts[2][digit(src[i+2],shift)]++;
+        counts[3][digit(src[i+3],shift)]++;
+      }
+      for (; i<end; i++)
+      {
+        if (keyBits) {
+          keyOr  |= (Key)src[i];
+          keyAnd &= (Key)src[i];
+        }
+        counts[0][digit(src[i],shift)]++;
+      }
+    }
+
+    void tbbRadixIteration0(const size_t shift,
                             const Ty* __restrict const src, 
                             Ty* __restrict const dst, 
                             const size_t threadIndex, const size_t threadCount)
     {
       const size_t startID = (threadIndex+0)*N/threadCount;
       const size_t endID   = (threadIndex+1)*N/threadCount;
-      
-      /* mask to extract some number of bits */
-      const Key mask = BUCKETS-1;
-      
-      /* count how many items go into the buckets */
-      for (size_t i=0; i<BUCKETS; i++)
-        radixCount[threadIndex][i] = 0;
 
-      /* iterate over src array and count buckets */
-      unsigned int * __restrict const count = radixCount[threadIndex];
-#if defined(__INTEL_COMPILER)
-#pragma nounroll      
-#endif
-      for (size_t i=startID; i<endID; i++) {
-#if defined(__X86_64__) || defined(__aarch64__)
-        const size_t index = ((size_t)(Key)src[i] >> (size_t)shift) & (size_t)mask;
-#else
-        const Key index = ((Key)src[i] >> shift) & mask;
-#endif
-        count[index]++;
+      __aligned(64) unsigned int counts[4][BUCKETS];
+      for (size_t j=0; j<4; j++)
+        for (size_t i=0; i<BUCKETS; i+=VSIZEX)
+          vintx::store(&counts[j][i], zero);
+
+      /* the first iteration also determines which key bits differ between items */
+      if (unlikely(!keyBitsKnown))
+      {
+        Key keyOr = 0, keyAnd = ~Key(0);
+        countDigits<true>(shift,src,startID,endID,counts,keyOr,keyAnd);
+        keyBitsOr[threadIndex] = keyOr;
+        keyBitsAnd[threadIndex] = keyAnd;
+      }
+      else
+      {
+        Key keyOr = 0, keyAnd = 0;
+        countDigits<false>(shift,src,startID,endID,counts,keyOr,keyAnd);
       }
+
+      /* reduce the partial counts */
+      unsigned int * __restrict const count = radixCount[threadIndex];
+      for (size_t j=0; j<BUCKETS; j+=VSIZEX)
+        vintx::store(&count[j], vintx::load(&counts[0][j]) + vintx::load(&counts[1][j]) + vintx::load(&counts[2][j]) + vintx::load(&counts[3][j]));
     }
     
-    void tbbRadixIteration1(const Key shift, 
+    void tbbRadixIteration1(const size_t shift,
                             const Ty* __restrict const src, 
                             Ty* __restrict const dst, 
                             const size_t threadIndex, const size_t threadCount)
@@ -353,27 +446,13 @@ namespace embree
       const size_t startID = (threadIndex+0)*N/threadCount;
       const size_t endID   = (threadIndex+1)*N/threadCount;
       
-      /* mask to extract some number of bits */
-      const Key mask = BUCKETS-1;
-      
       /* calculate total number of items for each bucket */
       __aligned(64) unsigned int total[BUCKETS];
-      /*
-      for (size_t i=0; i<BUCKETS; i++)
-        total[i] = 0;
-      */
       for (size_t i=0; i<BUCKETS; i+=VSIZEX)
         vintx::store(&total[i], zero);
       
       for (size_t i=0; i<threadCount; i++)
-      {
-        /*
-        for (size_t j=0; j<BUCKETS; j++)
-          total[j] += radixCount[i][j];
-        */
-        for (size_t j=0; j<BUCKETS; j+=VSIZEX)
-          vintx::store(&total[j], vintx::load(&total[j]) + vintx::load(&radixCount[i][j]));
-      }
+        addCounts(total,radixCount[i]);
       
       /* calculate start offset of each bucket */
       __aligned(64) unsigned int offset[BUCKETS];
@@ -383,64 +462,103 @@ namespace embree
       
       /* calculate start offset of each bucket for this thread */
       for (size_t i=0; i<threadIndex; i++)
+        addCounts(offset,radixCount[i]);
+
+      /* copy items directly into their buckets */
+      if (!WRITE_COMBINING)
       {
-        /*
-        for (size_t j=0; j<BUCKETS; j++)
-          offset[j] += radixCount[i][j];
-        */
-        for (size_t j=0; j<BUCKETS; j+=VSIZEX)
-          vintx::store(&offset[j], vintx::load(&offset[j]) + vintx::load(&radixCount[i][j]));
+        for (size_t i=startID; i<endID; i++)
+          dst[offset[digit(src[i],shift)]++] = src[i];
+        return;
       }
-      
-      /* copy items into their buckets */
-#if defined(__INTEL_COMPILER)
-#pragma nounroll
-#endif
-      for (size_t i=startID; i<endID; i++) {
+
+      /* gather items of each bucket in a cache line sized buffer and flush full buffers at once */
+      Ty* __restrict const wc = (Ty*) &wcBuffer[threadIndex*BUCKETS*CACHELINE_SIZE];
+      __aligned(64) unsigned int fill[BUCKETS];
+      for (size_t i=0; i<BUCKETS; i+=VSIZEX)
+        vintx::store(&fill[i], zero);
+
+      for (size_t i=startID; i<endID; i++)
+      {
         const Ty elt = src[i];
-#if defined(__X86_64__) || defined(__aarch64__)
-        const size_t index = ((size_t)(Key)src[i] >> (size_t)shift) & (size_t)mask;
-#else
-        const size_t index = ((Key)src[i] >> shift) & mask;
-#endif
-        dst[offset[index]++] = elt;
+        const size_t index = digit(elt,shift);
+        const size_t slot = fill[index]++;
+        wc[index*WC_ITEMS+slot] = elt;
+        if (slot == WC_ITEMS-1)
+        {
+          Ty* __restrict const d = dst+offset[index];
+          for (size_t j=0; j<WC_ITEMS; j++) d[j] = wc[index*WC_ITEMS+j];
+          offset[index] += WC_ITEMS;
+          fill[index] = 0;
+        }
       }
+
+      /* flush partially filled buffers */
+      for (size_t index=0; index<BUCKETS; index++)
+        for (size_t j=0; j<fill[index]; j++)
+          dst[offset[index]+j] = wc[index*WC_ITEMS+j];
     }
     
-    void tbbRadixIteration(const Key shift, const bool last,
-                           const Ty* __restrict src, Ty* __restrict dst,
-                           const size_t numTasks)
+    void tbbRadixIteration(const size_t shift, const size_t numTasks)
     {
+      const Ty* __restrict const src = this->src_;
+      Ty* __restrict const dst = this->dst_;
       affinity_partitioner ap;
       parallel_for_affinity(numTasks,[&] (size_t taskIndex) { tbbRadixIteration0(shift,src,dst,taskIndex,numTasks); },ap);
+
+      /* skip the copy if all items fall into the same bucket */
+      if (!keyBitsKnown)
+      {
+        Key keyOr = 0, keyAnd = ~Key(0);
+        for (size_t i=0; i<numTasks; i++) {
+          keyOr |= keyBitsOr[i];
+          keyAnd &= keyBitsAnd[i];
+        }
+        keyBitsDiffer = keyOr ^ keyAnd;
+        keyBitsKnown = true;
+      }
+      if (!isDigitUsed(shift)) return;
+
       parallel_for_affinity(numTasks,[&] (size_t taskIndex) { tbbRadixIteration1(shift,src,dst,taskIndex,numTasks); },ap);
+      std::swap(this->src_,this->dst_);
+    }
+
+    /* checks if some items differ in the specified digit */
+    __forceinline bool isDigitUsed(const size_t shift) const {
+      return !keyBitsKnown || ((keyBitsDiffer >> shift) & Key(BUCKETS-1)) != 0;
     }
     
     void tbbRadixSort(const size_t numTasks)
     {
       radixCount = (TyRadixCount*) alignedMalloc(MAX_TASKS*sizeof(TyRadixCount),64);
-      
-      if (sizeof(Key) == sizeof(uint32_t)) {
-        tbbRadixIteration(0*BITS,0,src,tmp,numTasks);
-        tbbRadixIteration(1*BITS,0,tmp,src,numTasks);
-        tbbRadixIteration(2*BITS,0,src,tmp,numTasks);
-        tbbRadixIteration(3*BITS,1,tmp,src,numTasks);
+      if (WRITE_COMBINING) wcBuffer = (char*) alignedMalloc(numTasks*BUCKETS*CACHELINE_SIZE,64);
+
+      /* sort by each digit, skipping digits that are the same for all items */
+      keyBitsKnown = false;
+      src_ = src; dst_ = tmp;
+      for (size_t d=0; d<DIGITS; d++) {
+        if (isDigitUsed(d*BITS))
+          tbbRadixIteration(d*BITS,numTasks);
       }
-      else if (sizeof(Key) == sizeof(uint64_t))
-      {
-        tbbRadixIteration(0*BITS,0,src,tmp,numTasks);
-        tbbRadixIteration(1*BITS,0,tmp,src,numTasks);
-        tbbRadixIteration(2*BITS,0,src,tmp,numTasks);
-        tbbRadixIteration(3*BITS,0,tmp,src,numTasks);
-        tbbRadixIteration(4*BITS,0,src,tmp,numTasks);
-        tbbRadixIteration(5*BITS,0,tmp,src,numTasks);
-        tbbRadixIteration(6*BITS,0,src,tmp,numTasks);
-        tbbRadixIteration(7*BITS,1,tmp,src,numTasks);
+
+      /* copy result back to source array after odd number of iterations */
+      if (src_ != src) {
+        parallel_for(size_t(0),N,size_t(4096),[&] (const range<size_t>& r) {
+            for (size_t i=r.begin(); i<r.end(); i++)
+              src[i] = tmp[i];
+          });
       }
     }
     
   private:
     TyRadixCount* radixCount;
+    char* wcBuffer;              //!< cache line sized write combining buffer per bucket and task
+    Key keyBitsOr[MAX_TASKS];    //!< OR of all keys of each task
+    Key keyBitsAnd[MAX_TASKS];   //!< AND of all keys of each task
+    Key keyBitsDiffer;           //!< bits that differ between some keys
+    bool keyBitsKnown;           //!< true when keyBitsDiffer got calculated
+    Ty* src_;                    //!< input of the current iteration
+    Ty* dst_;                    //!< output of the current iteration
     Ty* const src;
     Ty* const tmp;
     const size_t N;
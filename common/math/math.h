@@ -94,40 +94,22 @@ namespace embree
   }
 
   __forceinline float signmsk ( const float x ) {
-#if defined(__aarch64__) && defined(BUILD_IOS)
-      // FP and Neon shares same vector register in arm64
-      __m128 a;
-      __m128i b;
-      a[0] = x;
-      b[0] = 0x80000000;
-      a = _mm_and_ps(a, b);
-      return a[0];
+#if defined(__NEON_NATIVE__)
+    return cast_i2f(cast_f2i(x) & int(0x80000000));
 #else
     return _mm_cvtss_f32(_mm_and_ps(_mm_set_ss(x),_mm_castsi128_ps(_mm_set1_epi32(0x80000000))));
 #endif
   }
   __forceinline float xorf( const float x, const float y ) {
-#if defined(__aarch64__) && defined(BUILD_IOS)
-      // FP and Neon shares same vector register in arm64
-      __m128 a;
-      __m128 b;
-      a[0] = x;
-      b[0] = y;
-      a = _mm_xor_ps(a, b);
-      return a[0];
+#if defined(__NEON_NATIVE__)
+    return cast_i2f(cast_f2i(x) ^ cast_f2i(y));
 #else
     return _mm_cvtss_f32(_mm_xor_ps(_mm_set_ss(x),_mm_set_ss(y)));
 #endif
   }
   __forceinline float andf( const float x, const unsigned y ) {
-#if defined(__aarch64__) && defined(BUILD_IOS)
-      // FP and Neon shares same vector register in arm64
-      __m128 a;
-      __m128 b;
-      a[0] = x;
-      b[0] = y;
-      a = _mm_and_ps(a, b);
-      return a[0];
+#if defined(__NEON_NATIVE__)
+    return cast_i2f(cast_f2i(x) & int(y));
 #else
     return _mm_cvtss_f32(_mm_and_ps(_mm_set_ss(x),_mm_castsi128_ps(_mm_set1_epi32(y))));
 #endif
@@ -210,16 +192,11 @@ namespace embree
   __forceinline double floor( const double x ) { return ::floor (x); }
   __forceinline double ceil ( const double x ) { return ::ceil (x); }
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
-    __forceinline float mini(float a, float b) {
-        // FP and Neon shares same vector register in arm64
-        __m128 x;
-        __m128 y;
-        x[0] = a;
-        y[0] = b;
-        x = _mm_min_ps(x, y);
-        return x[0];
-    }
+#if defined(__NEON_NATIVE__)
+  __forceinline float mini(float a, float b) {
+    const int ai = cast_f2i(a), bi = cast_f2i(b);
+    return cast_i2f(ai < bi ? ai : bi);
+  }
 #elif defined(__SSE4_1__)
   __forceinline float mini(float a, float b) {
     const __m128i ai = _mm_castps_si128(_mm_set_ss(a));
@@ -229,16 +206,11 @@ namespace embree
   }
 #endif
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
-    __forceinline float maxi(float a, float b) {
-        // FP and Neon shares same vector register in arm64
-        __m128 x;
-        __m128 y;
-        x[0] = a;
-        y[0] = b;
-        x = _mm_max_ps(x, y);
-        return x[0];
-    }
+#if defined(__NEON_NATIVE__)
+  __forceinline float maxi(float a, float b) {
+    const int ai = cast_f2i(a), bi = cast_f2i(b);
+    return cast_i2f(ai < bi ? bi : ai);
+  }
 #elif defined(__SSE4_1__)
   __forceinline float maxi(float a, float b) {
     const __m128i ai = _mm_castps_si128(_mm_set_ss(a));
@@ -254,16 +226,8 @@ namespace embree
   __forceinline      int min(int      a, int      b) { return a<b ? a:b; }
   __forceinline unsigned min(unsigned a, unsigned b) { return a<b ? a:b; }
   __forceinline  int64_t min(int64_t  a, int64_t  b) { return a<b ? a:b; }
-#if defined(__aarch64__) && defined(BUILD_IOS)
-    __forceinline float min(float a, float b) {
-        // FP and Neon shares same vector register in arm64
-        __m128 x;
-        __m128 y;
-        x[0] = a;
-        y[0] = b;
-        x = _mm_min_ps(x, y);
-        return x[0];
-    }
+#if defined(__NEON_NATIVE__)
+  __forceinline float min(float a, float b) { return vget_lane_f32(vmin_f32(vdup_n_f32(a), vdup_n_f32(b)), 0); }
 #else
     __forceinline    float min(float    a, float    b) { return a<b ? a:b; }
 #endif
@@ -283,16 +247,8 @@ namespace embree
   __forceinline      int max(int      a, int      b) { return a<b ? b:a; }
   __forceinline unsigned max(unsigned a, unsigned b) { return a<b ? b:a; }
   __forceinline  int64_t max(int64_t  a, int64_t  b) { return a<b ? b:a; }
-#if defined(__aarch64__) && defined(BUILD_IOS)
-    __forceinline float max(float a, float b) {
-        // FP and Neon shares same vector register in arm64
-        __m128 x;
-        __m128 y;
-        x[0] = a;
-        y[0] = b;
-        x = _mm_max_ps(x, y);
-        return x[0];
-    }
+#if defined(__NEON_NATIVE__)
+  __forceinline float max(float a, float b) { return vget_lane_f32(vmax_f32(vdup_n_f32(a), vdup_n_f32(b)), 0); }
 #else
     __forceinline    float max(float    a, float    b) { return a<b ? b:a; }
 #endif
@@ -463,4 +419,17 @@ namespace embree
 
     return x | (y << 1) | (z << 2);
   }
+
+#if defined(__AVX2__) && defined(__X86_64__)
+
+  template<>
+    __forceinline uint64_t bitInterleave64(const uint64_t& xi, const uint64_t& yi, const uint64_t& zi)
+  {
+    const uint64_t xx = pdep(size_t(xi),size_t(0x1249249249249249));
+    const uint64_t yy = pdep(size_t(yi),size_t(0x2492492492492492));
+    const uint64_t zz = pdep(size_t(zi),size_t(0x4924924924924924));
+    return xx | yy | zz;
+  }
+
+#endif
 }
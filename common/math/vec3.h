@@ -286,6 +286,12 @@ namespace embree
 #include "../simd/avx.h"
 #endif
 
+#if !defined(__AVX__) && defined(EMBREE_BVH8_SIMD4)
+#include "../simd/vboolf8_sse2.h"
+#include "../simd/vint8_sse2.h"
+#include "../simd/vfloat8_sse2.h"
+#endif
+
 #if defined(__AVX512F__)
 #include "../simd/avx512.h"
 #endif
@@ -326,6 +332,13 @@ namespace embree
   }
 #endif
 
+#if !defined(__AVX__) && defined(EMBREE_BVH8_SIMD4)
+  template<>
+  __forceinline Vec3<vfloat8>::Vec3(const Vec3fa& a) {
+    const Vec3<vfloat4> v(a); x = vfloat8(v.x); y = vfloat8(v.y); z = vfloat8(v.z);
+  }
+#endif
+
 #if defined(__AVX__)
   template<>
   __forceinline Vec3<vfloat8>::Vec3(const Vec3fa& a) {
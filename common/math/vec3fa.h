@@ -150,9 +150,8 @@ namespace embree
 #endif
   }
   __forceinline Vec3fa sign ( const Vec3fa& a ) {
-#if defined(__aarch64__) && defined(BUILD_IOS)
-    Vec3fa r = blendv_ps(vOne, vmOne, _mm_cmplt_ps (a.m128,vzero));
-    return r;
+#if defined(__NEON_NATIVE__)
+    return vbslq_f32(vcltzq_f32(a.m128), vmOne, vOne);
 #else
     return blendv_ps(Vec3fa(one), -Vec3fa(one), _mm_cmplt_ps (a,Vec3fa(zero)));
 #endif
@@ -314,19 +313,19 @@ namespace embree
   ////////////////////////////////////////////////////////////////////////////////
   /// Reductions
   ////////////////////////////////////////////////////////////////////////////////
-#if defined(__aarch64__) && defined(BUILD_IOS)
+#if defined(__NEON_NATIVE__)
   __forceinline float reduce_add(const Vec3fa& v) {
-    float32x4_t t = vandq_u32(v.m128, vFFF0);
+    const float32x4_t t = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(v.m128), vFFF0));
     return vaddvq_f32(t);
   }
-                                                                                
+
   __forceinline float reduce_mul(const Vec3fa& v) { return v.x*v.y*v.z; }
   __forceinline float reduce_min(const Vec3fa& v) {
-    float32x4_t t = blendv_ps(vInf, v.m128, vFFF0);
+    const float32x4_t t = vbslq_f32(vFFF0, v.m128, vInf);
     return vminvq_f32(t);
   }
   __forceinline float reduce_max(const Vec3fa& v) {
-    float32x4_t t = blendv_ps(vmInf, v.m128, vFFF0);
+    const float32x4_t t = vbslq_f32(vFFF0, v.m128, vmInf);
     return vmaxvq_f32(t);
   }
 #else
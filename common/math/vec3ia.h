@@ -78,7 +78,7 @@ namespace embree
 
   __forceinline Vec3ia operator +( const Vec3ia& a ) { return a; }
   __forceinline Vec3ia operator -( const Vec3ia& a ) { return _mm_sub_epi32(_mm_setzero_si128(), a.m128); }
-#if (defined(__aarch64__) && defined(BUILD_IOS)) || defined(__SSSE3__)
+#if defined(__NEON_NATIVE__) || defined(__SSSE3__)
   __forceinline Vec3ia abs       ( const Vec3ia& a ) { return _mm_abs_epi32(a.m128); }
 #endif
 
@@ -150,22 +150,19 @@ namespace embree
   ////////////////////////////////////////////////////////////////////////////////
   /// Reductions
   ////////////////////////////////////////////////////////////////////////////////
-#if defined(__aarch64__) && defined(BUILD_IOS)
+#if defined(__NEON_NATIVE__)
   __forceinline int reduce_add(const Vec3ia& v) {
-    int32x4_t t = vandq_u32(v.m128, vFFF0);
+    const int32x4_t t = vandq_s32(v.m128, vreinterpretq_s32_u32(vFFF0));
     return vaddvq_s32(t);
-        
   }
   __forceinline int reduce_mul(const Vec3ia& v) { return v.x*v.y*v.z; }
   __forceinline int reduce_min(const Vec3ia& v) {
-    int32x4_t t = blendv_ps(v0x7fffffff, v.m128, vFFF0);
+    const int32x4_t t = vbslq_s32(vFFF0, v.m128, vreinterpretq_s32_u32(v0x7fffffff));
     return vminvq_s32(t);
-        
   }
   __forceinline int reduce_max(const Vec3ia& v) {
-    int32x4_t t = blendv_ps(v0x80000000, v.m128, vFFF0);
+    const int32x4_t t = vbslq_s32(vFFF0, v.m128, vreinterpretq_s32_u32(v0x80000000));
     return vmaxvq_s32(t);
-        
   }
 #else
   __forceinline int reduce_add(const Vec3ia& v) { return v.x+v.y+v.z; }
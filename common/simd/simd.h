@@ -28,6 +28,13 @@
 #  include "avx.h"
 #endif
 
+/* include 8-wide wrapper classes built from two 4-wide halves (BVH8 on SSE/NEON) */
+#if !defined(__AVX__) && defined(EMBREE_BVH8_SIMD4)
+#  include "vboolf8_sse2.h"
+#  include "vint8_sse2.h"
+#  include "vfloat8_sse2.h"
+#endif
+
 /* include AVX512 wrapper classes */
 #if defined (__AVX512F__)
 #  include "avx512.h"
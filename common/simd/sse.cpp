@@ -15,6 +15,16 @@
 // ======================================================================== //
 
 #include "sse.h"
+#include "../sys/regression.h"
+
+#if !defined(__AVX__) && defined(EMBREE_BVH8_SIMD4)
+#  include "vboolf8_sse2.h"
+#  include "vint8_sse2.h"
+#  include "vfloat8_sse2.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
 
 namespace embree 
 {
@@ -44,4 +54,190 @@ namespace embree
     _mm_castsi128_pd(_mm_set_epi32(-1,-1,-1,-1))
   };
 
+  /* checks the 4-wide SIMD types against a scalar reference, this
+   * mainly guards the hand written NEON code paths on ARM */
+  struct SIMD4RegressionTest : public RegressionTest
+  {
+    SIMD4RegressionTest(const char* name) : RegressionTest(name) {
+      registerRegressionTest(this);
+    }
+
+    static int rnd(int range) {
+      return (rand() % (2*range+1)) - range;
+    }
+
+    bool run ()
+    {
+      bool passed = true;
+
+      for (size_t iter=0; iter<1000; iter++)
+      {
+        int ai[4], bi[4]; float af[4], bf[4]; bool m[4];
+        for (size_t i=0; i<4; i++) {
+          ai[i] = rnd(1000); bi[i] = rnd(1000);
+          af[i] = 0.25f*float(rnd(1000)); bf[i] = 0.25f*float(rnd(1000));
+          m[i] = rand() & 1;
+        }
+        const vint4 va(ai[0],ai[1],ai[2],ai[3]);
+        const vint4 vb(bi[0],bi[1],bi[2],bi[3]);
+        const vfloat4 fa(af[0],af[1],af[2],af[3]);
+        const vfloat4 fb(bf[0],bf[1],bf[2],bf[3]);
+        const vboolf4 vm(m[0],m[1],m[2],m[3]);
+
+        /* mask operations */
+        size_t mask = 0, cnt = 0;
+        for (size_t i=0; i<4; i++) {
+          mask |= size_t(m[i]) << i;
+          cnt += m[i];
+          passed &= vm[i] == m[i];
+        }
+        passed &= movemask(vm) == mask;
+        passed &= popcnt(vm) == cnt;
+        passed &= all(vm) == (mask == 0xF);
+        passed &= any(vm) == (mask != 0x0);
+        passed &= none(vm) == (mask == 0x0);
+        passed &= movemask(!vm) == (~mask & 0xF);
+        passed &= movemask(fa < fb) == size_t((af[0]<bf[0]) | (af[1]<bf[1])<<1 | (af[2]<bf[2])<<2 | (af[3]<bf[3])<<3);
+
+        /* selection */
+        const vint4 si = select(vm,va,vb);
+        const vfloat4 sf = select(vm,fa,fb);
+        for (size_t i=0; i<4; i++) {
+          passed &= si[i] == (m[i] ? ai[i] : bi[i]);
+          passed &= sf[i] == (m[i] ? af[i] : bf[i]);
+        }
+
+        /* shuffles and lane access */
+        const vint4 s0 = shuffle<3,1,2,0>(va);
+        const vint4 s1 = shuffle<0,0,2,2>(va);
+        const vint4 s2 = shuffle<1,1,3,3>(va);
+        const vint4 s3 = shuffle<0,1,0,1>(va);
+        const vfloat4 s4 = shuffle<2,3,1,0>(fa,fb);
+        const vfloat4 ul = unpacklo(fa,fb), uh = unpackhi(fa,fb);
+        passed &= s0[0] == ai[3] && s0[1] == ai[1] && s0[2] == ai[2] && s0[3] == ai[0];
+        passed &= s1[0] == ai[0] && s1[1] == ai[0] && s1[2] == ai[2] && s1[3] == ai[2];
+        passed &= s2[0] == ai[1] && s2[1] == ai[1] && s2[2] == ai[3] && s2[3] == ai[3];
+        passed &= s3[0] == ai[0] && s3[1] == ai[1] && s3[2] == ai[0] && s3[3] == ai[1];
+        passed &= s4[0] == af[2] && s4[1] == af[3] && s4[2] == bf[1] && s4[3] == bf[0];
+        passed &= ul[0] == af[0] && ul[1] == bf[0] && ul[2] == af[1] && ul[3] == bf[1];
+        passed &= uh[0] == af[2] && uh[1] == bf[2] && uh[2] == af[3] && uh[3] == bf[3];
+        passed &= extract<2>(va) == ai[2] && extract<3>(fa) == af[3];
+        passed &= toScalar(va) == ai[0] && toScalar(fa) == af[0];
+        const vint4 ii = insert<1>(va,bi[1]);
+        passed &= ii[0] == ai[0] && ii[1] == bi[1] && ii[2] == ai[2] && ii[3] == ai[3];
+
+        /* reductions */
+        passed &= reduce_min(va) == *std::min_element(ai,ai+4);
+        passed &= reduce_max(va) == *std::max_element(ai,ai+4);
+        passed &= reduce_add(va) == ai[0]+ai[1]+ai[2]+ai[3];
+        passed &= reduce_min(fa) == *std::min_element(af,af+4);
+        passed &= reduce_max(fa) == *std::max_element(af,af+4);
+        passed &= reduce_add(fa) == ((af[0]+af[1])+(af[2]+af[3]));
+
+        /* integer min/max of positive floats */
+        const vfloat4 mi = mini(abs(fa),abs(fb));
+        const vfloat4 ma = maxi(abs(fa),abs(fb));
+        for (size_t i=0; i<4; i++) {
+          passed &= mi[i] == std::min(std::abs(af[i]),std::abs(bf[i]));
+          passed &= ma[i] == std::max(std::abs(af[i]),std::abs(bf[i]));
+        }
+
+        /* sorting network */
+        float sorted[4] = { af[0],af[1],af[2],af[3] };
+        std::sort(sorted,sorted+4);
+        const vfloat4 so = sort_ascending(fa);
+        for (size_t i=0; i<4; i++)
+          passed &= so[i] == sorted[i];
+      }
+
+      /* compile time selection masks */
+      const vint4 t(1,2,3,4), f(-1,-2,-3,-4);
+      passed &= select<0x0>(t,f)[0] == -1 && select<0x0>(t,f)[3] == -4;
+      passed &= select<0x1>(t,f)[0] ==  1 && select<0x1>(t,f)[1] == -2;
+      passed &= select<0x2>(t,f)[1] ==  2 && select<0x2>(t,f)[0] == -1;
+      passed &= select<0x5>(t,f)[2] ==  3 && select<0x5>(t,f)[3] == -4;
+      passed &= select<0x8>(t,f)[3] ==  4 && select<0x8>(t,f)[2] == -3;
+      passed &= select<0xF>(t,f)[0] ==  1 && select<0xF>(t,f)[3] ==  4;
+      passed &= select<0x3>(vfloat4(t),vfloat4(f))[1] == 2.0f && select<0x3>(vfloat4(t),vfloat4(f))[2] == -3.0f;
+
+      return passed;
+    }
+  };
+
+  SIMD4RegressionTest simd4_regression_test("SIMD4RegressionTest");
+
+#if !defined(__AVX__) && defined(EMBREE_BVH8_SIMD4)
+
+  /* checks the 8-wide types built from two 4-wide halves, which
+   * the BVH8 traversal uses on SSE and NEON */
+  struct SIMD8x4RegressionTest : public RegressionTest
+  {
+    SIMD8x4RegressionTest(const char* name) : RegressionTest(name) {
+      registerRegressionTest(this);
+    }
+
+    static int rnd(int range) {
+      return (rand() % (2*range+1)) - range;
+    }
+
+    bool run ()
+    {
+      bool passed = true;
+
+      for (size_t iter=0; iter<1000; iter++)
+      {
+        int ai[8]; float af[8], bf[8]; bool m[8];
+        for (size_t i=0; i<8; i++) {
+          ai[i] = rnd(1000);
+          af[i] = 0.25f*float(rnd(1000)); bf[i] = 0.25f*float(rnd(1000));
+          m[i] = rand() & 1;
+        }
+        const vint8 va(ai[0],ai[1],ai[2],ai[3],ai[4],ai[5],ai[6],ai[7]);
+        const vfloat8 fa = vfloat8::loadu(af);
+        const vfloat8 fb = vfloat8::loadu(bf);
+        const vboolf8 vm(m[0],m[1],m[2],m[3],m[4],m[5],m[6],m[7]);
+
+        /* mask operations */
+        size_t mask = 0, cnt = 0, cmp = 0;
+        for (size_t i=0; i<8; i++) {
+          mask |= size_t(m[i]) << i;
+          cnt += m[i];
+          cmp  |= size_t(af[i] <= bf[i]) << i;
+          passed &= vm[i] == m[i];
+        }
+        passed &= movemask(vm) == mask;
+        passed &= movemask(vboolf8(int(mask))) == mask;
+        passed &= popcnt(vm) == cnt;
+        passed &= movemask(fa <= fb) == cmp;
+        passed &= movemask(asInt(maxi(abs(fa),abs(fb))) > asInt(mini(abs(fa),abs(fb)))) == movemask(max(abs(fa),abs(fb)) > min(abs(fa),abs(fb)));
+
+        /* selection and reductions */
+        const vfloat8 sf = select(vm,fa,fb);
+        for (size_t i=0; i<8; i++)
+          passed &= sf[i] == (m[i] ? af[i] : bf[i]);
+        passed &= reduce_min(fa) == *std::min_element(af,af+8);
+        passed &= reduce_max(fa) == *std::max_element(af,af+8);
+        passed &= reduce_min(va) == *std::min_element(ai,ai+8);
+        passed &= reduce_max(va) == *std::max_element(ai,ai+8);
+        passed &= af[select_min(vboolf8(True),fa)] == *std::min_element(af,af+8);
+
+        /* sorting networks used by the stream traversal */
+        unsigned int sorted[8];
+        for (size_t i=0; i<8; i++) sorted[i] = unsigned(ai[i]);
+        std::sort(sorted,sorted+8);
+        const vint8 sa = usort_ascending(va);
+        const vint8 sd = usort_descending(va);
+        for (size_t i=0; i<8; i++) {
+          passed &= unsigned(sa[i]) == sorted[i];
+          passed &= unsigned(sd[i]) == sorted[7-i];
+        }
+      }
+
+      return passed;
+    }
+  };
+
+  SIMD8x4RegressionTest simd8x4_regression_test("SIMD8x4RegressionTest");
+#endif
 }
+
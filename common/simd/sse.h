@@ -24,7 +24,11 @@
 
 namespace embree 
 {
-#if (defined(__aarch64__) && defined(BUILD_IOS)) || defined(__SSE4_1__)
+#if defined(__NEON_NATIVE__)
+  __forceinline __m128 blendv_ps(__m128 f, __m128 t, __m128 mask) { 
+    return vbslq_f32(vreinterpretq_u32_f32(mask), t, f);
+  }
+#elif defined(__SSE4_1__)
   __forceinline __m128 blendv_ps(__m128 f, __m128 t, __m128 mask) { 
     return _mm_blendv_ps(f,t,mask);
   }
@@ -50,13 +50,8 @@ namespace embree
       : v(mm_lookupmask_ps[(size_t(b) << 3) | (size_t(a) << 2) | (size_t(b) << 1) | size_t(a)]) {}
     __forceinline vboolf(bool a, bool b, bool c, bool d)
       : v(mm_lookupmask_ps[(size_t(d) << 3) | (size_t(c) << 2) | (size_t(b) << 1) | size_t(a)]) {}
-#if defined(__aarch64__) && defined(BUILD_IOS)
-      __forceinline vboolf(int mask) { v = mm_lookupmask_ps[mask]; }
-      __forceinline vboolf(unsigned int mask) { v = mm_lookupmask_ps[mask]; }
-#else
     __forceinline vboolf(int mask) { assert(mask >= 0 && mask < 16); v = mm_lookupmask_ps[mask]; }
     __forceinline vboolf(unsigned int mask) { assert(mask < 16); v = mm_lookupmask_ps[mask]; }
-#endif
     /* return int32 mask */
     __forceinline __m128i mask32() const { 
       return _mm_castps_si128(v);
@@ -73,9 +68,9 @@ namespace embree
     /// Array Access
     ////////////////////////////////////////////////////////////////////////////////
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
-      __forceinline bool operator [](size_t index) const { return (_mm_movemask_ps(v) >> index) & 1; }
-      __forceinline int& operator [](size_t index)       { return i[index]; }
+#if defined(__NEON_NATIVE__)
+    __forceinline bool operator [](size_t index) const { assert(index < 4); return i[index] < 0; }
+    __forceinline int& operator [](size_t index)       { assert(index < 4); return i[index]; }
 #else
     __forceinline bool operator [](size_t index) const { assert(index < 4); return (_mm_movemask_ps(v) >> index) & 1; }
     __forceinline int& operator [](size_t index)       { assert(index < 4); return i[index]; }
@@ -86,7 +81,11 @@ namespace embree
   /// Unary Operators
   ////////////////////////////////////////////////////////////////////////////////
   
+#if defined(__NEON_NATIVE__)
+  __forceinline vboolf4 operator !(const vboolf4& a) { return vreinterpretq_f32_u32(vmvnq_u32(vreinterpretq_u32_f32(a.v))); }
+#else
   __forceinline vboolf4 operator !(const vboolf4& a) { return _mm_xor_ps(a, vboolf4(embree::True)); }
+#endif
   
   ////////////////////////////////////////////////////////////////////////////////
   /// Binary Operators
@@ -114,7 +113,9 @@ namespace embree
   __forceinline vboolf4 operator ==(const vboolf4& a, const vboolf4& b) { return _mm_castsi128_ps(_mm_cmpeq_epi32(a, b)); }
   
   __forceinline vboolf4 select(const vboolf4& m, const vboolf4& t, const vboolf4& f) {
-#if (defined(__aarch64__) && defined(BUILD_IOS)) || defined(__SSE4_1__)
+#if defined(__NEON_NATIVE__)
+    return vbslq_f32(vreinterpretq_u32_f32(m.v), t.v, f.v);
+#elif defined(__SSE4_1__)
     return _mm_blendv_ps(f, t, m); 
 #else
     return _mm_or_ps(_mm_and_ps(m, t), _mm_andnot_ps(m, f)); 
@@ -125,18 +126,26 @@ namespace embree
   /// Movement/Shifting/Shuffling Functions
   ////////////////////////////////////////////////////////////////////////////////
   
+#if defined(__NEON_NATIVE__)
+  __forceinline vboolf4 unpacklo(const vboolf4& a, const vboolf4& b) { return vzip1q_f32(a.v, b.v); }
+  __forceinline vboolf4 unpackhi(const vboolf4& a, const vboolf4& b) { return vzip2q_f32(a.v, b.v); }
+#else
   __forceinline vboolf4 unpacklo(const vboolf4& a, const vboolf4& b) { return _mm_unpacklo_ps(a, b); }
   __forceinline vboolf4 unpackhi(const vboolf4& a, const vboolf4& b) { return _mm_unpackhi_ps(a, b); }
+#endif
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
+#if defined(__NEON_NATIVE__)
   template<int i0, int i1, int i2, int i3>
   __forceinline vboolf4 shuffle(const vboolf4& v) {
-    return vqtbl1q_u8( (__m128i)v, _MN_SHUFFLE(i0, i1, i2, i3));
+    return vreinterpretq_f32_u8(vqtbl1q_u8(vreinterpretq_u8_f32(v.v), _MN_SHUFFLE(i0, i1, i2, i3)));
   }
                                                                 
   template<int i0, int i1, int i2, int i3>
   __forceinline vboolf4 shuffle(const vboolf4& a, const vboolf4& b) {
-    return vqtbl2q_u8( (uint8x16x2_t){(__m128i)a, (__m128i)b}, _MF_SHUFFLE(i0, i1, i2, i3) );
+    uint8x16x2_t ab;
+    ab.val[0] = vreinterpretq_u8_f32(a.v);
+    ab.val[1] = vreinterpretq_u8_f32(b.v);
+    return vreinterpretq_f32_u8(vqtbl2q_u8(ab, _MF_SHUFFLE(i0, i1, i2, i3)));
   }
 #else
   template<int i0, int i1, int i2, int i3>
@@ -155,10 +164,10 @@ namespace embree
     return shuffle<i0,i0,i0,i0>(v);
   }
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
-  template<> __forceinline vboolf4 shuffle<0, 0, 2, 2>(const vboolf4& v) { return vqtbl1q_u8( (int32x4_t)v, v0022 ); }
-  template<> __forceinline vboolf4 shuffle<1, 1, 3, 3>(const vboolf4& v) { return vqtbl1q_u8( (int32x4_t)v, v1133 ); }
-  template<> __forceinline vboolf4 shuffle<0, 1, 0, 1>(const vboolf4& v) { return vqtbl1q_u8( (int32x4_t)v, v0101 ); }
+#if defined(__NEON_NATIVE__)
+  template<> __forceinline vboolf4 shuffle<0, 0, 2, 2>(const vboolf4& v) { return vtrn1q_f32(v.v, v.v); }
+  template<> __forceinline vboolf4 shuffle<1, 1, 3, 3>(const vboolf4& v) { return vtrn2q_f32(v.v, v.v); }
+  template<> __forceinline vboolf4 shuffle<0, 1, 0, 1>(const vboolf4& v) { return vcombine_f32(vget_low_f32(v.v), vget_low_f32(v.v)); }
 #elif defined(__SSE3__)
   template<> __forceinline vboolf4 shuffle<0, 0, 2, 2>(const vboolf4& v) { return _mm_moveldup_ps(v); }
   template<> __forceinline vboolf4 shuffle<1, 1, 3, 3>(const vboolf4& v) { return _mm_movehdup_ps(v); }
@@ -175,21 +184,36 @@ namespace embree
   /// Reduction Operations
   ////////////////////////////////////////////////////////////////////////////////
     
+#if defined(__NEON_NATIVE__)
+  /* a lane is set if its sign bit is set, thus the horizontal signed min/max tells if any/all lanes are set */
+  __forceinline bool reduce_and(const vboolf4& a) { return vmaxvq_s32(vreinterpretq_s32_f32(a.v)) < 0; }
+  __forceinline bool reduce_or (const vboolf4& a) { return vminvq_s32(vreinterpretq_s32_f32(a.v)) < 0; }
+
+  __forceinline bool all (const vboolf4& b) { return vmaxvq_s32(vreinterpretq_s32_f32(b.v)) <  0; }
+  __forceinline bool any (const vboolf4& b) { return vminvq_s32(vreinterpretq_s32_f32(b.v)) <  0; }
+  __forceinline bool none(const vboolf4& b) { return vminvq_s32(vreinterpretq_s32_f32(b.v)) >= 0; }
+#else
   __forceinline bool reduce_and(const vboolf4& a) { return _mm_movemask_ps(a) == 0xf; }
   __forceinline bool reduce_or (const vboolf4& a) { return _mm_movemask_ps(a) != 0x0; }
 
   __forceinline bool all (const vboolf4& b) { return _mm_movemask_ps(b) == 0xf; }
   __forceinline bool any (const vboolf4& b) { return _mm_movemask_ps(b) != 0x0; }
   __forceinline bool none(const vboolf4& b) { return _mm_movemask_ps(b) == 0x0; }
+#endif
 
   __forceinline bool all (const vboolf4& valid, const vboolf4& b) { return all((!valid) | b); }
   __forceinline bool any (const vboolf4& valid, const vboolf4& b) { return any(valid & b); }
   __forceinline bool none(const vboolf4& valid, const vboolf4& b) { return none(valid & b); }
   
-  __forceinline size_t movemask(const vboolf4& a) { return _mm_movemask_ps(a); }
-#if defined(__aarch64__) && defined(BUILD_IOS)
-__forceinline size_t popcnt(const vboolf4& a) { return _mm_movemask_popcnt_ps(a); }
+#if defined(__NEON_NATIVE__)
+  /* shifts the sign bit of lane i to bit i and sums the lanes */
+  __forceinline size_t movemask(const vboolf4& a) {
+    const int32x4_t shift = { 0, 1, 2, 3 };
+    return vaddvq_u32(vshlq_u32(vshrq_n_u32(vreinterpretq_u32_f32(a.v), 31), shift));
+  }
+  __forceinline size_t popcnt(const vboolf4& a) { return vaddvq_u32(vshrq_n_u32(vreinterpretq_u32_f32(a.v), 31)); }
 #else
+  __forceinline size_t movemask(const vboolf4& a) { return _mm_movemask_ps(a); }
 #if defined(__SSE4_2__)
   __forceinline size_t popcnt(const vboolf4& a) { return popcnt((size_t)_mm_movemask_ps(a)); }
 #else
@@ -0,0 +1,172 @@
+// ======================================================================== //
+// Copyright 2009-2020 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+namespace embree
+{
+  /* 8-wide bool type for 4-wide ISAs, operates on two vboolf4 halves */
+  template<>
+  struct vboolf<8>
+  {
+    ALIGNED_STRUCT_(16);
+
+    typedef vboolf8 Bool;
+    typedef vint8   Int;
+    typedef vfloat8 Float;
+
+    enum  { size = 8 };       // number of SIMD elements
+    vboolf4 vl,vh;            // data
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// Constructors, Assignment & Cast Operators
+    ////////////////////////////////////////////////////////////////////////////////
+
+    __forceinline vboolf() {}
+    __forceinline vboolf(const vboolf8& a) : vl(a.vl), vh(a.vh) {}
+    __forceinline vboolf8& operator =(const vboolf8& a) { vl = a.vl; vh = a.vh; return *this; }
+
+    __forceinline vboolf(int a)
+    {
+      assert(a >= 0 && a <= 255);
+      vl = mm_lookupmask_ps[a & 0xF];
+      vh = mm_lookupmask_ps[a >> 4];
+    }
+
+    __forceinline explicit vboolf(const vboolf4& a) : vl(a), vh(a) {}
+    __forceinline vboolf(const vboolf4& a, const vboolf4& b) : vl(a), vh(b) {}
+
+    __forceinline vboolf(bool a) : vl(a), vh(a) {}
+    __forceinline vboolf(bool a, bool b) : vl(a,b), vh(a,b) {}
+    __forceinline vboolf(bool a, bool b, bool c, bool d) : vl(a,b,c,d), vh(a,b,c,d) {}
+    __forceinline vboolf(bool a, bool b, bool c, bool d, bool e, bool f, bool g, bool h) : vl(a,b,c,d), vh(e,f,g,h) {}
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// Constants
+    ////////////////////////////////////////////////////////////////////////////////
+
+    __forceinline vboolf(FalseTy) : vl(False), vh(False) {}
+    __forceinline vboolf(TrueTy)  : vl(True),  vh(True)  {}
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// Array Access
+    ////////////////////////////////////////////////////////////////////////////////
+
+    __forceinline bool operator [](size_t index) const { assert(index < 8); return (&vl)[index >> 2][index & 3]; }
+    __forceinline int& operator [](size_t index)       { assert(index < 8); return (&vl)[index >> 2][index & 3]; }
+  };
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Unary Operators
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline vboolf8 operator !(const vboolf8& a) { return vboolf8(!a.vl, !a.vh); }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Binary Operators
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline vboolf8 operator &(const vboolf8& a, const vboolf8& b) { return vboolf8(a.vl & b.vl, a.vh & b.vh); }
+  __forceinline vboolf8 operator |(const vboolf8& a, const vboolf8& b) { return vboolf8(a.vl | b.vl, a.vh | b.vh); }
+  __forceinline vboolf8 operator ^(const vboolf8& a, const vboolf8& b) { return vboolf8(a.vl ^ b.vl, a.vh ^ b.vh); }
+
+  __forceinline vboolf8 andn(const vboolf8& a, const vboolf8& b) { return vboolf8(andn(a.vl, b.vl), andn(a.vh, b.vh)); }
+
+  __forceinline vboolf8& operator &=(vboolf8& a, const vboolf8& b) { return a = a & b; }
+  __forceinline vboolf8& operator |=(vboolf8& a, const vboolf8& b) { return a = a | b; }
+  __forceinline vboolf8& operator ^=(vboolf8& a, const vboolf8& b) { return a = a ^ b; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Comparison Operators + Select
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline vboolf8 operator !=(const vboolf8& a, const vboolf8& b) { return vboolf8(a.vl != b.vl, a.vh != b.vh); }
+  __forceinline vboolf8 operator ==(const vboolf8& a, const vboolf8& b) { return vboolf8(a.vl == b.vl, a.vh == b.vh); }
+
+  __forceinline vboolf8 select(const vboolf8& mask, const vboolf8& t, const vboolf8& f) {
+    return vboolf8(select(mask.vl, t.vl, f.vl), select(mask.vh, t.vh, f.vh));
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Movement/Shifting/Shuffling Functions
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline vboolf8 unpacklo(const vboolf8& a, const vboolf8& b) { return vboolf8(unpacklo(a.vl, b.vl), unpacklo(a.vh, b.vh)); }
+  __forceinline vboolf8 unpackhi(const vboolf8& a, const vboolf8& b) { return vboolf8(unpackhi(a.vl, b.vl), unpackhi(a.vh, b.vh)); }
+
+  template<int i>
+  __forceinline vboolf8 shuffle(const vboolf8& v) {
+    return vboolf8(shuffle<i>(v.vl), shuffle<i>(v.vh));
+  }
+
+  template<int i0, int i1>
+  __forceinline vboolf8 shuffle4(const vboolf8& v) {
+    return vboolf8((&v.vl)[i0], (&v.vl)[i1]);
+  }
+
+  template<int i0, int i1>
+  __forceinline vboolf8 shuffle4(const vboolf8& a, const vboolf8& b) {
+    return vboolf8((&a.vl)[i0], (&b.vl)[i1]);
+  }
+
+  template<int i0, int i1, int i2, int i3>
+  __forceinline vboolf8 shuffle(const vboolf8& v) {
+    return vboolf8(shuffle<i0,i1,i2,i3>(v.vl), shuffle<i0,i1,i2,i3>(v.vh));
+  }
+
+  template<int i0, int i1, int i2, int i3>
+  __forceinline vboolf8 shuffle(const vboolf8& a, const vboolf8& b) {
+    return vboolf8(shuffle<i0,i1,i2,i3>(a.vl, b.vl), shuffle<i0,i1,i2,i3>(a.vh, b.vh));
+  }
+
+  template<int i> __forceinline vboolf8 insert4(const vboolf8& a, const vboolf4& b) { vboolf8 c = a; (&c.vl)[i] = b; return c; }
+  template<int i> __forceinline vboolf4 extract4(const vboolf8& a) { return (&a.vl)[i]; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Reduction Operations
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline bool reduce_and(const vboolf8& a) { return reduce_and(a.vl & a.vh); }
+  __forceinline bool reduce_or (const vboolf8& a) { return reduce_or (a.vl | a.vh); }
+
+  __forceinline bool all (const vboolf8& a) { return all (a.vl & a.vh); }
+  __forceinline bool any (const vboolf8& a) { return any (a.vl | a.vh); }
+  __forceinline bool none(const vboolf8& a) { return none(a.vl | a.vh); }
+
+  __forceinline bool all (const vboolf8& valid, const vboolf8& b) { return all((!valid) | b); }
+  __forceinline bool any (const vboolf8& valid, const vboolf8& b) { return any(valid & b); }
+  __forceinline bool none(const vboolf8& valid, const vboolf8& b) { return none(valid & b); }
+
+  __forceinline unsigned int movemask(const vboolf8& a) { return (unsigned int)(movemask(a.vl) | (movemask(a.vh) << 4)); }
+  __forceinline size_t       popcnt  (const vboolf8& a) { return popcnt(a.vl) + popcnt(a.vh); }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Get/Set Functions
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline bool get(const vboolf8& a, size_t index) { return a[index]; }
+  __forceinline void set(vboolf8& a, size_t index)       { a[index] = -1; }
+  __forceinline void clear(vboolf8& a, size_t index)     { a[index] =  0; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Output Operators
+  ////////////////////////////////////////////////////////////////////////////////
+
+  inline std::ostream& operator <<(std::ostream& cout, const vboolf8& a) {
+    return cout << "<" << a[0] << ", " << a[1] << ", " << a[2] << ", " << a[3] << ", "
+                       << a[4] << ", " << a[5] << ", " << a[6] << ", " << a[7] << ">";
+  }
+}
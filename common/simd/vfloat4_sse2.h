@@ -112,6 +112,8 @@ namespace embree
 
 #if defined(__AVX__)
     static __forceinline vfloat4 broadcast(const void* a) { return _mm_broadcast_ss((float*)a); }
+#elif defined(__NEON_NATIVE__)
+    static __forceinline vfloat4 broadcast(const void* a) { return vld1q_dup_f32((float*)a); }
 #else
     static __forceinline vfloat4 broadcast(const void* a) { return _mm_set1_ps(*(float*)a); }
 #endif
@@ -124,9 +126,9 @@ namespace embree
 #endif
   }
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
+#if defined(__NEON_NATIVE__)
     static __forceinline vfloat4 load(const int8_t* ptr) {
-        return _mm_load4epi8_f32(((__m128i*)ptr));
+      return vreinterpretq_f32_s32(_mm_load4epi8_f32((__m128i*)ptr));
     }
 #elif defined(__SSE4_1__)
     static __forceinline vfloat4 load(const int8_t* ptr) {
@@ -138,9 +140,9 @@ namespace embree
     }
 #endif
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
+#if defined(__NEON_NATIVE__)
     static __forceinline vfloat4 load(const uint8_t* ptr) {
-        return _mm_load4epu8_f32(((__m128i*)ptr));
+      return vcvtq_f32_u32(vreinterpretq_u32_s32(_mm_load4epu8_epi32((__m128i*)ptr)));
     }
 #elif defined(__SSE4_1__)
     static __forceinline vfloat4 load(const uint8_t* ptr) {
@@ -153,9 +155,9 @@ namespace embree
     }
 #endif
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
+#if defined(__NEON_NATIVE__)
     static __forceinline vfloat4 load(const short* ptr) {
-        return _mm_load4epi16_f32(((__m128i*)ptr));
+      return vreinterpretq_f32_s32(_mm_load4epi16_f32((__m128i*)ptr));
     }
 #elif defined(__SSE4_1__)
     static __forceinline vfloat4 load(const short* ptr) {
@@ -171,6 +173,22 @@ namespace embree
       return _mm_mul_ps(vfloat4(vint4::load(ptr)),vfloat4(1.0f/65535.0f));
     }
 
+    /* loads 4 IEEE half precision values, infinities and NaNs are only converted with hardware support */
+    static __forceinline vfloat4 load_half(const unsigned short* ptr) {
+#if defined(__aarch64__) && defined(__NEON_NATIVE__)
+      return vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(ptr)));
+#elif defined(__F16C__)
+      return _mm_cvtph_ps(_mm_loadl_epi64((__m128i*)ptr));
+#else
+      /* rebias the exponent with a multiplication, which also handles denormals */
+      const __m128i h = vint4::load(ptr);
+      const __m128i m = _mm_slli_epi32(_mm_and_si128(h,_mm_set1_epi32(0x7fff)),13);
+      const __m128i s = _mm_slli_epi32(_mm_and_si128(h,_mm_set1_epi32(0x8000)),16);
+      const __m128  f = _mm_mul_ps(_mm_castsi128_ps(m),_mm_castsi128_ps(_mm_set1_epi32(0x77800000))); // 2^112
+      return _mm_or_ps(f,_mm_castsi128_ps(s));
+#endif
+    }
+
     static __forceinline void store_nt(void* ptr, const vfloat4& v)
     {
 #if defined (__SSE4_1__)
@@ -252,6 +270,8 @@ namespace embree
     friend __forceinline vfloat4 select(const vboolf4& m, const vfloat4& t, const vfloat4& f) {
 #if defined(__AVX512VL__)
       return _mm_mask_blend_ps(m, f, t);
+#elif defined(__NEON_NATIVE__)
+      return vbslq_f32(vreinterpretq_u32_f32(m.v), t.v, f.v);
 #elif defined(__SSE4_1__)
       return _mm_blendv_ps(f, t, m);
 #else
@@ -397,16 +417,22 @@ namespace embree
   __forceinline vfloat4 max(const vfloat4& a, float          b) { return _mm_max_ps(a,vfloat4(b)); }
   __forceinline vfloat4 max(float          a, const vfloat4& b) { return _mm_max_ps(vfloat4(a),b); }
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
-__forceinline vfloat4 mini(const vfloat4& a, const vfloat4& b)
-    {
-        return _mm_min_ps(a, b);
-    }
+#if defined(__NEON_NATIVE__)
+  __forceinline vfloat4 mini(const vfloat4& a, const vfloat4& b) {
+    return vreinterpretq_f32_s32(vminq_s32(vreinterpretq_s32_f32(a.v), vreinterpretq_s32_f32(b.v)));
+  }
 
-__forceinline vfloat4 maxi(const vfloat4& a, const vfloat4& b)
-    {
-        return _mm_max_ps(a, b);
-    }
+  __forceinline vfloat4 maxi(const vfloat4& a, const vfloat4& b) {
+    return vreinterpretq_f32_s32(vmaxq_s32(vreinterpretq_s32_f32(a.v), vreinterpretq_s32_f32(b.v)));
+  }
+
+  __forceinline vfloat4 minui(const vfloat4& a, const vfloat4& b) {
+    return vreinterpretq_f32_u32(vminq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v)));
+  }
+
+  __forceinline vfloat4 maxui(const vfloat4& a, const vfloat4& b) {
+    return vreinterpretq_f32_u32(vmaxq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v)));
+  }
 #elif defined(__SSE4_1__)
     __forceinline vfloat4 mini(const vfloat4& a, const vfloat4& b) {
       const vint4 ai = _mm_castps_si128(a);
@@ -456,6 +482,12 @@ __forceinline vfloat4 maxi(const vfloat4& a, const vfloat4& b)
   __forceinline vfloat4 nmsub(const vfloat4& a, const vfloat4& b, const vfloat4& c) { return _mm_fnmsub_ps(a,b,c); }
 #else
 
+#if defined(__NEON_NATIVE__)
+  __forceinline vfloat4 madd (const vfloat4& a, const vfloat4& b, const vfloat4& c) { return vfmaq_f32(c.v, a.v, b.v); }  //  a*b+c
+  __forceinline vfloat4 msub (const vfloat4& a, const vfloat4& b, const vfloat4& c) { return vnegq_f32(vfmsq_f32(c.v, a.v, b.v)); }  //  a*b-c
+  __forceinline vfloat4 nmadd(const vfloat4& a, const vfloat4& b, const vfloat4& c) { return vfmsq_f32(c.v, a.v, b.v); }  // -a*b+c
+  __forceinline vfloat4 nmsub(const vfloat4& a, const vfloat4& b, const vfloat4& c) { return vnegq_f32(vfmaq_f32(c.v, a.v, b.v)); }  // -a*b-c
+#else
 #if defined(__aarch64__)
   __forceinline vfloat4 madd (const vfloat4& a, const vfloat4& b, const vfloat4& c) {
     return _mm_madd_ps(a, b, c);  //a*b+c;
@@ -474,6 +506,7 @@ __forceinline vfloat4 maxi(const vfloat4& a, const vfloat4& b)
 #endif
 
   __forceinline vfloat4 msub (const vfloat4& a, const vfloat4& b, const vfloat4& c) { return a*b-c; }
+#endif
 #endif
 
   ////////////////////////////////////////////////////////////////////////////////
@@ -563,57 +596,6 @@ __forceinline vfloat4 maxi(const vfloat4& a, const vfloat4& b)
 #endif
   }
 
-#if defined(__aarch64__)
-    template<> __forceinline vfloat4 select<0>(const vfloat4& t, const vfloat4& f) {
-        return _mm_blendv_ps(f, t, vreinterpretq_f32_u32(vzero));
-    }
-    template<> __forceinline vfloat4 select<1>(const vfloat4& t, const vfloat4& f) {
-        return _mm_blendv_ps(f, t, vreinterpretq_f32_u32(v000F));
-    }
-    template<> __forceinline vfloat4 select<2>(const vfloat4& t, const vfloat4& f) {
-        return _mm_blendv_ps(f, t, vreinterpretq_f32_u32(v00F0));
-    }
-    template<> __forceinline vfloat4 select<3>(const vfloat4& t, const vfloat4& f) {
-        return _mm_blendv_ps(f, t, vreinterpretq_f32_u32(v00FF));
-    }
-    template<> __forceinline vfloat4 select<4>(const vfloat4& t, const vfloat4& f) {
-        return _mm_blendv_ps(f, t, vreinterpretq_f32_u32(v0F00));
-    }
-    template<> __forceinline vfloat4 select<5>(const vfloat4& t, const vfloat4& f) {
-        return _mm_blendv_ps(f, t, vreinterpretq_f32_u32(v0F0F));
-    }
-    template<> __forceinline vfloat4 select<6>(const vfloat4& t, const vfloat4& f) {
-        return _mm_blendv_ps(f, t, vreinterpretq_f32_u32(v0FF0));
-    }
-    template<> __forceinline vfloat4 select<7>(const vfloat4& t, const vfloat4& f) {
-        return _mm_blendv_ps(f, t, vreinterpretq_f32_u32(v0FFF));
-    }
-    template<> __forceinline vfloat4 select<8>(const vfloat4& t, const vfloat4& f) {
-        return _mm_blendv_ps(f, t, vreinterpretq_f32_u32(vF000));
-    }
-    template<> __forceinline vfloat4 select<9>(const vfloat4& t, const vfloat4& f) {
-        return _mm_blendv_ps(f, t, vreinterpretq_f32_u32(vF00F));
-    }
-    template<> __forceinline vfloat4 select<10>(const vfloat4& t, const vfloat4& f) {
-        return _mm_blendv_ps(f, t, vreinterpretq_f32_u32(vF0F0));
-    }
-    template<> __forceinline vfloat4 select<11>(const vfloat4& t, const vfloat4& f) {
-        return _mm_blendv_ps(f, t, vreinterpretq_f32_u32(vF0FF));
-    }
-    template<> __forceinline vfloat4 select<12>(const vfloat4& t, const vfloat4& f) {
-        return _mm_blendv_ps(f, t, vreinterpretq_f32_u32(vFF00));
-    }
-    template<> __forceinline vfloat4 select<13>(const vfloat4& t, const vfloat4& f) {
-        return _mm_blendv_ps(f, t, vreinterpretq_f32_u32(vFF0F));
-    }
-    template<> __forceinline vfloat4 select<14>(const vfloat4& t, const vfloat4& f) {
-        return _mm_blendv_ps(f, t, vreinterpretq_f32_u32(vFFF0));
-    }
-    template<> __forceinline vfloat4 select<15>(const vfloat4& t, const vfloat4& f) {
-        return _mm_blendv_ps(f, t, vreinterpretq_f32_u32(vFFFF));
-    }
-#endif
-
   __forceinline vfloat4 lerp(const vfloat4& a, const vfloat4& b, const vfloat4& t) {
     return madd(t,b-a,a);
   }
@@ -634,11 +616,11 @@ __forceinline vfloat4 maxi(const vfloat4& a, const vfloat4& b)
   /// Rounding Functions
   ////////////////////////////////////////////////////////////////////////////////
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
-  __forceinline vfloat4 floor(const vfloat4& a) { return vrndmq_f32(a); } // towards -inf
-  __forceinline vfloat4 ceil (const vfloat4& a) { return vrndpq_f32(a); } // toward +inf
-  __forceinline vfloat4 trunc(const vfloat4& a) { return vrndq_f32(a); } // towards 0
-  __forceinline vfloat4 round(const vfloat4& a) { return vrndnq_f32(a); } // to nearest, ties to even. NOTE(LTE): arm clang uses vrndnq, old gcc uses vrndqn?
+#if defined(__NEON_NATIVE__)
+  __forceinline vfloat4 floor(const vfloat4& a) { return vrndmq_f32(a.v); } // towards -inf
+  __forceinline vfloat4 ceil (const vfloat4& a) { return vrndpq_f32(a.v); } // toward +inf
+  __forceinline vfloat4 trunc(const vfloat4& a) { return vrndq_f32(a.v); } // towards 0
+  __forceinline vfloat4 round(const vfloat4& a) { return vrndnq_f32(a.v); } // to nearest, ties to even. NOTE(LTE): arm clang uses vrndnq, old gcc uses vrndqn?
 #elif defined (__SSE4_1__)
   __forceinline vfloat4 floor(const vfloat4& a) { return _mm_round_ps(a, _MM_FROUND_TO_NEG_INF   ); }
   __forceinline vfloat4 ceil (const vfloat4& a) { return _mm_round_ps(a, _MM_FROUND_TO_POS_INF   ); }
@@ -653,8 +635,8 @@ __forceinline vfloat4 maxi(const vfloat4& a, const vfloat4& b)
   __forceinline vfloat4 frac(const vfloat4& a) { return a-floor(a); }
 
   __forceinline vint4 floori(const vfloat4& a) {
-#if defined(__aarch64__) && defined(BUILD_IOS)
-    return vcvtq_s32_f32(floor(a));
+#if defined(__NEON_NATIVE__)
+    return vcvtmq_s32_f32(a.v);
 #elif defined(__SSE4_1__)
     return vint4(floor(a));
 #else
@@ -666,18 +648,27 @@ __forceinline vfloat4 maxi(const vfloat4& a, const vfloat4& b)
   /// Movement/Shifting/Shuffling Functions
   ////////////////////////////////////////////////////////////////////////////////
 
+#if defined(__NEON_NATIVE__)
+  __forceinline vfloat4 unpacklo(const vfloat4& a, const vfloat4& b) { return vzip1q_f32(a.v, b.v); }
+  __forceinline vfloat4 unpackhi(const vfloat4& a, const vfloat4& b) { return vzip2q_f32(a.v, b.v); }
+#else
   __forceinline vfloat4 unpacklo(const vfloat4& a, const vfloat4& b) { return _mm_unpacklo_ps(a, b); }
   __forceinline vfloat4 unpackhi(const vfloat4& a, const vfloat4& b) { return _mm_unpackhi_ps(a, b); }
+#endif
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
-      template<int i0, int i1, int i2, int i3>
-      __forceinline vfloat4 shuffle(const vfloat4& v) {
-          return vqtbl1q_u8( v, _MN_SHUFFLE(i0, i1, i2, i3));
-      }
-      template<int i0, int i1, int i2, int i3>
-      __forceinline vfloat4 shuffle(const vfloat4& a, const vfloat4& b) {
-          return vqtbl2q_u8( (uint8x16x2_t){a, b}, _MF_SHUFFLE(i0, i1, i2, i3) );
-      }
+#if defined(__NEON_NATIVE__)
+  template<int i0, int i1, int i2, int i3>
+  __forceinline vfloat4 shuffle(const vfloat4& v) {
+    return vreinterpretq_f32_u8(vqtbl1q_u8(vreinterpretq_u8_f32(v.v), _MN_SHUFFLE(i0, i1, i2, i3)));
+  }
+
+  template<int i0, int i1, int i2, int i3>
+  __forceinline vfloat4 shuffle(const vfloat4& a, const vfloat4& b) {
+    uint8x16x2_t ab;
+    ab.val[0] = vreinterpretq_u8_f32(a.v);
+    ab.val[1] = vreinterpretq_u8_f32(b.v);
+    return vreinterpretq_f32_u8(vqtbl2q_u8(ab, _MF_SHUFFLE(i0, i1, i2, i3)));
+  }
 #else
   template<int i0, int i1, int i2, int i3>
   __forceinline vfloat4 shuffle(const vfloat4& v) {
@@ -696,10 +687,10 @@ __forceinline vfloat4 maxi(const vfloat4& a, const vfloat4& b)
   }
 #endif
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
-  template<> __forceinline vfloat4 shuffle<0, 0, 2, 2>(const vfloat4& v) { return vqtbl1q_u8( v, v0022 ); }
-  template<> __forceinline vfloat4 shuffle<1, 1, 3, 3>(const vfloat4& v) { return vqtbl1q_u8( v, v1133); }
-  template<> __forceinline vfloat4 shuffle<0, 1, 0, 1>(const vfloat4& v) { return vqtbl1q_u8( v, v0101); }
+#if defined(__NEON_NATIVE__)
+  template<> __forceinline vfloat4 shuffle<0, 0, 2, 2>(const vfloat4& v) { return vtrn1q_f32(v.v, v.v); }
+  template<> __forceinline vfloat4 shuffle<1, 1, 3, 3>(const vfloat4& v) { return vtrn2q_f32(v.v, v.v); }
+  template<> __forceinline vfloat4 shuffle<0, 1, 0, 1>(const vfloat4& v) { return vcombine_f32(vget_low_f32(v.v), vget_low_f32(v.v)); }
 #elif defined(__SSE3__)
   template<> __forceinline vfloat4 shuffle<0, 0, 2, 2>(const vfloat4& v) { return _mm_moveldup_ps(v); }
   template<> __forceinline vfloat4 shuffle<1, 1, 3, 3>(const vfloat4& v) { return _mm_movehdup_ps(v); }
@@ -711,20 +702,8 @@ __forceinline vfloat4 maxi(const vfloat4& a, const vfloat4& b)
     return shuffle<i,i,i,i>(v);
   }
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
-  template<int i> __forceinline float extract(const vfloat4& a);
-  template<> __forceinline float extract<0>(const vfloat4& b) {
-      return b[0];
-  }
-  template<> __forceinline float extract<1>(const vfloat4& b) {
-      return b[1];
-  }
-  template<> __forceinline float extract<2>(const vfloat4& b) {
-      return b[2];
-  }
-  template<> __forceinline float extract<3>(const vfloat4& b) {
-      return b[3];
-  }
+#if defined(__NEON_NATIVE__)
+  template<int i> __forceinline float extract(const vfloat4& a) { return vgetq_lane_f32(a.v, i); }
 #elif defined (__SSE4_1__) && !defined(__GNUC__)
   template<int i> __forceinline float extract(const vfloat4& a) { return _mm_cvtss_f32(_mm_extract_ps(a,i)); }
   template<> __forceinline float extract<0>(const vfloat4& a) { return _mm_cvtss_f32(a); }
@@ -734,32 +713,9 @@ __forceinline vfloat4 maxi(const vfloat4& a, const vfloat4& b)
 #endif
 
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
-  template<int dst>  __forceinline vfloat4 insert(const vfloat4& a, float b);
-  template<> __forceinline vfloat4 insert<0>(const vfloat4& a, float b)
-  {
-        vfloat4 c = a;
-        c[0] = b;
-        return c;
-  }
-  template<> __forceinline vfloat4 insert<1>(const vfloat4& a, float b)
-  {
-        vfloat4 c = a;
-        c[1] = b;
-        return c;
-  }
-  template<> __forceinline vfloat4 insert<2>(const vfloat4& a, float b)
-  {
-        vfloat4 c = a;
-        c[2] = b;
-        return c;
-  }
-  template<> __forceinline vfloat4 insert<3>(const vfloat4& a, float b)
-  {
-        vfloat4 c = a;
-        c[3] = b;
-        return c;
-  }
+#if defined(__NEON_NATIVE__)
+  template<int dst, int src> __forceinline vfloat4 insert(const vfloat4& a, const vfloat4& b) { return vcopyq_laneq_f32(a.v, dst, b.v, src); }
+  template<int dst>  __forceinline vfloat4 insert(const vfloat4& a, float b) { return vsetq_lane_f32(b, a.v, dst); }
 #elif defined (__SSE4_1__)
   template<int dst, int src, int clr> __forceinline vfloat4 insert(const vfloat4& a, const vfloat4& b) { return _mm_insert_ps(a, b, (dst << 4) | (src << 6) | clr); }
   template<int dst, int src> __forceinline vfloat4 insert(const vfloat4& a, const vfloat4& b) { return insert<dst, src, 0>(a, b); }
@@ -769,10 +725,8 @@ __forceinline vfloat4 maxi(const vfloat4& a, const vfloat4& b)
   template<int dst>  __forceinline vfloat4 insert(const vfloat4& a, float b) { vfloat4 c = a; c[dst&3] = b; return c; }
 #endif
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
-  __forceinline float toScalar(const vfloat4& v) {
-    return v[0];
-  }
+#if defined(__NEON_NATIVE__)
+  __forceinline float toScalar(const vfloat4& v) { return vgetq_lane_f32(v.v, 0); }
 #else
   __forceinline float toScalar(const vfloat4& v) { return _mm_cvtss_f32(v); }
 #endif
@@ -871,20 +825,20 @@ __forceinline vfloat4 maxi(const vfloat4& a, const vfloat4& b)
   ////////////////////////////////////////////////////////////////////////////////
   /// Reductions
   ////////////////////////////////////////////////////////////////////////////////
-#if defined(__aarch64__) && defined(BUILD_IOS)
-      __forceinline vfloat4 vreduce_min(const vfloat4& v) { float h = vminvq_f32(v); return vdupq_n_f32(h); }
-      __forceinline vfloat4 vreduce_max(const vfloat4& v) { float h = vmaxvq_f32(v); return vdupq_n_f32(h); }
-      __forceinline vfloat4 vreduce_add(const vfloat4& v) { float h = vaddvq_f32(v); return vdupq_n_f32(h); }
+#if defined(__NEON_NATIVE__)
+  __forceinline vfloat4 vreduce_min(const vfloat4& v) { return vdupq_n_f32(vminvq_f32(v.v)); }
+  __forceinline vfloat4 vreduce_max(const vfloat4& v) { return vdupq_n_f32(vmaxvq_f32(v.v)); }
+  __forceinline vfloat4 vreduce_add(const vfloat4& v) { return vdupq_n_f32(vaddvq_f32(v.v)); }
 #else
   __forceinline vfloat4 vreduce_min(const vfloat4& v) { vfloat4 h = min(shuffle<1,0,3,2>(v),v); return min(shuffle<2,3,0,1>(h),h); }
   __forceinline vfloat4 vreduce_max(const vfloat4& v) { vfloat4 h = max(shuffle<1,0,3,2>(v),v); return max(shuffle<2,3,0,1>(h),h); }
   __forceinline vfloat4 vreduce_add(const vfloat4& v) { vfloat4 h = shuffle<1,0,3,2>(v)   + v ; return shuffle<2,3,0,1>(h)   + h ; }
 #endif
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
-  __forceinline float reduce_min(const vfloat4& v) { return vminvq_f32(v); }
-  __forceinline float reduce_max(const vfloat4& v) { return vmaxvq_f32(v); }
-  __forceinline float reduce_add(const vfloat4& v) { return vaddvq_f32(v); }
+#if defined(__NEON_NATIVE__)
+  __forceinline float reduce_min(const vfloat4& v) { return vminvq_f32(v.v); }
+  __forceinline float reduce_max(const vfloat4& v) { return vmaxvq_f32(v.v); }
+  __forceinline float reduce_add(const vfloat4& v) { return vaddvq_f32(v.v); }
 #else
   __forceinline float reduce_min(const vfloat4& v) { return _mm_cvtss_f32(vreduce_min(v)); }
   __forceinline float reduce_max(const vfloat4& v) { return _mm_cvtss_f32(vreduce_max(v)); }
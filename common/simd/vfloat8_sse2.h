@@ -0,0 +1,402 @@
+// ======================================================================== //
+// Copyright 2009-2020 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+namespace embree
+{
+  /* 8-wide float type for 4-wide ISAs, operates on two vfloat4 halves */
+  template<>
+  struct vfloat<8>
+  {
+    ALIGNED_STRUCT_(16);
+
+    typedef vboolf8 Bool;
+    typedef vint8   Int;
+    typedef vfloat8 Float;
+
+    enum  { size = 8 };        // number of SIMD elements
+    vfloat4 vl,vh;             // data
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// Constructors, Assignment & Cast Operators
+    ////////////////////////////////////////////////////////////////////////////////
+
+    __forceinline vfloat() {}
+    __forceinline vfloat(const vfloat8& other) : vl(other.vl), vh(other.vh) {}
+    __forceinline vfloat8& operator =(const vfloat8& other) { vl = other.vl; vh = other.vh; return *this; }
+
+    __forceinline explicit vfloat(const vfloat4& a) : vl(a), vh(a) {}
+    __forceinline vfloat(const vfloat4& a, const vfloat4& b) : vl(a), vh(b) {}
+
+    __forceinline explicit vfloat(const int8_t* a) : vl(vfloat4::loadu(a)), vh(vfloat4::loadu(a+16)) {}
+    __forceinline vfloat(float a) : vl(a), vh(a) {}
+    __forceinline vfloat(float a, float b) : vl(a,b,a,b), vh(a,b,a,b) {}
+    __forceinline vfloat(float a, float b, float c, float d) : vl(a,b,c,d), vh(a,b,c,d) {}
+    __forceinline vfloat(float a, float b, float c, float d, float e, float f, float g, float h) : vl(a,b,c,d), vh(e,f,g,h) {}
+
+    __forceinline explicit vfloat(const vint8& a) : vl(a.vl), vh(a.vh) {}
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// Constants
+    ////////////////////////////////////////////////////////////////////////////////
+
+    __forceinline vfloat(ZeroTy)   : vl(zero), vh(zero) {}
+    __forceinline vfloat(OneTy)    : vl(one),  vh(one)  {}
+    __forceinline vfloat(PosInfTy) : vl(pos_inf), vh(pos_inf) {}
+    __forceinline vfloat(NegInfTy) : vl(neg_inf), vh(neg_inf) {}
+    __forceinline vfloat(StepTy)   : vl(0.0f, 1.0f, 2.0f, 3.0f), vh(4.0f, 5.0f, 6.0f, 7.0f) {}
+    __forceinline vfloat(NaNTy)    : vl(nan), vh(nan) {}
+    __forceinline vfloat(UndefinedTy) : vl(undefined), vh(undefined) {}
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// Loads and Stores
+    ////////////////////////////////////////////////////////////////////////////////
+
+    static __forceinline vfloat8 broadcast(const void* a) { return vfloat8(*(float*)a); }
+
+    static __forceinline vfloat8 broadcast2(const float* a, const float* b) { return vfloat8(vfloat4(*a), vfloat4(*b)); }
+
+    static __forceinline vfloat8 broadcast4f(const vfloat4* ptr) { return vfloat8(*ptr); }
+
+    static __forceinline vfloat8 load(const int8_t* ptr) { return vfloat8(vfloat4::load(ptr), vfloat4::load(ptr+4)); }
+    static __forceinline vfloat8 load(const uint8_t* ptr) { return vfloat8(vfloat4::load(ptr), vfloat4::load(ptr+4)); }
+    static __forceinline vfloat8 load(const short* ptr) { return vfloat8(vfloat4::load(ptr), vfloat4::load(ptr+4)); }
+
+    static __forceinline vfloat8 load (const void* ptr) { return vfloat8(vfloat4::load ((const float*)ptr), vfloat4::load ((const float*)ptr+4)); }
+    static __forceinline vfloat8 loadu(const void* ptr) { return vfloat8(vfloat4::loadu((const float*)ptr), vfloat4::loadu((const float*)ptr+4)); }
+
+    static __forceinline void store (void* ptr, const vfloat8& v) { vfloat4::store ((float*)ptr,v.vl); vfloat4::store ((float*)ptr+4,v.vh); }
+    static __forceinline void storeu(void* ptr, const vfloat8& v) { vfloat4::storeu((float*)ptr,v.vl); vfloat4::storeu((float*)ptr+4,v.vh); }
+
+    static __forceinline vfloat8 load (const vboolf8& mask, const void* ptr) { return vfloat8(vfloat4::load (mask.vl,(const float*)ptr), vfloat4::load (mask.vh,(const float*)ptr+4)); }
+    static __forceinline vfloat8 loadu(const vboolf8& mask, const void* ptr) { return vfloat8(vfloat4::loadu(mask.vl,(const float*)ptr), vfloat4::loadu(mask.vh,(const float*)ptr+4)); }
+
+    static __forceinline void store (const vboolf8& mask, void* ptr, const vfloat8& v) { vfloat4::store (mask.vl,(float*)ptr,v.vl); vfloat4::store (mask.vh,(float*)ptr+4,v.vh); }
+    static __forceinline void storeu(const vboolf8& mask, void* ptr, const vfloat8& v) { vfloat4::storeu(mask.vl,(float*)ptr,v.vl); vfloat4::storeu(mask.vh,(float*)ptr+4,v.vh); }
+
+    static __forceinline vfloat8 load_nt(void* ptr) { return vfloat8(vfloat4::load_nt((float*)ptr), vfloat4::load_nt((float*)ptr+4)); }
+    static __forceinline void store_nt(void* ptr, const vfloat8& v) { vfloat4::store_nt((float*)ptr,v.vl); vfloat4::store_nt((float*)ptr+4,v.vh); }
+
+    template<int scale = 4>
+    static __forceinline vfloat8 gather(const float* ptr, const vint8& index) {
+      return vfloat8(vfloat4::gather<scale>(ptr,index.vl), vfloat4::gather<scale>(ptr,index.vh));
+    }
+
+    template<int scale = 4>
+    static __forceinline vfloat8 gather(const vboolf8& mask, const float* ptr, const vint8& index) {
+      return vfloat8(vfloat4::gather<scale>(mask.vl,ptr,index.vl), vfloat4::gather<scale>(mask.vh,ptr,index.vh));
+    }
+
+    template<int scale = 4>
+    static __forceinline void scatter(void* ptr, const vint8& ofs, const vfloat8& v) {
+      vfloat4::scatter<scale>(ptr,ofs.vl,v.vl);
+      vfloat4::scatter<scale>(ptr,ofs.vh,v.vh);
+    }
+
+    template<int scale = 4>
+    static __forceinline void scatter(const vboolf8& mask, void* ptr, const vint8& ofs, const vfloat8& v) {
+      vfloat4::scatter<scale>(mask.vl,ptr,ofs.vl,v.vl);
+      vfloat4::scatter<scale>(mask.vh,ptr,ofs.vh,v.vh);
+    }
+
+    static __forceinline void store(const vboolf8& mask, int8_t* ptr, const vint8& ofs, const vfloat8& v) {
+      scatter<1>(mask,ptr,ofs,v);
+    }
+    static __forceinline void store(const vboolf8& mask, float* ptr, const vint8& ofs, const vfloat8& v) {
+      scatter<4>(mask,ptr,ofs,v);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// Array Access
+    ////////////////////////////////////////////////////////////////////////////////
+
+    __forceinline const float& operator [](size_t index) const { assert(index < 8); return (&vl)[index >> 2][index & 3]; }
+    __forceinline       float& operator [](size_t index)       { assert(index < 8); return (&vl)[index >> 2][index & 3]; }
+  };
+
+  __forceinline vint8::vint(const vfloat8& a) : vl(vint4(a.vl)), vh(vint4(a.vh)) {}
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Unary Operators
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline vfloat8 asFloat(const vint8&   a) { return vfloat8(asFloat(a.vl), asFloat(a.vh)); }
+  __forceinline vint8   asInt  (const vfloat8& a) { return vint8(asInt(a.vl), asInt(a.vh)); }
+
+  __forceinline vint8   toInt  (const vfloat8& a) { return vint8(toInt(a.vl), toInt(a.vh)); }
+  __forceinline vfloat8 toFloat(const vint8&   a) { return vfloat8(a); }
+
+  __forceinline vfloat8 operator +(const vfloat8& a) { return a; }
+  __forceinline vfloat8 operator -(const vfloat8& a) { return vfloat8(-a.vl, -a.vh); }
+
+  __forceinline vfloat8 abs    (const vfloat8& a) { return vfloat8(abs(a.vl), abs(a.vh)); }
+  __forceinline vfloat8 sign   (const vfloat8& a) { return vfloat8(sign(a.vl), sign(a.vh)); }
+  __forceinline vfloat8 signmsk(const vfloat8& a) { return vfloat8(signmsk(a.vl), signmsk(a.vh)); }
+
+  __forceinline vfloat8 rcp  (const vfloat8& a) { return vfloat8(rcp(a.vl), rcp(a.vh)); }
+  __forceinline vfloat8 sqr  (const vfloat8& a) { return vfloat8(sqr(a.vl), sqr(a.vh)); }
+  __forceinline vfloat8 sqrt (const vfloat8& a) { return vfloat8(sqrt(a.vl), sqrt(a.vh)); }
+  __forceinline vfloat8 rsqrt(const vfloat8& a) { return vfloat8(rsqrt(a.vl), rsqrt(a.vh)); }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Binary Operators
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline vfloat8 operator +(const vfloat8& a, const vfloat8& b) { return vfloat8(a.vl + b.vl, a.vh + b.vh); }
+  __forceinline vfloat8 operator +(const vfloat8& a, float          b) { return a + vfloat8(b); }
+  __forceinline vfloat8 operator +(float          a, const vfloat8& b) { return vfloat8(a) + b; }
+
+  __forceinline vfloat8 operator -(const vfloat8& a, const vfloat8& b) { return vfloat8(a.vl - b.vl, a.vh - b.vh); }
+  __forceinline vfloat8 operator -(const vfloat8& a, float          b) { return a - vfloat8(b); }
+  __forceinline vfloat8 operator -(float          a, const vfloat8& b) { return vfloat8(a) - b; }
+
+  __forceinline vfloat8 operator *(const vfloat8& a, const vfloat8& b) { return vfloat8(a.vl * b.vl, a.vh * b.vh); }
+  __forceinline vfloat8 operator *(const vfloat8& a, float          b) { return a * vfloat8(b); }
+  __forceinline vfloat8 operator *(float          a, const vfloat8& b) { return vfloat8(a) * b; }
+
+  __forceinline vfloat8 operator /(const vfloat8& a, const vfloat8& b) { return vfloat8(a.vl / b.vl, a.vh / b.vh); }
+  __forceinline vfloat8 operator /(const vfloat8& a, float          b) { return a / vfloat8(b); }
+  __forceinline vfloat8 operator /(float          a, const vfloat8& b) { return vfloat8(a) / b; }
+
+  __forceinline vfloat8 operator &(const vfloat8& a, const vfloat8& b) { return vfloat8(a.vl & b.vl, a.vh & b.vh); }
+  __forceinline vfloat8 operator |(const vfloat8& a, const vfloat8& b) { return vfloat8(a.vl | b.vl, a.vh | b.vh); }
+  __forceinline vfloat8 operator ^(const vfloat8& a, const vfloat8& b) { return vfloat8(a.vl ^ b.vl, a.vh ^ b.vh); }
+  __forceinline vfloat8 operator ^(const vfloat8& a, const vint8&   b) { return vfloat8(a.vl ^ b.vl, a.vh ^ b.vh); }
+
+  __forceinline vfloat8 min(const vfloat8& a, const vfloat8& b) { return vfloat8(min(a.vl, b.vl), min(a.vh, b.vh)); }
+  __forceinline vfloat8 min(const vfloat8& a, float          b) { return min(a, vfloat8(b)); }
+  __forceinline vfloat8 min(float          a, const vfloat8& b) { return min(vfloat8(a), b); }
+
+  __forceinline vfloat8 max(const vfloat8& a, const vfloat8& b) { return vfloat8(max(a.vl, b.vl), max(a.vh, b.vh)); }
+  __forceinline vfloat8 max(const vfloat8& a, float          b) { return max(a, vfloat8(b)); }
+  __forceinline vfloat8 max(float          a, const vfloat8& b) { return max(vfloat8(a), b); }
+
+  __forceinline vfloat8 mini(const vfloat8& a, const vfloat8& b) { return vfloat8(mini(a.vl, b.vl), mini(a.vh, b.vh)); }
+  __forceinline vfloat8 maxi(const vfloat8& a, const vfloat8& b) { return vfloat8(maxi(a.vl, b.vl), maxi(a.vh, b.vh)); }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Ternary Operators
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline vfloat8 madd  (const vfloat8& a, const vfloat8& b, const vfloat8& c) { return vfloat8(madd (a.vl,b.vl,c.vl), madd (a.vh,b.vh,c.vh)); }
+  __forceinline vfloat8 msub  (const vfloat8& a, const vfloat8& b, const vfloat8& c) { return vfloat8(msub (a.vl,b.vl,c.vl), msub (a.vh,b.vh,c.vh)); }
+  __forceinline vfloat8 nmadd (const vfloat8& a, const vfloat8& b, const vfloat8& c) { return vfloat8(nmadd(a.vl,b.vl,c.vl), nmadd(a.vh,b.vh,c.vh)); }
+  __forceinline vfloat8 nmsub (const vfloat8& a, const vfloat8& b, const vfloat8& c) { return vfloat8(nmsub(a.vl,b.vl,c.vl), nmsub(a.vh,b.vh,c.vh)); }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Assignment Operators
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline vfloat8& operator +=(vfloat8& a, const vfloat8& b) { return a = a + b; }
+  __forceinline vfloat8& operator +=(vfloat8& a, float          b) { return a = a + b; }
+
+  __forceinline vfloat8& operator -=(vfloat8& a, const vfloat8& b) { return a = a - b; }
+  __forceinline vfloat8& operator -=(vfloat8& a, float          b) { return a = a - b; }
+
+  __forceinline vfloat8& operator *=(vfloat8& a, const vfloat8& b) { return a = a * b; }
+  __forceinline vfloat8& operator *=(vfloat8& a, float          b) { return a = a * b; }
+
+  __forceinline vfloat8& operator /=(vfloat8& a, const vfloat8& b) { return a = a / b; }
+  __forceinline vfloat8& operator /=(vfloat8& a, float          b) { return a = a / b; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Comparison Operators + Select
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline vboolf8 operator ==(const vfloat8& a, const vfloat8& b) { return vboolf8(a.vl == b.vl, a.vh == b.vh); }
+  __forceinline vboolf8 operator !=(const vfloat8& a, const vfloat8& b) { return vboolf8(a.vl != b.vl, a.vh != b.vh); }
+  __forceinline vboolf8 operator < (const vfloat8& a, const vfloat8& b) { return vboolf8(a.vl <  b.vl, a.vh <  b.vh); }
+  __forceinline vboolf8 operator >=(const vfloat8& a, const vfloat8& b) { return vboolf8(a.vl >= b.vl, a.vh >= b.vh); }
+  __forceinline vboolf8 operator > (const vfloat8& a, const vfloat8& b) { return vboolf8(a.vl >  b.vl, a.vh >  b.vh); }
+  __forceinline vboolf8 operator <=(const vfloat8& a, const vfloat8& b) { return vboolf8(a.vl <= b.vl, a.vh <= b.vh); }
+
+  __forceinline vfloat8 select(const vboolf8& m, const vfloat8& t, const vfloat8& f) {
+    return vfloat8(select(m.vl, t.vl, f.vl), select(m.vh, t.vh, f.vh));
+  }
+
+  __forceinline vboolf8 operator ==(const vfloat8& a, const float&   b) { return a == vfloat8(b); }
+  __forceinline vboolf8 operator ==(const float&   a, const vfloat8& b) { return vfloat8(a) == b; }
+
+  __forceinline vboolf8 operator !=(const vfloat8& a, const float&   b) { return a != vfloat8(b); }
+  __forceinline vboolf8 operator !=(const float&   a, const vfloat8& b) { return vfloat8(a) != b; }
+
+  __forceinline vboolf8 operator < (const vfloat8& a, const float&   b) { return a <  vfloat8(b); }
+  __forceinline vboolf8 operator < (const float&   a, const vfloat8& b) { return vfloat8(a) <  b; }
+
+  __forceinline vboolf8 operator >=(const vfloat8& a, const float&   b) { return a >= vfloat8(b); }
+  __forceinline vboolf8 operator >=(const float&   a, const vfloat8& b) { return vfloat8(a) >= b; }
+
+  __forceinline vboolf8 operator > (const vfloat8& a, const float&   b) { return a >  vfloat8(b); }
+  __forceinline vboolf8 operator > (const float&   a, const vfloat8& b) { return vfloat8(a) >  b; }
+
+  __forceinline vboolf8 operator <=(const vfloat8& a, const float&   b) { return a <= vfloat8(b); }
+  __forceinline vboolf8 operator <=(const float&   a, const vfloat8& b) { return vfloat8(a) <= b; }
+
+  __forceinline vboolf8 eq(const vfloat8& a, const vfloat8& b) { return a == b; }
+  __forceinline vboolf8 ne(const vfloat8& a, const vfloat8& b) { return a != b; }
+  __forceinline vboolf8 lt(const vfloat8& a, const vfloat8& b) { return a <  b; }
+  __forceinline vboolf8 ge(const vfloat8& a, const vfloat8& b) { return a >= b; }
+  __forceinline vboolf8 gt(const vfloat8& a, const vfloat8& b) { return a >  b; }
+  __forceinline vboolf8 le(const vfloat8& a, const vfloat8& b) { return a <= b; }
+
+  __forceinline vboolf8 eq(const vboolf8& mask, const vfloat8& a, const vfloat8& b) { return mask & (a == b); }
+  __forceinline vboolf8 ne(const vboolf8& mask, const vfloat8& a, const vfloat8& b) { return mask & (a != b); }
+  __forceinline vboolf8 lt(const vboolf8& mask, const vfloat8& a, const vfloat8& b) { return mask & (a <  b); }
+  __forceinline vboolf8 ge(const vboolf8& mask, const vfloat8& a, const vfloat8& b) { return mask & (a >= b); }
+  __forceinline vboolf8 gt(const vboolf8& mask, const vfloat8& a, const vfloat8& b) { return mask & (a >  b); }
+  __forceinline vboolf8 le(const vboolf8& mask, const vfloat8& a, const vfloat8& b) { return mask & (a <= b); }
+
+  __forceinline vfloat8 lerp(const vfloat8& a, const vfloat8& b, const vfloat8& t) {
+    return madd(t,b-a,a);
+  }
+
+  __forceinline bool isvalid (const vfloat8& v) {
+    return all((v > vfloat8(-FLT_LARGE)) & (v < vfloat8(+FLT_LARGE)));
+  }
+
+  __forceinline bool is_finite (const vfloat8& a) {
+    return all((a >= vfloat8(-FLT_MAX)) & (a <= vfloat8(+FLT_MAX)));
+  }
+
+  __forceinline bool is_finite (const vboolf8& valid, const vfloat8& a) {
+    return all(valid, (a >= vfloat8(-FLT_MAX)) & (a <= vfloat8(+FLT_MAX)));
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Rounding Functions
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline vfloat8 floor(const vfloat8& a) { return vfloat8(floor(a.vl), floor(a.vh)); }
+  __forceinline vfloat8 ceil (const vfloat8& a) { return vfloat8(ceil (a.vl), ceil (a.vh)); }
+  __forceinline vfloat8 trunc(const vfloat8& a) { return vfloat8(trunc(a.vl), trunc(a.vh)); }
+  __forceinline vfloat8 round(const vfloat8& a) { return vfloat8(round(a.vl), round(a.vh)); }
+  __forceinline vfloat8 frac (const vfloat8& a) { return a-floor(a); }
+
+  __forceinline vint8 floori(const vfloat8& a) { return vint8(floori(a.vl), floori(a.vh)); }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Movement/Shifting/Shuffling Functions
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline vfloat8 unpacklo(const vfloat8& a, const vfloat8& b) { return vfloat8(unpacklo(a.vl, b.vl), unpacklo(a.vh, b.vh)); }
+  __forceinline vfloat8 unpackhi(const vfloat8& a, const vfloat8& b) { return vfloat8(unpackhi(a.vl, b.vl), unpackhi(a.vh, b.vh)); }
+
+  template<int i>
+  __forceinline vfloat8 shuffle(const vfloat8& v) {
+    return vfloat8(shuffle<i>(v.vl), shuffle<i>(v.vh));
+  }
+
+  template<int i0, int i1>
+  __forceinline vfloat8 shuffle4(const vfloat8& v) {
+    return vfloat8((&v.vl)[i0], (&v.vl)[i1]);
+  }
+
+  template<int i0, int i1>
+  __forceinline vfloat8 shuffle4(const vfloat8& a, const vfloat8& b) {
+    return vfloat8((&a.vl)[i0], (&b.vl)[i1]);
+  }
+
+  template<int i0, int i1, int i2, int i3>
+  __forceinline vfloat8 shuffle(const vfloat8& v) {
+    return vfloat8(shuffle<i0,i1,i2,i3>(v.vl), shuffle<i0,i1,i2,i3>(v.vh));
+  }
+
+  template<int i0, int i1, int i2, int i3>
+  __forceinline vfloat8 shuffle(const vfloat8& a, const vfloat8& b) {
+    return vfloat8(shuffle<i0,i1,i2,i3>(a.vl, b.vl), shuffle<i0,i1,i2,i3>(a.vh, b.vh));
+  }
+
+  __forceinline vfloat8 broadcast(const float* ptr) { return vfloat8(*ptr); }
+  template<size_t i> __forceinline vfloat8 insert4(const vfloat8& a, const vfloat4& b) { vfloat8 c = a; (&c.vl)[i] = b; return c; }
+  template<size_t i> __forceinline vfloat4 extract4(const vfloat8& a) { return (&a.vl)[i]; }
+
+  __forceinline float toScalar(const vfloat8& v) { return toScalar(v.vl); }
+
+  __forceinline vfloat8 assign(const vfloat4& a) { return vfloat8(a, vfloat4(zero)); }
+
+  __forceinline vfloat4 broadcast4f(const vfloat8& a, const size_t k) {
+    return vfloat4(a[k]);
+  }
+
+  __forceinline vfloat8 broadcast8f(const vfloat8& a, const size_t k) {
+    return vfloat8(a[k]);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Transpose
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline void transpose(const vfloat8& r0, const vfloat8& r1, const vfloat8& r2, const vfloat8& r3, vfloat8& c0, vfloat8& c1, vfloat8& c2, vfloat8& c3)
+  {
+    transpose(r0.vl, r1.vl, r2.vl, r3.vl, c0.vl, c1.vl, c2.vl, c3.vl);
+    transpose(r0.vh, r1.vh, r2.vh, r3.vh, c0.vh, c1.vh, c2.vh, c3.vh);
+  }
+
+  __forceinline void transpose(const vfloat8& r0, const vfloat8& r1, const vfloat8& r2, const vfloat8& r3, vfloat8& c0, vfloat8& c1, vfloat8& c2)
+  {
+    transpose(r0.vl, r1.vl, r2.vl, r3.vl, c0.vl, c1.vl, c2.vl);
+    transpose(r0.vh, r1.vh, r2.vh, r3.vh, c0.vh, c1.vh, c2.vh);
+  }
+
+  __forceinline void transpose(const vfloat4& r0, const vfloat4& r1, const vfloat4& r2, const vfloat4& r3, const vfloat4& r4, const vfloat4& r5, const vfloat4& r6, const vfloat4& r7,
+                               vfloat8& c0, vfloat8& c1, vfloat8& c2, vfloat8& c3)
+  {
+    transpose(r0, r1, r2, r3, c0.vl, c1.vl, c2.vl, c3.vl);
+    transpose(r4, r5, r6, r7, c0.vh, c1.vh, c2.vh, c3.vh);
+  }
+
+  __forceinline void transpose(const vfloat4& r0, const vfloat4& r1, const vfloat4& r2, const vfloat4& r3, const vfloat4& r4, const vfloat4& r5, const vfloat4& r6, const vfloat4& r7,
+                               vfloat8& c0, vfloat8& c1, vfloat8& c2)
+  {
+    transpose(r0, r1, r2, r3, c0.vl, c1.vl, c2.vl);
+    transpose(r4, r5, r6, r7, c0.vh, c1.vh, c2.vh);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Reductions
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline vfloat8 vreduce_min(const vfloat8& v) { return vfloat8(vreduce_min(min(v.vl, v.vh))); }
+  __forceinline vfloat8 vreduce_max(const vfloat8& v) { return vfloat8(vreduce_max(max(v.vl, v.vh))); }
+  __forceinline vfloat8 vreduce_add(const vfloat8& v) { return vfloat8(vreduce_add(v.vl + v.vh)); }
+
+  __forceinline float reduce_min(const vfloat8& v) { return reduce_min(min(v.vl, v.vh)); }
+  __forceinline float reduce_max(const vfloat8& v) { return reduce_max(max(v.vl, v.vh)); }
+  __forceinline float reduce_add(const vfloat8& v) { return reduce_add(v.vl + v.vh); }
+
+  __forceinline size_t select_min(const vboolf8& valid, const vfloat8& v)
+  {
+    const vfloat8 a = select(valid,v,vfloat8(pos_inf));
+    const vbool8 valid_min = valid & (a == vreduce_min(a));
+    return bsf(movemask(any(valid_min) ? valid_min : valid));
+  }
+
+  __forceinline size_t select_max(const vboolf8& valid, const vfloat8& v)
+  {
+    const vfloat8 a = select(valid,v,vfloat8(neg_inf));
+    const vbool8 valid_max = valid & (a == vreduce_max(a));
+    return bsf(movemask(any(valid_max) ? valid_max : valid));
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Output Operators
+  ////////////////////////////////////////////////////////////////////////////////
+
+  inline std::ostream& operator <<(std::ostream& cout, const vfloat8& a) {
+    return cout << "<" << a[0] << ", " << a[1] << ", " << a[2] << ", " << a[3] << ", " << a[4] << ", " << a[5] << ", " << a[6] << ", " << a[7] << ">";
+  }
+}
@@ -111,7 +111,7 @@ namespace embree
 #endif
 
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
+#if defined(__NEON_NATIVE__)
     static __forceinline vint4 load(const uint8_t* ptr) {
         return _mm_load4epu8_epi32(((__m128i*)ptr));
     }
@@ -140,8 +140,8 @@ namespace embree
 #endif
 
     static __forceinline vint4 load(const unsigned short* ptr) {
-#if defined(__aarch64__) && defined(BUILD_IOS)
-      return vmovl_u16(vld1_u16(ptr));
+#if defined(__NEON_NATIVE__)
+      return vreinterpretq_s32_u32(vmovl_u16(vld1_u16(ptr)));
 #elif defined (__SSE4_1__)
       return _mm_cvtepu16_epi32(_mm_loadu_si128((__m128i*)ptr));
 #else
@@ -150,11 +150,10 @@ namespace embree
     }
 
     static __forceinline void store(uint8_t* ptr, const vint4& v) {
-#if defined(__aarch64__) && defined(BUILD_IOS)
-        int32x4_t x = v;
-        int16x4_t y = vqmovn_u32(x);
-        int8x8_t z = vqmovn_u16(vcombine_u16(y, y));
-        vst1_lane_s32(ptr, z, 0);
+#if defined(__NEON_NATIVE__)
+      const uint16x4_t x = vqmovun_s32(v.v);
+      const uint8x8_t  y = vqmovn_u16(vcombine_u16(x, x));
+      vst1_lane_u32((uint32_t*)ptr, vreinterpret_u32_u8(y), 0);
 #elif defined(__SSE4_1__)
       __m128i x = v;
       x = _mm_packus_epi32(x, x);
@@ -167,10 +166,8 @@ namespace embree
     }
 
     static __forceinline void store(unsigned short* ptr, const vint4& v) {
-#if defined(__aarch64__) && defined(BUILD_IOS)
-      int32x4_t x = v;
-      int16x4_t y = vqmovn_u32(x);
-      vst1_u16(ptr, y);
+#if defined(__NEON_NATIVE__)
+      vst1_u16(ptr, vmovn_u32(vreinterpretq_u32_s32(v.v)));
 #else
       for (size_t i=0;i<4;i++)
         ptr[i] = (unsigned short)v[i];
@@ -178,7 +175,7 @@ namespace embree
     }
 
     static __forceinline vint4 load_nt(void* ptr) {
-#if (defined(__aarch64__) && defined(BUILD_IOS)) || defined(__SSE4_1__)
+#if defined(__NEON_NATIVE__) || defined(__SSE4_1__)
       return _mm_stream_load_si128((__m128i*)ptr);
 #else
       return _mm_load_si128((__m128i*)ptr);
@@ -186,7 +183,7 @@ namespace embree
     }
 
     static __forceinline void store_nt(void* ptr, const vint4& v) {
-#if (defined(__aarch64__) && defined(BUILD_IOS)) || defined(__SSE4_1__)
+#if defined(__NEON_NATIVE__) || defined(__SSE4_1__)
       _mm_stream_ps((float*)ptr, _mm_castsi128_ps(v));
 #else
       _mm_store_si128((__m128i*)ptr,v);
@@ -262,8 +259,8 @@ namespace embree
     friend __forceinline vint4 select(const vboolf4& m, const vint4& t, const vint4& f) {
 #if defined(__AVX512VL__)
       return _mm_mask_blend_epi32(m, (__m128i)f, (__m128i)t);
-#elif defined(__aarch64__) && defined(BUILD_IOS)
-      return _mm_blendv_ps(f, t, m);
+#elif defined(__NEON_NATIVE__)
+      return vbslq_s32(vreinterpretq_u32_f32(m.v), t.v, f.v);
 #elif defined(__SSE4_1__)
       return _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(f), _mm_castsi128_ps(t), m));
 #else
@@ -284,7 +281,7 @@ namespace embree
 
   __forceinline vint4 operator +(const vint4& a) { return a; }
   __forceinline vint4 operator -(const vint4& a) { return _mm_sub_epi32(_mm_setzero_si128(), a); }
-#if (defined(__aarch64__) && defined(BUILD_IOS)) || defined(__SSSE3__)
+#if defined(__NEON_NATIVE__) || defined(__SSSE3__)
   __forceinline vint4 abs(const vint4& a) { return _mm_abs_epi32(a); }
 #endif
 
@@ -300,7 +297,7 @@ namespace embree
   __forceinline vint4 operator -(const vint4& a, int          b) { return a - vint4(b); }
   __forceinline vint4 operator -(int          a, const vint4& b) { return vint4(a) - b; }
 
-#if (defined(__aarch64__) && defined(BUILD_IOS)) || defined(__SSE4_1__)
+#if defined(__NEON_NATIVE__) || defined(__SSE4_1__)
   __forceinline vint4 operator *(const vint4& a, const vint4& b) { return _mm_mullo_epi32(a, b); }
 #else
   __forceinline vint4 operator *(const vint4& a, const vint4& b) { return vint4(a[0]*b[0],a[1]*b[1],a[2]*b[2],a[3]*b[3]); }
@@ -337,7 +334,7 @@ namespace embree
   __forceinline vint4& operator -=(vint4& a, const vint4& b) { return a = a - b; }
   __forceinline vint4& operator -=(vint4& a, int          b) { return a = a - b; }
 
-#if (defined(__aarch64__) && defined(BUILD_IOS)) || defined(__SSE4_1__)
+#if defined(__NEON_NATIVE__) || defined(__SSE4_1__)
   __forceinline vint4& operator *=(vint4& a, const vint4& b) { return a = a * b; }
   __forceinline vint4& operator *=(vint4& a, int          b) { return a = a * b; }
 #endif
@@ -420,59 +417,8 @@ namespace embree
     return select(vboolf4(mask), t, f);
 #endif
   }
-
-#if defined(__aarch64__) && defined(BUILD_IOS)
-    template<> __forceinline vint4 select<0>(const vint4& t, const vint4& f) {
-        return _mm_blendv_ps(f, t, vzero);
-    }
-    template<> __forceinline vint4 select<1>(const vint4& t, const vint4& f) {
-        return _mm_blendv_ps(f, t, v000F);
-    }
-    template<> __forceinline vint4 select<2>(const vint4& t, const vint4& f) {
-        return _mm_blendv_ps(f, t, v00F0);
-    }
-    template<> __forceinline vint4 select<3>(const vint4& t, const vint4& f) {
-        return _mm_blendv_ps(f, t, v00FF);
-    }
-    template<> __forceinline vint4 select<4>(const vint4& t, const vint4& f) {
-        return _mm_blendv_ps(f, t, v0F00);
-    }
-    template<> __forceinline vint4 select<5>(const vint4& t, const vint4& f) {
-        return _mm_blendv_ps(f, t, v0F0F);
-    }
-    template<> __forceinline vint4 select<6>(const vint4& t, const vint4& f) {
-        return _mm_blendv_ps(f, t, v0FF0);
-    }
-    template<> __forceinline vint4 select<7>(const vint4& t, const vint4& f) {
-        return _mm_blendv_ps(f, t, v0FFF);
-    }
-    template<> __forceinline vint4 select<8>(const vint4& t, const vint4& f) {
-        return _mm_blendv_ps(f, t, vF000);
-    }
-    template<> __forceinline vint4 select<9>(const vint4& t, const vint4& f) {
-        return _mm_blendv_ps(f, t, vF00F);
-    }
-    template<> __forceinline vint4 select<10>(const vint4& t, const vint4& f) {
-        return _mm_blendv_ps(f, t, vF0F0);
-    }
-    template<> __forceinline vint4 select<11>(const vint4& t, const vint4& f) {
-        return _mm_blendv_ps(f, t, vF0FF);
-    }
-    template<> __forceinline vint4 select<12>(const vint4& t, const vint4& f) {
-        return _mm_blendv_ps(f, t, vFF00);
-    }
-    template<> __forceinline vint4 select<13>(const vint4& t, const vint4& f) {
-        return _mm_blendv_ps(f, t, vFF0F);
-    }
-    template<> __forceinline vint4 select<14>(const vint4& t, const vint4& f) {
-        return _mm_blendv_ps(f, t, vFFF0);
-    }
-    template<> __forceinline vint4 select<15>(const vint4& t, const vint4& f) {
-        return _mm_blendv_ps(f, t, vFFFF);
-    }
-#endif
       
-#if (defined(__aarch64__) && defined(BUILD_IOS)) || defined(__SSE4_1__)
+#if defined(__NEON_NATIVE__) || defined(__SSE4_1__)
   __forceinline vint4 min(const vint4& a, const vint4& b) { return _mm_min_epi32(a, b); }
   __forceinline vint4 max(const vint4& a, const vint4& b) { return _mm_max_epi32(a, b); }
 
@@ -493,18 +439,26 @@ namespace embree
   // Movement/Shifting/Shuffling Functions
   ////////////////////////////////////////////////////////////////////////////////
 
+#if defined(__NEON_NATIVE__)
+  __forceinline vint4 unpacklo(const vint4& a, const vint4& b) { return vzip1q_s32(a.v, b.v); }
+  __forceinline vint4 unpackhi(const vint4& a, const vint4& b) { return vzip2q_s32(a.v, b.v); }
+#else
   __forceinline vint4 unpacklo(const vint4& a, const vint4& b) { return _mm_castps_si128(_mm_unpacklo_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b))); }
   __forceinline vint4 unpackhi(const vint4& a, const vint4& b) { return _mm_castps_si128(_mm_unpackhi_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b))); }
+#endif
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
-    template<int i0, int i1, int i2, int i3>
-    __forceinline vint4 shuffle(const vint4& v) {
-        return vqtbl1q_u8( v, _MN_SHUFFLE(i0, i1, i2, i3));
-    }
-    template<int i0, int i1, int i2, int i3>
-    __forceinline vint4 shuffle(const vint4& a, const vint4& b) {
-        return vqtbl2q_u8( (uint8x16x2_t){a, b}, _MF_SHUFFLE(i0, i1, i2, i3) );
-    }
+#if defined(__NEON_NATIVE__)
+  template<int i0, int i1, int i2, int i3>
+  __forceinline vint4 shuffle(const vint4& v) {
+    return vreinterpretq_s32_u8(vqtbl1q_u8(vreinterpretq_u8_s32(v.v), _MN_SHUFFLE(i0, i1, i2, i3)));
+  }
+  template<int i0, int i1, int i2, int i3>
+  __forceinline vint4 shuffle(const vint4& a, const vint4& b) {
+    uint8x16x2_t ab;
+    ab.val[0] = vreinterpretq_u8_s32(a.v);
+    ab.val[1] = vreinterpretq_u8_s32(b.v);
+    return vreinterpretq_s32_u8(vqtbl2q_u8(ab, _MF_SHUFFLE(i0, i1, i2, i3)));
+  }
 #else
   template<int i0, int i1, int i2, int i3>
   __forceinline vint4 shuffle(const vint4& v) {
@@ -516,10 +470,10 @@ namespace embree
   }
 #endif
       
-#if defined(__aarch64__) && defined(BUILD_IOS)
-      template<> __forceinline vint4 shuffle<0, 0, 2, 2>(const vint4& v) { return vqtbl1q_u8( v, v0022 ); }
-      template<> __forceinline vint4 shuffle<1, 1, 3, 3>(const vint4& v) { return vqtbl1q_u8( v, v1133 ); }
-      template<> __forceinline vint4 shuffle<0, 1, 0, 1>(const vint4& v) { return vqtbl1q_u8( v, v0101 ); }
+#if defined(__NEON_NATIVE__)
+  template<> __forceinline vint4 shuffle<0, 0, 2, 2>(const vint4& v) { return vtrn1q_s32(v.v, v.v); }
+  template<> __forceinline vint4 shuffle<1, 1, 3, 3>(const vint4& v) { return vtrn2q_s32(v.v, v.v); }
+  template<> __forceinline vint4 shuffle<0, 1, 0, 1>(const vint4& v) { return vcombine_s32(vget_low_s32(v.v), vget_low_s32(v.v)); }
 #elif defined(__SSE3__)
   template<> __forceinline vint4 shuffle<0, 0, 2, 2>(const vint4& v) { return _mm_castps_si128(_mm_moveldup_ps(_mm_castsi128_ps(v))); }
   template<> __forceinline vint4 shuffle<1, 1, 3, 3>(const vint4& v) { return _mm_castps_si128(_mm_movehdup_ps(_mm_castsi128_ps(v))); }
@@ -531,9 +485,9 @@ namespace embree
     return shuffle<i,i,i,i>(v);
   }
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
-    template<int src> __forceinline int extract(const vint4& b);
-    template<int dst> __forceinline vint4 insert(const vint4& a, const int b);
+#if defined(__NEON_NATIVE__)
+  template<int src> __forceinline int extract(const vint4& b) { return vgetq_lane_s32(b.v, src); }
+  template<int dst> __forceinline vint4 insert(const vint4& a, const int b) { return vsetq_lane_s32(b, a.v, dst); }
 #elif defined(__SSE4_1__)
   template<int src> __forceinline int extract(const vint4& b) { return _mm_extract_epi32(b, src); }
   template<int dst> __forceinline vint4 insert(const vint4& a, const int b) { return _mm_insert_epi32(a, b, dst); }
@@ -542,53 +496,10 @@ namespace embree
   template<int dst> __forceinline vint4 insert(const vint4& a, int b) { vint4 c = a; c[dst&3] = b; return c; }
 #endif
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
-    template<> __forceinline int extract<0>(const vint4& b) {
-        return b[0];
-    }
-    template<> __forceinline int extract<1>(const vint4& b) {
-        return b[1];
-    }
-    template<> __forceinline int extract<2>(const vint4& b) {
-        return b[2];
-    }
-    template<> __forceinline int extract<3>(const vint4& b) {
-        return b[3];
-    }
-      
-    template<> __forceinline vint4 insert<0>(const vint4& a, int b)
-    {
-        vint4 c = a;
-        c[0] = b;
-        return c;
-    }
-    template<> __forceinline vint4 insert<1>(const vint4& a, int b)
-    {
-        vint4 c = a;
-        c[1] = b;
-        return c;
-    }
-    template<> __forceinline vint4 insert<2>(const vint4& a, int b)
-    {
-        vint4 c = a;
-        c[2] = b;
-        return c;
-    }
-    template<> __forceinline vint4 insert<3>(const vint4& a, int b)
-    {
-        vint4 c = a;
-        c[3] = b;
-        return c;
-    }
-      
-    __forceinline int toScalar(const vint4& v) {
-        return v[0];
-    }
-      
-    __forceinline size_t toSizeT(const vint4& v) {
-        int32x4_t t = vandq_s32(v, vFF00);
-        return vaddvq_s64(t);
-    }
+#if defined(__NEON_NATIVE__)
+  __forceinline int toScalar(const vint4& v) { return vgetq_lane_s32(v.v, 0); }
+
+  __forceinline size_t toSizeT(const vint4& v) { return vgetq_lane_s64(vreinterpretq_s64_s32(v.v), 0); }
 #else
   template<> __forceinline int extract<0>(const vint4& b) { return _mm_cvtsi128_si32(b); }
 
@@ -622,16 +533,16 @@ namespace embree
   /// Reductions
   ////////////////////////////////////////////////////////////////////////////////
 
-#if (defined(__aarch64__) && defined(BUILD_IOS)) || defined(__SSE4_1__)
-      
-#if (defined(__aarch64__) && defined(BUILD_IOS))
-    __forceinline vint4 vreduce_min(const vint4& v) { int h = vminvq_s32(v); return vdupq_n_s32(h); }
-    __forceinline vint4 vreduce_max(const vint4& v) { int h = vmaxvq_s32(v); return vdupq_n_s32(h); }
-    __forceinline vint4 vreduce_add(const vint4& v) { int h = vaddvq_s32(v); return vdupq_n_s32(h); }
+#if defined(__NEON_NATIVE__) || defined(__SSE4_1__)
       
-    __forceinline int reduce_min(const vint4& v) { return vminvq_s32(v); }
-    __forceinline int reduce_max(const vint4& v) { return vmaxvq_s32(v); }
-    __forceinline int reduce_add(const vint4& v) { return vaddvq_s32(v); }
+#if defined(__NEON_NATIVE__)
+  __forceinline vint4 vreduce_min(const vint4& v) { return vdupq_n_s32(vminvq_s32(v.v)); }
+  __forceinline vint4 vreduce_max(const vint4& v) { return vdupq_n_s32(vmaxvq_s32(v.v)); }
+  __forceinline vint4 vreduce_add(const vint4& v) { return vdupq_n_s32(vaddvq_s32(v.v)); }
+
+  __forceinline int reduce_min(const vint4& v) { return vminvq_s32(v.v); }
+  __forceinline int reduce_max(const vint4& v) { return vmaxvq_s32(v.v); }
+  __forceinline int reduce_add(const vint4& v) { return vaddvq_s32(v.v); }
 #else
   __forceinline vint4 vreduce_min(const vint4& v) { vint4 h = min(shuffle<1,0,3,2>(v),v); return min(shuffle<2,3,0,1>(h),h); }
   __forceinline vint4 vreduce_max(const vint4& v) { vint4 h = max(shuffle<1,0,3,2>(v),v); return max(shuffle<2,3,0,1>(h),h); }
@@ -660,7 +571,7 @@ namespace embree
   /// Sorting networks
   ////////////////////////////////////////////////////////////////////////////////
 
-#if (defined(__aarch64__) && defined(BUILD_IOS)) || defined(__SSE4_1__)
+#if defined(__NEON_NATIVE__) || defined(__SSE4_1__)
 
   __forceinline vint4 usort_ascending(const vint4& v)
   {
@@ -0,0 +1,345 @@
+// ======================================================================== //
+// Copyright 2009-2020 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+namespace embree
+{
+  template<> struct vfloat<8>;
+
+  /* 8-wide integer type for 4-wide ISAs, operates on two vint4 halves */
+  template<>
+  struct vint<8>
+  {
+    ALIGNED_STRUCT_(16);
+
+    typedef vboolf8 Bool;
+    typedef vint8   Int;
+    typedef vfloat8 Float;
+
+    enum  { size = 8 };        // number of SIMD elements
+    vint4 vl,vh;               // data
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// Constructors, Assignment & Cast Operators
+    ////////////////////////////////////////////////////////////////////////////////
+
+    __forceinline vint() {}
+    __forceinline vint(const vint8& a) : vl(a.vl), vh(a.vh) {}
+    __forceinline vint8& operator =(const vint8& a) { vl = a.vl; vh = a.vh; return *this; }
+
+    __forceinline explicit vint(const vint4& a) : vl(a), vh(a) {}
+    __forceinline vint(const vint4& a, const vint4& b) : vl(a), vh(b) {}
+
+    __forceinline explicit vint(const int* a) : vl(vint4::loadu(a)), vh(vint4::loadu(a+4)) {}
+    __forceinline vint(int a) : vl(a), vh(a) {}
+    __forceinline vint(int a, int b) : vl(a,b,a,b), vh(a,b,a,b) {}
+    __forceinline vint(int a, int b, int c, int d) : vl(a,b,c,d), vh(a,b,c,d) {}
+    __forceinline vint(int a, int b, int c, int d, int e, int f, int g, int h) : vl(a,b,c,d), vh(e,f,g,h) {}
+
+    __forceinline explicit vint(const vboolf8& a) : vl(a.vl), vh(a.vh) {}
+    __forceinline explicit vint(const vfloat8& a); // defined in vfloat8_sse2.h
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// Constants
+    ////////////////////////////////////////////////////////////////////////////////
+
+    __forceinline vint(ZeroTy)        : vl(zero), vh(zero) {}
+    __forceinline vint(OneTy)         : vl(one),  vh(one)  {}
+    __forceinline vint(PosInfTy)      : vl(pos_inf), vh(pos_inf) {}
+    __forceinline vint(NegInfTy)      : vl(neg_inf), vh(neg_inf) {}
+    __forceinline vint(StepTy)        : vl(0, 1, 2, 3), vh(4, 5, 6, 7) {}
+    __forceinline vint(ReverseStepTy) : vl(7, 6, 5, 4), vh(3, 2, 1, 0) {}
+    __forceinline vint(UndefinedTy)   : vl(undefined), vh(undefined) {}
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// Loads and Stores
+    ////////////////////////////////////////////////////////////////////////////////
+
+    static __forceinline vint8 load (const void* a) { return vint8(vint4::load ((const int*)a), vint4::load ((const int*)a+4)); }
+    static __forceinline vint8 loadu(const void* a) { return vint8(vint4::loadu((const int*)a), vint4::loadu((const int*)a+4)); }
+
+    static __forceinline vint8 load (const vboolf8& mask, const void* a) { return vint8(vint4::load (mask.vl,(const int*)a), vint4::load (mask.vh,(const int*)a+4)); }
+    static __forceinline vint8 loadu(const vboolf8& mask, const void* a) { return vint8(vint4::loadu(mask.vl,(const int*)a), vint4::loadu(mask.vh,(const int*)a+4)); }
+
+    static __forceinline void store (void* ptr, const vint8& v) { vint4::store ((int*)ptr,v.vl); vint4::store ((int*)ptr+4,v.vh); }
+    static __forceinline void storeu(void* ptr, const vint8& v) { vint4::storeu((int*)ptr,v.vl); vint4::storeu((int*)ptr+4,v.vh); }
+
+    static __forceinline void store (const vboolf8& mask, void* ptr, const vint8& v) { vint4::store (mask.vl,(int*)ptr,v.vl); vint4::store (mask.vh,(int*)ptr+4,v.vh); }
+    static __forceinline void storeu(const vboolf8& mask, void* ptr, const vint8& v) { vint4::storeu(mask.vl,(int*)ptr,v.vl); vint4::storeu(mask.vh,(int*)ptr+4,v.vh); }
+
+    static __forceinline vint8 load_nt(void* ptr) { return vint8(vint4::load_nt(ptr), vint4::load_nt((int*)ptr+4)); }
+    static __forceinline void store_nt(void* ptr, const vint8& v) { vint4::store_nt(ptr,v.vl); vint4::store_nt((int*)ptr+4,v.vh); }
+
+    static __forceinline vint8 load (const uint8_t* ptr) { return vint8(vint4::load (ptr+0), vint4::load (ptr+4)); }
+    static __forceinline vint8 loadu(const uint8_t* ptr) { return vint8(vint4::loadu(ptr+0), vint4::loadu(ptr+4)); }
+
+    static __forceinline vint8 load(const unsigned short* ptr) { return vint8(vint4::load(ptr+0), vint4::load(ptr+4)); }
+
+    static __forceinline void store(uint8_t* ptr, const vint8& v) { vint4::store(ptr+0,v.vl); vint4::store(ptr+4,v.vh); }
+    static __forceinline void store(unsigned short* ptr, const vint8& v) { vint4::store(ptr+0,v.vl); vint4::store(ptr+4,v.vh); }
+
+    template<int scale = 4>
+    static __forceinline vint8 gather(const int* ptr, const vint8& index) {
+      return vint8(vint4::gather<scale>(ptr,index.vl), vint4::gather<scale>(ptr,index.vh));
+    }
+
+    template<int scale = 4>
+    static __forceinline vint8 gather(const vboolf8& mask, const int* ptr, const vint8& index) {
+      return vint8(vint4::gather<scale>(mask.vl,ptr,index.vl), vint4::gather<scale>(mask.vh,ptr,index.vh));
+    }
+
+    template<int scale = 4>
+    static __forceinline void scatter(void* ptr, const vint8& ofs, const vint8& v) {
+      vint4::scatter<scale>(ptr,ofs.vl,v.vl);
+      vint4::scatter<scale>(ptr,ofs.vh,v.vh);
+    }
+
+    template<int scale = 4>
+    static __forceinline void scatter(const vboolf8& mask, void* ptr, const vint8& ofs, const vint8& v) {
+      vint4::scatter<scale>(mask.vl,ptr,ofs.vl,v.vl);
+      vint4::scatter<scale>(mask.vh,ptr,ofs.vh,v.vh);
+    }
+
+#if defined(__x86_64__) || defined(__aarch64__)
+    static __forceinline vint8 broadcast64(long long a) { return vint8(vint4::broadcast64(a)); }
+#endif
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// Array Access
+    ////////////////////////////////////////////////////////////////////////////////
+
+    __forceinline const int& operator [](size_t index) const { assert(index < 8); return (&vl)[index >> 2][index & 3]; }
+    __forceinline       int& operator [](size_t index)       { assert(index < 8); return (&vl)[index >> 2][index & 3]; }
+  };
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Unary Operators
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline vboolf8 asBool(const vint8& a) { return vboolf8(asBool(a.vl), asBool(a.vh)); }
+
+  __forceinline vint8 operator +(const vint8& a) { return a; }
+  __forceinline vint8 operator -(const vint8& a) { return vint8(-a.vl, -a.vh); }
+#if defined(__NEON_NATIVE__) || defined(__SSSE3__)
+  __forceinline vint8 abs       (const vint8& a) { return vint8(abs(a.vl), abs(a.vh)); }
+#endif
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Binary Operators
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline vint8 operator +(const vint8& a, const vint8& b) { return vint8(a.vl + b.vl, a.vh + b.vh); }
+  __forceinline vint8 operator +(const vint8& a, int          b) { return a + vint8(b); }
+  __forceinline vint8 operator +(int          a, const vint8& b) { return vint8(a) + b; }
+
+  __forceinline vint8 operator -(const vint8& a, const vint8& b) { return vint8(a.vl - b.vl, a.vh - b.vh); }
+  __forceinline vint8 operator -(const vint8& a, int          b) { return a - vint8(b); }
+  __forceinline vint8 operator -(int          a, const vint8& b) { return vint8(a) - b; }
+
+  __forceinline vint8 operator *(const vint8& a, const vint8& b) { return vint8(a.vl * b.vl, a.vh * b.vh); }
+  __forceinline vint8 operator *(const vint8& a, int          b) { return a * vint8(b); }
+  __forceinline vint8 operator *(int          a, const vint8& b) { return vint8(a) * b; }
+
+  __forceinline vint8 operator &(const vint8& a, const vint8& b) { return vint8(a.vl & b.vl, a.vh & b.vh); }
+  __forceinline vint8 operator &(const vint8& a, int          b) { return a & vint8(b); }
+  __forceinline vint8 operator &(int          a, const vint8& b) { return vint8(a) & b; }
+
+  __forceinline vint8 operator |(const vint8& a, const vint8& b) { return vint8(a.vl | b.vl, a.vh | b.vh); }
+  __forceinline vint8 operator |(const vint8& a, int          b) { return a | vint8(b); }
+  __forceinline vint8 operator |(int          a, const vint8& b) { return vint8(a) | b; }
+
+  __forceinline vint8 operator ^(const vint8& a, const vint8& b) { return vint8(a.vl ^ b.vl, a.vh ^ b.vh); }
+  __forceinline vint8 operator ^(const vint8& a, int          b) { return a ^ vint8(b); }
+  __forceinline vint8 operator ^(int          a, const vint8& b) { return vint8(a) ^ b; }
+
+  __forceinline vint8 operator <<(const vint8& a, int n) { return vint8(a.vl << n, a.vh << n); }
+  __forceinline vint8 operator >>(const vint8& a, int n) { return vint8(a.vl >> n, a.vh >> n); }
+
+  __forceinline vint8 sll (const vint8& a, int b) { return vint8(sll(a.vl, b), sll(a.vh, b)); }
+  __forceinline vint8 sra (const vint8& a, int b) { return vint8(sra(a.vl, b), sra(a.vh, b)); }
+  __forceinline vint8 srl (const vint8& a, int b) { return vint8(srl(a.vl, b), srl(a.vh, b)); }
+
+  __forceinline vint8 min(const vint8& a, const vint8& b) { return vint8(min(a.vl, b.vl), min(a.vh, b.vh)); }
+  __forceinline vint8 min(const vint8& a, int          b) { return min(a,vint8(b)); }
+  __forceinline vint8 min(int          a, const vint8& b) { return min(vint8(a),b); }
+
+  __forceinline vint8 max(const vint8& a, const vint8& b) { return vint8(max(a.vl, b.vl), max(a.vh, b.vh)); }
+  __forceinline vint8 max(const vint8& a, int          b) { return max(a,vint8(b)); }
+  __forceinline vint8 max(int          a, const vint8& b) { return max(vint8(a),b); }
+
+#if defined(__NEON_NATIVE__) || defined(__SSE4_1__)
+  __forceinline vint8 umin(const vint8& a, const vint8& b) { return vint8(umin(a.vl, b.vl), umin(a.vh, b.vh)); }
+  __forceinline vint8 umax(const vint8& a, const vint8& b) { return vint8(umax(a.vl, b.vl), umax(a.vh, b.vh)); }
+#endif
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Assignment Operators
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline vint8& operator +=(vint8& a, const vint8& b) { return a = a + b; }
+  __forceinline vint8& operator +=(vint8& a, int          b) { return a = a + b; }
+
+  __forceinline vint8& operator -=(vint8& a, const vint8& b) { return a = a - b; }
+  __forceinline vint8& operator -=(vint8& a, int          b) { return a = a - b; }
+
+  __forceinline vint8& operator *=(vint8& a, const vint8& b) { return a = a * b; }
+  __forceinline vint8& operator *=(vint8& a, int          b) { return a = a * b; }
+
+  __forceinline vint8& operator &=(vint8& a, const vint8& b) { return a = a & b; }
+  __forceinline vint8& operator &=(vint8& a, int          b) { return a = a & b; }
+
+  __forceinline vint8& operator |=(vint8& a, const vint8& b) { return a = a | b; }
+  __forceinline vint8& operator |=(vint8& a, int          b) { return a = a | b; }
+
+  __forceinline vint8& operator <<=(vint8& a, int b) { return a = a << b; }
+  __forceinline vint8& operator >>=(vint8& a, int b) { return a = a >> b; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Comparison Operators + Select
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline vboolf8 operator ==(const vint8& a, const vint8& b) { return vboolf8(a.vl == b.vl, a.vh == b.vh); }
+  __forceinline vboolf8 operator ==(const vint8& a, int          b) { return a == vint8(b); }
+  __forceinline vboolf8 operator ==(int          a, const vint8& b) { return vint8(a) == b; }
+
+  __forceinline vboolf8 operator !=(const vint8& a, const vint8& b) { return vboolf8(a.vl != b.vl, a.vh != b.vh); }
+  __forceinline vboolf8 operator !=(const vint8& a, int          b) { return a != vint8(b); }
+  __forceinline vboolf8 operator !=(int          a, const vint8& b) { return vint8(a) != b; }
+
+  __forceinline vboolf8 operator < (const vint8& a, const vint8& b) { return vboolf8(a.vl <  b.vl, a.vh <  b.vh); }
+  __forceinline vboolf8 operator < (const vint8& a, int          b) { return a <  vint8(b); }
+  __forceinline vboolf8 operator < (int          a, const vint8& b) { return vint8(a) <  b; }
+
+  __forceinline vboolf8 operator >=(const vint8& a, const vint8& b) { return vboolf8(a.vl >= b.vl, a.vh >= b.vh); }
+  __forceinline vboolf8 operator >=(const vint8& a, int          b) { return a >= vint8(b); }
+  __forceinline vboolf8 operator >=(int          a, const vint8& b) { return vint8(a) >= b; }
+
+  __forceinline vboolf8 operator > (const vint8& a, const vint8& b) { return vboolf8(a.vl >  b.vl, a.vh >  b.vh); }
+  __forceinline vboolf8 operator > (const vint8& a, int          b) { return a >  vint8(b); }
+  __forceinline vboolf8 operator > (int          a, const vint8& b) { return vint8(a) >  b; }
+
+  __forceinline vboolf8 operator <=(const vint8& a, const vint8& b) { return vboolf8(a.vl <= b.vl, a.vh <= b.vh); }
+  __forceinline vboolf8 operator <=(const vint8& a, int          b) { return a <= vint8(b); }
+  __forceinline vboolf8 operator <=(int          a, const vint8& b) { return vint8(a) <= b; }
+
+  __forceinline vboolf8 eq(const vint8& a, const vint8& b) { return a == b; }
+  __forceinline vboolf8 ne(const vint8& a, const vint8& b) { return a != b; }
+  __forceinline vboolf8 lt(const vint8& a, const vint8& b) { return a <  b; }
+  __forceinline vboolf8 ge(const vint8& a, const vint8& b) { return a >= b; }
+  __forceinline vboolf8 gt(const vint8& a, const vint8& b) { return a >  b; }
+  __forceinline vboolf8 le(const vint8& a, const vint8& b) { return a <= b; }
+
+  __forceinline vboolf8 eq(const vboolf8& mask, const vint8& a, const vint8& b) { return mask & (a == b); }
+  __forceinline vboolf8 ne(const vboolf8& mask, const vint8& a, const vint8& b) { return mask & (a != b); }
+  __forceinline vboolf8 lt(const vboolf8& mask, const vint8& a, const vint8& b) { return mask & (a <  b); }
+  __forceinline vboolf8 ge(const vboolf8& mask, const vint8& a, const vint8& b) { return mask & (a >= b); }
+  __forceinline vboolf8 gt(const vboolf8& mask, const vint8& a, const vint8& b) { return mask & (a >  b); }
+  __forceinline vboolf8 le(const vboolf8& mask, const vint8& a, const vint8& b) { return mask & (a <= b); }
+
+  __forceinline vint8 select(const vboolf8& m, const vint8& t, const vint8& f) {
+    return vint8(select(m.vl, t.vl, f.vl), select(m.vh, t.vh, f.vh));
+  }
+
+  __forceinline vint8 notand(const vboolf8& m, const vint8& f) {
+    return select(m, vint8(zero), f);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Movement/Shifting/Shuffling Functions
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline vint8 unpacklo(const vint8& a, const vint8& b) { return vint8(unpacklo(a.vl, b.vl), unpacklo(a.vh, b.vh)); }
+  __forceinline vint8 unpackhi(const vint8& a, const vint8& b) { return vint8(unpackhi(a.vl, b.vl), unpackhi(a.vh, b.vh)); }
+
+  template<int i>
+  __forceinline vint8 shuffle(const vint8& v) {
+    return vint8(shuffle<i>(v.vl), shuffle<i>(v.vh));
+  }
+
+  template<int i0, int i1>
+  __forceinline vint8 shuffle4(const vint8& v) {
+    return vint8((&v.vl)[i0], (&v.vl)[i1]);
+  }
+
+  template<int i0, int i1>
+  __forceinline vint8 shuffle4(const vint8& a, const vint8& b) {
+    return vint8((&a.vl)[i0], (&b.vl)[i1]);
+  }
+
+  template<int i0, int i1, int i2, int i3>
+  __forceinline vint8 shuffle(const vint8& v) {
+    return vint8(shuffle<i0,i1,i2,i3>(v.vl), shuffle<i0,i1,i2,i3>(v.vh));
+  }
+
+  template<int i0, int i1, int i2, int i3>
+  __forceinline vint8 shuffle(const vint8& a, const vint8& b) {
+    return vint8(shuffle<i0,i1,i2,i3>(a.vl, b.vl), shuffle<i0,i1,i2,i3>(a.vh, b.vh));
+  }
+
+  __forceinline vint8 broadcast(const int* ptr) { return vint8(*ptr); }
+  template<int i> __forceinline vint8 insert4(const vint8& a, const vint4& b) { vint8 c = a; (&c.vl)[i] = b; return c; }
+  template<int i> __forceinline vint4 extract4(const vint8& a) { return (&a.vl)[i]; }
+
+  __forceinline int toScalar(const vint8& v) { return toScalar(v.vl); }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Reductions
+  ////////////////////////////////////////////////////////////////////////////////
+
+  __forceinline int reduce_min(const vint8& v) { return min(reduce_min(v.vl), reduce_min(v.vh)); }
+  __forceinline int reduce_max(const vint8& v) { return max(reduce_max(v.vl), reduce_max(v.vh)); }
+  __forceinline int reduce_add(const vint8& v) { return reduce_add(v.vl + v.vh); }
+
+  __forceinline vint8 vreduce_min(const vint8& v) { return vint8(reduce_min(v)); }
+  __forceinline vint8 vreduce_max(const vint8& v) { return vint8(reduce_max(v)); }
+  __forceinline vint8 vreduce_add(const vint8& v) { return vint8(reduce_add(v)); }
+
+  __forceinline size_t select_min(const vint8& v) { return bsf(movemask(v == vreduce_min(v))); }
+  __forceinline size_t select_max(const vint8& v) { return bsf(movemask(v == vreduce_max(v))); }
+
+  __forceinline size_t select_min(const vboolf8& valid, const vint8& v) { const vint8 a = select(valid,v,vint8(pos_inf)); return bsf(movemask(valid & (a == vreduce_min(a)))); }
+  __forceinline size_t select_max(const vboolf8& valid, const vint8& v) { const vint8 a = select(valid,v,vint8(neg_inf)); return bsf(movemask(valid & (a == vreduce_max(a)))); }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Sorting networks
+  ////////////////////////////////////////////////////////////////////////////////
+
+  /* sorts both halves and merges them with one bitonic half-cleaner step */
+  __forceinline vint8 usort_ascending(const vint8& v)
+  {
+    const vint4 bias(0x80000000);
+    const vint4 a = usort_ascending(v.vl) ^ bias;
+    const vint4 b = shuffle<3,2,1,0>(usort_ascending(v.vh)) ^ bias;
+    return vint8(usort_ascending(min(a,b) ^ bias), usort_ascending(max(a,b) ^ bias));
+  }
+
+  __forceinline vint8 usort_descending(const vint8& v)
+  {
+    const vint4 bias(0x80000000);
+    const vint4 a = usort_descending(v.vl) ^ bias;
+    const vint4 b = shuffle<3,2,1,0>(usort_descending(v.vh)) ^ bias;
+    return vint8(usort_descending(max(a,b) ^ bias), usort_descending(min(a,b) ^ bias));
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Output Operators
+  ////////////////////////////////////////////////////////////////////////////////
+
+  inline std::ostream& operator <<(std::ostream& cout, const vint8& a) {
+    return cout << "<" << a[0] << ", " << a[1] << ", " << a[2] << ", " << a[3] << ", " << a[4] << ", " << a[5] << ", " << a[6] << ", " << a[7] << ">";
+  }
+}
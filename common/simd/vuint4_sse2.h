@@ -119,8 +119,8 @@ namespace embree
 #endif
 
     static __forceinline vuint4 load(const unsigned short* ptr) {
-#if defined(__aarch64__) && defined(BUILD_IOS)
-      return _mm_load4epu16_epi32(((__m128i*)ptr));
+#if defined(__NEON_NATIVE__)
+      return vreinterpretq_s32_u32(vmovl_u16(vld1_u16(ptr)));
 #elif defined (__SSE4_1__)
       return _mm_cvtepu16_epi32(_mm_loadu_si128((__m128i*)ptr));
 #else
@@ -129,11 +129,10 @@ namespace embree
     } 
 
     static __forceinline void store_uint8(uint8_t* ptr, const vuint4& v) {
-#if defined(__aarch64__) && defined(BUILD_IOS)
-        uint32x4_t x = v;
-        uint16x4_t y = vqmovn_u32(x);
-        uint8x8_t z = vqmovn_u16(vcombine_u16(y, y));
-        vst1_lane_u32(ptr, z, 0);
+#if defined(__NEON_NATIVE__)
+      const uint16x4_t x = vqmovn_u32(vreinterpretq_u32_s32(v.v));
+      const uint8x8_t  y = vqmovn_u16(vcombine_u16(x, x));
+      vst1_lane_u32((uint32_t*)ptr, vreinterpret_u32_u8(y), 0);
 #elif defined(__SSE4_1__)
       __m128i x = v;
       x = _mm_packus_epi32(x, x);
@@ -146,10 +145,8 @@ namespace embree
     }
 
     static __forceinline void store_uint8(unsigned short* ptr, const vuint4& v) {
-#if defined(__aarch64__) && defined(BUILD_IOS)
-        int32x4_t x = v;
-        int16x4_t y = vqmovn_u32(x);
-        vst1_u16(ptr, y);
+#if defined(__NEON_NATIVE__)
+      vst1_u16(ptr, vmovn_u32(vreinterpretq_u32_s32(v.v)));
 #else
       for (size_t i=0;i<4;i++)
         ptr[i] = (unsigned short)v[i];
@@ -157,7 +154,7 @@ namespace embree
     }
 
     static __forceinline vuint4 load_nt(void* ptr) {
-#if (defined(__aarch64__) && defined(BUILD_IOS)) || defined(__SSE4_1__)
+#if defined(__NEON_NATIVE__) || defined(__SSE4_1__)
       return _mm_stream_load_si128((__m128i*)ptr); 
 #else
       return _mm_load_si128((__m128i*)ptr); 
@@ -165,7 +162,7 @@ namespace embree
     }
     
     static __forceinline void store_nt(void* ptr, const vuint4& v) {
-#if (defined(__aarch64__) && defined(BUILD_IOS)) || defined(__SSE4_1__)
+#if defined(__NEON_NATIVE__) || defined(__SSE4_1__)
       _mm_stream_ps((float*)ptr,_mm_castsi128_ps(v)); 
 #else
       _mm_store_si128((__m128i*)ptr,v);
@@ -211,6 +208,8 @@ namespace embree
     friend __forceinline vuint4 select(const vboolf4& m, const vuint4& t, const vuint4& f) {
 #if defined(__AVX512VL__)
       return _mm_mask_blend_epi32(m, (__m128i)f, (__m128i)t);
+#elif defined(__NEON_NATIVE__)
+      return vbslq_s32(vreinterpretq_u32_f32(m.v), t.v, f.v);
 #elif defined(__SSE4_1__)
       return _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(f), _mm_castsi128_ps(t), m)); 
 #else
@@ -365,56 +364,6 @@ namespace embree
 #endif    
   }
                                                                                
-#if defined(__aarch64__) && defined(BUILD_IOS)
-  template<> __forceinline vuint4 select<0>(const vuint4& t, const vuint4& f) {
-    return _mm_blendv_ps(f, t, vzero);
-  }
-  template<> __forceinline vuint4 select<1>(const vuint4& t, const vuint4& f) {
-    return _mm_blendv_ps(f, t, v000F);
-  }
-  template<> __forceinline vuint4 select<2>(const vuint4& t, const vuint4& f) {
-    return _mm_blendv_ps(f, t, v00F0);
-  }
-  template<> __forceinline vuint4 select<3>(const vuint4& t, const vuint4& f) {
-    return _mm_blendv_ps(f, t, v00FF);
-  }
-  template<> __forceinline vuint4 select<4>(const vuint4& t, const vuint4& f) {
-    return _mm_blendv_ps(f, t, v0F00);
-  }
-  template<> __forceinline vuint4 select<5>(const vuint4& t, const vuint4& f) {
-    return _mm_blendv_ps(f, t, v0F0F);
-  }
-  template<> __forceinline vuint4 select<6>(const vuint4& t, const vuint4& f) {
-    return _mm_blendv_ps(f, t, v0FF0);
-  }
-  template<> __forceinline vuint4 select<7>(const vuint4& t, const vuint4& f) {
-    return _mm_blendv_ps(f, t, v0FFF);
-  }
-  template<> __forceinline vuint4 select<8>(const vuint4& t, const vuint4& f) {
-    return _mm_blendv_ps(f, t, vF000);
-  }
-  template<> __forceinline vuint4 select<9>(const vuint4& t, const vuint4& f) {
-    return _mm_blendv_ps(f, t, vF00F);
-  }
-  template<> __forceinline vuint4 select<10>(const vuint4& t, const vuint4& f) {
-    return _mm_blendv_ps(f, t, vF0F0);
-  }
-  template<> __forceinline vuint4 select<11>(const vuint4& t, const vuint4& f) {
-    return _mm_blendv_ps(f, t, vF0FF);
-  }
-  template<> __forceinline vuint4 select<12>(const vuint4& t, const vuint4& f) {
-    return _mm_blendv_ps(f, t, vFF00);
-  }
-  template<> __forceinline vuint4 select<13>(const vuint4& t, const vuint4& f) {
-    return _mm_blendv_ps(f, t, vFF0F);
-  }
-  template<> __forceinline vuint4 select<14>(const vuint4& t, const vuint4& f) {
-    return _mm_blendv_ps(f, t, vFFF0);
-  }
-  template<> __forceinline vuint4 select<15>(const vuint4& t, const vuint4& f) {
-    return _mm_blendv_ps(f, t, vFFFF);
-  }
-#endif
 
 /*#if defined(__SSE4_1__)
   __forceinline vuint4 min(const vuint4& a, const vuint4& b) { return _mm_min_epu32(a, b); }
@@ -434,17 +383,25 @@ namespace embree
   // Movement/Shifting/Shuffling Functions
   ////////////////////////////////////////////////////////////////////////////////
 
+#if defined(__NEON_NATIVE__)
+  __forceinline vuint4 unpacklo(const vuint4& a, const vuint4& b) { return vzip1q_s32(a.v, b.v); }
+  __forceinline vuint4 unpackhi(const vuint4& a, const vuint4& b) { return vzip2q_s32(a.v, b.v); }
+#else
   __forceinline vuint4 unpacklo(const vuint4& a, const vuint4& b) { return _mm_castps_si128(_mm_unpacklo_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b))); }
   __forceinline vuint4 unpackhi(const vuint4& a, const vuint4& b) { return _mm_castps_si128(_mm_unpackhi_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b))); }
+#endif
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
+#if defined(__NEON_NATIVE__)
   template<int i0, int i1, int i2, int i3>
   __forceinline vuint4 shuffle(const vuint4& v) {
-    return vqtbl1q_u8( v, _MN_SHUFFLE(i0, i1, i2, i3));
+    return vreinterpretq_s32_u8(vqtbl1q_u8(vreinterpretq_u8_s32(v.v), _MN_SHUFFLE(i0, i1, i2, i3)));
   }
   template<int i0, int i1, int i2, int i3>
   __forceinline vuint4 shuffle(const vuint4& a, const vuint4& b) {
-    return vqtbl2q_u8( (uint8x16x2_t){a, b}, _MF_SHUFFLE(i0, i1, i2, i3) );
+    uint8x16x2_t ab;
+    ab.val[0] = vreinterpretq_u8_s32(a.v);
+    ab.val[1] = vreinterpretq_u8_s32(b.v);
+    return vreinterpretq_s32_u8(vqtbl2q_u8(ab, _MF_SHUFFLE(i0, i1, i2, i3)));
   }
 #else
   template<int i0, int i1, int i2, int i3>
@@ -457,10 +414,10 @@ namespace embree
   }
 #endif
                                                                                
-#if defined(__aarch64__) && defined(BUILD_IOS)
-  template<> __forceinline vuint4 shuffle<0, 0, 2, 2>(const vuint4& v) { return vqtbl1q_u8( v, (uint8x16_t){0,1,2,3, 0,1,2,3, 8,9,10,11, 8,9,10,11} ); }
-  template<> __forceinline vuint4 shuffle<1, 1, 3, 3>(const vuint4& v) { return vqtbl1q_u8( v, (uint8x16_t){4,5,6,7, 4,5,6,7, 12,13,14,15, 12,13,14,15} ); }
-  template<> __forceinline vuint4 shuffle<0, 1, 0, 1>(const vuint4& v) { return vqtbl1q_u8( v, (uint8x16_t){0,1,2,3, 4,5,6,7, 0,1,2,3, 4,5,6,7} ); }
+#if defined(__NEON_NATIVE__)
+  template<> __forceinline vuint4 shuffle<0, 0, 2, 2>(const vuint4& v) { return vtrn1q_s32(v.v, v.v); }
+  template<> __forceinline vuint4 shuffle<1, 1, 3, 3>(const vuint4& v) { return vtrn2q_s32(v.v, v.v); }
+  template<> __forceinline vuint4 shuffle<0, 1, 0, 1>(const vuint4& v) { return vcombine_s32(vget_low_s32(v.v), vget_low_s32(v.v)); }
 #elif defined(__SSE3__)
   template<> __forceinline vuint4 shuffle<0, 0, 2, 2>(const vuint4& v) { return _mm_castps_si128(_mm_moveldup_ps(_mm_castsi128_ps(v))); }
   template<> __forceinline vuint4 shuffle<1, 1, 3, 3>(const vuint4& v) { return _mm_castps_si128(_mm_movehdup_ps(_mm_castsi128_ps(v))); }
@@ -472,9 +429,9 @@ namespace embree
     return shuffle<i,i,i,i>(v);
   }
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
-  template<int src> __forceinline unsigned int extract(const vuint4& b);
-  template<int dst> __forceinline vuint4 insert(const vuint4& a, const unsigned b);
+#if defined(__NEON_NATIVE__)
+  template<int src> __forceinline unsigned int extract(const vuint4& b) { return vgetq_lane_s32(b.v, src); }
+  template<int dst> __forceinline vuint4 insert(const vuint4& a, const unsigned b) { return vsetq_lane_s32(int(b), a.v, dst); }
 #elif defined(__SSE4_1__)
   template<int src> __forceinline unsigned int extract(const vuint4& b) { return _mm_extract_epi32(b, src); }
   template<int dst> __forceinline vuint4 insert(const vuint4& a, const unsigned b) { return _mm_insert_epi32(a, b, dst); }
@@ -483,44 +440,8 @@ namespace embree
   template<int dst> __forceinline vuint4 insert(const vuint4& a, const unsigned b) { vuint4 c = a; c[dst&3] = b; return c; }
 #endif
 
-#if defined(__aarch64__) && defined(BUILD_IOS)
-  template<> __forceinline unsigned int extract<0>(const vuint4& b) {
-    return b[0];
-  }
-  template<> __forceinline unsigned int extract<1>(const vuint4& b) {
-    return b[1];
-  }
-  template<> __forceinline unsigned int extract<2>(const vuint4& b) {
-    return b[2];
-  }
-  template<> __forceinline unsigned int extract<3>(const vuint4& b) {
-    return b[3];
-  }
-                                                                               
-  template<> __forceinline vuint4 insert<0>(const vuint4& a, unsigned b){
-    vuint4 c = a;
-    c[0] = b;
-    return c;
-  }
-  template<> __forceinline vuint4 insert<1>(const vuint4& a, unsigned b){
-    vuint4 c = a;
-    c[1] = b;
-    return c;
-  }
-  template<> __forceinline vuint4 insert<2>(const vuint4& a, unsigned b){
-    vuint4 c = a;
-    c[2] = b;
-    return c;
-  }
-  template<> __forceinline vuint4 insert<3>(const vuint4& a, unsigned b){
-    vuint4 c = a;
-    c[3] = b;
-    return c;
-  }
-                                                                               
-  __forceinline unsigned int toScalar(const vuint4& v) {
-    return v[0];
-  }
+#if defined(__NEON_NATIVE__)
+  __forceinline unsigned int toScalar(const vuint4& v) { return vgetq_lane_s32(v.v, 0); }
 #else
   template<> __forceinline unsigned int extract<0>(const vuint4& b) { return _mm_cvtsi128_si32(b); }
 
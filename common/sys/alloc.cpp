@@ -120,7 +120,7 @@ namespace embree
     return true;
   }
 
-  void* os_malloc(size_t bytes, bool& hugepages)
+  void* os_malloc(size_t bytes, bool& hugepages, bool align2M)
   {
     if (bytes == 0) {
       hugepages = false;
@@ -246,7 +246,7 @@ namespace embree
     return true;
   }
 
-  void* os_malloc(size_t bytes, bool& hugepages)
+  void* os_malloc(size_t bytes, bool& hugepages, bool align2M)
   { 
     if (bytes == 0) {
       hugepages = false;
@@ -271,6 +271,21 @@ namespace embree
 #endif
     } 
 
+#if defined(MADV_HUGEPAGE)
+    /* on request map a 2MB aligned range for multiples of 2MB, such that transparent huge pages can back all of it */
+    if (align2M && (bytes & (PAGE_SIZE_2M-1)) == 0)
+    {
+      char* ptr = (char*) mmap(0, bytes+PAGE_SIZE_2M, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+      if (ptr == MAP_FAILED) throw std::bad_alloc();
+      char* aptr = (char*) ((((size_t)ptr)+PAGE_SIZE_2M-1) & ~size_t(PAGE_SIZE_2M-1));
+      if (aptr != ptr) munmap(ptr,aptr-ptr);
+      munmap(aptr+bytes,ptr+PAGE_SIZE_2M-aptr);
+      hugepages = false;
+      os_advise(aptr,bytes);
+      return aptr;
+    }
+#endif
+
     /* fallback to 4k pages */
     void* ptr = (char*) mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
     if (ptr == MAP_FAILED) throw std::bad_alloc();
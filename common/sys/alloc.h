@@ -69,7 +69,7 @@ namespace embree
   /*! allocates pages directly from OS */
   bool win_enable_selockmemoryprivilege(bool verbose);
   bool os_init(bool hugepages, bool verbose);
-  void* os_malloc (size_t bytes, bool& hugepages);
+  void* os_malloc (size_t bytes, bool& hugepages, bool align2M = false);
   size_t os_shrink (void* ptr, size_t bytesNew, size_t bytesOld, bool hugepages);
   void  os_free   (void* ptr, size_t bytes, bool hugepages);
   void  os_advise (void* ptr, size_t bytes);
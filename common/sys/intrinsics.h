@@ -485,6 +485,20 @@ namespace embree
     return _mm_popcnt_u64(in);
   }
 #endif
+
+#elif defined(__NEON_NATIVE__)
+
+  __forceinline int popcnt(int in) {
+    return vaddv_u8(vcnt_u8(vcreate_u8(uint32_t(in))));
+  }
+
+  __forceinline unsigned popcnt(unsigned in) {
+    return vaddv_u8(vcnt_u8(vcreate_u8(in)));
+  }
+
+  __forceinline size_t popcnt(size_t in) {
+    return vaddv_u8(vcnt_u8(vcreate_u8(in)));
+  }
   
 #endif
 
@@ -92,6 +92,15 @@
 #  endif
 #endif
 
+/* native NEON code paths are available on all aarch64 targets, they
+ * replace the SSE2NEON translation and enable the SSE4.1 style fast
+ * paths of the kernels */
+#if defined(__aarch64__) && !defined(EMBREE_NO_NEON_NATIVE)
+#  if !defined(__NEON_NATIVE__)
+#     define __NEON_NATIVE__
+#  endif
+#endif
+
 #if defined (_DEBUG) && !defined(DEBUG)
 	#define DEBUG
 #endif
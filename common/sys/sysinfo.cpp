@@ -370,6 +370,16 @@ namespace embree
     if (hasISA(features,AVX512SKX)) v += "NEON ";
     return v;
   }
+
+  /* NUMA node of the calling thread plus one, zero if not queried yet */
+  static __thread unsigned int g_current_numa_node = 0;
+
+  unsigned int getCurrentNumaNode()
+  {
+    if (unlikely(g_current_numa_node == 0))
+      g_current_numa_node = getNumaNodeOfCPU(getCurrentCPU())+1;
+    return g_current_numa_node-1;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -420,6 +430,30 @@ namespace embree
     return nThreads;
   }
 
+  unsigned int getCurrentCPU() {
+    return GetCurrentProcessorNumber();
+  }
+
+  unsigned int getNumaNodeOfCPU(unsigned int cpu)
+  {
+    UCHAR node = 0;
+    if (cpu < 256 && GetNumaProcessorNode((UCHAR)cpu,&node) && node != 0xFF)
+      return node;
+    return 0;
+  }
+
+  /* the NUMA node is the finest granularity we query on Windows */
+  unsigned int getCacheClusterOfCPU(unsigned int cpu) {
+    return getNumaNodeOfCPU(cpu);
+  }
+
+  unsigned int getNumberOfNumaNodes()
+  {
+    ULONG highestNode = 0;
+    if (!GetNumaHighestNodeNumber(&highestNode)) return 1;
+    return highestNode+1;
+  }
+
   int getTerminalWidth()
   {
     HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -466,9 +500,113 @@ namespace embree
 
 #include <stdio.h>
 #include <unistd.h>
+#include <sched.h>
+#include <dirent.h>
+#include <vector>
+#include <sstream>
+#include <algorithm>
 
 namespace embree
 {
+  /* parses a list of CPUs of the form "0-3,8,10-11" as used by sysfs */
+  static std::vector<unsigned int> parseCPUList(const std::string& str)
+  {
+    std::vector<unsigned int> cpus;
+    std::stringstream stream(str);
+    std::string range;
+    while (std::getline(stream,range,','))
+    {
+      unsigned int begin = 0, end = 0;
+      const int n = sscanf(range.c_str(),"%u-%u",&begin,&end);
+      if (n < 1) continue;
+      if (n < 2) end = begin;
+      for (unsigned int cpu=begin; cpu<=end; cpu++)
+        cpus.push_back(cpu);
+    }
+    return cpus;
+  }
+
+  static std::string readSysFile(const std::string& fileName)
+  {
+    std::string str;
+    std::ifstream file(fileName);
+    std::getline(file,str);
+    return str;
+  }
+
+  /* cache cluster and NUMA node of each logical CPU as reported by sysfs */
+  struct CPUTopology
+  {
+    CPUTopology ()
+      : numNodes(1)
+    {
+      const long numCPUs = sysconf(_SC_NPROCESSORS_CONF);
+      cluster.resize(std::max(numCPUs,1L),0);
+      node.resize(std::max(numCPUs,1L),0);
+
+      /* the CPUs sharing the highest level cache form a cluster that we identify by its first CPU */
+      for (size_t cpu=0; cpu<cluster.size(); cpu++)
+      {
+        const std::string path = "/sys/devices/system/cpu/cpu" + toString(cpu) + "/cache/index";
+        int bestLevel = -1;
+        for (size_t index=0;; index++)
+        {
+          const std::string level = readSysFile(path + toString(index) + "/level");
+          if (level.empty()) break;
+          const std::vector<unsigned int> cpus = parseCPUList(readSysFile(path + toString(index) + "/shared_cpu_list"));
+          if (cpus.empty() || atoi(level.c_str()) <= bestLevel) continue;
+          bestLevel = atoi(level.c_str());
+          cluster[cpu] = *std::min_element(cpus.begin(),cpus.end());
+        }
+      }
+
+      DIR* dir = opendir("/sys/devices/system/node");
+      if (!dir) return;
+      while (struct dirent* entry = readdir(dir))
+      {
+        unsigned int nodeID = 0;
+        if (sscanf(entry->d_name,"node%u",&nodeID) != 1) continue;
+        const std::string path = "/sys/devices/system/node/" + std::string(entry->d_name) + "/cpulist";
+        for (unsigned int cpu : parseCPUList(readSysFile(path)))
+          if (cpu < node.size()) node[cpu] = nodeID;
+        numNodes = std::max(numNodes,nodeID+1);
+      }
+      closedir(dir);
+    }
+
+    static const CPUTopology& get() {
+      static CPUTopology topology;
+      return topology;
+    }
+
+  public:
+    std::vector<unsigned int> cluster;
+    std::vector<unsigned int> node;
+    unsigned int numNodes;
+  };
+
+  unsigned int getCurrentCPU()
+  {
+    const int cpu = sched_getcpu();
+    return cpu < 0 ? 0 : cpu;
+  }
+
+  unsigned int getCacheClusterOfCPU(unsigned int cpu)
+  {
+    const CPUTopology& topology = CPUTopology::get();
+    return cpu < topology.cluster.size() ? topology.cluster[cpu] : 0;
+  }
+
+  unsigned int getNumaNodeOfCPU(unsigned int cpu)
+  {
+    const CPUTopology& topology = CPUTopology::get();
+    return cpu < topology.node.size() ? topology.node[cpu] : 0;
+  }
+
+  unsigned int getNumberOfNumaNodes() {
+    return CPUTopology::get().numNodes;
+  }
+
   std::string getExecutableFileName()
   {
     std::string pid = "/proc/" + toString(getpid()) + "/exe";
@@ -591,6 +729,16 @@ namespace embree
     return nThreads;
   }
 
+#if !defined(__LINUX__)
+
+  /* no topology information on these platforms, thus all CPUs form a single cluster */
+  unsigned int getCurrentCPU() { return 0; }
+  unsigned int getCacheClusterOfCPU(unsigned int cpu) { return 0; }
+  unsigned int getNumaNodeOfCPU(unsigned int cpu) { return 0; }
+  unsigned int getNumberOfNumaNodes() { return 1; }
+
+#endif
+
   int getTerminalWidth()
   {
     struct winsize info;
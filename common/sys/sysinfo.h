@@ -177,6 +177,21 @@ namespace embree
   /*! return the number of logical threads of the system */
   unsigned int getNumberOfLogicalThreads();
 
+  /*! returns the logical CPU the calling thread is currently running on */
+  unsigned int getCurrentCPU();
+
+  /*! returns an ID shared by all logical CPUs that share the last level cache with the specified CPU */
+  unsigned int getCacheClusterOfCPU(unsigned int cpu);
+
+  /*! returns the NUMA node of the specified logical CPU */
+  unsigned int getNumaNodeOfCPU(unsigned int cpu);
+
+  /*! returns the number of NUMA nodes of the system */
+  unsigned int getNumberOfNumaNodes();
+
+  /*! returns the NUMA node of the calling thread, which is queried once per thread and cached */
+  unsigned int getCurrentNumaNode();
+
   /*! returns the size of the terminal window in characters */
   int getTerminalWidth();
 
@@ -96,6 +96,40 @@ namespace embree
     setAffinity(GetCurrentThread(), affinity);
   }
 
+  /*! restricts the calling thread to the logical threads of some NUMA node */
+  void setNumaAffinity(unsigned int node)
+  {
+    ULONGLONG mask = 0;
+    if (node > 0xFF || !GetNumaNodeProcessorMask((UCHAR)node, &mask) || mask == 0)
+      return;
+
+    if (!SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(mask)))
+      WARNING("SetThreadAffinityMask failed"); // on purpose only a warning
+  }
+
+  /*! restricts the calling thread to the given logical threads */
+  void setAffinityMask(const std::vector<size_t>& cpus)
+  {
+    DWORD_PTR mask = 0;
+    for (size_t i=0; i<cpus.size(); i++)
+      if (cpus[i] < 8*sizeof(DWORD_PTR)) mask |= DWORD_PTR(1) << cpus[i];
+    if (mask == 0)
+      return;
+
+    if (!SetThreadAffinityMask(GetCurrentThread(), mask))
+      WARNING("SetThreadAffinityMask failed"); // on purpose only a warning
+  }
+
+  /*! sets the scheduling priority of the calling thread */
+  void setThreadPriority(int priority)
+  {
+    int p = THREAD_PRIORITY_NORMAL;
+    if      (priority < 0) p = THREAD_PRIORITY_BELOW_NORMAL;
+    else if (priority > 0) p = THREAD_PRIORITY_ABOVE_NORMAL;
+    if (!SetThreadPriority(GetCurrentThread(), p))
+      WARNING("SetThreadPriority failed"); // on purpose only a warning
+  }
+
   struct ThreadStartupData
   {
   public:
@@ -137,6 +171,11 @@ namespace embree
     CloseHandle(HANDLE(tid));
   }
 
+  /*! releases the given thread, its resources get freed once it terminated */
+  void detach(thread_t tid) {
+    CloseHandle(HANDLE(tid));
+  }
+
   /*! creates thread local storage */
   tls_t createTls() {
     return tls_t(size_t(TlsAlloc()));
@@ -170,6 +209,9 @@ namespace embree
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
 
 #if defined(__ANDROID__)
 #include <pthread.h>
@@ -220,6 +262,11 @@ namespace embree
           }
         }
       }
+
+      /* keep the threads of a NUMA node together, such that consecutive thread IDs share a memory controller */
+      std::stable_sort(threadIDs.begin(),threadIDs.end(),[] (size_t a, size_t b) {
+          return getNumaNodeOfCPU((unsigned int)a) < getNumaNodeOfCPU((unsigned int)b);
+        });
     }
 
     /* re-map threadIDs if mapping is available */
@@ -262,6 +309,52 @@ namespace embree
       WARNING("pthread_setaffinity_np failed to set affinity to thread "+std::to_string(threadID)); // on purpose only a warning
 #endif
   }
+
+  /*! restricts the calling thread to the logical threads of some NUMA node */
+  void setNumaAffinity(unsigned int node)
+  {
+#if !defined(__ANDROID__)
+    cpu_set_t set;
+    if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+      return;
+
+    cpu_set_t cset;
+    CPU_ZERO(&cset);
+    for (int i=0; i<CPU_SETSIZE; i++) {
+      if (CPU_ISSET(i,&set) && getNumaNodeOfCPU(i) == node)
+        CPU_SET(i,&cset);
+    }
+    if (CPU_COUNT(&cset) == 0)
+      return;
+
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cset), &cset) != 0)
+      WARNING("pthread_setaffinity_np failed to set affinity to NUMA node "+std::to_string(node)); // on purpose only a warning
+#endif
+  }
+
+  /*! restricts the calling thread to the given logical threads */
+  void setAffinityMask(const std::vector<size_t>& cpus)
+  {
+#if !defined(__ANDROID__)
+    cpu_set_t cset;
+    CPU_ZERO(&cset);
+    for (size_t i=0; i<cpus.size(); i++)
+      if (cpus[i] < CPU_SETSIZE) CPU_SET(cpus[i],&cset);
+    if (CPU_COUNT(&cset) == 0)
+      return;
+
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cset), &cset) != 0)
+      WARNING("pthread_setaffinity_np failed to set affinity mask"); // on purpose only a warning
+#endif
+  }
+
+  /*! sets the scheduling priority of the calling thread, Linux applies nice values per thread */
+  void setThreadPriority(int priority)
+  {
+    const int nice = priority < 0 ? 10 : priority > 0 ? -5 : 0;
+    if (setpriority(PRIO_PROCESS, (id_t) syscall(SYS_gettid), nice) != 0)
+      WARNING("setpriority failed to set thread priority "+std::to_string(priority)); // on purpose only a warning
+  }
 }
 #endif
 
@@ -285,6 +378,28 @@ namespace embree
     if (pthread_setaffinity_np(pthread_self(), sizeof(cset), &cset) != 0)
       WARNING("pthread_setaffinity_np failed"); // on purpose only a warning
   }
+
+  /*! NUMA topology is not queried on FreeBSD */
+  void setNumaAffinity(unsigned int node) {
+  }
+
+  /*! restricts the calling thread to the given logical threads */
+  void setAffinityMask(const std::vector<size_t>& cpus)
+  {
+    cpuset_t cset;
+    CPU_ZERO(&cset);
+    for (size_t i=0; i<cpus.size(); i++)
+      if (cpus[i] < CPU_SETSIZE) CPU_SET(cpus[i],&cset);
+    if (CPU_COUNT(&cset) == 0)
+      return;
+
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cset), &cset) != 0)
+      WARNING("pthread_setaffinity_np failed"); // on purpose only a warning
+  }
+
+  /*! thread priorities are not supported on FreeBSD */
+  void setThreadPriority(int priority) {
+  }
 }
 #endif
 
@@ -308,6 +423,18 @@ namespace embree
     if (thread_policy_set(mach_thread_self(),THREAD_AFFINITY_POLICY,(thread_policy_t)&ap,THREAD_AFFINITY_POLICY_COUNT) != KERN_SUCCESS)
       WARNING("setting thread affinity failed"); // on purpose only a warning
   }
+
+  /*! Mac OS X has no NUMA nodes */
+  void setNumaAffinity(unsigned int node) {
+  }
+
+  /*! Mac OS X does not support binding threads to logical threads */
+  void setAffinityMask(const std::vector<size_t>& cpus) {
+  }
+
+  /*! thread priorities are not supported on Mac OS X */
+  void setThreadPriority(int priority) {
+  }
 }
 #endif
 
@@ -404,6 +531,13 @@ namespace embree
     delete (pthread_t*)tid;
   }
 
+  /*! releases the given thread, its resources get freed once it terminated */
+  void detach(thread_t tid) {
+    if (pthread_detach(*(pthread_t*)tid) != 0)
+      FATAL("pthread_detach failed");
+    delete (pthread_t*)tid;
+  }
+
   /*! creates thread local storage */
   tls_t createTls()
   {
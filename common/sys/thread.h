@@ -36,12 +36,24 @@ namespace embree
   /*! set affinity of the calling thread */
   void setAffinity(ssize_t affinity);
 
+  /*! restricts the calling thread to the logical threads of some NUMA node */
+  void setNumaAffinity(unsigned int node);
+
+  /*! restricts the calling thread to the given logical threads */
+  void setAffinityMask(const std::vector<size_t>& cpus);
+
+  /*! sets the scheduling priority of the calling thread (-1 low, 0 normal, 1 high) */
+  void setThreadPriority(int priority);
+
   /*! the thread calling this function gets yielded */
   void yield();
 
   /*! waits until the given thread has terminated */
   void join(thread_t tid);
 
+  /*! releases the given thread, its resources get freed once it terminated */
+  void detach(thread_t tid);
+
   /*! type for handle to thread local storage */
   typedef struct opaque_tls_t* tls_t;
 
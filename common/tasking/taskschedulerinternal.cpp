@@ -24,6 +24,8 @@ namespace embree
   RTC_NAMESPACE_BEGIN
   
   static MutexSys g_mutex;
+  static MutexSys g_statistics_mutex;
+  static std::vector<TaskScheduler::ThreadStatistics> g_thread_statistics;
   size_t TaskScheduler::g_numThreads = 0;
   __thread TaskScheduler* TaskScheduler::g_instance = nullptr;
   std::vector<Ref<TaskScheduler>> g_instance_vector;
@@ -48,6 +50,7 @@ namespace embree
             body();
           }
         }
+        thread.statistics.yields++;
         yield();
       }
     }
@@ -150,8 +153,8 @@ namespace embree
     pool->thread_loop(threadIndex);
   }
 
-  TaskScheduler::ThreadPool::ThreadPool(bool set_affinity)
-    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), running(false) {}
+  TaskScheduler::ThreadPool::ThreadPool(bool set_affinity, const std::vector<size_t>& cpus, int priority)
+    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), cpus(cpus), priority(priority), running(false) {}
 
   dll_export void TaskScheduler::ThreadPool::startThreads()
   {
@@ -186,7 +189,7 @@ namespace embree
     {
       if (t == 0) continue;
       auto pair = new std::pair<TaskScheduler::ThreadPool*,size_t>(this,t);
-      threads.push_back(createThread((thread_func)threadPoolFunction,pair,4*1024*1024,set_affinity ? t : -1));
+      threads.push_back(createThread((thread_func)threadPoolFunction,pair,4*1024*1024,set_affinity && cpus.empty() ? t : -1));
     }
 
     /* stop some threads if we reduce the number of threads */
@@ -231,6 +234,14 @@ namespace embree
 
   void TaskScheduler::ThreadPool::thread_loop(size_t globalThreadIndex)
   {
+    /* restrict worker to the logical threads of the pool, with affinity each worker gets its own logical thread */
+    if (!cpus.empty()) {
+      if (set_affinity) setAffinityMask(std::vector<size_t>(1,cpus[globalThreadIndex % cpus.size()]));
+      else              setAffinityMask(cpus);
+    }
+    if (priority != 0)
+      setThreadPriority(priority);
+
     while (globalThreadIndex < numThreadsRunning)
     {
       Ref<TaskScheduler> scheduler = NULL;
@@ -246,8 +257,8 @@ namespace embree
     }
   }
 
-  TaskScheduler::TaskScheduler()
-    : threadCounter(0), anyTasksRunning(0), hasRootTask(false)
+  TaskScheduler::TaskScheduler(ThreadPool* threadArena)
+    : threadCounter(0), anyTasksRunning(0), hasRootTask(false), threadArena(threadArena)
   {
     threadLocal.resize(2*getNumberOfLogicalThreads()); // FIXME: this has to be 2x as in the compatibility join mode with rtcCommitScene the worker threads also join. When disallowing rtcCommitScene to join a build we can remove the 2x.
     for (size_t i=0; i<threadLocal.size(); i++)
@@ -273,8 +284,11 @@ namespace embree
     else        return 0;
   }
 
-  dll_export size_t TaskScheduler::threadCount() {
-    return threadPool->size();
+  dll_export size_t TaskScheduler::threadCount()
+  {
+    Thread* thread = TaskScheduler::thread();
+    if (thread) return thread->scheduler->getThreadPool()->size();
+    else        return threadPool->size();
   }
 
   dll_export TaskScheduler* TaskScheduler::instance()
@@ -364,6 +378,7 @@ namespace embree
     }
     threadLocal[threadIndex].store(nullptr);
     swapThread(oldThread);
+    addThreadStatistics(thread);
 
     /* remember exception to throw */
     std::exception_ptr except = nullptr;
@@ -394,33 +409,61 @@ namespace embree
     const size_t threadIndex = thread.threadIndex;
     const size_t threadCount = this->threadCounter;
 
-    for (size_t i=1; i<threadCount; i++)
+    /* first probe threads sharing our cache cluster, then threads of
+     * our NUMA node, and finally the remaining threads starting at a
+     * random thread to not have all threads probe the same victims */
+    for (int level=ThreadStatistics::CLUSTER; level<=ThreadStatistics::REMOTE; level++)
     {
-      pause_cpu(32);
-      size_t otherThreadIndex = threadIndex+i;
-      if (otherThreadIndex >= threadCount) otherThreadIndex -= threadCount;
-
-      Thread* othread = threadLocal[otherThreadIndex].load();
-      if (!othread)
-        continue;
-
-      if (othread->tasks.steal(thread))
-        return true;
+      const size_t start = level == ThreadStatistics::REMOTE ? thread.random() : 0;
+      for (size_t i=0; i<threadCount; i++)
+      {
+        const size_t otherThreadIndex = (threadIndex+start+i) % threadCount;
+        if (otherThreadIndex == threadIndex) continue;
+
+        Thread* othread = threadLocal[otherThreadIndex].load();
+        if (!othread)
+          continue;
+
+        const bool sameCluster = othread->cluster == thread.cluster && othread->numaNode == thread.numaNode;
+        const bool sameNode = othread->numaNode == thread.numaNode;
+        if (level == ThreadStatistics::CLUSTER && !sameCluster) continue;
+        if (level == ThreadStatistics::NODE && (sameCluster || !sameNode)) continue;
+        if (level == ThreadStatistics::REMOTE && sameNode) continue;
+
+        pause_cpu(32);
+        if (othread->tasks.steal(thread)) {
+          thread.statistics.steals[level]++;
+          return true;
+        }
+      }
     }
 
+    thread.statistics.failedSteals++;
     return false;
   }
 
-  dll_export void TaskScheduler::startThreads() {
-    threadPool->startThreads();
+  dll_export TaskScheduler::ThreadPool* TaskScheduler::getGlobalThreadPool() {
+    return threadPool;
   }
 
-  dll_export void TaskScheduler::addScheduler(const Ref<TaskScheduler>& scheduler) {
-    threadPool->add(scheduler);
+  dll_export void TaskScheduler::addThreadStatistics(const Thread& thread)
+  {
+    Lock<MutexSys> lock(g_statistics_mutex);
+    if (thread.threadIndex >= g_thread_statistics.size())
+      g_thread_statistics.resize(thread.threadIndex+1);
+    g_thread_statistics[thread.threadIndex] += thread.statistics;
   }
 
-  dll_export void TaskScheduler::removeScheduler(const Ref<TaskScheduler>& scheduler) {
-    threadPool->remove(scheduler);
+  dll_export std::vector<TaskScheduler::ThreadStatistics> TaskScheduler::getThreadStatistics()
+  {
+    Lock<MutexSys> lock(g_statistics_mutex);
+    return g_thread_statistics;
+  }
+
+  dll_export void TaskScheduler::resetThreadStatistics()
+  {
+    Lock<MutexSys> lock(g_statistics_mutex);
+    g_thread_statistics.clear();
   }
 
   RTC_NAMESPACE_END
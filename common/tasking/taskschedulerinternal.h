@@ -24,6 +24,7 @@
 #include "../sys/condition.h"
 #include "../sys/ref.h"
 #include "../sys/atomic.h"
+#include "../sys/sysinfo.h"
 #include "../math/range.h"
 #include "../../include/embree3/rtcore.h"
 
@@ -176,28 +177,68 @@ namespace embree
       size_t stackPtr;
     };
 
+    /*! work stealing statistics of a thread */
+    struct ThreadStatistics
+    {
+      /*! locality of the victim thread relative to the stealing thread */
+      enum { CLUSTER, NODE, REMOTE };
+
+      ThreadStatistics ()
+        : steals{0,0,0}, failedSteals(0), yields(0) {}
+
+      ThreadStatistics& operator+= (const ThreadStatistics& other)
+      {
+        for (size_t i=0; i<3; i++) steals[i] += other.steals[i];
+        failedSteals += other.failedSteals;
+        yields += other.yields;
+        return *this;
+      }
+
+      size_t steals[3];                //!< tasks stolen from threads of the same cache cluster, of the same NUMA node, and of other NUMA nodes
+      size_t failedSteals;             //!< steal attempts that found no task at any other thread
+      size_t yields;                   //!< number of times the thread yielded as there was no work to steal
+    };
+
     /*! thread local structure for each thread */
     struct Thread
     {
       ALIGNED_STRUCT_(64);
 
       Thread (size_t threadIndex, const Ref<TaskScheduler>& scheduler)
-      : threadIndex(threadIndex), task(nullptr), scheduler(scheduler) {}
+      : threadIndex(threadIndex), task(nullptr), scheduler(scheduler), randomState(2654435761u*(unsigned int)(threadIndex+1))
+      {
+        const unsigned int cpu = getCurrentCPU();
+        cluster = getCacheClusterOfCPU(cpu);
+        numaNode = getNumaNodeOfCPU(cpu);
+      }
 
       __forceinline size_t threadCount() {
         return scheduler->threadCounter;
       }
 
+      /*! xorshift random number generator to select victims for stealing */
+      __forceinline unsigned int random()
+      {
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 17;
+        randomState ^= randomState << 5;
+        return randomState;
+      }
+
       size_t threadIndex;              //!< ID of this thread
       TaskQueue tasks;                 //!< local task queue
       Task* task;                      //!< current active task
       Ref<TaskScheduler> scheduler;     //!< pointer to task scheduler
+      unsigned int cluster;            //!< cache cluster the thread runs on
+      unsigned int numaNode;           //!< NUMA node the thread runs on
+      unsigned int randomState;        //!< state of random number generator
+      ThreadStatistics statistics;     //!< work stealing statistics
     };
 
     /*! pool of worker threads */
     struct ThreadPool
     {
-      ThreadPool (bool set_affinity);
+      ThreadPool (bool set_affinity, const std::vector<size_t>& cpus = std::vector<size_t>(), int priority = 0);
       ~ThreadPool ();
 
       /*! starts the threads */
@@ -222,6 +263,8 @@ namespace embree
       std::atomic<size_t> numThreads;
       std::atomic<size_t> numThreadsRunning;
       bool set_affinity;
+      std::vector<size_t> cpus;        //!< logical threads the worker threads are restricted to, all if empty
+      int priority;                    //!< scheduling priority of the worker threads
       std::atomic<bool> running;
       std::vector<thread_t> threads;
 
@@ -231,7 +274,7 @@ namespace embree
       std::list<Ref<TaskScheduler> > schedulers;
     };
 
-    TaskScheduler ();
+    TaskScheduler (ThreadPool* threadArena = nullptr);
     ~TaskScheduler ();
 
     /*! initializes the task scheduler */
@@ -263,7 +306,7 @@ namespace embree
     template<typename Closure>
       void spawn_root(const Closure& closure, size_t size = 1, bool useThreadPool = true)
     {
-      if (useThreadPool) startThreads();
+      if (useThreadPool) getThreadPool()->startThreads();
 
       size_t threadIndex = allocThreadIndex();
       std::unique_ptr<Thread> mthread(new Thread(threadIndex,this)); // too large for stack allocation
@@ -279,14 +322,15 @@ namespace embree
         condition.notify_all();
       }
 
-      if (useThreadPool) addScheduler(this);
+      if (useThreadPool) getThreadPool()->add(this);
 
       while (thread.tasks.execute_local(thread,nullptr));
       anyTasksRunning--;
-      if (useThreadPool) removeScheduler(this);
+      if (useThreadPool) getThreadPool()->remove(this);
 
       threadLocal[threadIndex] = nullptr;
       swapThread(oldThread);
+      addThreadStatistics(thread);
 
       /* remember exception to throw */
       std::exception_ptr except = nullptr;
@@ -345,6 +389,12 @@ namespace embree
     /* returns the total number of threads */
     dll_export static size_t threadCount();
 
+    /* returns the accumulated work stealing statistics of each thread index */
+    dll_export static std::vector<ThreadStatistics> getThreadStatistics();
+
+    /* clears the work stealing statistics */
+    dll_export static void resetThreadStatistics();
+
   private:
 
     /* returns the thread local task list of this worker thread */
@@ -356,14 +406,16 @@ namespace embree
     /*! returns the taskscheduler object to be used by the master thread */
     dll_export static TaskScheduler* instance();
 
-    /*! starts the threads */
-    dll_export static void startThreads();
+    /*! returns the thread pool that executes the tasks of this scheduler */
+    __forceinline ThreadPool* getThreadPool() {
+      return threadArena ? threadArena : getGlobalThreadPool();
+    }
 
-    /*! adds a task scheduler object for scheduling */
-    dll_export static void addScheduler(const Ref<TaskScheduler>& scheduler);
+    /*! returns the thread pool shared by all schedulers without own thread arena */
+    dll_export static ThreadPool* getGlobalThreadPool();
 
-    /*! remove the task scheduler object again */
-    dll_export static void removeScheduler(const Ref<TaskScheduler>& scheduler);
+    /*! accumulates the work stealing statistics of a thread that leaves the scheduler */
+    dll_export static void addThreadStatistics(const Thread& thread);
 
   private:
     std::vector<atomic<Thread*>> threadLocal;
@@ -371,6 +423,7 @@ namespace embree
     std::atomic<size_t> anyTasksRunning;
     std::atomic<bool> hasRootTask;
     std::exception_ptr cancellingException;
+    ThreadPool* threadArena;            //!< thread pool owned by the device, or nullptr to use the global pool
     MutexSys mutex;
     ConditionSys condition;
 
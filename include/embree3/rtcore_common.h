@@ -185,7 +185,8 @@ enum RTCIntersectContextFlags
 {
   RTC_INTERSECT_CONTEXT_FLAG_NONE       = 0,
   RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT = (0 << 0), // optimize for incoherent rays
-  RTC_INTERSECT_CONTEXT_FLAG_COHERENT   = (1 << 0)  // optimize for coherent rays
+  RTC_INTERSECT_CONTEXT_FLAG_COHERENT   = (1 << 0), // optimize for coherent rays
+  RTC_INTERSECT_CONTEXT_FLAG_REORDER    = (1 << 1)  // reorder incoherent rays into coherent packets
 };
 
 /* Arguments for RTCFilterFunctionN */
@@ -325,5 +326,33 @@ struct RTC_ALIGN(16) RTCPointQueryFunctionArguments
 };
 
 typedef bool (*RTCPointQueryFunction)(struct RTCPointQueryFunctionArguments* args);
+
+/* Closest point hit of the built-in closest point queries */
+struct RTC_ALIGN(16) RTCClosestPointHit
+{
+  float u;               // barycentric u coordinate of the closest point
+  float v;               // barycentric v coordinate of the closest point
+  unsigned int primID;   // primitive ID of the closest point
+  unsigned int geomID;   // geometry ID of the closest point
+  unsigned int instID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // instance ID of the closest point
+};
+
+/* Search modes of the built-in nearest point queries */
+enum RTCNearestPointsMode
+{
+  RTC_NEAREST_POINTS_MODE_KNN    = 0, // finds the k nearest primitives within the query radius
+  RTC_NEAREST_POINTS_MODE_RADIUS = 1  // finds all primitives within the query radius, reports if more than k got found
+};
+
+/* Hit of the built-in k-nearest and radius search point queries */
+struct RTC_ALIGN(16) RTCNearestPointHit
+{
+  float distance;        // distance of the query point to the primitive
+  float u;               // barycentric u coordinate of the closest point on the primitive
+  float v;               // barycentric v coordinate of the closest point on the primitive
+  unsigned int primID;   // primitive ID
+  unsigned int geomID;   // geometry ID
+  unsigned int instID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // instance ID
+};
   
 RTC_NAMESPACE_END
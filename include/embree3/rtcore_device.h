@@ -59,7 +59,17 @@ enum RTCDeviceProperty
 
   RTC_DEVICE_PROPERTY_TASKING_SYSTEM        = 128,
   RTC_DEVICE_PROPERTY_JOIN_COMMIT_SUPPORTED = 129,
-  RTC_DEVICE_PROPERTY_PARALLEL_COMMIT_SUPPORTED = 130
+  RTC_DEVICE_PROPERTY_PARALLEL_COMMIT_SUPPORTED = 130,
+
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE     = 160,
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HIT_RATE = 161,
+
+  RTC_DEVICE_PROPERTY_REFIT_REBUILD_COUNT       = 192,
+  RTC_DEVICE_PROPERTY_INCREMENTAL_UPDATE_COUNT  = 193,
+  RTC_DEVICE_PROPERTY_TASK_STEAL_COUNT          = 194,
+  RTC_DEVICE_PROPERTY_TASK_FAILED_STEAL_COUNT   = 195,
+  RTC_DEVICE_PROPERTY_TASK_YIELD_COUNT          = 196,
+  RTC_DEVICE_PROPERTY_HUGE_PAGE_BVH_BYTES       = 197
 };
 
 /* Gets a device property. */
@@ -66,6 +66,21 @@ RTC_API void rtcCommitScene(RTCScene scene);
 /* Commits the scene from multiple threads. */
 RTC_API void rtcJoinCommitScene(RTCScene scene);
 
+/* Commit complete callback function */
+typedef void (*RTCCommitCompleteFunction)(void* userPtr, RTCScene scene);
+
+/* Commits the scene in the background while queries keep using the previously committed state. */
+RTC_API void rtcCommitSceneAsync(RTCScene scene, RTCCommitCompleteFunction complete, void* userPtr);
+
+/* Waits until an asynchronous scene commit finished. */
+RTC_API void rtcWaitCommitScene(RTCScene scene);
+
+/* Writes the acceleration structures of a committed scene to a BVH cache file. */
+RTC_API void rtcSaveSceneBVH(RTCScene scene, const char* filename);
+
+/* Commits the scene by loading its acceleration structures from a BVH cache file. */
+RTC_API void rtcLoadSceneBVH(RTCScene scene, const char* filename);
+
 
 /* Progress monitor callback function */
 typedef bool (*RTCProgressMonitorFunction)(void* ptr, double n);
@@ -100,6 +115,21 @@ RTC_API bool rtcPointQuery8(const int* valid, RTCScene scene, struct RTCPointQue
 /* Perform a closest point query with a packet of 4 points with the scene. */
 RTC_API bool rtcPointQuery16(const int* valid, RTCScene scene, struct RTCPointQuery16* query, struct RTCPointQueryContext* context, RTCPointQueryFunction queryFunc, void** userPtr);
 
+/* Perform a closest point query with a stream of M query points with the scene. */
+RTC_API bool rtcPointQuery1M(RTCScene scene, struct RTCPointQuery* query, unsigned int M, size_t byteStride, struct RTCPointQueryContext* context, RTCPointQueryFunction queryFunc, void** userPtr);
+
+/* Finds the closest point on the triangles, quads, and grids of the scene using the built-in closest point kernels. */
+RTC_API bool rtcClosestPoint(RTCScene scene, struct RTCPointQuery* query, struct RTCPointQueryContext* context, struct RTCClosestPointHit* hit);
+
+/* Finds the closest points for a stream of M query points using the built-in closest point kernels. */
+RTC_API bool rtcClosestPoint1M(RTCScene scene, struct RTCPointQuery* query, unsigned int M, size_t byteStride, struct RTCPointQueryContext* context, struct RTCClosestPointHit* hit);
+
+/* Finds the up to k nearest primitives within the query radius, sorted by increasing distance. Returns the number of primitives found, radius searches return k+1 if more than k primitives are within the radius. */
+RTC_API unsigned int rtcNearestPoints(RTCScene scene, struct RTCPointQuery* query, struct RTCPointQueryContext* context, enum RTCNearestPointsMode mode, unsigned int k, struct RTCNearestPointHit* hits);
+
+/* Finds the up to k nearest primitives for a stream of M query points, the hits of query i are stored at hits+i*k. */
+RTC_API void rtcNearestPoints1M(RTCScene scene, struct RTCPointQuery* query, unsigned int M, size_t byteStride, struct RTCPointQueryContext* context, enum RTCNearestPointsMode mode, unsigned int k, struct RTCNearestPointHit* hits, unsigned int* numHits);
+
 /* Intersects a single ray with the scene. */
 RTC_API void rtcIntersect1(RTCScene scene, struct RTCIntersectContext* context, struct RTCRayHit* rayhit);
 
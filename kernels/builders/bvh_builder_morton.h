@@ -64,16 +64,11 @@ namespace embree
       /*! Build primitive consisting of morton code and primitive ID. */
       struct __aligned(8) BuildPrim
       {
-        union {
-          struct {
-            unsigned int code;     //!< morton code
-            unsigned int index;    //!< i'th primitive
-          };
-          uint64_t t;
-        };
+        uint64_t code;         //!< morton code
+        unsigned int index;    //!< i'th primitive
 
         /*! interface for radix sort */
-        __forceinline operator unsigned() const { return code; }
+        __forceinline operator uint64_t() const { return code; }
 
         /*! interface for standard sort */
         __forceinline bool operator<(const BuildPrim &m) const { return code < m.code; }
@@ -82,7 +77,7 @@ namespace embree
       /*! maps bounding box to morton code */
       struct MortonCodeMapping
       {
-        static const size_t LATTICE_BITS_PER_DIM = 10;
+        static const size_t LATTICE_BITS_PER_DIM = 21;
         static const size_t LATTICE_SIZE_PER_DIM = size_t(1) << LATTICE_BITS_PER_DIM;
 
         vfloat4 base;
@@ -103,20 +98,18 @@ namespace embree
           return vint4((centroid-base)*scale);
         }
 
-        __forceinline unsigned int code (const BBox3fa& box) const
+        __forceinline uint64_t code (const BBox3fa& box) const
         {
           const vint4 binID = bin(box);
-          const unsigned int x = extract<0>(binID);
-          const unsigned int y = extract<1>(binID);
-          const unsigned int z = extract<2>(binID);
-          const unsigned int xyz = bitInterleave(x,y,z);
+          const uint64_t x = (unsigned int) extract<0>(binID);
+          const uint64_t y = (unsigned int) extract<1>(binID);
+          const uint64_t z = (unsigned int) extract<2>(binID);
+          const uint64_t xyz = bitInterleave64(x,y,z);
           return xyz;
         }
       };
 
-#if defined (__AVX2__)
-
-      /*! for AVX2 there is a fast scalar bitInterleave */
+      /*! generates morton codes for a sequence of primitives */
       struct MortonCodeGenerator
       {
         __forceinline MortonCodeGenerator(const MortonCodeMapping& mapping, BuildPrim* dest)
@@ -132,58 +125,8 @@ namespace embree
       public:
         const MortonCodeMapping mapping;
         BuildPrim* dest;
-        size_t currentID;
       };
 
-#else
-
-      /*! before AVX2 is it better to use the SSE version of bitInterleave */
-      struct MortonCodeGenerator
-      {
-        __forceinline MortonCodeGenerator(const MortonCodeMapping& mapping, BuildPrim* dest)
-          : mapping(mapping), dest(dest), currentID(0), slots(0), ax(0), ay(0), az(0), ai(0) {}
-
-        __forceinline ~MortonCodeGenerator()
-        {
-          if (slots != 0)
-          {
-            const vint4 code = bitInterleave(ax,ay,az);
-            for (size_t i=0; i<slots; i++) {
-              dest[currentID-slots+i].index = ai[i];
-              dest[currentID-slots+i].code = code[i];
-            }
-          }
-        }
-
-        __forceinline void operator() (const BBox3fa& b, const unsigned index)
-        {
-          const vint4 binID = mapping.bin(b);
-          ax[slots] = extract<0>(binID);
-          ay[slots] = extract<1>(binID);
-          az[slots] = extract<2>(binID);
-          ai[slots] = index;
-          slots++;
-          currentID++;
-
-          if (slots == 4)
-          {
-            const vint4 code = bitInterleave(ax,ay,az);
-            vint4::storeu(&dest[currentID-4],unpacklo(code,ai));
-            vint4::storeu(&dest[currentID-2],unpackhi(code,ai));
-            slots = 0;
-          }
-        }
-
-      public:
-        const MortonCodeMapping mapping;
-        BuildPrim* dest;
-        size_t currentID;
-        size_t slots;
-        vint4 ax, ay, az, ai;
-      };
-
-#endif
-
       template<
         typename ReductionTy,
         typename Allocator,
@@ -316,42 +259,42 @@ namespace embree
 #if defined(TASKING_TBB)
             tbb::parallel_sort(morton+current.begin(),morton+current.end());
 #else
-            radixsort32(morton+current.begin(),current.size());
+            std::sort(morton+current.begin(),morton+current.end());
 #endif
           }
         }
 
         __forceinline void split(const range<unsigned>& current, range<unsigned>& left, range<unsigned>& right) const
         {
-          const unsigned int code_start = morton[current.begin()].code;
-          const unsigned int code_end   = morton[current.end()-1].code;
-          unsigned int bitpos = lzcnt(code_start^code_end);
+          const uint64_t code_start = morton[current.begin()].code;
+          const uint64_t code_end   = morton[current.end()-1].code;
+          uint64_t code_diff = code_start^code_end;
 
           /* if all items mapped to same morton code, then re-create new morton codes for the items */
-          if (unlikely(bitpos == 32))
+          if (unlikely(code_diff == 0))
           {
             recreateMortonCodes(current);
-            const unsigned int code_start = morton[current.begin()].code;
-            const unsigned int code_end   = morton[current.end()-1].code;
-            bitpos = lzcnt(code_start^code_end);
+            const uint64_t code_start = morton[current.begin()].code;
+            const uint64_t code_end   = morton[current.end()-1].code;
+            code_diff = code_start^code_end;
 
             /* if the morton code is still the same, goto fall back split */
-            if (unlikely(bitpos == 32)) {
+            if (unlikely(code_diff == 0)) {
               current.split(left,right);
               return;
             }
           }
 
           /* split the items at the topmost different morton code bit */
-          const unsigned int bitpos_diff = 31-bitpos;
-          const unsigned int bitmask = 1 << bitpos_diff;
+          const size_t bitpos_diff = bsr(size_t(code_diff));
+          const uint64_t bitmask = uint64_t(1) << bitpos_diff;
 
           /* find location where bit differs using binary search */
           unsigned begin = current.begin();
           unsigned end   = current.end();
           while (begin + 1 != end) {
             const unsigned mid = (begin+end)/2;
-            const unsigned bit = morton[mid].code & bitmask;
+            const uint64_t bit = morton[mid].code & bitmask;
             if (bit == 0) begin = mid; else end = mid;
           }
           unsigned center = end;
@@ -448,7 +391,7 @@ namespace embree
         {
           /* sort morton codes */
           morton = src;
-          radix_sort_u32(src,tmp,numPrimitives,singleThreadThreshold);
+          radix_sort_u64(src,tmp,numPrimitives,singleThreadThreshold);
 
           /* build BVH */
           const ReductionTy root = recurse(1, range<unsigned>(0,(unsigned)numPrimitives), nullptr, true);
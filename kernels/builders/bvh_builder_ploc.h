@@ -0,0 +1,371 @@
+// ======================================================================== //
+// Copyright 2009-2020 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "bvh_builder_morton.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Parallel locally-ordered clustering builder. Primitives are
+     *  sorted along their morton codes and then agglomerated bottom-up
+     *  by repeatedly merging clusters that are mutual nearest
+     *  neighbours (smallest merged surface area) within a small
+     *  window of the sorted cluster list. The resulting binary tree
+     *  is collapsed into an N-ary BVH using the same callbacks as the
+     *  morton builder. */
+    struct BVHBuilderPLOC
+    {
+      static const size_t MAX_BRANCHING_FACTOR = BVHBuilderMorton::MAX_BRANCHING_FACTOR;
+      static const size_t MIN_LARGE_LEAF_LEVELS = BVHBuilderMorton::MIN_LARGE_LEAF_LEVELS;
+      static const size_t SEARCH_RADIUS = 8;                 //!< number of neighbours searched to the left and right of each cluster
+
+      typedef BVHBuilderMorton::BuildPrim BuildPrim;
+      typedef BVHBuilderMorton::Settings Settings;
+
+      /*! node of the binary cluster tree */
+      struct Cluster
+      {
+        BBox3fa bounds;     //!< bounds of all primitives of the cluster
+        unsigned left;      //!< ID of left child cluster, or -1 for primitive clusters
+        unsigned right;     //!< ID of right child cluster, or -1 for primitive clusters
+        unsigned begin;     //!< first primitive of the cluster
+        unsigned size;      //!< number of primitives of the cluster
+
+        __forceinline bool isLeaf() const { return left == unsigned(-1); }
+      };
+
+      template<
+        typename ReductionTy,
+        typename Allocator,
+        typename CreateAllocator,
+        typename CreateNodeFunc,
+        typename SetNodeBoundsFunc,
+        typename CreateLeafFunc,
+        typename CalculateBounds,
+        typename ProgressMonitor>
+
+        class BuilderT : private Settings
+      {
+        ALIGNED_CLASS_(16);
+
+        typedef BVHBuilderMorton::BuilderT<
+          ReductionTy,
+          Allocator,
+          CreateAllocator,
+          CreateNodeFunc,
+          SetNodeBoundsFunc,
+          CreateLeafFunc,
+          CalculateBounds,
+          ProgressMonitor> LeafBuilder;
+
+      public:
+
+        BuilderT (CreateAllocator& createAllocator,
+                  CreateNodeFunc& createNode,
+                  SetNodeBoundsFunc& setBounds,
+                  CreateLeafFunc& createLeaf,
+                  CalculateBounds& calculateBounds,
+                  ProgressMonitor& progressMonitor,
+                  const Settings& settings)
+
+          : Settings(settings),
+          createAllocator(createAllocator),
+          createNode(createNode),
+          setBounds(setBounds),
+          calculateBounds(calculateBounds),
+          progressMonitor(progressMonitor),
+          leafBuilder(createAllocator,createNode,setBounds,createLeaf,calculateBounds,progressMonitor,settings),
+          morton(nullptr) {}
+
+        /*! agglomerates the sorted primitives into a binary cluster tree and returns the root cluster */
+        unsigned cluster(size_t numPrimitives)
+        {
+          clusters.resize(2*numPrimitives-1);
+          active.resize(numPrimitives);
+          neighbour.resize(numPrimitives);
+
+          /* every primitive starts as its own cluster */
+          parallel_for(size_t(0), numPrimitives, size_t(1024), [&] (const range<size_t>& r) {
+              for (size_t i=r.begin(); i<r.end(); i++)
+              {
+                Cluster& c = clusters[i];
+                c.bounds = calculateBounds(morton[i]);
+                c.left = c.right = unsigned(-1);
+                c.begin = unsigned(i);
+                c.size = 1;
+                active[i] = unsigned(i);
+              }
+            });
+
+          std::atomic<unsigned> numClusters((unsigned)numPrimitives);
+          size_t numActive = numPrimitives;
+
+          while (numActive > 1)
+          {
+            /* find nearest neighbour of each cluster in the search window */
+            parallel_for(size_t(0), numActive, size_t(1024), [&] (const range<size_t>& r) {
+                for (size_t i=r.begin(); i<r.end(); i++)
+                {
+                  const BBox3fa bounds = clusters[active[i]].bounds;
+                  const size_t begin = i > SEARCH_RADIUS ? i-SEARCH_RADIUS : 0;
+                  const size_t end = min(i+SEARCH_RADIUS+1,numActive);
+                  float bestArea = pos_inf;
+                  size_t bestIndex = i;
+                  for (size_t j=begin; j<end; j++)
+                  {
+                    if (j == i) continue;
+                    const float area = halfArea(embree::merge(bounds,clusters[active[j]].bounds));
+                    if (area < bestArea || (area == bestArea && tieBreak(i,j) < tieBreak(i,bestIndex))) { bestArea = area; bestIndex = j; }
+                  }
+                  neighbour[i] = unsigned(bestIndex);
+                }
+              });
+
+            /* merge all pairs of mutual nearest neighbours */
+            parallel_for(size_t(0), numActive, size_t(1024), [&] (const range<size_t>& r) {
+                for (size_t i=r.begin(); i<r.end(); i++)
+                {
+                  const size_t j = neighbour[i];
+                  if (j <= i || neighbour[j] != i) continue;
+                  active[i] = merge(active[i],active[j],numClusters.fetch_add(1));
+                  active[j] = unsigned(-1);
+                }
+              });
+
+            /* compact the list of active clusters */
+            size_t numMerged = 0;
+            for (size_t i=0; i<numActive; i++)
+            {
+              if (active[i] == unsigned(-1)) continue;
+              active[numMerged++] = active[i];
+            }
+
+            /* force progress by greedily merging neighbouring clusters in case no mutual neighbours were found */
+            if (unlikely(numMerged == numActive))
+            {
+              for (size_t i=0; i+1<numActive; i+=2)
+                active[i/2] = merge(active[i],active[i+1],numClusters.fetch_add(1));
+              if (numActive & 1) active[numActive/2] = active[numActive-1];
+              numMerged = (numActive+1)/2;
+            }
+            numActive = numMerged;
+          }
+
+          /* parents always have larger IDs than their children, thus assign primitive ranges top-down in decreasing ID order */
+          const unsigned root = active[0];
+          assert(root == numClusters-1);
+          clusters[root].begin = 0;
+          for (size_t i=root; i>=numPrimitives; i--)
+          {
+            const Cluster& c = clusters[i];
+            clusters[c.left ].begin = c.begin;
+            clusters[c.right].begin = c.begin + clusters[c.left].size;
+          }
+          return root;
+        }
+
+        /*! symmetric order of cluster pairs with equal merged area,
+         *  prefers close pairs and pairs starting at an even index
+         *  such that equal areas still form many mutual neighbours */
+        static __forceinline size_t tieBreak(size_t i, size_t j)
+        {
+          const size_t lo = min(i,j), hi = max(i,j);
+          return 2*(hi-lo) + (lo & 1);
+        }
+
+        __forceinline unsigned merge(unsigned left, unsigned right, unsigned id)
+        {
+          Cluster& c = clusters[id];
+          c.bounds = embree::merge(clusters[left].bounds,clusters[right].bounds);
+          c.left = left;
+          c.right = right;
+          c.begin = 0;
+          c.size = clusters[left].size + clusters[right].size;
+          return id;
+        }
+
+        ReductionTy recurse(size_t depth, unsigned id, Allocator alloc, bool toplevel)
+        {
+          /* get thread local allocator */
+          if (!alloc)
+            alloc = createAllocator();
+
+          const Cluster& current = clusters[id];
+          const range<unsigned> prims(current.begin,current.begin+current.size);
+
+          /* call memory monitor function to signal progress */
+          if (toplevel && current.size <= singleThreadThreshold)
+            progressMonitor(current.size);
+
+          /* create leaf node */
+          if (unlikely(depth+MIN_LARGE_LEAF_LEVELS >= maxDepth || current.size <= minLeafSize || current.isLeaf()))
+            return leafBuilder.createLargeLeaf(depth,prims,alloc);
+
+          /* fill all children by always opening the one with the largest surface area */
+          unsigned children[MAX_BRANCHING_FACTOR];
+          children[0] = current.left;
+          children[1] = current.right;
+          size_t numChildren = 2;
+
+          while (numChildren < branchingFactor)
+          {
+            /* find best child with largest surface area */
+            int bestChild = -1;
+            float bestArea = neg_inf;
+            for (unsigned int i=0; i<numChildren; i++)
+            {
+              /* ignore leaves as they cannot get opened */
+              const Cluster& c = clusters[children[i]];
+              if (c.isLeaf() || c.size <= minLeafSize)
+                continue;
+
+              /* remember child with largest area */
+              const float area = halfArea(c.bounds);
+              if (area > bestArea) {
+                bestArea = area;
+                bestChild = i;
+              }
+            }
+            if (bestChild == -1) break;
+
+            /*! replace best child by its left and right child */
+            const Cluster& best = clusters[children[bestChild]];
+            children[bestChild] = children[numChildren-1];
+            children[numChildren-1] = best.left;
+            children[numChildren+0] = best.right;
+            numChildren++;
+          }
+
+          /* allocate node */
+          auto node = createNode(alloc,numChildren);
+
+          /* process top parts of tree parallel */
+          ReductionTy bounds[MAX_BRANCHING_FACTOR];
+          if (current.size > singleThreadThreshold)
+          {
+            /*! parallel_for is faster than spawing sub-tasks */
+            parallel_for(size_t(0), numChildren, [&] (const range<size_t>& r) {
+                for (size_t i=r.begin(); i<r.end(); i++) {
+                  bounds[i] = recurse(depth+1,children[i],nullptr,true);
+                  _mm_mfence(); // to allow non-temporal stores during build
+                }
+              });
+          }
+
+          /* finish tree sequentially */
+          else
+          {
+            for (size_t i=0; i<numChildren; i++)
+              bounds[i] = recurse(depth+1,children[i],alloc,false);
+          }
+
+          return setBounds(node,bounds,numChildren);
+        }
+
+        /* build function */
+        ReductionTy build(BuildPrim* src, BuildPrim* tmp, size_t numPrimitives)
+        {
+          /* the morton builder handles the trivial cases */
+          if (numPrimitives < 2)
+            return leafBuilder.build(src,tmp,numPrimitives);
+
+          /* sort morton codes */
+          morton = leafBuilder.morton = src;
+          radix_sort_u64(src,tmp,numPrimitives,singleThreadThreshold);
+
+          /* build cluster tree */
+          const unsigned root = cluster(numPrimitives);
+
+          /* reorder primitives to match the leaf order of the cluster tree */
+          parallel_for(size_t(0), numPrimitives, size_t(1024), [&] (const range<size_t>& r) {
+              for (size_t i=r.begin(); i<r.end(); i++)
+                tmp[clusters[i].begin] = src[i];
+            });
+          parallel_for(size_t(0), numPrimitives, size_t(1024), [&] (const range<size_t>& r) {
+              for (size_t i=r.begin(); i<r.end(); i++)
+                src[i] = tmp[i];
+            });
+
+          /* build BVH */
+          const ReductionTy result = recurse(1, root, nullptr, true);
+          _mm_mfence(); // to allow non-temporal stores during build
+          clusters.clear();
+          active.clear();
+          neighbour.clear();
+          return result;
+        }
+
+      public:
+        CreateAllocator& createAllocator;
+        CreateNodeFunc& createNode;
+        SetNodeBoundsFunc& setBounds;
+        CalculateBounds& calculateBounds;
+        ProgressMonitor& progressMonitor;
+        LeafBuilder leafBuilder;
+
+      public:
+        BuildPrim* morton;
+        avector<Cluster> clusters;
+        avector<unsigned> active;     //!< IDs of the clusters that are not merged yet
+        avector<unsigned> neighbour;  //!< index of the nearest neighbour of each active cluster
+      };
+
+      template<
+      typename ReductionTy,
+        typename CreateAllocFunc,
+        typename CreateNodeFunc,
+        typename SetBoundsFunc,
+        typename CreateLeafFunc,
+        typename CalculateBoundsFunc,
+        typename ProgressMonitor>
+
+        static ReductionTy build(CreateAllocFunc createAllocator,
+                                 CreateNodeFunc createNode,
+                                 SetBoundsFunc setBounds,
+                                 CreateLeafFunc createLeaf,
+                                 CalculateBoundsFunc calculateBounds,
+                                 ProgressMonitor progressMonitor,
+                                 BuildPrim* src,
+                                 BuildPrim* tmp,
+                                 size_t numPrimitives,
+                                 const Settings& settings)
+        {
+          typedef BuilderT<
+            ReductionTy,
+            decltype(createAllocator()),
+            CreateAllocFunc,
+            CreateNodeFunc,
+            SetBoundsFunc,
+            CreateLeafFunc,
+            CalculateBoundsFunc,
+            ProgressMonitor> Builder;
+
+          Builder builder(createAllocator,
+                          createNode,
+                          setBounds,
+                          createLeaf,
+                          calculateBounds,
+                          progressMonitor,
+                          settings);
+
+          return builder.build(src,tmp,numPrimitives);
+        }
+    };
+  }
+}
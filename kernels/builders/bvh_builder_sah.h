@@ -138,12 +138,23 @@ namespace embree
             prims(prims),
             heuristic(heuristic),
             createAlloc(createAlloc), createNode(createNode), updateNode(updateNode), createLeaf(createLeaf),
-            progressMonitor(progressMonitor)
+            progressMonitor(progressMonitor), cancelled(false)
           {
             if (cfg.branchingFactor > MAX_BRANCHING_FACTOR)
               throw_RTCError(RTC_ERROR_UNKNOWN,"bvh_builder: branching factor too large");
           }
 
+          /*! signals progress, a build cancelled by the progress monitor is terminated by all other tasks at their next recursion step */
+          void progress(size_t dn)
+          {
+            try {
+              progressMonitor(dn);
+            } catch (...) {
+              cancelled.store(true,std::memory_order_relaxed);
+              throw;
+            }
+          }
+
           const ReductionTy createLargeLeaf(const BuildRecord& current, Allocator alloc)
           {
             /* this should never occur but is a fatal error */
@@ -213,9 +224,13 @@ namespace embree
             if (!alloc)
               alloc = createAlloc();
 
-            /* call memory monitor function to signal progress */
-            if (toplevel && current.size() <= cfg.singleThreadThreshold)
-              progressMonitor(current.size());
+            /* terminate early when some other task got cancelled */
+            if (unlikely(cancelled.load(std::memory_order_relaxed)))
+              throw_RTCError(RTC_ERROR_CANCELLED,"progress monitor forced termination");
+
+            /* call progress monitor function to signal progress, large tasks only give the monitor a chance to cancel the build */
+            if (toplevel)
+              progress(current.size() <= cfg.singleThreadThreshold ? current.size() : 0);
 
             /*! find best split */
             auto split = heuristic.find(current.prims,cfg.logBlockSize);
@@ -315,6 +330,7 @@ namespace embree
           const UpdateNodeFunc& updateNode;
           const CreateLeafFunc& createLeaf;
           const ProgressMonitor& progressMonitor;
+          std::atomic<bool> cancelled; //!< set when the progress monitor cancelled the build
         };
 
       template<
@@ -16,6 +16,8 @@
 
 #include "bvh.h"
 #include "bvh_statistics.h"
+#include "../geometry/instance.h"
+#include "../../common/sys/regression.h"
 
 namespace embree
 {
@@ -30,6 +32,7 @@ namespace embree
   template<int N>
   BVHN<N>::~BVHN ()
   {
+    clearReplicas();
     for (size_t i=0; i<objects.size(); i++) 
       delete objects[i];
   }
@@ -44,11 +47,151 @@ namespace embree
   template<int N>
   void BVHN<N>::set (NodeRef root, const LBBox3fa& bounds, size_t numPrimitives)
   {
+    clearReplicas();
     this->root = root;
     this->bounds = bounds;
     this->numPrimitives = numPrimitives;
   }	
 
+  template<int N>
+  size_t BVHN<N>::getHugePageBytes()
+  {
+    size_t bytes = alloc.getHugePageBytes();
+    for (size_t i=0; i<objects.size(); i++)
+      if (objects[i]) bytes += objects[i]->alloc.getHugePageBytes();
+    return bytes;
+  }
+
+  /* version of the BVH cache format, increase when node or primitive layouts change */
+  static const unsigned int BVH_CACHE_VERSION = 1;
+
+  template<int N>
+  size_t BVHN<N>::serialize(NodeRef node, std::vector<char>& buf) const
+  {
+    if (node == emptyNode)
+      return node;
+
+    if (node.isLeaf())
+    {
+      size_t num; const char* prims = node.leaf(num);
+      size_t bytes = 0;
+      for (size_t i=0; i<num; i++)
+        bytes += primTy->getBytes(prims+bytes);
+
+      const size_t ofs = (buf.size()+byteAlignment-1) & ~(byteAlignment-1);
+      buf.resize(ofs+bytes);
+      memcpy(&buf[ofs],prims,bytes);
+      return ofs | (node & items_mask);
+    }
+
+    size_t bytes;
+    if      (node.isAlignedNode()) bytes = sizeof(AlignedNode);
+    else if (node.isHalfNode()   ) bytes = sizeof(HalfNode);
+    else throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH node type does not support saving");
+
+    const size_t ofs = (buf.size()+63) & ~size_t(63);
+    buf.resize(ofs+bytes);
+    memcpy(&buf[ofs],node.baseNode(),bytes);
+    for (size_t i=0; i<N; i++) {
+      const size_t child = serialize(node.baseNode()->child(i),buf);
+      ((BaseNode*)&buf[ofs])->children[i] = NodeRef(child);
+    }
+    return ofs | (node & align_mask);
+  }
+
+  template<int N>
+  void BVHN<N>::relocate(NodeRef& node, char* base, size_t bytes)
+  {
+    if (node == emptyNode)
+      return;
+
+    const size_t ofs = node & ~align_mask;
+    if (ofs >= bytes)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH cache file is corrupted");
+    node = NodeRef((size_t)base + node);
+
+    /* all primitive blocks of a leaf have to lie inside the buffer */
+    if (node.isLeaf())
+    {
+      size_t num; const char* prims = node.leaf(num);
+      size_t leafBytes = 0;
+      for (size_t i=0; i<num; i++) {
+        if (ofs + leafBytes >= bytes)
+          throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH cache file is corrupted");
+        leafBytes += primTy->getBytes(prims+leafBytes);
+      }
+      if (ofs + leafBytes > bytes)
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH cache file is corrupted");
+      return;
+    }
+
+    if (!node.isAlignedNode() && !node.isHalfNode())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH cache file is corrupted");
+    if (ofs + (node.isAlignedNode() ? sizeof(AlignedNode) : sizeof(HalfNode)) > bytes)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH cache file is corrupted");
+
+    for (size_t i=0; i<N; i++)
+      relocate(node.baseNode()->child(i),base,bytes);
+  }
+
+  template<int N>
+  void BVHN<N>::save(std::ostream& out) const
+  {
+    /* only primitives that do not reference memory outside the BVH can be stored */
+    const std::string prim = primTy->name();
+    if (prim != "triangle4" && prim != "triangle4v" && prim != "triangle4i" && prim != "quad4v" && prim != "quad4i")
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH over " + prim + " primitives does not support saving");
+
+    /* the top-level BVH of the two-level builder references the object BVHs, they get flattened into one buffer */
+    std::vector<char> buf;
+    const size_t root = serialize(this->root,buf);
+
+    writeBinary(out,BVH_CACHE_VERSION);
+    writeBinary(out,(unsigned int)N);
+    writeBinary(out,(unsigned int)sizeof(void*));
+    writeBinary(out,(unsigned int)prim.size());
+    out.write(prim.data(),prim.size());
+    writeBinary(out,bounds);
+    writeBinary(out,(uint64_t)numPrimitives);
+    writeBinary(out,(uint64_t)root);
+    writeBinary(out,(uint64_t)buf.size());
+    out.write(buf.data(),buf.size());
+  }
+
+  template<int N>
+  void BVHN<N>::load(std::istream& in)
+  {
+    if (readBinary<unsigned int>(in) != BVH_CACHE_VERSION)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH cache file has wrong version");
+    if (readBinary<unsigned int>(in) != N || readBinary<unsigned int>(in) != sizeof(void*))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH cache file was written for a different BVH layout");
+
+    std::string prim(readBinary<unsigned int>(in),'\0');
+    if (!in.read(&prim[0],prim.size()) || prim != primTy->name())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH cache file was written for a different primitive type");
+
+    const LBBox3fa bounds = readBinary<LBBox3fa>(in);
+    const size_t numPrimitives = (size_t) readBinary<uint64_t>(in);
+    NodeRef root = NodeRef((size_t) readBinary<uint64_t>(in));
+    const size_t bytes = (size_t) readBinary<uint64_t>(in);
+
+    /* the whole tree goes into a single allocator block that is freed with the BVH */
+    alloc.clear();
+    if (bytes == 0) {
+      if (root != emptyNode)
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH cache file is corrupted");
+      set(root,bounds,numPrimitives);
+      return;
+    }
+    alloc.init(bytes,bytes,bytes);
+    char* base = (char*) alloc.specialAlloc(bytes);
+    if (!in.read(base,bytes))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH cache file is truncated");
+
+    relocate(root,base,bytes);
+    set(root,bounds,numPrimitives);
+  }
+
   template<int N>
   void BVHN<N>::clearBarrier(NodeRef& node)
   {
@@ -122,6 +265,90 @@ namespace embree
     else return node;
   }
 
+  template<int N>
+  bool BVHN<N>::countAlignedNodes(NodeRef node, size_t& num) const
+  {
+    if (node.isLeaf()) return true;
+    if (!node.isAlignedNode()) return false;
+    num++;
+    for (size_t i=0; i<N; i++)
+      if (!countAlignedNodes(node.alignedNode()->child(i),num)) return false;
+    return true;
+  }
+
+  template<int N>
+  typename BVHN<N>::NodeRef BVHN<N>::copyAlignedNodes(NodeRef node, AlignedNode*& dst) const
+  {
+    if (node.isLeaf()) return node;
+    AlignedNode* oldnode = node.alignedNode();
+    AlignedNode* newnode = dst++;
+    *newnode = *oldnode;
+    for (size_t i=0; i<N; i++)
+      newnode->child(i) = copyAlignedNodes(oldnode->child(i),dst);
+    return encodeNode(newnode);
+  }
+
+  template<int N>
+  void BVHN<N>::replicateNodes()
+  {
+    clearReplicas();
+
+    /* only static instance level BVHs are small and read mostly enough to replicate their nodes */
+    if (!device->numa_replicate_bvh || !scene->isStaticAccel() || primTy != &InstancePrimitive::type)
+      return;
+
+    const unsigned int numNodes = device->numa_replicas ? (unsigned int) device->numa_replicas : getNumberOfNumaNodes();
+    size_t numAlignedNodes = 0;
+    if (numNodes < 2 || root == emptyNode || !countAlignedNodes(root,numAlignedNodes) || numAlignedNodes == 0)
+      return;
+
+    const size_t bytes = numAlignedNodes*sizeof(AlignedNode);
+    device->memoryMonitor(numNodes*bytes,false);
+    replicas.resize(numNodes);
+    for (unsigned int i=0; i<numNodes; i++)
+      replicas[i].bytes = bytes;
+
+    /* each replica gets allocated and written by a thread of its NUMA node, thus first touch places its pages on that node */
+    struct ReplicateTask { BVHN* bvh; unsigned int node; };
+    std::vector<ReplicateTask> tasks(numNodes);
+    std::vector<thread_t> threads(numNodes);
+    for (unsigned int i=0; i<numNodes; i++)
+    {
+      tasks[i].bvh = this;
+      tasks[i].node = i;
+      threads[i] = createThread([] (void* ptr)
+      {
+        ReplicateTask* task = (ReplicateTask*) ptr;
+        NodeReplica& replica = task->bvh->replicas[task->node];
+        setNumaAffinity(task->node);
+        try {
+          replica.ptr = os_malloc(replica.bytes,replica.hugepages);
+        } catch (...) {
+          return;
+        }
+        AlignedNode* dst = (AlignedNode*) replica.ptr;
+        replica.root = task->bvh->copyAlignedNodes(task->bvh->root,dst);
+      },&tasks[i]);
+    }
+    for (unsigned int i=0; i<numNodes; i++)
+      embree::join(threads[i]);
+
+    /* traverse the original nodes if some replica could not get allocated */
+    for (unsigned int i=0; i<numNodes; i++)
+      if (replicas[i].ptr == nullptr) { clearReplicas(); return; }
+  }
+
+  template<int N>
+  void BVHN<N>::clearReplicas()
+  {
+    for (size_t i=0; i<replicas.size(); i++)
+    {
+      if (replicas[i].ptr) os_free(replicas[i].ptr,replicas[i].bytes,replicas[i].hugepages);
+      device->memoryMonitor(-ssize_t(replicas[i].bytes),true);
+    }
+    replicas.clear();
+  }
+
   template<int N>
   double BVHN<N>::preBuild(const std::string& builderName)
   {
@@ -144,6 +371,8 @@ namespace embree
   {
     if (t0 == double(inf))
       return;
+
+    replicateNodes();
     
     double dt = 0.0;
     if (device->benchmark || device->verbosity(2)) 
@@ -192,12 +421,66 @@ namespace embree
     }
   }
 
-#if defined(__AVX__)
+#if defined(__AVX__) || defined(EMBREE_BVH8_SIMD4)
   template class BVHN<8>;
 #endif
 
 #if !defined(__AVX__) || !defined(EMBREE_TARGET_SSE2) && !defined(EMBREE_TARGET_SSE42)
   template class BVHN<4>;
 #endif
+
+#if defined(EMBREE_LOWEST_ISA)
+  struct half_node_regression_test : public RegressionTest
+  {
+    typedef BVH4::AlignedNode AlignedNode;
+    typedef BVH4::HalfNode HalfNode;
+
+    half_node_regression_test(const char* name) : RegressionTest(name) {
+      registerRegressionTest(this);
+    }
+
+    static float random(float range) {
+      return range*(2.0f*float(rand())/float(RAND_MAX)-1.0f);
+    }
+
+    bool run ()
+    {
+      bool passed = true;
+      for (size_t iter=0; iter<10000; iter++)
+      {
+        /* mix of large offsets, small extents, and degenerate boxes */
+        const float offset = random(float(1<<(rand()%40)));
+        const float extent = iter%8 == 0 ? 0.0f : std::abs(random(std::ldexp(1.0f,rand()%40-20)));
+        const size_t numChildren = 1+rand()%4;
+
+        AlignedNode anode; anode.clear();
+        BBox3fa bounds[4];
+        for (size_t i=0; i<numChildren; i++) {
+          const Vec3fa lower(offset+random(extent),offset+random(extent),offset+random(extent));
+          const Vec3fa size(std::abs(random(extent)),std::abs(random(extent)),std::abs(random(extent)));
+          bounds[i] = BBox3fa(lower,lower+size);
+          anode.setBounds(i,bounds[i]);
+        }
+
+        HalfNode hnode; hnode.init(anode);
+        passed &= movemask(hnode.validMask()) == (1u<<numChildren)-1;
+
+        /* decoded bounds have to enclose the original bounds */
+        for (size_t i=0; i<numChildren; i++)
+          passed &= subset(bounds[i],hnode.bounds(i));
+
+        /* SIMD decoding has to match the decoding the builder verified against */
+        for (size_t p=0; p<6; p++) {
+          const vfloat4 f = hnode.decode<4>(p*4*sizeof(HalfNode::T));
+          for (size_t i=0; i<4; i++)
+            passed &= f[i] == HalfNode::toFloat(hnode.all_planes[4*p+i]);
+        }
+      }
+      return passed;
+    }
+  };
+
+  half_node_regression_test half_node_regression("half_node_regression_test");
+#endif
 }
 
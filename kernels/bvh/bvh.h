@@ -35,6 +35,7 @@ namespace embree
     BVH_FLAG_UNALIGNED_NODE_MB = 0x01000,
     BVH_FLAG_QUANTIZED_NODE = 0x100000,
     BVH_FLAG_ALIGNED_NODE_MB4D = 0x1000000,
+    BVH_FLAG_HALF_NODE = 0x10000000,
 
     /* short versions */
     BVH_AN1 = BVH_FLAG_ALIGNED_NODE,
@@ -46,7 +47,8 @@ namespace embree
     BVH_AN1_UN1 = BVH_FLAG_ALIGNED_NODE | BVH_FLAG_UNALIGNED_NODE,
     BVH_AN2_UN2 = BVH_FLAG_ALIGNED_NODE_MB | BVH_FLAG_UNALIGNED_NODE_MB,
     BVH_AN2_AN4D_UN2 = BVH_FLAG_ALIGNED_NODE_MB | BVH_FLAG_ALIGNED_NODE_MB4D | BVH_FLAG_UNALIGNED_NODE_MB,
-    BVH_QN1 = BVH_FLAG_QUANTIZED_NODE
+    BVH_QN1 = BVH_FLAG_QUANTIZED_NODE,
+    BVH_HN1 = BVH_FLAG_HALF_NODE
   };
 
   /* BVH node reference with bounds */
@@ -98,6 +100,7 @@ namespace embree
     struct UnalignedNode;
     struct UnalignedNodeMB;
     struct QuantizedNode;
+    struct HalfNode;
 
     /*! Number of bytes the nodes and primitives are minimally aligned to.*/
     static const size_t byteAlignment = 16;
@@ -116,6 +119,7 @@ namespace embree
     static const size_t tyAlignedNodeMB4D = 6;
     static const size_t tyUnalignedNode = 2;
     static const size_t tyUnalignedNodeMB = 3;
+    static const size_t tyHalfNode = 4;
     static const size_t tyQuantizedNode = 5;
     static const size_t tyLeaf = 8;
 
@@ -182,7 +186,7 @@ namespace embree
           if (types != BVH_FLAG_QUANTIZED_NODE) {
             prefetchL1(((char*)ptr)+0*64);
             prefetchL1(((char*)ptr)+1*64);
-            if ((N >= 8) || (types > BVH_FLAG_ALIGNED_NODE)) {
+            if ((N >= 8) || (types > BVH_FLAG_ALIGNED_NODE && types != BVH_FLAG_HALF_NODE)) {
               prefetchL1(((char*)ptr)+2*64);
               prefetchL1(((char*)ptr)+3*64);
             }
@@ -317,6 +321,9 @@ namespace embree
       /*! checks if this is a quantized node */
       __forceinline int isQuantizedNode() const { return (ptr & (size_t)align_mask) == tyQuantizedNode; }
 
+      /*! checks if this is a half precision node */
+      __forceinline int isHalfNode() const { return (ptr & (size_t)align_mask) == tyHalfNode; }
+
       /*! returns base node pointer */
       __forceinline BaseNode* baseNode()
       {
@@ -353,6 +360,10 @@ namespace embree
       __forceinline       QuantizedNode* quantizedNode()       { assert(isQuantizedNode()); return (      QuantizedNode*)(ptr  & ~(size_t)align_mask ); }
       __forceinline const QuantizedNode* quantizedNode() const { assert(isQuantizedNode()); return (const QuantizedNode*)(ptr  & ~(size_t)align_mask ); }
 
+      /*! returns half precision node pointer */
+      __forceinline       HalfNode* halfNode()       { assert(isHalfNode()); return (      HalfNode*)(ptr & ~(size_t)align_mask); }
+      __forceinline const HalfNode* halfNode() const { assert(isHalfNode()); return (const HalfNode*)(ptr & ~(size_t)align_mask); }
+
       /*! returns leaf pointer */
       __forceinline char* leaf(size_t& num) const {
         assert(isLeaf());
@@ -697,7 +708,7 @@ namespace embree
 
       /*! tests if the node has valid bounds */
       __forceinline bool hasBounds() const {
-        return lower_dx.i[0] != cast_f2i(float(nan));
+        return cast_f2i(lower_dx[0]) != cast_f2i(float(nan));
       }
 
       /*! Return bounding box for time 0 */
@@ -1304,6 +1315,164 @@ namespace embree
     };
 
 
+    /*! BVHN Half Node. Stores the child bounds as IEEE half
+     *  precision offsets to a per node origin. The offsets are
+     *  scaled by a per node power of two, thus decoding is exact up
+     *  to the final addition of the origin. Bounds are rounded
+     *  conservatively, and half denormals are never stored. */
+    struct __aligned(8) HalfNode : public BaseNode
+    {
+      using BaseNode::children;
+
+      typedef unsigned short T;
+      static const T HALF_ZERO = 0x0000;
+      static const T HALF_MIN_NORMAL = 0x0400; //!< 2^-14
+      static const T HALF_MAX = 0x7bff;        //!< 65504
+
+      struct Create2
+      {
+        template<typename BuildRecord>
+        __forceinline NodeRef operator() (BuildRecord* children, const size_t n, const FastAllocator::CachedAllocator& alloc) const
+        {
+          __aligned(64) AlignedNode node;
+          node.clear();
+          for (size_t i=0; i<n; i++) {
+            node.setBounds(i,children[i].bounds());
+          }
+          /* 32 byte alignment keeps the 96 byte BVH4 node within two cache lines */
+          HalfNode* hnode = (HalfNode*) alloc.malloc0(sizeof(HalfNode), 32);
+          hnode->init(node);
+
+          return (size_t)hnode | tyHalfNode;
+        }
+      };
+
+      struct Set2
+      {
+        template<typename BuildRecord>
+        __forceinline NodeRef operator() (const BuildRecord& precord, const BuildRecord* crecords, NodeRef ref, NodeRef* children, const size_t num) const
+        {
+          HalfNode* node = ref.halfNode();
+          for (size_t i=0; i<num; i++) node->setRef(i,children[i]);
+          return ref;
+        }
+      };
+
+      __forceinline void setRef(size_t i, const NodeRef& ref) {
+        assert(i < N);
+        children[i] = ref;
+      }
+
+      /*! converts a half to float, only handles zero and normal halves */
+      static __forceinline float toFloat(const T h) {
+        return h == HALF_ZERO ? 0.0f : cast_i2f((int(h) << 13) + (112 << 23));
+      }
+
+      /*! converts a positive float to half by truncation, small values are flushed to zero */
+      static __forceinline T toHalf(const float f)
+      {
+        if (f < 6.103515625e-05f) return HALF_ZERO;
+        if (f >= 65504.0f) return HALF_MAX;
+        return T((cast_f2i(f) >> 13) - (112 << 10));
+      }
+
+      /*! decodes a half offset the same way traversal does */
+      static __forceinline float decode(const T h, const float start, const float scale) {
+        return madd(toFloat(h),scale,start);
+      }
+
+      /*! largest half whose decoded value is not above lower */
+      static __forceinline T encodeLower(const float lower, const float start, const float scale)
+      {
+        T h = toHalf((lower-start)/scale);
+        while (h != HALF_ZERO && decode(h,start,scale) > lower)
+          h = h == HALF_MIN_NORMAL ? HALF_ZERO : h-1;
+        return h;
+      }
+
+      /*! smallest half whose decoded value is not below upper */
+      static __forceinline T encodeUpper(const float upper, const float start, const float scale)
+      {
+        T h = toHalf((upper-start)/scale);
+        while (decode(h,start,scale) < upper)
+          h = h == HALF_ZERO ? HALF_MIN_NORMAL : h+1;
+        assert(h <= HALF_MAX);
+        return h;
+      }
+
+      __forceinline void init(AlignedNode& node)
+      {
+        for (size_t i=0; i<N; i++) children[i] = emptyNode;
+
+        /* empty children have lower=+inf and upper=-inf */
+        start.x = reduce_min(node.lower_x);
+        start.y = reduce_min(node.lower_y);
+        start.z = reduce_min(node.lower_z);
+        const float ext = max(reduce_max(node.upper_x)-start.x,
+                              reduce_max(node.upper_y)-start.y,
+                              reduce_max(node.upper_z)-start.z);
+
+        /* offsets stay below 2^15, leaving headroom for upward rounding */
+        int e = 0; std::frexp(ext/32768.0f,&e);
+        scale = std::ldexp(1.0f,clamp(e,-100,110));
+
+        for (size_t i=0; i<N; i++)
+        {
+          if (node.lower_x[i] > node.upper_x[i]) {
+            lower_x[i] = lower_y[i] = lower_z[i] = HALF_MAX;
+            upper_x[i] = upper_y[i] = upper_z[i] = HALF_ZERO;
+            continue;
+          }
+          lower_x[i] = encodeLower(node.lower_x[i],start.x,scale);
+          upper_x[i] = encodeUpper(node.upper_x[i],start.x,scale);
+          lower_y[i] = encodeLower(node.lower_y[i],start.y,scale);
+          upper_y[i] = encodeUpper(node.upper_y[i],start.y,scale);
+          lower_z[i] = encodeLower(node.lower_z[i],start.z,scale);
+          upper_z[i] = encodeUpper(node.upper_z[i],start.z,scale);
+        }
+      }
+
+      /*! Returns bounds of specified child. */
+      __forceinline BBox3fa bounds(size_t i) const
+      {
+        assert(i < N);
+        const Vec3fa lower(decode(lower_x[i],start.x,scale),
+                           decode(lower_y[i],start.y,scale),
+                           decode(lower_z[i],start.z,scale));
+        const Vec3fa upper(decode(upper_x[i],start.x,scale),
+                           decode(upper_y[i],start.y,scale),
+                           decode(upper_z[i],start.z,scale));
+        return BBox3fa(lower,upper);
+      }
+
+      /*! Returns extent of bounds of specified child. */
+      __forceinline Vec3fa extent(size_t i) const {
+        return bounds(i).size();
+      }
+
+      __forceinline vbool<N> validMask() const { return vint<N>::load(lower_x) <= vint<N>::load(upper_x); }
+
+      /*! loads the half plane at the specified byte offset, scaling and origin still have to be applied */
+      template <int M>
+      __forceinline vfloat<M> decode(const size_t offset) const { return vfloat<M>::load_half((const T*)((const char*)all_planes+offset)); }
+
+      union {
+        struct {
+          T lower_x[N]; //!< fp16 X dimension of lower bounds of all N children
+          T upper_x[N]; //!< fp16 X dimension of upper bounds of all N children
+          T lower_y[N]; //!< fp16 Y dimension of lower bounds of all N children
+          T upper_y[N]; //!< fp16 Y dimension of upper bounds of all N children
+          T lower_z[N]; //!< fp16 Z dimension of lower bounds of all N children
+          T upper_z[N]; //!< fp16 Z dimension of upper bounds of all N children
+        };
+        T all_planes[6*N];
+      };
+
+      Vec3f start;
+      float scale;
+    };
+
+
     /*! BVHN Quantized Node */
     struct __aligned(8) QuantizedBaseNodeMB
     {
@@ -1432,6 +1601,21 @@ namespace embree
     /*! sets BVH members after build */
     void set (NodeRef root, const LBBox3fa& bounds, size_t numPrimitives);
 
+    /*! writes the BVH into a relocatable BVH cache stream */
+    void save(std::ostream& out) const;
+
+    /*! restores the BVH from a BVH cache stream without rebuilding */
+    void load(std::istream& in);
+
+    /*! returns the number of node and leaf bytes that reside on 2MB pages */
+    size_t getHugePageBytes();
+
+    /*! copies a subtree into buf, child references become offsets into buf */
+    size_t serialize(NodeRef node, std::vector<char>& buf) const;
+
+    /*! turns the offsets of a loaded subtree back into pointers */
+    void relocate(NodeRef& node, char* base, size_t bytes);
+
     /*! Clears the barrier bits of a subtree. */
     void clearBarrier(NodeRef& node);
 
@@ -1439,6 +1623,25 @@ namespace embree
     void layoutLargeNodes(size_t num);
     NodeRef layoutLargeNodesRecursion(NodeRef& node, const FastAllocator::CachedAllocator& allocator);
 
+    /*! replicates the inner nodes of static instance level BVHs to each NUMA node */
+    void replicateNodes();
+
+    /*! frees the replicated nodes again */
+    void clearReplicas();
+
+    /*! counts the aligned nodes of a subtree, returns false if the subtree contains other node types */
+    bool countAlignedNodes(NodeRef node, size_t& num) const;
+
+    /*! copies the aligned nodes of a subtree to consecutive nodes starting at dst, leaves are shared */
+    NodeRef copyAlignedNodes(NodeRef node, AlignedNode*& dst) const;
+
+    /*! returns the root to start traversal from, which is the root of the replica of the caller's NUMA node if available */
+    __forceinline NodeRef getTraversalRoot() const
+    {
+      if (likely(replicas.empty())) return root;
+      return replicas[getCurrentNumaNode() % replicas.size()].root;
+    }
+
     /*! called by all builders before build starts */
     double preBuild(const std::string& builderName);
 
@@ -1538,6 +1741,22 @@ namespace embree
   public:
     std::vector<BVHN*> objects;
     vector_t<char,aligned_allocator<char,32>> subdiv_patches;
+
+    /*! copy of the inner nodes placed on some NUMA node */
+    struct NodeReplica
+    {
+      NodeReplica ()
+        : root(emptyNode), ptr(nullptr), bytes(0), hugepages(false) {}
+
+      NodeRef root;                    //!< root node of the replica
+      void* ptr;                       //!< memory holding the replicated nodes
+      size_t bytes;                    //!< size of the replica in bytes
+      bool hugepages;                  //!< true if the replica got allocated on huge pages
+    };
+
+    /*! node replicas for each NUMA node */
+  public:
+    std::vector<NodeReplica> replicas;
   };
 
   template<>
@@ -36,6 +36,9 @@
 namespace embree
 {
   DECLARE_SYMBOL2(Accel::Collider,BVH4ColliderUserGeom);
+  DECLARE_SYMBOL2(Accel::Collider,BVH4Triangle4Collider);
+  DECLARE_SYMBOL2(Accel::Collider,BVH4Triangle4vCollider);
+  DECLARE_SYMBOL2(Accel::Collider,BVH4Triangle4iCollider);
 
   DECLARE_ISA_FUNCTION(VirtualCurveIntersector*,VirtualCurveIntersector4i,void);
   DECLARE_ISA_FUNCTION(VirtualCurveIntersector*,VirtualCurveIntersector8i,void);
@@ -70,6 +73,9 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector1,QBVH4Triangle4iIntersector1Pluecker);
   DECLARE_SYMBOL2(Accel::Intersector1,QBVH4Quad4iIntersector1Pluecker);
 
+  DECLARE_SYMBOL2(Accel::Intersector1,HBVH4Triangle4Intersector1Moeller);
+  DECLARE_SYMBOL2(Accel::Intersector1,HBVH4Quad4vIntersector1Moeller);
+
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4SubdivPatch1Intersector1);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4SubdivPatch1MBIntersector1);
   
@@ -230,11 +236,13 @@ namespace embree
   DECLARE_ISA_FUNCTION(Builder*,BVH4Triangle4iMBSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH4Triangle4vMBSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH4QuantizedTriangle4iSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
+  DECLARE_ISA_FUNCTION(Builder*,BVH4HalfTriangle4SceneBuilderSAH,void* COMMA Scene* COMMA size_t);
 
   DECLARE_ISA_FUNCTION(Builder*,BVH4Quad4vSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH4Quad4iSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH4Quad4iMBSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH4QuantizedQuad4iSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
+  DECLARE_ISA_FUNCTION(Builder*,BVH4HalfQuad4vSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
 
   DECLARE_ISA_FUNCTION(Builder*,BVH4Triangle4SceneBuilderFastSpatialSAH,void* COMMA Scene* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH4Triangle4vSceneBuilderFastSpatialSAH,void* COMMA Scene* COMMA size_t);
@@ -277,6 +285,9 @@ namespace embree
   BVH4Factory::BVH4Factory(int bfeatures, int ifeatures)
   {
     SELECT_SYMBOL_DEFAULT_AVX_AVX2(ifeatures,BVH4ColliderUserGeom);
+    IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_AVX_AVX2(ifeatures,BVH4Triangle4Collider));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_AVX_AVX2(ifeatures,BVH4Triangle4vCollider));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_AVX_AVX2(ifeatures,BVH4Triangle4iCollider));
 
     selectBuilders(bfeatures);
     selectIntersectors(ifeatures);
@@ -300,11 +311,13 @@ namespace embree
     IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_AVX(features,BVH4Triangle4iMBSceneBuilderSAH));
     IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_AVX(features,BVH4Triangle4vMBSceneBuilderSAH));
     IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_AVX(features,BVH4QuantizedTriangle4iSceneBuilderSAH));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_AVX(features,BVH4HalfTriangle4SceneBuilderSAH));
 
     IF_ENABLED_QUADS(SELECT_SYMBOL_DEFAULT_AVX_AVX512KNL(features,BVH4Quad4vSceneBuilderSAH));
     IF_ENABLED_QUADS(SELECT_SYMBOL_DEFAULT_AVX_AVX512KNL(features,BVH4Quad4iSceneBuilderSAH));
     IF_ENABLED_QUADS(SELECT_SYMBOL_DEFAULT_AVX(features,BVH4Quad4iMBSceneBuilderSAH));
     IF_ENABLED_QUADS(SELECT_SYMBOL_DEFAULT_AVX(features,BVH4QuantizedQuad4iSceneBuilderSAH));
+    IF_ENABLED_QUADS(SELECT_SYMBOL_DEFAULT_AVX(features,BVH4HalfQuad4vSceneBuilderSAH));
 
     IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_AVX(features,BVH4Triangle4SceneBuilderFastSpatialSAH));
     IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_AVX(features,BVH4Triangle4vSceneBuilderFastSpatialSAH));
@@ -381,6 +394,9 @@ namespace embree
     IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX512SKX(features,QBVH4Triangle4iIntersector1Pluecker));
     IF_ENABLED_QUADS(SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX512SKX(features,QBVH4Quad4iIntersector1Pluecker));
 
+    IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2_AVX512SKX(features,HBVH4Triangle4Intersector1Moeller));
+    IF_ENABLED_QUADS(SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2_AVX512SKX(features,HBVH4Quad4vIntersector1Moeller));
+
     IF_ENABLED_SUBDIV(SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2_AVX512SKX(features,BVH4SubdivPatch1Intersector1));
     IF_ENABLED_SUBDIV(SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2_AVX512SKX(features,BVH4SubdivPatch1MBIntersector1));
     
@@ -614,6 +630,7 @@ namespace embree
     assert(ivariant == IntersectVariant::FAST);
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
+    intersectors.collider = BVH4Triangle4Collider();
     intersectors.intersector1           = BVH4Triangle4Intersector1Moeller();
 #if defined (EMBREE_RAY_PACKETS)
     intersectors.intersector4_filter    = BVH4Triangle4Intersector4HybridMoeller();
@@ -633,6 +650,7 @@ namespace embree
     assert(ivariant == IntersectVariant::ROBUST);
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
+    intersectors.collider = BVH4Triangle4vCollider();
     intersectors.intersector1  = BVH4Triangle4vIntersector1Pluecker();
 #if defined (EMBREE_RAY_PACKETS)
     intersectors.intersector4  = BVH4Triangle4vIntersector4HybridPluecker();
@@ -650,6 +668,7 @@ namespace embree
     {
       Accel::Intersectors intersectors;
       intersectors.ptr = bvh;
+      intersectors.collider = BVH4Triangle4iCollider();
       intersectors.intersector1  = BVH4Triangle4iIntersector1Moeller();
 #if defined (EMBREE_RAY_PACKETS)
       intersectors.intersector4  = BVH4Triangle4iIntersector4HybridMoeller();
@@ -663,6 +682,7 @@ namespace embree
     {
       Accel::Intersectors intersectors;
       intersectors.ptr = bvh;
+      intersectors.collider = BVH4Triangle4iCollider();
       intersectors.intersector1  = BVH4Triangle4iIntersector1Pluecker();
 #if defined (EMBREE_RAY_PACKETS)
       intersectors.intersector4  = BVH4Triangle4iIntersector4HybridPluecker();
@@ -861,6 +881,22 @@ namespace embree
     return intersectors;
   }
 
+  Accel::Intersectors BVH4Factory::HBVH4Triangle4Intersectors(BVH4* bvh)
+  {
+    Accel::Intersectors intersectors;
+    intersectors.ptr = bvh;
+    intersectors.intersector1 = HBVH4Triangle4Intersector1Moeller();
+    return intersectors;
+  }
+
+  Accel::Intersectors BVH4Factory::HBVH4Quad4vIntersectors(BVH4* bvh)
+  {
+    Accel::Intersectors intersectors;
+    intersectors.ptr = bvh;
+    intersectors.intersector1 = HBVH4Quad4vIntersector1Moeller();
+    return intersectors;
+  }
+
   Accel::Intersectors BVH4Factory::BVH4UserGeometryIntersectors(BVH4* bvh)
   {
     Accel::Intersectors intersectors;
@@ -1339,6 +1375,22 @@ namespace embree
     return new AccelInstance(accel,builder,intersectors);
   }
 
+  Accel* BVH4Factory::BVH4HalfTriangle4(Scene* scene)
+  {
+    BVH4* accel = new BVH4(Triangle4::type,scene);
+    Builder* builder = BVH4HalfTriangle4SceneBuilderSAH(accel,scene,0);
+    Accel::Intersectors intersectors = HBVH4Triangle4Intersectors(accel);
+    return new AccelInstance(accel,builder,intersectors);
+  }
+
+  Accel* BVH4Factory::BVH4HalfQuad4v(Scene* scene)
+  {
+    BVH4* accel = new BVH4(Quad4v::type,scene);
+    Builder* builder = BVH4HalfQuad4vSceneBuilderSAH(accel,scene,0);
+    Accel::Intersectors intersectors = HBVH4Quad4vIntersectors(accel);
+    return new AccelInstance(accel,builder,intersectors);
+  }
+
   Accel* BVH4Factory::BVH4SubdivPatch1(Scene* scene)
   {
     BVH4* accel = new BVH4(SubdivPatch1::type,scene);
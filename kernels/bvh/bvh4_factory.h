@@ -51,6 +51,9 @@ namespace embree
 
     Accel* BVH4QuantizedTriangle4i(Scene* scene);
     Accel* BVH4QuantizedQuad4i(Scene* scene);
+
+    Accel* BVH4HalfTriangle4(Scene* scene);
+    Accel* BVH4HalfQuad4v(Scene* scene);
  
     Accel* BVH4SubdivPatch1(Scene* scene);
     Accel* BVH4SubdivPatch1MB(Scene* scene);
@@ -85,6 +88,9 @@ namespace embree
     Accel::Intersectors QBVH4Quad4iIntersectors(BVH4* bvh);
     Accel::Intersectors QBVH4Triangle4iIntersectors(BVH4* bvh);
 
+    Accel::Intersectors HBVH4Triangle4Intersectors(BVH4* bvh);
+    Accel::Intersectors HBVH4Quad4vIntersectors(BVH4* bvh);
+
     Accel::Intersectors BVH4UserGeometryIntersectors(BVH4* bvh);
     Accel::Intersectors BVH4UserGeometryMBIntersectors(BVH4* bvh);
 
@@ -112,6 +118,9 @@ namespace embree
   private:
 
     DEFINE_SYMBOL2(Accel::Collider,BVH4ColliderUserGeom);
+    DEFINE_SYMBOL2(Accel::Collider,BVH4Triangle4Collider);
+    DEFINE_SYMBOL2(Accel::Collider,BVH4Triangle4vCollider);
+    DEFINE_SYMBOL2(Accel::Collider,BVH4Triangle4iCollider);
 
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4OBBVirtualCurveIntersector1);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4OBBVirtualCurveIntersector1MB);
@@ -139,6 +148,9 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector1,QBVH4Triangle4iIntersector1Pluecker);
     DEFINE_SYMBOL2(Accel::Intersector1,QBVH4Quad4iIntersector1Pluecker);
 
+    DEFINE_SYMBOL2(Accel::Intersector1,HBVH4Triangle4Intersector1Moeller);
+    DEFINE_SYMBOL2(Accel::Intersector1,HBVH4Quad4vIntersector1Moeller);
+
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4SubdivPatch1Intersector1);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4SubdivPatch1MBIntersector1);
 
@@ -304,11 +316,13 @@ namespace embree
     DEFINE_ISA_FUNCTION(Builder*,BVH4Triangle4iMBSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
     DEFINE_ISA_FUNCTION(Builder*,BVH4Triangle4vMBSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
     DEFINE_ISA_FUNCTION(Builder*,BVH4QuantizedTriangle4iSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
+    DEFINE_ISA_FUNCTION(Builder*,BVH4HalfTriangle4SceneBuilderSAH,void* COMMA Scene* COMMA size_t);
     
     DEFINE_ISA_FUNCTION(Builder*,BVH4Quad4vSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
     DEFINE_ISA_FUNCTION(Builder*,BVH4Quad4iSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
     DEFINE_ISA_FUNCTION(Builder*,BVH4Quad4iMBSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
     DEFINE_ISA_FUNCTION(Builder*,BVH4QuantizedQuad4iSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
+    DEFINE_ISA_FUNCTION(Builder*,BVH4HalfQuad4vSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
     
     DEFINE_ISA_FUNCTION(Builder*,BVH4SubdivPatch1BuilderSAH,void* COMMA Scene* COMMA size_t);
     DEFINE_ISA_FUNCTION(Builder*,BVH4SubdivPatch1MBBuilderSAH,void* COMMA Scene* COMMA size_t);
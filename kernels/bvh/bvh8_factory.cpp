@@ -16,7 +16,7 @@
 
 #include "../common/isa.h" // to define EMBREE_TARGET_SIMD8
 
-#if defined (EMBREE_TARGET_SIMD8)
+#if defined (EMBREE_TARGET_SIMD8) || defined (EMBREE_BVH8_SIMD4)
 
 #include "bvh8_factory.h"
 #include "../bvh/bvh.h"
@@ -40,6 +40,9 @@
 namespace embree
 {
   DECLARE_SYMBOL2(Accel::Collider,BVH8ColliderUserGeom);
+  DECLARE_SYMBOL2(Accel::Collider,BVH8Triangle4Collider);
+  DECLARE_SYMBOL2(Accel::Collider,BVH8Triangle4vCollider);
+  DECLARE_SYMBOL2(Accel::Collider,BVH8Triangle4iCollider);
   
   DECLARE_ISA_FUNCTION(VirtualCurveIntersector*,VirtualCurveIntersector8v,void);
   DECLARE_ISA_FUNCTION(VirtualCurveIntersector*,VirtualCurveIntersector8iMB,void);
@@ -257,6 +260,12 @@ namespace embree
   BVH8Factory::BVH8Factory(int bfeatures, int ifeatures)
   {
     SELECT_SYMBOL_INIT_AVX(ifeatures,BVH8ColliderUserGeom);
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX(ifeatures,BVH8Triangle4Collider));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX(ifeatures,BVH8Triangle4vCollider));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX(ifeatures,BVH8Triangle4iCollider));
+#if defined(EMBREE_BVH8_SIMD4)
+    IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT(ifeatures,BVH8Triangle4Collider));
+#endif
     
     selectBuilders(bfeatures);
     selectIntersectors(ifeatures);
@@ -315,6 +324,11 @@ namespace embree
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Triangle4iMeshBuilderMortonGeneral));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Quad4vMeshBuilderMortonGeneral));
     IF_ENABLED_USER (SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8VirtualMeshBuilderMortonGeneral));
+
+#if defined(EMBREE_BVH8_SIMD4)
+    /* 4-wide ISAs only provide the SAH builder for BVH8<Triangle4> */
+    IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT(features,BVH8Triangle4SceneBuilderSAH));
+#endif
   }
 
   void BVH8Factory::selectIntersectors(int features)
@@ -489,6 +503,17 @@ namespace embree
 
     IF_ENABLED_INSTANCE(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8InstanceIntersectorStream));
 
+#endif
+
+#if defined(EMBREE_BVH8_SIMD4)
+    /* 4-wide ISAs only provide the double-pumped BVH8<Triangle4> intersectors */
+    IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_SSE42(features,BVH8Triangle4Intersector1Moeller));
+#if defined (EMBREE_RAY_PACKETS)
+    IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_SSE42(features,BVH8Triangle4Intersector4HybridMoeller));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_SSE42(features,BVH8Triangle4Intersector4HybridMoellerNoFilter));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_SSE42(features,BVH8Triangle4IntersectorStreamMoeller));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_SSE42(features,BVH8Triangle4IntersectorStreamMoellerNoFilter));
+#endif
 #endif
   }
 
@@ -687,6 +712,7 @@ namespace embree
     assert(ivariant == IntersectVariant::FAST);
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
+    intersectors.collider = BVH8Triangle4Collider();
     intersectors.intersector1           = BVH8Triangle4Intersector1Moeller();
 #if defined (EMBREE_RAY_PACKETS)
     intersectors.intersector4_filter    = BVH8Triangle4Intersector4HybridMoeller();
@@ -705,6 +731,7 @@ namespace embree
   {
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
+    intersectors.collider = BVH8Triangle4vCollider();
 #define ENABLE_WOOP_TEST 0
 #if ENABLE_WOOP_TEST == 0
     //assert(ivariant == IntersectVariant::ROBUST);
@@ -729,6 +756,7 @@ namespace embree
     {
       Accel::Intersectors intersectors;
       intersectors.ptr = bvh;
+      intersectors.collider = BVH8Triangle4iCollider();
       intersectors.intersector1  = BVH8Triangle4iIntersector1Moeller();
 #if defined (EMBREE_RAY_PACKETS)
       intersectors.intersector4  = BVH8Triangle4iIntersector4HybridMoeller();
@@ -742,6 +770,7 @@ namespace embree
     {
       Accel::Intersectors intersectors;
       intersectors.ptr = bvh;
+      intersectors.collider = BVH8Triangle4iCollider();
       intersectors.intersector1  = BVH8Triangle4iIntersector1Pluecker();
 #if defined (EMBREE_RAY_PACKETS)
       intersectors.intersector4  = BVH8Triangle4iIntersector4HybridPluecker();
@@ -1005,6 +1034,8 @@ namespace embree
     return intersectors;
   }
 
+#if !defined(EMBREE_BVH8_SIMD4)
+
   Accel* BVH8Factory::BVH8OBBVirtualCurve8v(Scene* scene, IntersectVariant ivariant)
   {
     BVH8* accel = new BVH8(Curve8v::type,scene);
@@ -1021,6 +1052,8 @@ namespace embree
     return new AccelInstance(accel,builder,intersectors);
   }
 
+#endif
+
   Accel* BVH8Factory::BVH8Triangle4(Scene* scene, BuildVariant bvariant, IntersectVariant ivariant)
   {
     BVH8* accel = new BVH8(Triangle4::type,scene);
@@ -1286,6 +1319,8 @@ namespace embree
     return intersectors;
   }
 
+#if !defined(EMBREE_BVH8_SIMD4)
+
   Accel* BVH8Factory::BVH8Grid(Scene* scene, BuildVariant bvariant, IntersectVariant ivariant)
   {
     BVH8* accel = new BVH8(SubGridQBVH8::type,scene);
@@ -1310,6 +1345,8 @@ namespace embree
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown builder "+scene->device->object_builder+" for BVH8MB<GridMesh>");
     return new AccelInstance(accel,builder,intersectors);        
   }
+
+#endif
 }
 
 #endif
@@ -100,6 +100,9 @@ namespace embree
 
   private:
     DEFINE_SYMBOL2(Accel::Collider,BVH8ColliderUserGeom);
+    DEFINE_SYMBOL2(Accel::Collider,BVH8Triangle4Collider);
+    DEFINE_SYMBOL2(Accel::Collider,BVH8Triangle4vCollider);
+    DEFINE_SYMBOL2(Accel::Collider,BVH8Triangle4iCollider);
     
     DEFINE_SYMBOL2(Accel::Intersector1,BVH8OBBVirtualCurveIntersector1);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH8OBBVirtualCurveIntersector1MB);
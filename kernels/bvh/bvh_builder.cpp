@@ -21,7 +21,7 @@ namespace embree
   namespace isa
   {
     template<int N>
-    typename BVHN<N>::NodeRef BVHNBuilderVirtual<N>::BVHNBuilderV::build(FastAllocator* allocator, BuildProgressMonitor& progressFunc, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings)
+    typename BVHN<N>::NodeRef BVHNBuilderVirtual<N>::BVHNBuilderV::build(FastAllocator* allocator, BuildProgressMonitor& progressFunc, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings, double* sah)
     {
       auto createLeafFunc = [&] (const PrimRef* prims, const range<size_t>& set, const Allocator& alloc) -> NodeRef {
         return createLeaf(prims,set,alloc);
@@ -29,8 +29,46 @@ namespace embree
       
       settings.branchingFactor = N;
       settings.maxDepth = BVH::maxBuildDepthLeaf;
-      return BVHBuilderBinnedSAH::build<NodeRef>
-        (FastAllocator::Create(allocator),typename BVH::AlignedNode::Create2(),typename BVH::AlignedNode::Set3(allocator,prims),createLeafFunc,progressFunc,prims,pinfo,settings);
+      if (sah == nullptr) {
+        return BVHBuilderBinnedSAH::build<NodeRef>
+          (FastAllocator::Create(allocator),typename BVH::AlignedNode::Create2(),typename BVH::AlignedNode::Set3(allocator,prims),createLeafFunc,progressFunc,prims,pinfo,settings);
+      }
+
+      /* also reduce the SAH cost over the tree, accumulated the same way as BVHNRefitter does */
+      struct NodeRefSAH
+      {
+        __forceinline NodeRefSAH () {}
+        __forceinline NodeRefSAH (NodeRef ref, double sah = 0.0) : ref(ref), sah(sah) {}
+        NodeRef ref;
+        double sah;
+      };
+
+      auto leafSAH = [] (NodeRef ref, const BBox3fa& bounds) -> double {
+        if (!ref.isLeaf()) return 0.0;
+        size_t num; ref.leaf(num);
+        return max(0.0f,halfArea(bounds))*double(num);
+      };
+
+      const typename BVH::AlignedNode::Set3 setNode(allocator,prims);
+      auto updateNodeFunc = [&] (const BVHBuilderBinnedSAH::BuildRecord& precord, const BVHBuilderBinnedSAH::BuildRecord* crecords, NodeRef ref, NodeRefSAH* children, const size_t num) -> NodeRefSAH
+      {
+        NodeRef refs[N];
+        double nodeSAH = max(0.0f,halfArea(precord.bounds()));
+        for (size_t i=0; i<num; i++) {
+          refs[i] = children[i].ref;
+          nodeSAH += children[i].sah + leafSAH(children[i].ref,crecords[i].bounds());
+        }
+        return NodeRefSAH(setNode(precord,crecords,ref,refs,num),nodeSAH);
+      };
+
+      const NodeRefSAH root = BVHBuilderBinnedSAH::build<NodeRefSAH>
+        (FastAllocator::Create(allocator),typename BVH::AlignedNode::Create2(),updateNodeFunc,createLeafFunc,progressFunc,prims,pinfo,settings);
+
+      /* normalize SAH cost the same way as BVHNStatistics does */
+      const float A = max(0.0f,halfArea(pinfo.geomBounds));
+      const double rootSAH = root.sah + leafSAH(root.ref,pinfo.geomBounds);
+      *sah = A > 0.0f ? rootSAH/double(A) : 0.0;
+      return root.ref;
     }
 
 
@@ -47,6 +85,19 @@ namespace embree
         (FastAllocator::Create(allocator),typename BVH::QuantizedNode::Create2(),typename BVH::QuantizedNode::Set2(),createLeafFunc,progressFunc,prims,pinfo,settings);
     }
 
+    template<int N>
+    typename BVHN<N>::NodeRef BVHNBuilderHalfVirtual<N>::BVHNBuilderV::build(FastAllocator* allocator, BuildProgressMonitor& progressFunc, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings)
+    {
+      auto createLeafFunc = [&] (const PrimRef* prims, const range<size_t>& set, const Allocator& alloc) -> NodeRef {
+        return createLeaf(prims,set,alloc);
+      };
+
+      settings.branchingFactor = N;
+      settings.maxDepth = BVH::maxBuildDepthLeaf;
+      return BVHBuilderBinnedSAH::build<NodeRef>
+        (FastAllocator::Create(allocator),typename BVH::HalfNode::Create2(),typename BVH::HalfNode::Set2(),createLeafFunc,progressFunc,prims,pinfo,settings);
+    }
+
     template<int N>
     typename BVHN<N>::NodeRecordMB BVHNBuilderMblurVirtual<N>::BVHNBuilderV::build(FastAllocator* allocator, BuildProgressMonitor& progressFunc, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings, const BBox1f& timeRange)
     {
@@ -62,12 +113,15 @@ namespace embree
 
     template struct BVHNBuilderVirtual<4>;
     template struct BVHNBuilderQuantizedVirtual<4>;
+    template struct BVHNBuilderHalfVirtual<4>;
     template struct BVHNBuilderMblurVirtual<4>;    
 
 #if defined(__AVX__)
     template struct BVHNBuilderVirtual<8>;
     template struct BVHNBuilderQuantizedVirtual<8>;
     template struct BVHNBuilderMblurVirtual<8>;
+#elif defined(EMBREE_BVH8_SIMD4)
+    template struct BVHNBuilderVirtual<8>;
 #endif
   }
 }
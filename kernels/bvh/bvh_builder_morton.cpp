@@ -22,6 +22,7 @@
 
 #include "../builders/primrefgen.h"
 #include "../builders/bvh_builder_morton.h"
+#include "../builders/bvh_builder_ploc.h"
 
 #include "../geometry/triangle.h"
 #include "../geometry/trianglev.h"
@@ -425,11 +426,19 @@ namespace embree
         SetBVHNBounds<N> setBounds(bvh);
         CreateMortonLeaf<N,Primitive> createLeaf(mesh,geomID_,morton.data());
         CalculateMeshBounds<Mesh> calculateBounds(mesh);
-        auto root = BVHBuilderMorton::build<NodeRecord>(
-          typename BVH::CreateAlloc(bvh), 
-          typename BVH::AlignedNode::Create(),
-          setBounds,createLeaf,calculateBounds,bvh->scene->progressInterface,
-          morton.data(),dest,numPrimitivesGen,settings);
+        NodeRecord root;
+        if (bvh->device->ploc_builder)
+          root = BVHBuilderPLOC::build<NodeRecord>(
+            typename BVH::CreateAlloc(bvh),
+            typename BVH::AlignedNode::Create(),
+            setBounds,createLeaf,calculateBounds,bvh->scene->progressInterface,
+            morton.data(),dest,numPrimitivesGen,settings);
+        else
+          root = BVHBuilderMorton::build<NodeRecord>(
+            typename BVH::CreateAlloc(bvh),
+            typename BVH::AlignedNode::Create(),
+            setBounds,createLeaf,calculateBounds,bvh->scene->progressInterface,
+            morton.data(),dest,numPrimitivesGen,settings);
         
         bvh->set(root.ref,LBBox3fa(root.bounds),numPrimitives);
         
@@ -442,6 +451,10 @@ namespace embree
         }
 #endif
 
+        /* optionally improve the tree further by treelet restructuring */
+        if (bvh->device->restructure_budget > 0.0f)
+          BVHNRotate<N>::restructure(bvh->root,getSeconds()+0.001*bvh->device->restructure_budget,true);
+
         /* clear temporary data for static geometry */
         if (bvh->scene->isStaticAccel()) 
         {
@@ -16,6 +16,7 @@
 
 #include "bvh.h"
 #include "bvh_builder.h"
+#include "bvh_rotate.h"
 #include "../builders/primrefgen.h"
 #include "../builders/splitter.h"
 
@@ -90,6 +91,22 @@ namespace embree
       BVH* bvh;
     };
 
+    /*! accumulates the SAH cost of a built tree the same way as BVHNRefitter does */
+    template<int N>
+    static double treeSAH(typename BVHN<N>::NodeRef ref, const BBox3fa& bounds)
+    {
+      if (ref.isLeaf()) {
+        size_t num; ref.leaf(num);
+        return max(0.0f,halfArea(bounds))*double(num);
+      }
+      typename BVHN<N>::AlignedNode* node = ref.alignedNode();
+      double sah = max(0.0f,halfArea(bounds));
+      for (size_t i=0; i<N; i++)
+        if (node->child(i) != BVHN<N>::emptyNode)
+          sah += treeSAH<N>(node->child(i),node->bounds(i));
+      return sah;
+    }
+
     /************************************************************************************/
     /************************************************************************************/
     /************************************************************************************/
@@ -110,6 +127,7 @@ namespace embree
       unsigned int geomID_ = std::numeric_limits<unsigned int>::max ();
       bool primrefarrayalloc;
       unsigned int numPreviousPrimitives = 0;
+      double sah = 0.0;                 //!< SAH cost of the last built mesh BVH
 
       BVHNBuilderSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize,
                       const Geometry::GTypeMask gtype, bool primrefarrayalloc = false)
@@ -135,6 +153,7 @@ namespace embree
 	/* skip build for empty scene */
         const size_t numPrimitives = mesh ? mesh->size() : scene->getNumPrimitives(gtype_,false);
         numPreviousPrimitives = numPrimitives;
+        sah = 0.0;
         if (numPrimitives == 0) {
           bvh->clear();
           prims.clear();
@@ -177,9 +196,20 @@ namespace embree
               return;
             }
 
-            /* call BVH builder */
-            NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeaf<N,Primitive>(bvh),bvh->scene->progressInterface,prims.data(),pinfo,settings);
+            /* call BVH builder, mesh BVHs also track their SAH cost for refitting */
+            NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeaf<N,Primitive>(bvh),bvh->scene->progressInterface,prims.data(),pinfo,settings,mesh ? &sah : nullptr);
             bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
+
+            /* optionally improve the tree by treelet restructuring, the reference SAH for refitting has to describe the final tree */
+            if (bvh->device->restructure_budget > 0.0f)
+            {
+              BVHNRotate<N>::restructure(bvh->root,getSeconds()+0.001*bvh->device->restructure_budget,true);
+              if (mesh) {
+                const float A = max(0.0f,halfArea(pinfo.geomBounds));
+                sah = A > 0.0f ? treeSAH<N>(bvh->root,pinfo.geomBounds)/double(A) : 0.0;
+              }
+            }
+
             bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
 
 #if PROFILE
@@ -202,6 +232,10 @@ namespace embree
       void clear() {
         prims.clear();
       }
+
+      double getSAH() const {
+        return sah;
+      }
     };
 
     /************************************************************************************/
@@ -295,6 +329,91 @@ namespace embree
     /************************************************************************************/
 
 
+    template<int N, typename Primitive>
+    struct BVHNBuilderSAHHalf : public Builder
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVHN<N>::NodeRef NodeRef;
+
+      BVH* bvh;
+      Scene* scene;
+      Geometry* mesh;
+      mvector<PrimRef> prims;
+      GeneralBVHBuilder::Settings settings;
+      Geometry::GTypeMask gtype_;
+      unsigned int geomID_ = std::numeric_limits<unsigned int>::max();
+      unsigned int numPreviousPrimitives = 0;
+
+      BVHNBuilderSAHHalf (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const Geometry::GTypeMask gtype)
+        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), gtype_(gtype) {}
+
+      BVHNBuilderSAHHalf (BVH* bvh, Geometry* mesh, unsigned int geomID, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const Geometry::GTypeMask gtype)
+        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), gtype_(gtype), geomID_(geomID) {}
+
+      // FIXME: shrink bvh->alloc in destructor here and in other builders too
+
+      void build()
+      {
+        /* we reset the allocator when the mesh size changed */
+        if (mesh && mesh->numPrimitives != numPreviousPrimitives) {
+          bvh->alloc.clear();
+        }
+
+	/* skip build for empty scene */
+        const size_t numPrimitives = mesh ? mesh->size() : scene->getNumPrimitives(gtype_,false);
+        numPreviousPrimitives = numPrimitives;
+        if (numPrimitives == 0) {
+          prims.clear();
+          bvh->clear();
+          return;
+        }
+
+        double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::HBVH" + toString(N) + "BuilderSAH");
+
+#if PROFILE
+        profile(2,PROFILE_RUNS,numPrimitives,[&] (ProfileTimer& timer) {
+#endif
+            /* create primref array */
+            prims.resize(numPrimitives);
+            PrimInfo pinfo = mesh ?
+              createPrimRefArray(mesh,geomID_,prims,bvh->scene->progressInterface) :
+              createPrimRefArray(scene,gtype_,false,prims,bvh->scene->progressInterface);
+
+            /* enable os_malloc for two level build */
+            if (mesh)
+              bvh->alloc.setOSallocation(true);
+
+            /* call BVH builder */
+            const size_t node_bytes = numPrimitives*sizeof(typename BVH::HalfNode)/(4*N);
+            const size_t leaf_bytes = size_t(1.2*Primitive::blocks(numPrimitives)*sizeof(Primitive));
+            bvh->alloc.init_estimate(node_bytes+leaf_bytes);
+            settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
+            NodeRef root = BVHNBuilderHalfVirtual<N>::build(&bvh->alloc,CreateLeaf<N,Primitive>(bvh),bvh->scene->progressInterface,prims.data(),pinfo,settings);
+            bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
+#if PROFILE
+          });
+#endif
+
+	/* clear temporary data for static geometry */
+	if (scene && scene->isStaticAccel()) {
+          prims.clear();
+          bvh->shrink();
+        }
+	bvh->cleanup();
+        bvh->postBuild(t0);
+      }
+
+      void clear() {
+        prims.clear();
+      }
+    };
+
+    /************************************************************************************/
+    /************************************************************************************/
+    /************************************************************************************/
+    /************************************************************************************/
+
+
     template<int N, typename Primitive>
     struct CreateLeafGrid
     {
@@ -572,6 +691,7 @@ namespace embree
 
 
     Builder* BVH4QuantizedTriangle4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
+    Builder* BVH4HalfTriangle4SceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHHalf<4,Triangle4>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
 #if defined(__AVX__)
     Builder* BVH8Triangle4MeshBuilderSAH  (void* bvh, TriangleMesh* mesh, unsigned int geomID, size_t mode) { return new BVHNBuilderSAH<8,Triangle4>((BVH8*)bvh,mesh,geomID,4,1.0f,4,inf,TriangleMesh::geom_type); }
     Builder* BVH8Triangle4vMeshBuilderSAH (void* bvh, TriangleMesh* mesh, unsigned int geomID, size_t mode) { return new BVHNBuilderSAH<8,Triangle4v>((BVH8*)bvh,mesh,geomID,4,1.0f,4,inf,TriangleMesh::geom_type); }
@@ -583,6 +703,8 @@ namespace embree
     Builder* BVH8QuantizedTriangle4iSceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<8,Triangle4i>((BVH8*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
     Builder* BVH8QuantizedTriangle4SceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<8,Triangle4>((BVH8*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
 
+#elif defined(EMBREE_BVH8_SIMD4)
+    Builder* BVH8Triangle4SceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,Triangle4>((BVH8*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
 #endif
 #endif
 
@@ -593,6 +715,7 @@ namespace embree
     Builder* BVH4Quad4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,Quad4i>((BVH4*)bvh,scene,4,1.0f,4,inf,QuadMesh::geom_type,true); }
     Builder* BVH4QuantizedQuad4vSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,Quad4v>((BVH4*)bvh,scene,4,1.0f,4,inf,QuadMesh::geom_type); }
     Builder* BVH4QuantizedQuad4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,Quad4i>((BVH4*)bvh,scene,4,1.0f,4,inf,QuadMesh::geom_type); }
+    Builder* BVH4HalfQuad4vSceneBuilderSAH          (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHHalf<4,Quad4v>((BVH4*)bvh,scene,4,1.0f,4,inf,QuadMesh::geom_type); }
 
 #if defined(__AVX__)
     Builder* BVH8Quad4vSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,Quad4v>((BVH8*)bvh,scene,4,1.0f,4,inf,QuadMesh::geom_type); }
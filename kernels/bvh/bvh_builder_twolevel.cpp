@@ -30,13 +30,18 @@
 #define SPLIT_MEMORY_RESERVE_SCALE 2
 #define SPLIT_MIN_EXT_SPACE 1000
 
+/* incremental top-level updates */
+#define ENABLE_INCREMENTAL_TOPLEVEL 1
+#define INCREMENTAL_REBUILD_FRACTION 4 // full rebuild once a quarter of the objects got updated since the last one
+
 namespace embree
 {
   namespace isa
   {
     template<int N, typename Mesh>
     BVHNBuilderTwoLevel<N,Mesh>::BVHNBuilderTwoLevel (BVH* bvh, Scene* scene, const createMeshAccelTy createMeshAccel, const size_t singleThreadThreshold)
-      : bvh(bvh), objects(bvh->objects), scene(scene), createMeshAccel(createMeshAccel), refs(scene->device,0), prims(scene->device,0), singleThreadThreshold(singleThreadThreshold) {}
+      : bvh(bvh), objects(bvh->objects), scene(scene), createMeshAccel(createMeshAccel), refs(scene->device,0), prims(scene->device,0), singleThreadThreshold(singleThreadThreshold),
+        topLevelValid(false), topLevelChanges(0), numTopLevelObjects(0), leafRefs(scene->device,0), changedObjects(scene->device,0) {}
     
     template<int N, typename Mesh>
     BVHNBuilderTwoLevel<N,Mesh>::~BVHNBuilderTwoLevel () {
@@ -58,21 +63,21 @@ namespace embree
               delete objects[i]; objects[i] = nullptr;
             }
           });
+        topLevelValid = false;
       }
       
 #if PROFILE
       while(1) 
 #endif
       {
-      /* reset memory allocator */
-      bvh->alloc.reset();
-      
       /* skip build for empty scene */
       const size_t numPrimitives = scene->getNumPrimitives(Mesh::geom_type,false);
 
       if (numPrimitives == 0) {
+        bvh->alloc.reset();
         prims.resize(0);
         bvh->set(BVH::emptyNode,empty,0);
+        topLevelValid = false;
         return;
       }
 
@@ -82,7 +87,12 @@ namespace embree
       if (objects.size()  < num) objects.resize(num);
       if (builders.size() < num) builders.resize(num);
       if (refs.size()     < num) refs.resize(num);
+      if (changedObjects.size() < num) changedObjects.resize(num);
       nextRef.store(0);
+      nextChangedObject.store(0);
+
+      /* objects that get created or re-created are not referenced by the current top-level tree */
+      std::atomic<bool> topLevelMismatch(!topLevelValid || objectSlotsBegin.size() != num+1);
       
       /* create acceleration structures */
       parallel_for(size_t(0), num, [&] (const range<size_t>& r)
@@ -100,6 +110,7 @@ namespace embree
             Builder* builder = nullptr;
             createMeshAccel(scene, unsigned(objectID),(AccelData*&)objects[objectID],builder);
             builders[objectID] = BuilderState(builder,mesh->quality);
+            topLevelMismatch = true;
           }
 
           /* re-create when build quality changed */
@@ -108,6 +119,7 @@ namespace embree
             delete objects[objectID]; 
             createMeshAccel(scene, unsigned(objectID),(AccelData*&)objects[objectID],builder);
             builders[objectID] = BuilderState(builder,mesh->quality);
+            topLevelMismatch = true;
           }
         }
       });
@@ -126,12 +138,18 @@ namespace embree
           Ref<Builder>& builder = builders[objectID].builder; assert(builder);
 
           /* build object if it got modified */
-          if (scene->isGeometryModified(objectID))
+          if (scene->isGeometryModified(objectID)) {
             builder->build();
+            changedObjects[nextChangedObject++] = (unsigned int)objectID;
+          }
 
           /* create build primitive */
           if (!object->getBounds().empty())
           {
+            /* the top-level tree has to reference exactly the objects with a build primitive */
+            if (!topLevelMismatch && objectSlotsBegin[objectID] == objectSlotsBegin[objectID+1])
+              topLevelMismatch = true;
+
 #if ENABLE_DIRECT_SAH_MERGE_BUILDER
             refs[nextRef++] = BVHNBuilderTwoLevel::BuildRef(object->getBounds(),object->root,(unsigned int)objectID,(unsigned int)mesh->size());
 #else
@@ -145,6 +163,25 @@ namespace embree
 #if PROFILE
       double d0 = getSeconds();
 #endif
+
+#if ENABLE_INCREMENTAL_TOPLEVEL
+      /* only a few objects changed, update their references in the top-level tree instead of rebuilding it */
+      const size_t numChanged = nextChangedObject;
+      if (!topLevelMismatch && size_t(nextRef) == numTopLevelObjects &&
+          (topLevelChanges+numChanged)*INCREMENTAL_REBUILD_FRACTION <= numTopLevelObjects)
+      {
+        updateTopLevel(changedObjects.data(),numChanged);
+        bvh->device->numIncrementalUpdates++;
+        bvh->set(bvh->root,LBBox3fa(bvh->root.alignedNode()->bounds()),numPrimitives);
+        bvh->postBuild(t0);
+        return;
+      }
+#endif
+      topLevelValid = false;
+
+      /* reset memory allocator */
+      bvh->alloc.reset();
+
       /* fast path for single geometry scenes */
       if (nextRef == 1) { 
         bvh->set(refs[0].node,LBBox3fa(refs[0].bounds()),numPrimitives);
@@ -221,6 +258,8 @@ namespace embree
       
 #if ENABLE_DIRECT_SAH_MERGE_BUILDER
             refs.resize(extSize); 
+            leafRefs.resize(extSize);
+            nextLeafRef.store(0);
          
             NodeRef root = BVHBuilderBinnedOpenMergeSAH::build<NodeRef,BuildRef>(
               typename BVH::CreateAlloc(bvh),
@@ -229,6 +268,7 @@ namespace embree
               
               [&] (const BuildRef* refs, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> NodeRef  {
                 assert(range.size() == 1);
+                leafRefs[nextLeafRef++] = refs[range.begin()];
                 return (NodeRef) refs[range.begin()].node;
               },
               [&] (BuildRef &bref, BuildRef *refs) -> size_t { 
@@ -252,6 +292,9 @@ namespace embree
 
             
             bvh->set(root,LBBox3fa(pinfo.geomBounds),numPrimitives);
+#if ENABLE_DIRECT_SAH_MERGE_BUILDER && ENABLE_INCREMENTAL_TOPLEVEL
+            recordTopLevel(leafRefs.data(),nextLeafRef);
+#endif
           }
         }
 #if defined(TASKING_TBB) && defined(__AVX512ER__) && USE_TASK_ARENA // KNL
@@ -274,6 +317,7 @@ namespace embree
     void BVHNBuilderTwoLevel<N,Mesh>::deleteGeometry(size_t geomID)
     {
       if (geomID >= objects.size()) return;
+      topLevelValid = false;
       builders[geomID].clear();
       delete objects [geomID]; objects [geomID] = nullptr;
     }
@@ -288,6 +332,100 @@ namespace embree
 	if (builders[i].builder) builders[i].builder->clear();
 
       refs.clear();
+      topLevelValid = false;
+    }
+
+    template<int N, typename Mesh>
+    void BVHNBuilderTwoLevel<N,Mesh>::recordTopLevel(const BuildRef* leaves, size_t numLeaves)
+    {
+      topLevelValid = false;
+      topLevelChanges = 0;
+      objectSlots.clear();
+      parentSlots.clear();
+      if (!bvh->root.isAlignedNode())
+        return;
+
+      /* the object subtrees the top-level leaves point to */
+      std::vector<std::pair<size_t,unsigned int>> leafNodes(numLeaves);
+      for (size_t i=0; i<numLeaves; i++)
+        leafNodes[i] = std::make_pair((size_t)leaves[i].node,leaves[i].geomID());
+      std::sort(leafNodes.begin(),leafNodes.end());
+
+      auto findLeaf = [&] (NodeRef ref) {
+        auto leaf = std::lower_bound(leafNodes.begin(),leafNodes.end(),std::make_pair((size_t)ref,0u));
+        return (leaf != leafNodes.end() && leaf->first == (size_t)ref) ? leaf : leafNodes.end();
+      };
+      if (findLeaf(bvh->root) != leafNodes.end())
+        return;
+
+      /* collect the parent of each top-level node and the leaf slots of each object */
+      std::vector<AlignedNode*> stack;
+      stack.push_back(bvh->root.alignedNode());
+      parentSlots[stack.back()] = TopLevelSlot(nullptr,0);
+      while (!stack.empty())
+      {
+        AlignedNode* node = stack.back(); stack.pop_back();
+        for (unsigned int i=0; i<N; i++)
+        {
+          NodeRef child = node->child(i);
+          if (child == BVH::emptyNode) continue;
+
+          auto leaf = findLeaf(child);
+          if (leaf != leafNodes.end())
+            objectSlots.push_back(TopLevelSlot(node,i,leaf->second));
+          else if (child.isAlignedNode()) {
+            parentSlots[child.alignedNode()] = TopLevelSlot(node,i);
+            stack.push_back(child.alignedNode());
+          }
+          else
+            return;
+        }
+      }
+
+      std::sort(objectSlots.begin(),objectSlots.end(),[] (const TopLevelSlot& a, const TopLevelSlot& b) { return a.geomID < b.geomID; });
+      objectSlotsBegin.assign(scene->size()+1,0);
+      for (const TopLevelSlot& slot : objectSlots)
+        objectSlotsBegin[slot.geomID+1]++;
+
+      numTopLevelObjects = 0;
+      for (size_t i=1; i<objectSlotsBegin.size(); i++) {
+        numTopLevelObjects += objectSlotsBegin[i] != 0;
+        objectSlotsBegin[i] += objectSlotsBegin[i-1];
+      }
+      topLevelValid = true;
+    }
+
+    template<int N, typename Mesh>
+    void BVHNBuilderTwoLevel<N,Mesh>::updateTopLevel(const unsigned int* changed, size_t numChanged)
+    {
+      for (size_t i=0; i<numChanged; i++)
+      {
+        const unsigned int geomID = changed[i];
+        const BVH* object = objects[geomID];
+
+        for (size_t j=objectSlotsBegin[geomID]; j<objectSlotsBegin[geomID+1]; j++)
+        {
+          /* the first slot gets the new root, the others pointed to subtrees of the old object BVH */
+          const TopLevelSlot& slot = objectSlots[j];
+          if (j == objectSlotsBegin[geomID]) {
+            slot.node->child(slot.child) = object->root;
+            slot.node->setBounds(slot.child,object->getBounds());
+          } else {
+            slot.node->child(slot.child) = BVH::emptyNode;
+            slot.node->setBounds(slot.child,BBox3fa(empty));
+          }
+
+          /* refit the path to the root */
+          for (AlignedNode* node = slot.node;;)
+          {
+            const TopLevelSlot& parent = parentSlots[node];
+            if (parent.node == nullptr) break;
+            parent.node->setBounds(parent.child,node->bounds());
+            node = parent.node;
+          }
+        }
+      }
+      topLevelChanges += numChanged;
     }
 
     template<int N, typename Mesh>
@@ -113,6 +113,12 @@ namespace embree
 
       void open_sequential(const size_t extSize);
 
+      /*! records where the top-level tree references the object BVHs */
+      void recordTopLevel(const BuildRef* leaves, size_t numLeaves);
+
+      /*! replaces the references to changed objects and refits their top-level paths */
+      void updateTopLevel(const unsigned int* changed, size_t numChanged);
+
     public:
       
       struct BuilderState
@@ -146,6 +152,29 @@ namespace embree
       std::atomic<int> nextRef;
       const size_t singleThreadThreshold;
 
+      /* state for incremental top-level updates */
+      struct TopLevelSlot
+      {
+        TopLevelSlot () {}
+        TopLevelSlot (AlignedNode* node, unsigned int child, unsigned int geomID = 0)
+          : node(node), child(child), geomID(geomID) {}
+
+        AlignedNode* node;     //!< top-level node referencing the child
+        unsigned int child;    //!< child slot inside that node
+        unsigned int geomID;   //!< object referenced by leaf slots
+      };
+
+      bool topLevelValid;                                        //!< top-level tree can be updated incrementally
+      size_t topLevelChanges;                                    //!< object updates applied since the last full build
+      size_t numTopLevelObjects;                                 //!< number of objects referenced by the top-level tree
+      std::vector<TopLevelSlot> objectSlots;                     //!< leaf slots of the top-level tree, sorted by geomID
+      std::vector<size_t> objectSlotsBegin;                      //!< range of leaf slots of each object
+      std::map<AlignedNode*,TopLevelSlot> parentSlots;           //!< parent slot of each top-level node
+      mvector<BuildRef> leafRefs;                                //!< object subtrees referenced by the top-level leaves
+      std::atomic<size_t> nextLeafRef;
+      mvector<unsigned int> changedObjects;
+      std::atomic<size_t> nextChangedObject;
+
       typedef mvector<BuildRef> bvector;
 
     };
@@ -34,19 +34,6 @@ namespace embree
     CSTAT(std::atomic<size_t> bvh_collide_prim_intersections5(0));
     CSTAT(std::atomic<size_t> bvh_collide_prim_intersections(0));
 
-    struct Collision
-    {
-      __forceinline Collision() {}
-
-      __forceinline Collision (unsigned geomID0, unsigned primID0, unsigned geomID1, unsigned primID1)
-        : geomID0(geomID0), primID0(primID0), geomID1(geomID1), primID1(primID1) {}
-
-      unsigned geomID0;
-      unsigned primID0;
-      unsigned geomID1;
-      unsigned primID1;
-    };
-    
     template<int N>
     __forceinline size_t overlap(const BBox3fa& box0, const typename BVHN<N>::AlignedNode& node1)
     {
@@ -121,39 +108,88 @@ namespace embree
     }
     
     template<int N>
-    __forceinline void BVHNColliderUserGeom<N>::processLeaf(NodeRef node0, NodeRef node1)
+    __forceinline void BVHNColliderUserGeom<N>::processLeaf(NodeRef node0, NodeRef node1, CollisionBuffer& collisions)
     {
-      Collision collisions[16];
-      size_t num_collisions = 0;
-
+      /* a leaf colliding with itself reports each pair of its primitives only once */
+      const bool sameLeaf = this->selfCollision && node0 == node1;
       size_t N0; Object* leaf0 = (Object*) node0.leaf(N0);
       size_t N1; Object* leaf1 = (Object*) node1.leaf(N1);
       for (size_t i=0; i<N0; i++) {
-        for (size_t j=0; j<N1; j++) {
+        for (size_t j=sameLeaf ? i+1 : 0; j<N1; j++) {
           const unsigned geomID0 = leaf0[i].geomID();
           const unsigned primID0 = leaf0[i].primID();
           const unsigned geomID1 = leaf1[j].geomID();
           const unsigned primID1 = leaf1[j].primID();
-          if (this->scene0 == this->scene1 && geomID0 == geomID1 && primID0 == primID1) continue;
-          collisions[num_collisions++] = Collision(geomID0,primID0,geomID1,primID1);
-          if (num_collisions == 16) {
-            this->callback(this->userPtr,(RTCCollision*)&collisions,num_collisions);
-            num_collisions = 0;
+          if (this->selfCollision && geomID0 == geomID1 && primID0 == primID1) continue;
+          collisions.add(geomID0,primID0,geomID1,primID1);
+        }
+      }
+    }
+
+    template<int N, typename Primitive>
+    __forceinline void BVHNColliderTriangle<N,Primitive>::processLeaf(NodeRef node0, NodeRef node1, CollisionBuffer& collisions)
+    {
+      size_t N0; const Primitive* leaf0 = (const Primitive*) node0.leaf(N0);
+      size_t N1; const Primitive* leaf1 = (const Primitive*) node1.leaf(N1);
+
+      /* gather bounds of all triangles of the second leaf in SIMD layout, padding lanes get empty bounds */
+      static const size_t MAX_TRIANGLES = BVH::maxLeafBlocks*16;
+      BBox<Vec3vf4> bounds1[MAX_TRIANGLES/4];
+      unsigned geomIDs1[MAX_TRIANGLES], primIDs1[MAX_TRIANGLES];
+      size_t num1 = 0;
+      for (size_t j=0; j<N1; j++)
+      {
+        for (size_t k=0; k<Primitive::max_size() && leaf1[j].valid(k); k++)
+        {
+          assert(num1 < MAX_TRIANGLES);
+          const unsigned geomID = leaf1[j].geomID(k);
+          const unsigned primID = leaf1[j].primID(k);
+          const BBox3fa b = this->scene1->template get<TriangleMesh>(geomID)->bounds(primID);
+          if (num1%4 == 0) bounds1[num1/4] = BBox<Vec3vf4>(Vec3vf4(pos_inf),Vec3vf4(neg_inf));
+          BBox<Vec3vf4>& bb = bounds1[num1/4];
+          bb.lower.x[num1%4] = b.lower.x; bb.lower.y[num1%4] = b.lower.y; bb.lower.z[num1%4] = b.lower.z;
+          bb.upper.x[num1%4] = b.upper.x; bb.upper.y[num1%4] = b.upper.y; bb.upper.z[num1%4] = b.upper.z;
+          geomIDs1[num1] = geomID; primIDs1[num1] = primID;
+          num1++;
+        }
+      }
+
+      /* a leaf colliding with itself only tests the triangles following the current one */
+      const bool sameLeaf = this->selfCollision && node0 == node1;
+
+      /* cull triangle pairs by their bounds, then perform exact triangle/triangle tests */
+      size_t num0 = 0;
+      for (size_t i=0; i<N0; i++)
+      {
+        for (size_t k=0; k<Primitive::max_size() && leaf0[i].valid(k); k++, num0++)
+        {
+          const unsigned geomID0 = leaf0[i].geomID(k);
+          const unsigned primID0 = leaf0[i].primID(k);
+          const BBox3fa b0 = this->scene0->template get<TriangleMesh>(geomID0)->bounds(primID0);
+          for (size_t j=sameLeaf ? (num0+1) & ~size_t(3) : 0; j<num1; j+=4)
+          {
+            size_t mask = overlap<4>(b0,bounds1[j/4]);
+            if (sameLeaf && j <= num0) mask &= ~((size_t(2) << (num0-j))-1);
+            for (size_t m=mask, l=bsf(m); m!=0; m=btc(m,l), l=bsf(m))
+            {
+              const unsigned geomID1 = geomIDs1[j+l];
+              const unsigned primID1 = primIDs1[j+l];
+              if (intersect_triangle_triangle(this->scene0,geomID0,primID0,this->scene1,geomID1,primID1))
+                collisions.add(geomID0,primID0,geomID1,primID1);
+            }
           }
         }
       }
-      if (num_collisions)
-        this->callback(this->userPtr,(RTCCollision*)&collisions,num_collisions);
     }
 
     template<int N>
-    void BVHNCollider<N>::collide_recurse(NodeRef ref0, const BBox3fa& bounds0, NodeRef ref1, const BBox3fa& bounds1, size_t depth0, size_t depth1)
+    void BVHNCollider<N>::collide_recurse(NodeRef ref0, const BBox3fa& bounds0, NodeRef ref1, const BBox3fa& bounds1, size_t depth0, size_t depth1, CollisionBuffer& collisions)
     {
       CSTAT(bvh_collide_traversal_steps++);
       if (unlikely(ref0.isLeaf())) {
         if (unlikely(ref1.isLeaf())) {
           CSTAT(bvh_collide_leaf_pairs++);
-          processLeaf(ref0,ref1);
+          processLeaf(ref0,ref1,collisions);
           return;
         } else goto recurse_node1;
         
@@ -161,13 +197,31 @@ namespace embree
         if (unlikely(ref1.isLeaf())) {
           goto recurse_node0;
         } else {
-          if (area(bounds0) > area(bounds1)) {
-            goto recurse_node0;
-          }
-          else {
-            goto recurse_node1;
+          goto recurse_both;
+        }
+      }
+
+      {
+      recurse_both:
+        /* open both nodes, each child of the first node is tested against all children of the second node at once */
+        AlignedNode* node0 = ref0.alignedNode();
+        AlignedNode* node1 = ref1.alignedNode();
+        /* a node colliding with itself only visits each pair of its children once */
+        const bool sameNode = selfCollision && ref0 == ref1;
+        size_t mask0 = overlap<N>(bounds1,*node0);
+        for (size_t m0=mask0, i=bsf(m0); m0!=0; m0=btc(m0,i), i=bsf(m0))
+        {
+          const BBox3fa cbounds0 = node0->bounds(i);
+          size_t mask1 = overlap<N>(cbounds0,*node1);
+          if (sameNode) mask1 &= ~((size_t(1) << i)-1);
+          if (mask1 == 0) continue;
+          node0->child(i).prefetch(BVH_FLAG_ALIGNED_NODE);
+          for (size_t m1=mask1, j=bsf(m1); m1!=0; m1=btc(m1,j), j=bsf(m1)) {
+            node1->child(j).prefetch(BVH_FLAG_ALIGNED_NODE);
+            collide_recurse(node0->child(i),cbounds0,node1->child(j),node1->bounds(j),depth0+1,depth1+1,collisions);
           }
         }
+        return;
       }
 
       {
@@ -182,7 +236,7 @@ namespace embree
           parallel_for(size_t(N), [&] ( size_t i ) {
               if (mask & ( 1 << i)) {
                 node0->child(i).prefetch(BVH_FLAG_ALIGNED_NODE);
-                collide_recurse(node0->child(i),node0->bounds(i),ref1,bounds1,depth0+1,depth1);
+                collide_recurse(node0->child(i),node0->bounds(i),ref1,bounds1,depth0+1,depth1,collisions);
               }
             });
         } 
@@ -191,7 +245,7 @@ namespace embree
         {
           for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
             node0->child(i).prefetch(BVH_FLAG_ALIGNED_NODE);
-            collide_recurse(node0->child(i),node0->bounds(i),ref1,bounds1,depth0+1,depth1);
+            collide_recurse(node0->child(i),node0->bounds(i),ref1,bounds1,depth0+1,depth1,collisions);
           }
         }
         return;
@@ -209,7 +263,7 @@ namespace embree
           parallel_for(size_t(N), [&] ( size_t i ) {
               if (mask & ( 1 << i)) {
                 node1->child(i).prefetch(BVH_FLAG_ALIGNED_NODE);
-                collide_recurse(ref0,bounds0,node1->child(i),node1->bounds(i),depth0,depth1+1);
+                collide_recurse(ref0,bounds0,node1->child(i),node1->bounds(i),depth0,depth1+1,collisions);
               }
             });
         }
@@ -218,7 +272,7 @@ namespace embree
         {
           for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
             node1->child(i).prefetch(BVH_FLAG_ALIGNED_NODE);
-            collide_recurse(ref0,bounds0,node1->child(i),node1->bounds(i),depth0,depth1+1);
+            collide_recurse(ref0,bounds0,node1->child(i),node1->bounds(i),depth0,depth1+1,collisions);
           }
         }
         return;
@@ -236,6 +290,8 @@ namespace embree
       } else {
         if (unlikely(job.ref1.isLeaf())) {
           goto recurse_node0;
+        } else if (unlikely(selfCollision && job.ref0 == job.ref1)) {
+          goto recurse_same;
         } else {
           if (area(job.bounds0) > area(job.bounds1)) {
             goto recurse_node0;
@@ -265,6 +321,19 @@ namespace embree
         }
         return;
       }
+
+      {
+      recurse_same:
+        /* a node colliding with itself creates one job for each unordered pair of overlapping children */
+        const AlignedNode* node = job.ref0.alignedNode();
+        size_t mask0 = overlap<N>(job.bounds0,*node);
+        for (size_t m0=mask0, i=bsf(m0); m0!=0; m0=btc(m0,i), i=bsf(m0)) {
+          size_t mask1 = overlap<N>(node->bounds(i),*node) & ~((size_t(1) << i)-1);
+          for (size_t m1=mask1, j=bsf(m1); m1!=0; m1=btc(m1,j), j=bsf(m1))
+            jobs.push_back(CollideJob(node->child(i),node->bounds(i),job.depth0+1,node->child(j),node->bounds(j),job.depth1+1));
+        }
+        return;
+      }
     }
     
     template<int N>
@@ -280,9 +349,11 @@ namespace embree
       CSTAT(bvh_collide_prim_intersections5 = 0);
       CSTAT(bvh_collide_prim_intersections = 0);
 #if 0
-      collide_recurse(ref0,bounds0,ref1,bounds1,0,0);
+      CollisionBuffer collisions(this);
+      collide_recurse(ref0,bounds0,ref1,bounds1,0,0,collisions);
 #else
-      const int M = 2048;
+      const size_t M = 2048;
+      const size_t MAX_SPLIT_JOBS = N*(N+1)/2; // maximal number of jobs a single job gets split into
       jobvector jobs[2];
       jobs[0].reserve(M);
       jobs[1].reserve(M);
@@ -291,13 +362,13 @@ namespace embree
       int target = 1;
 
       /* try to split job until job list is full */
-      while (jobs[source].size()+8 <= M)
+      while (jobs[source].size()+MAX_SPLIT_JOBS <= M)
       {
         for (size_t i=0; i<jobs[source].size(); i++)
         {
           const CollideJob& job = jobs[source][i];
           size_t remaining = jobs[source].size()-i;
-          if (jobs[target].size()+remaining+8 > M) {
+          if (jobs[target].size()+remaining+MAX_SPLIT_JOBS > M) {
             jobs[target].push_back(job);
           } else {
             split(job,jobs[target]);
@@ -312,10 +383,15 @@ namespace embree
         std::swap(source,target);
       }
 
-      /* parallel processing of all jobs */
-      parallel_for(size_t(jobs[source].size()), [&] ( size_t i ) {
-          CollideJob& j = jobs[source][i];
-          collide_recurse(j.ref0,j.bounds0,j.ref1,j.bounds1,j.depth0,j.depth1);
+      /* parallel processing of all jobs, each task processes a range of jobs and reports their collisions together */
+      const size_t numJobs = jobs[source].size();
+      const size_t blockSize = max(size_t(1),numJobs/(8*TaskScheduler::threadCount()));
+      parallel_for(size_t(0), numJobs, blockSize, [&] (const range<size_t>& r) {
+          CollisionBuffer collisions(this);
+          for (size_t i=r.begin(); i<r.end(); i++) {
+            CollideJob& j = jobs[source][i];
+            collide_recurse(j.ref0,j.bounds0,j.ref1,j.bounds1,j.depth0,j.depth1,collisions);
+          }
         });
       
       
@@ -338,6 +414,13 @@ namespace embree
         collide_recurse_entry(bvh0->root,bvh0->bounds.bounds(),bvh1->root,bvh1->bounds.bounds());
     }
 
+    template<int N, typename Primitive>
+    void BVHNColliderTriangle<N,Primitive>::collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr)
+    {
+      BVHNColliderTriangle<N,Primitive>(bvh0->scene,bvh1->scene,callback,userPtr).
+        collide_recurse_entry(bvh0->root,bvh0->bounds.bounds(),bvh1->root,bvh1->bounds.bounds());
+    }
+
 #if defined (EMBREE_LOWEST_ISA)
     struct collision_regression_test : public RegressionTest
     {
@@ -380,9 +463,18 @@ namespace embree
     ////////////////////////////////////////////////////////////////////////////////
 
     DEFINE_COLLIDER(BVH4ColliderUserGeom,BVHNColliderUserGeom<4>);
+    IF_ENABLED_TRIS(DEFINE_COLLIDER(BVH4Triangle4Collider,BVHNColliderTriangle<4 COMMA Triangle4>));
+    IF_ENABLED_TRIS(DEFINE_COLLIDER(BVH4Triangle4vCollider,BVHNColliderTriangle<4 COMMA Triangle4v>));
+    IF_ENABLED_TRIS(DEFINE_COLLIDER(BVH4Triangle4iCollider,BVHNColliderTriangle<4 COMMA Triangle4i>));
 
 #if defined(__AVX__)
     DEFINE_COLLIDER(BVH8ColliderUserGeom,BVHNColliderUserGeom<8>);
+    IF_ENABLED_TRIS(DEFINE_COLLIDER(BVH8Triangle4Collider,BVHNColliderTriangle<8 COMMA Triangle4>));
+    IF_ENABLED_TRIS(DEFINE_COLLIDER(BVH8Triangle4vCollider,BVHNColliderTriangle<8 COMMA Triangle4v>));
+    IF_ENABLED_TRIS(DEFINE_COLLIDER(BVH8Triangle4iCollider,BVHNColliderTriangle<8 COMMA Triangle4i>));
+#elif defined(EMBREE_BVH8_SIMD4)
+    /* on 4-wide ISAs only the double-pumped BVH8<Triangle4> is supported */
+    IF_ENABLED_TRIS(DEFINE_COLLIDER(BVH8Triangle4Collider,BVHNColliderTriangle<8 COMMA Triangle4>));
 #endif
   }
 }
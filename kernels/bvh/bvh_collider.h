@@ -17,7 +17,9 @@
 #pragma once
 
 #include "bvh.h"
+#include "../geometry/triangle.h"
 #include "../geometry/trianglev.h"
+#include "../geometry/trianglei.h"
 #include "../geometry/object.h"
 
 namespace embree
@@ -50,19 +52,54 @@ namespace embree
       typedef vector_t<CollideJob, aligned_allocator<CollideJob,16>> jobvector;
 
       void split(const CollideJob& job, jobvector& jobs);
+
+    protected:
+
+      /* per task buffer that batches collisions into large callback invocations */
+      struct CollisionBuffer
+      {
+        static const size_t MAX_COLLISIONS = 256;
+
+        __forceinline CollisionBuffer (const BVHNCollider* collider)
+          : collider(collider), num(0) {}
+
+        __forceinline ~CollisionBuffer () {
+          flush();
+        }
+
+        __forceinline void add(unsigned geomID0, unsigned primID0, unsigned geomID1, unsigned primID1)
+        {
+          RTCCollision& c = collisions[num++];
+          c.geomID0 = geomID0; c.primID0 = primID0;
+          c.geomID1 = geomID1; c.primID1 = primID1;
+          if (unlikely(num == MAX_COLLISIONS)) flush();
+        }
+
+        __forceinline void flush()
+        {
+          if (num == 0) return;
+          collider->callback(collider->userPtr,collisions,(unsigned int)num);
+          num = 0;
+        }
+
+        const BVHNCollider* collider;
+        size_t num;
+        RTCCollision collisions[MAX_COLLISIONS];
+      };
       
     public:
       __forceinline BVHNCollider (Scene* scene0, Scene* scene1, RTCCollideFunc callback, void* userPtr)
-        : scene0(scene0), scene1(scene1), callback(callback), userPtr(userPtr) {}
+        : scene0(scene0), scene1(scene1), selfCollision(scene0 == scene1), callback(callback), userPtr(userPtr) {}
 
     public:
-      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1) = 0;
-      void collide_recurse(NodeRef node0, const BBox3fa& bounds0, NodeRef node1, const BBox3fa& bounds1, size_t depth0, size_t depth1);
+      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1, CollisionBuffer& collisions) = 0;
+      void collide_recurse(NodeRef node0, const BBox3fa& bounds0, NodeRef node1, const BBox3fa& bounds1, size_t depth0, size_t depth1, CollisionBuffer& collisions);
       void collide_recurse_entry(NodeRef node0, const BBox3fa& bounds0, NodeRef node1, const BBox3fa& bounds1);
     
     protected:
       Scene* scene0;
       Scene* scene1;
+      bool selfCollision;  //!< scene collides with itself, thus each pair of primitives is only reported once
       RTCCollideFunc callback;
       void* userPtr;
     };
@@ -73,11 +110,30 @@ namespace embree
       typedef BVHN<N> BVH;
       typedef typename BVH::NodeRef NodeRef;
       typedef typename BVH::AlignedNode AlignedNode;
+      typedef typename BVHNCollider<N>::CollisionBuffer CollisionBuffer;
 
       __forceinline BVHNColliderUserGeom (Scene* scene0, Scene* scene1, RTCCollideFunc callback, void* userPtr)
         : BVHNCollider<N>(scene0,scene1,callback,userPtr) {}
 
-      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1);
+      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1, CollisionBuffer& collisions);
+    public:
+      static void collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr);
+    };
+
+    /*! Collider for triangle meshes, reports only pairs of triangles
+     *  that really intersect. */
+    template<int N, typename Primitive>
+      class BVHNColliderTriangle : public BVHNCollider<N>
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef typename BVH::AlignedNode AlignedNode;
+      typedef typename BVHNCollider<N>::CollisionBuffer CollisionBuffer;
+
+      __forceinline BVHNColliderTriangle (Scene* scene0, Scene* scene1, RTCCollideFunc callback, void* userPtr)
+        : BVHNCollider<N>(scene0,scene1,callback,userPtr) {}
+
+      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1, CollisionBuffer& collisions);
     public:
       static void collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr);
     };
@@ -58,7 +58,7 @@ namespace embree
       StackItemT<NodeRef> stack[stackSize];    // stack of nodes
       StackItemT<NodeRef>* stackPtr = stack+1; // current stack pointer
       StackItemT<NodeRef>* stackEnd = stack+stackSize;
-      stack[0].ptr  = bvh->root;
+      stack[0].ptr  = bvh->getTraversalRoot();
       stack[0].dist = neg_inf;
       
       if (bvh->root == BVH::emptyNode)
@@ -153,7 +153,7 @@ namespace embree
       NodeRef stack[stackSize];    // stack of nodes that still need to get traversed
       NodeRef* stackPtr = stack+1; // current stack pointer
       NodeRef* stackEnd = stack+stackSize;
-      stack[0] = bvh->root;
+      stack[0] = bvh->getTraversalRoot();
 
       /* filter out invalid rays */
 #if defined(EMBREE_IGNORE_INVALID_RAYS)
@@ -215,13 +215,14 @@ namespace embree
     }
 
     template<int N, int types, bool robust, typename PrimitiveIntersector1>
-    struct PointQueryDispatch
+    struct PointQueryTraversal
     {
       typedef typename PrimitiveIntersector1::Precalculations Precalculations;
       typedef typename PrimitiveIntersector1::Primitive Primitive;
       typedef BVHN<N> BVH;
       typedef typename BVH::NodeRef NodeRef;
       typedef typename BVH::AlignedNode AlignedNode;
+      typedef typename BVH::AlignedNodeMB AlignedNodeMB;
       typedef typename BVH::AlignedNodeMB4D AlignedNodeMB4D;
 
       static const size_t stackSize = 1+(N-1)*BVH::maxDepth+3; // +3 due to 16-wide store
@@ -241,14 +242,14 @@ namespace embree
         StackItemT<NodeRef> stack[stackSize];    // stack of nodes
         StackItemT<NodeRef>* stackPtr = stack+1; // current stack pointer
         StackItemT<NodeRef>* stackEnd = stack+stackSize;
-        stack[0].ptr  = bvh->root;
+        stack[0].ptr  = bvh->getTraversalRoot();
         stack[0].dist = neg_inf;
         
         /* verify correct input */
         assert(!(types & BVH_MB) || (query->time >= 0.0f && query->time <= 1.0f));
 
         /* load the point query into SIMD registers */
-        TravPointQuery<N> tquery(query->p, context->query_radius);
+        TravPointQuery<N> tquery(query->p, queryRadius(query, context));
 
         /* initialize the node traverser */
         BVHNNodeTraverser1Hit<N, N, types> nodeTraverser;
@@ -300,7 +301,7 @@ namespace embree
           if (PrimitiveIntersector1::pointQuery(This, query, context, prim, num, tquery, lazy_node))
           {
             changed = true;
-            tquery.rad = context->query_radius;
+            tquery.rad = queryRadius(query, context);
             cull_radius = context->query_type == POINT_QUERY_TYPE_SPHERE
                         ? query->radius * query->radius
                         : dot(context->query_radius, context->query_radius);
@@ -315,22 +316,224 @@ namespace embree
         }
         return changed;
       }
+
+      /* sphere queries are culled with the radius of the query at the current instance level */
+      static __forceinline Vec3fa queryRadius(const PointQuery* query, const PointQueryContext* context)
+      {
+        return context->query_type == POINT_QUERY_TYPE_SPHERE
+             ? Vec3fa(query->radius)
+             : context->query_radius;
+      }
+
+      static __forceinline float cullRadius(const PointQuery* query, const PointQueryContext* context)
+      {
+        return context->query_type == POINT_QUERY_TYPE_SPHERE
+             ? query->radius * query->radius
+             : dot(context->query_radius, context->query_radius);
+      }
+
+      /* squared distance of the query points to child i of a node, only valid for aligned nodes */
+      template<int K>
+      static __forceinline vfloat<K> childDist(const NodeRef& cur, size_t i, const Vec3vf<K>& org, const Vec3vf<K>& rad, const vfloat<K>& time, bool sphere, vbool<K>& overlap)
+      {
+        Vec3vf<K> lower, upper;
+        if (types == BVH_AN1) {
+          const AlignedNode* node = cur.alignedNode();
+          lower = Vec3vf<K>(node->lower_x[i],node->lower_y[i],node->lower_z[i]);
+          upper = Vec3vf<K>(node->upper_x[i],node->upper_y[i],node->upper_z[i]);
+        } else {
+          const AlignedNodeMB* node = cur.alignedNodeMB();
+          lower = Vec3vf<K>(madd(time,vfloat<K>(node->lower_dx[i]),vfloat<K>(node->lower_x[i])),
+                            madd(time,vfloat<K>(node->lower_dy[i]),vfloat<K>(node->lower_y[i])),
+                            madd(time,vfloat<K>(node->lower_dz[i]),vfloat<K>(node->lower_z[i])));
+          upper = Vec3vf<K>(madd(time,vfloat<K>(node->upper_dx[i]),vfloat<K>(node->upper_x[i])),
+                            madd(time,vfloat<K>(node->upper_dy[i]),vfloat<K>(node->upper_y[i])),
+                            madd(time,vfloat<K>(node->upper_dz[i]),vfloat<K>(node->upper_z[i])));
+        }
+        const Vec3vf<K> v = min(max(org,lower),upper) - org;
+        if (!sphere) {
+          overlap = !((upper.x < org.x - rad.x) | (lower.x > org.x + rad.x) |
+                      (upper.y < org.y - rad.y) | (lower.y > org.y + rad.y) |
+                      (upper.z < org.z - rad.z) | (lower.z > org.z + rad.z));
+        }
+        return v.x*v.x + v.y*v.y + v.z*v.z;
+      }
+
+      /* traverses up to K point queries as a packet, the queries share the node tests and only
+       * leaves are processed per query */
+      template<int K>
+      static bool pointQueryK(const Accel::Intersectors* This, PointQuery** query, PointQueryContext** context, size_t num)
+      {
+        const BVH* __restrict__ bvh = (const BVH*)This->ptr;
+
+        /* we may traverse an empty BVH in case all geometry was invalid */
+        if (bvh->root == BVH::emptyNode)
+          return false;
+
+        /* all queries share the instance stack, thus have the same query type */
+        const bool sphere = context[0]->query_type == POINT_QUERY_TYPE_SPHERE;
+
+        /* load the point queries into SIMD registers, unused lanes get culled everywhere */
+        Vec3vf<K> org(zero), rad(zero);
+        vfloat<K> time(zero), cull(neg_inf);
+        for (size_t k=0; k<num; k++)
+        {
+          assert(!(types & BVH_MB) || (query[k]->time >= 0.0f && query[k]->time <= 1.0f));
+          org.x[k] = query[k]->p.x; org.y[k] = query[k]->p.y; org.z[k] = query[k]->p.z;
+          const Vec3fa r = queryRadius(query[k],context[k]); rad.x[k] = r.x; rad.y[k] = r.y; rad.z[k] = r.z;
+          time[k] = query[k]->time;
+          cull[k] = cullRadius(query[k],context[k]);
+        }
+
+        /* stack state */
+        vfloat<K> stack_near[stackSize];
+        NodeRef stack_node[stackSize];
+        stack_node[0] = bvh->getTraversalRoot();
+        stack_near[0] = select(vint<K>(step) < vint<K>(int(num)),vfloat<K>(neg_inf),vfloat<K>(inf));
+        NodeRef* __restrict__ sptr_node = stack_node + 1;
+        vfloat<K>* __restrict__ sptr_near = stack_near + 1;
+
+        bool changed = false;
+
+        /* pop loop */
+        while (true) pop:
+        {
+          /* pop next node */
+          if (unlikely(sptr_node == stack_node)) break;
+          sptr_node--;
+          sptr_near--;
+          NodeRef cur = *sptr_node;
+          vfloat<K> curDist = *sptr_near;
+
+          /* if popped node is too far for all queries, pop next one */
+          if (unlikely(none(curDist <= cull)))
+            continue;
+
+          /* downtraversal loop */
+          while (likely(!cur.isLeaf()))
+          {
+            STAT3(point_query.trav_nodes,1,1,1);
+            const vbool<K> active = curDist <= cull;
+
+            /* intersect all children with the packet */
+            size_t numHits = 0;
+            NodeRef hitNode[N];
+            vfloat<K> hitDist[N];
+            float hitKey[N];
+            for (size_t i=0; i<N; i++)
+            {
+              const NodeRef child = types == BVH_AN1 ? cur.alignedNode()->child(i) : cur.alignedNodeMB()->child(i);
+              if (child == BVH::emptyNode) continue;
+              vbool<K> overlap(true);
+              const vfloat<K> dist = childDist<K>(cur,i,org,rad,time,sphere,overlap);
+              const vbool<K> vmask = active & (dist <= cull) & overlap;
+              if (none(vmask)) continue;
+
+              /* insertion sort by closest query distance */
+              const vfloat<K> d = select(vmask,dist,vfloat<K>(inf));
+              const float key = reduce_min(d);
+              size_t j = numHits++;
+              for (; j>0 && hitKey[j-1] > key; j--) {
+                hitNode[j] = hitNode[j-1]; hitDist[j] = hitDist[j-1]; hitKey[j] = hitKey[j-1];
+              }
+              hitNode[j] = child; hitDist[j] = d; hitKey[j] = key;
+            }
+
+            /* if no child is hit, pop next node */
+            if (unlikely(numHits == 0))
+              goto pop;
+
+            /* continue with the closest child and push the others far to near */
+            for (size_t j=numHits-1; j>0; j--) {
+              *sptr_node++ = hitNode[j];
+              *sptr_near++ = hitDist[j];
+              assert(sptr_node - stack_node < (ptrdiff_t)stackSize);
+            }
+            cur = hitNode[0];
+            curDist = hitDist[0];
+          }
+
+          /* this is a leaf node, intersect each active query separately */
+          assert(cur != BVH::emptyNode);
+          STAT3(point_query.trav_leaves,1,1,1);
+          size_t numPrims; Primitive* prim = (Primitive*)cur.leaf(numPrims);
+          size_t m_active = movemask(curDist <= cull);
+          while (m_active)
+          {
+            const size_t k = bscf(m_active);
+            TravPointQuery<N> tquery(query[k]->p, queryRadius(query[k], context[k]));
+            size_t lazy_node = 0;
+            if (PrimitiveIntersector1::pointQuery(This, query[k], context[k], prim, numPrims, tquery, lazy_node))
+            {
+              changed = true;
+              cull[k] = cullRadius(query[k],context[k]);
+              const Vec3fa r = queryRadius(query[k],context[k]); rad.x[k] = r.x; rad.y[k] = r.y; rad.z[k] = r.z;
+            }
+
+            /* push lazy node onto stack for that query only */
+            if (unlikely(lazy_node)) {
+              *sptr_node++ = (NodeRef)lazy_node;
+              *sptr_near++ = select(vint<K>(step) == vint<K>(int(k)),vfloat<K>(neg_inf),vfloat<K>(inf));
+            }
+          }
+        }
+        return changed;
+      }
+
+      static __forceinline bool pointQuery1M(const Accel::Intersectors* This, PointQuery** query, PointQueryContext** context, size_t M)
+      {
+        bool changed = false;
+
+        /* packet traversal is only implemented for aligned nodes */
+        if (types != BVH_AN1 && types != BVH_AN2) {
+          for (size_t i=0; i<M; i++)
+            changed |= pointQuery(This, query[i], context[i]);
+          return changed;
+        }
+
+        for (size_t i=0; i<M; i+=VSIZEX)
+        {
+          const size_t num = min(M-i,size_t(VSIZEX));
+          if (num == 1) changed |= pointQuery(This, query[i], context[i]);
+          else          changed |= pointQueryK<VSIZEX>(This, query+i, context+i, num);
+        }
+        return changed;
+      }
     };
 
-    /* disable point queries for not yet supported geometry types */
+    template<int N, int types, bool robust, typename PrimitiveIntersector1>
+    struct PointQueryDispatch : public PointQueryTraversal<N, types, robust, PrimitiveIntersector1> {};
+
+    /* curves are not supported yet, points are only supported by the built-in closest and nearest point queries */
     template<int N, int types, bool robust>
-    struct PointQueryDispatch<N, types, robust, VirtualCurveIntersector1> {
-      static __forceinline bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context) { return false; }
+    struct PointQueryDispatch<N, types, robust, VirtualCurveIntersector1>
+    {
+      typedef PointQueryTraversal<N, types, robust, VirtualCurveIntersector1> Traversal;
+
+      static __forceinline bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context)
+      {
+        if (context->mode == POINT_QUERY_MODE_CALLBACK) return false;
+        return Traversal::pointQuery(This, query, context);
+      }
+
+      static __forceinline bool pointQuery1M(const Accel::Intersectors* This, PointQuery** query, PointQueryContext** context, size_t M)
+      {
+        if (context[0]->mode == POINT_QUERY_MODE_CALLBACK) return false;
+        return Traversal::pointQuery1M(This, query, context, M);
+      }
     };
-    
+
+    /* disable point queries for not yet supported geometry types */
     template<int N, int types, bool robust>
     struct PointQueryDispatch<N, types, robust, SubdivPatch1Intersector1> {
       static __forceinline bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context) { return false; }
+      static __forceinline bool pointQuery1M(const Accel::Intersectors* This, PointQuery** query, PointQueryContext** context, size_t M) { return false; }
     };
     
     template<int N, int types, bool robust>
     struct PointQueryDispatch<N, types, robust, SubdivPatch1MBIntersector1> {
       static __forceinline bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context) { return false; }
+      static __forceinline bool pointQuery1M(const Accel::Intersectors* This, PointQuery** query, PointQueryContext** context, size_t M) { return false; }
     };
 
     template<int N, int types, bool robust, typename PrimitiveIntersector1>
@@ -339,5 +542,12 @@ namespace embree
     {
       return PointQueryDispatch<N, types, robust, PrimitiveIntersector1>::pointQuery(This, query, context);
     }
+
+    template<int N, int types, bool robust, typename PrimitiveIntersector1>
+    bool BVHNIntersector1<N, types, robust, PrimitiveIntersector1>::pointQuery1M(
+      const Accel::Intersectors* This, PointQuery** query, PointQueryContext** context, size_t M)
+    {
+      return PointQueryDispatch<N, types, robust, PrimitiveIntersector1>::pointQuery1M(This, query, context, M);
+    }
   }
 }
@@ -45,6 +45,7 @@ namespace embree
       static void intersect (const Accel::Intersectors* This, RayHit& ray, IntersectContext* context);
       static void occluded  (const Accel::Intersectors* This, Ray& ray, IntersectContext* context);
       static bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context);
+      static bool pointQuery1M(const Accel::Intersectors* This, PointQuery** query, PointQueryContext** context, size_t M);
     };
   }
 }
@@ -64,6 +64,9 @@ namespace embree
     IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(QBVH4Triangle4iIntersector1Pluecker,BVHNIntersector1<4 COMMA BVH_QN1 COMMA false COMMA ArrayIntersector1<TriangleMiIntersector1Pluecker<SIMD_MODE(4) COMMA true> > >));
     IF_ENABLED_QUADS(DEFINE_INTERSECTOR1(QBVH4Quad4iIntersector1Pluecker,BVHNIntersector1<4 COMMA BVH_QN1 COMMA false COMMA ArrayIntersector1<QuadMiIntersector1Pluecker<4 COMMA true> > >));
 
+    IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(HBVH4Triangle4Intersector1Moeller,BVHNIntersector1<4 COMMA BVH_HN1 COMMA false COMMA ArrayIntersector1<TriangleMIntersector1Moeller<SIMD_MODE(4) COMMA true> > >));
+    IF_ENABLED_QUADS(DEFINE_INTERSECTOR1(HBVH4Quad4vIntersector1Moeller,BVHNIntersector1<4 COMMA BVH_HN1 COMMA false COMMA ArrayIntersector1<QuadMvIntersector1Moeller<4 COMMA true> > >));
+
     IF_ENABLED_GRIDS(DEFINE_INTERSECTOR1(BVH4GridIntersector1Moeller,BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA SubGridIntersector1Moeller<4 COMMA true> >));
     IF_ENABLED_GRIDS(DEFINE_INTERSECTOR1(BVH4GridMBIntersector1Moeller,BVHNIntersector1<4 COMMA BVH_AN2_AN4D COMMA true COMMA SubGridMBIntersector1Pluecker<4 COMMA true> >));
 
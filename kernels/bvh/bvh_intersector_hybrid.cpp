@@ -173,7 +173,7 @@ namespace embree
         
         for (; valid_bits!=0; ) {
           const size_t i = bscf(valid_bits);
-          intersect1(This, bvh, bvh->root, i, pre, ray, tray, context);
+          intersect1(This, bvh, bvh->getTraversalRoot(), i, pre, ray, tray, context);
         }
         return;
       }
@@ -223,7 +223,7 @@ namespace embree
         NodeRef stack_node[stackSizeChunk];
         stack_node[0] = BVH::invalidNode;
         stack_near[0] = inf;
-        stack_node[1] = bvh->root;
+        stack_node[1] = bvh->getTraversalRoot();
         stack_near[1] = tray.tnear;
         NodeRef* stackEnd MAYBE_UNUSED = stack_node+stackSizeChunk;
         NodeRef* __restrict__ sptr_node = stack_node + 2;
@@ -248,7 +248,7 @@ namespace embree
             continue;
 
           /* switch to single ray traversal */
-#if (!defined(__WIN32__) || defined(__X86_64__)) && ((defined(__aarch64__) && defined(BUILD_IOS)) || defined(__SSE4_2__))
+#if (!defined(__WIN32__) || defined(__X86_64__)) && (defined(__NEON_NATIVE__) || defined(__SSE4_2__))
 #if FORCE_SINGLE_MODE == 0
           if (single)
 #endif
@@ -432,7 +432,7 @@ namespace embree
 
         StackItemT<NodeRef> stack[stackSizeSingle];  // stack of nodes
         StackItemT<NodeRef>* stackPtr = stack + 1;   // current stack pointer
-        stack[0].ptr  = bvh->root;
+        stack[0].ptr  = bvh->getTraversalRoot();
         stack[0].dist = neg_inf;
 
         while (1) pop:
@@ -667,7 +667,7 @@ namespace embree
       NodeRef stack_node[stackSizeChunk];
       stack_node[0] = BVH::invalidNode;
       stack_near[0] = inf;
-      stack_node[1] = bvh->root;
+      stack_node[1] = bvh->getTraversalRoot();
       stack_near[1] = tray.tnear;
       NodeRef* stackEnd MAYBE_UNUSED = stack_node+stackSizeChunk;
       NodeRef* __restrict__ sptr_node = stack_node + 2;
@@ -692,7 +692,7 @@ namespace embree
           continue;
 
         /* switch to single ray traversal */
-#if (!defined(__WIN32__) || defined(__X86_64__)) && ((defined(__aarch64__) && defined(BUILD_IOS)) || defined(__SSE4_2__))
+#if (!defined(__WIN32__) || defined(__X86_64__)) && (defined(__NEON_NATIVE__) || defined(__SSE4_2__))
 #if FORCE_SINGLE_MODE == 0
         if (single)
 #endif
@@ -843,7 +843,7 @@ namespace embree
 
         StackItemMaskT<NodeRef> stack[stackSizeSingle];  // stack of nodes
         StackItemMaskT<NodeRef>* stackPtr = stack + 1;   // current stack pointer
-        stack[0].ptr  = bvh->root;
+        stack[0].ptr  = bvh->getTraversalRoot();
         stack[0].mask = movemask(octant_valid);
 
         while (1) pop:
@@ -89,7 +89,7 @@ namespace embree
 
       stack[0].mask   = m_active;
       stack[0].parent = 0;
-      stack[0].child  = bvh->root;
+      stack[0].child  = bvh->getTraversalRoot();
 
       ///////////////////////////////////////////////////////////////////////////////////
       ///////////////////////////////////////////////////////////////////////////////////
@@ -217,7 +217,7 @@ namespace embree
 
       stack[0].mask   = m_active;
       stack[0].parent = 0;
-      stack[0].child  = bvh->root;
+      stack[0].child  = bvh->getTraversalRoot();
 
       ///////////////////////////////////////////////////////////////////////////////////
       ///////////////////////////////////////////////////////////////////////////////////
@@ -328,7 +328,7 @@ namespace embree
 
       StackItemMaskT<NodeRef> stack[stackSizeSingle]; // stack of nodes
       StackItemMaskT<NodeRef>* stackPtr = stack + 1;  // current stack pointer
-      stack[0].ptr = bvh->root;
+      stack[0].ptr = bvh->getTraversalRoot();
       stack[0].mask = m_active;
 
       size_t terminated = ~m_active;
@@ -20,6 +20,14 @@ namespace embree
 {
   namespace isa
   {
+#if defined(EMBREE_BVH8_SIMD4)
+
+    /* on 4-wide ISAs only the double-pumped BVH8<Triangle4> is supported */
+    IF_ENABLED_TRIS(DEFINE_INTERSECTORN(BVH8Triangle4IntersectorStreamMoeller,         BVHNIntersectorStream<SIMD_MODE(8) COMMA BVH_AN1 COMMA false COMMA Triangle4IntersectorStreamMoeller<true>>));
+    IF_ENABLED_TRIS(DEFINE_INTERSECTORN(BVH8Triangle4IntersectorStreamMoellerNoFilter, BVHNIntersectorStream<SIMD_MODE(8) COMMA BVH_AN1 COMMA false COMMA Triangle4IntersectorStreamMoeller<false>>));
+
+#else
+
     ////////////////////////////////////////////////////////////////////////////////
     /// General BVHIntersectorStreamPacketFallback Intersector
     ////////////////////////////////////////////////////////////////////////////////
@@ -44,5 +52,7 @@ namespace embree
 
     IF_ENABLED_USER(DEFINE_INTERSECTORN(BVH8VirtualIntersectorStream,BVHNIntersectorStream<SIMD_MODE(8) COMMA BVH_AN1 COMMA false COMMA ObjectIntersectorStream>));
     IF_ENABLED_INSTANCE(DEFINE_INTERSECTORN(BVH8InstanceIntersectorStream,BVHNIntersectorStream<SIMD_MODE(8) COMMA BVH_AN1 COMMA false COMMA InstanceIntersectorStream>));
+
+#endif
   }
 }
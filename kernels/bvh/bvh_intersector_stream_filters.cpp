@@ -21,6 +21,78 @@ namespace embree
 {
   namespace isa
   {
+    /* accesses an array of ray pointers by ray index instead of offset */
+    struct RayStreamAOPIndexed : public RayStreamAOP
+    {
+      __forceinline RayStreamAOPIndexed(void** rays)
+        : RayStreamAOP(rays) {}
+
+      __forceinline Ray& getRayByOffset(size_t index) {
+        return getRayByIndex(index);
+      }
+
+      template<int K>
+      __forceinline RayK<K> getRayByOffset(const vbool<K>& valid, const vint<K>& index) {
+        return getRayByIndex(valid, index);
+      }
+
+      template<int K>
+      __forceinline void setHitByOffset(const vbool<K>& valid, const vint<K>& index, const RayHitK<K>& ray) {
+        setHitByIndex(valid, index, ray);
+      }
+    };
+
+    template<int K, typename RayStream, typename OffsetFunc>
+    __forceinline void RayStreamFilter::intersectReordered(Scene* scene, RayStream& rayN, size_t N, const OffsetFunc& getOffset, IntersectContext* context)
+    {
+      __aligned(64) unsigned long long keys[MAX_REORDER_STREAM_SIZE];
+      __aligned(64) unsigned int offsets[MAX_REORDER_STREAM_SIZE];
+      __aligned(64) int packetOffsets[K];
+
+      /* ray origins get quantized to 10 bits per axis inside the scene bounds */
+      const BBox3fa bounds = scene->bounds.bounds();
+      const vfloat4 base  = vfloat4(bounds.lower);
+      const vfloat4 scale = vfloat4(1023.0f) / max(vfloat4(bounds.size()), vfloat4(1E-19f));
+
+      for (size_t i = 0; i < N; i += MAX_REORDER_STREAM_SIZE)
+      {
+        const size_t size = min(N - i, MAX_REORDER_STREAM_SIZE);
+
+        /* compute sort keys from direction octant and origin Morton code */
+        size_t numRays = 0;
+        for (size_t j = 0; j < size; j++)
+        {
+          const size_t offset = getOffset(i+j);
+          const Ray& ray = rayN.getRayByOffset(offset);
+
+          /* skip invalid rays */
+          if (unlikely(ray.tnear() > ray.tfar)) continue;
+
+          const unsigned int octantID = movemask(vfloat4(Vec3fa(ray.dir)) < 0.0f) & 0x7;
+          const vint4 q = min(max(toInt((vfloat4(Vec3fa(ray.org)) - base) * scale), vint4(zero)), vint4(1023));
+          const unsigned int code = bitInterleave((unsigned int)q[0], (unsigned int)q[1], (unsigned int)q[2]);
+          keys[numRays] = ((((unsigned long long)octantID << 30) | code) << 10) | j;
+          offsets[j] = (unsigned int)offset;
+          numRays++;
+        }
+        std::sort(&keys[0], &keys[numRays]);
+
+        /* trace sorted rays as packets and scatter the hits back */
+        for (size_t j = 0; j < numRays; j += K)
+        {
+          const vint<K> vj = vint<K>(int(j)) + vint<K>(step);
+          vbool<K> valid = vj < vint<K>(int(numRays));
+          for (size_t k = 0; k < K; k++)
+            packetOffsets[k] = j+k < numRays ? offsets[keys[j+k] & (MAX_REORDER_STREAM_SIZE-1)] : 0;
+          const vint<K> offset = vint<K>::load(packetOffsets);
+
+          RayHitK<K> ray = rayN.getRayByOffset(valid, offset);
+          scene->intersectors.intersect(valid, ray, context);
+          rayN.setHitByOffset(valid, offset, ray);
+        }
+      }
+    }
+
     template<int K, bool intersect>
     __noinline void RayStreamFilter::filterAOS(Scene* scene, void* _rayN, size_t N, size_t stride, IntersectContext* context)
     {
@@ -145,6 +217,11 @@ namespace embree
           raysInOctant[curOctant] = 0;
         }
       }
+      else if (unlikely(context->isReorder()))
+      {
+        /* sort incoherent rays into coherent packets */
+        intersectReordered<K>(scene, rayN, N, [&] (size_t i) { return i * stride; }, context);
+      }
       else
       {
         /* fallback to packets */
@@ -287,6 +364,12 @@ namespace embree
           raysInOctant[curOctant] = 0;
         }
       }
+      else if (unlikely(context->isReorder()))
+      {
+        /* sort incoherent rays into coherent packets */
+        RayStreamAOPIndexed rayIndexed(_rayN);
+        intersectReordered<K>(scene, rayIndexed, N, [&] (size_t i) { return i; }, context);
+      }
       else
       {
         /* fallback to packets */
@@ -308,6 +391,14 @@ namespace embree
     template<int K, bool intersect>
     __noinline void RayStreamFilter::filterSOA(Scene* scene, char* rayData, size_t N, size_t numPackets, size_t stride, IntersectContext* context)
     {
+      /* sort incoherent rays of all packets into coherent packets */
+      if (unlikely(intersect && context->isIncoherent() && context->isReorder()))
+      {
+        RayStreamSOA rayN(rayData, N);
+        intersectReordered<K>(scene, rayN, N * numPackets, [&] (size_t i) { return (i / N) * stride + (i % N) * sizeof(float); }, context);
+        return;
+      }
+
       const size_t rayDataAlignment = (size_t)rayData % (K*sizeof(float));
       const size_t offsetAlignment  = (size_t)stride  % (K*sizeof(float));
 
@@ -585,6 +676,11 @@ namespace embree
           raysInOctant[curOctant] = 0;
         }
       }
+      else if (unlikely(context->isReorder()))
+      {
+        /* sort incoherent rays into coherent packets */
+        intersectReordered<K>(scene, rayN, N, [&] (size_t i) { return i * sizeof(float); }, context);
+      }
       else
       {
         /* fallback to packets */
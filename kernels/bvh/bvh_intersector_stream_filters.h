@@ -49,6 +49,11 @@ namespace embree
 
       template<int K, bool intersect>
       static void filterSOP(Scene* scene, const void* rays, size_t N, IntersectContext* context);
+
+      template<int K, typename RayStream, typename OffsetFunc>
+      static void intersectReordered(Scene* scene, RayStream& rayN, size_t N, const OffsetFunc& getOffset, IntersectContext* context);
+
+      static const size_t MAX_REORDER_STREAM_SIZE = 1024; //!< number of rays sorted together in reorder mode
     };
   }
 };
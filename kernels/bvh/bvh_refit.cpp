@@ -40,32 +40,39 @@ namespace embree
 
     template<int N>
     BVHNRefitter<N>::BVHNRefitter (BVH* bvh, const LeafBoundsInterface& leafBounds)
-      : bvh(bvh), leafBounds(leafBounds), numSubTrees(0)
+      : bvh(bvh), leafBounds(leafBounds), sah(0.0), numSubTrees(0)
     {
     }
 
     template<int N>
     void BVHNRefitter<N>::refit()
     {
+      double nodeSAH = 0.0;
       if (bvh->numPrimitives <= SINGLE_THREAD_THRESHOLD) {
-        bvh->bounds = LBBox3fa(recurse_bottom(bvh->root));
+        bvh->bounds = LBBox3fa(recurse_bottom(bvh->root,nodeSAH));
       }
       else
       {
         BBox3fa subTreeBounds[MAX_NUM_SUB_TREES];
+        double subTreeSAH[MAX_NUM_SUB_TREES];
         numSubTrees = 0;
         gather_subtree_refs(bvh->root,numSubTrees,0);
         if (numSubTrees)
           parallel_for(size_t(0), numSubTrees, size_t(1), [&](const range<size_t>& r) {
               for (size_t i=r.begin(); i<r.end(); i++) {
                 NodeRef& ref = subTrees[i];
-                subTreeBounds[i] = recurse_bottom(ref);
+                subTreeSAH[i] = 0.0;
+                subTreeBounds[i] = recurse_bottom(ref,subTreeSAH[i]);
               }
             });
 
         numSubTrees = 0;        
-        bvh->bounds = LBBox3fa(refit_toplevel(bvh->root,numSubTrees,subTreeBounds,0));
-      }    
+        bvh->bounds = LBBox3fa(refit_toplevel(bvh->root,numSubTrees,subTreeBounds,subTreeSAH,nodeSAH,0));
+      }
+
+      /* normalize SAH cost the same way as BVHNStatistics does */
+      const float A = bvh->getLinearBounds().expectedHalfArea();
+      sah = A > 0.0f ? nodeSAH/double(A) : 0.0;
   }
 
     template<int N>
@@ -95,12 +102,15 @@ namespace embree
     BBox3fa BVHNRefitter<N>::refit_toplevel(NodeRef& ref,
                                             size_t &subtrees,
 											const BBox3fa *const subTreeBounds,
+                                            const double *const subTreeSAH,
+                                            double& nodeSAH,
                                             const size_t depth)
     {
       if (depth >= MAX_SUB_TREE_EXTRACTION_DEPTH) 
       {
         assert(subtrees < MAX_NUM_SUB_TREES);
         assert(subTrees[subtrees] == ref);
+        nodeSAH += subTreeSAH[subtrees];
         return subTreeBounds[subtrees++];
       }
 
@@ -116,7 +126,7 @@ namespace embree
           if (unlikely(child == BVH::emptyNode)) 
             bounds[i] = BBox3fa(empty);
           else
-            bounds[i] = refit_toplevel(child,subtrees,subTreeBounds,depth+1); 
+            bounds[i] = refit_toplevel(child,subtrees,subTreeBounds,subTreeSAH,nodeSAH,depth+1); 
         }
         
         BBox3vf<N> boundsT = transpose<N>(bounds);
@@ -129,10 +139,12 @@ namespace embree
         node->upper_y = boundsT.upper.y;
         node->upper_z = boundsT.upper.z;
         
-        return merge<N>(bounds);
+        const BBox3fa nodeBounds = merge<N>(bounds);
+        nodeSAH += max(0.0f,halfArea(nodeBounds));
+        return nodeBounds;
       }
       else
-        return leafBounds.leafBounds(ref);
+        return leaf_bounds(ref,nodeSAH);
     }
 
     // =========================================================
@@ -141,11 +153,20 @@ namespace embree
 
     
     template<int N>
-    BBox3fa BVHNRefitter<N>::recurse_bottom(NodeRef& ref)
+    __forceinline BBox3fa BVHNRefitter<N>::leaf_bounds(NodeRef& ref, double& nodeSAH)
+    {
+      size_t num; ref.leaf(num);
+      const BBox3fa bounds = leafBounds.leafBounds(ref);
+      nodeSAH += max(0.0f,halfArea(bounds))*double(num);
+      return bounds;
+    }
+    
+    template<int N>
+    BBox3fa BVHNRefitter<N>::recurse_bottom(NodeRef& ref, double& nodeSAH)
     {
       /* this is a leaf node */
       if (unlikely(ref.isLeaf()))
-        return leafBounds.leafBounds(ref);
+        return leaf_bounds(ref,nodeSAH);
       
       /* recurse if this is an internal node */
       AlignedNode* node = ref.alignedNode();
@@ -162,7 +183,7 @@ namespace embree
           bounds[i] = BBox3fa(empty);          
         }
       else
-        bounds[i] = recurse_bottom(node->child(i));
+        bounds[i] = recurse_bottom(node->child(i),nodeSAH);
       
       /* AOS to SOA transform */
       BBox3vf<N> boundsT = transpose<N>(bounds);
@@ -175,12 +196,14 @@ namespace embree
       node->upper_y = boundsT.upper.y;
       node->upper_z = boundsT.upper.z;
 
-      return merge<N>(bounds);
+      const BBox3fa nodeBounds = merge<N>(bounds);
+      nodeSAH += max(0.0f,halfArea(nodeBounds));
+      return nodeBounds;
     }
 
     template<int N, typename Mesh, typename Primitive>
     BVHNRefitT<N,Mesh,Primitive>::BVHNRefitT (BVH* bvh, Builder* builder, Mesh* mesh, size_t mode)
-      : bvh(bvh), builder(builder), refitter(new BVHNRefitter<N>(bvh,*(typename BVHNRefitter<N>::LeafBoundsInterface*)this)), mesh(mesh), topologyVersion(0) {}
+      : bvh(bvh), builder(builder), refitter(new BVHNRefitter<N>(bvh,*(typename BVHNRefitter<N>::LeafBoundsInterface*)this)), mesh(mesh), topologyVersion(0), buildSAH(0.0) {}
 
     template<int N, typename Mesh, typename Primitive>
     void BVHNRefitT<N,Mesh,Primitive>::clear()
@@ -189,15 +212,46 @@ namespace embree
         builder->clear();
     }
     
+    template<int N, typename Mesh, typename Primitive>
+    void BVHNRefitT<N,Mesh,Primitive>::rebuild()
+    {
+      builder->build();
+      buildSAH = builder->getSAH();
+    }
+    
     template<int N, typename Mesh, typename Primitive>
     void BVHNRefitT<N,Mesh,Primitive>::build()
     {
       if (mesh->topologyChanged(topologyVersion)) {
         topologyVersion = mesh->getTopologyVersion();
-        builder->build();
+        rebuild();
+        return;
+      }
+
+      refitter->refit();
+
+      /* rebuild once refitting degraded the SAH cost too much */
+      const float threshold = bvh->device->refit_rebuild_threshold;
+      const double ratio = buildSAH > 0.0 ? refitter->sah/buildSAH : 1.0;
+      const bool needsRebuild = threshold > 0.0f && ratio > double(threshold);
+
+      if (bvh->device->verbosity(2))
+      {
+        Lock<MutexSys> lock(g_printMutex);
+        std::cout << "refitted BVH" << N << "<" << bvh->primTy->name() << "> : sah = " << refitter->sah << ", build sah = " << buildSAH
+                  << ", ratio = " << ratio << (needsRebuild ? ", rebuilding" : "") << std::endl << std::flush;
+      }
+
+      if (bvh->device->benchmark)
+      {
+        Lock<MutexSys> lock(g_printMutex);
+        std::cout << "BENCHMARK_REFIT " << refitter->sah << " " << buildSAH << " " << ratio << " " << needsRebuild << " BVH" << N << "<" << bvh->primTy->name() << ">" << std::endl << std::flush;
+      }
+
+      if (needsRebuild) {
+        bvh->device->numRefitRebuilds++;
+        rebuild();
       }
-      else
-        refitter->refit();
     }
 
     template class BVHNRefitter<4>;
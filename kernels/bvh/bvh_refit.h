@@ -41,7 +41,7 @@ namespace embree
       /*! Constructor. */
       BVHNRefitter (BVH* bvh, const LeafBoundsInterface& leafBounds);
 
-      /*! refits the BVH */
+      /*! refits the BVH and updates its SAH cost */
       void refit();
 
     private:
@@ -54,14 +54,20 @@ namespace embree
       BBox3fa refit_toplevel(NodeRef& ref,
                              size_t &subtrees,
 							 const BBox3fa *const subTreeBounds,
+                             const double *const subTreeSAH,
+                             double& nodeSAH,
                              const size_t depth = 0);
 
       /* single-threaded subtree refit */
-      BBox3fa recurse_bottom(NodeRef& ref);
+      BBox3fa recurse_bottom(NodeRef& ref, double& nodeSAH);
+
+      /* calculates bounds of a leaf and adds its SAH cost */
+      BBox3fa leaf_bounds(NodeRef& ref, double& nodeSAH);
       
     public:
       BVH* bvh;                              //!< BVH to refit
       const LeafBoundsInterface& leafBounds; //!< calculates bounds of leaves
+      double sah;                            //!< SAH cost of the BVH after the last refit
 
       static const size_t MAX_SUB_TREE_EXTRACTION_DEPTH = (N==4) ? 4   : (N==8) ? 3    : 3;
       static const size_t MAX_NUM_SUB_TREES             = (N==4) ? 256 : (N==8) ? 512 : N*N*N; // N ^ MAX_SUB_TREE_EXTRACTION_DEPTH
@@ -86,6 +92,9 @@ namespace embree
       
       virtual void clear();
 
+      /*! rebuilds the BVH and remembers its SAH cost */
+      void rebuild();
+
       virtual const BBox3fa leafBounds (NodeRef& ref) const
       {
         size_t num; char* prim = ref.leaf(num);
@@ -103,6 +112,7 @@ namespace embree
       std::unique_ptr<BVHNRefitter<N>> refitter;
       Mesh* mesh;
       unsigned int topologyVersion;
+      double buildSAH;                  //!< SAH cost of the BVH after the last rebuild
     };
   }
 }
@@ -15,6 +15,7 @@
 // ======================================================================== //
 
 #include "bvh_rotate.h"
+#include "../../common/algorithms/parallel_for.h"
 
 namespace embree
 {
@@ -136,5 +137,140 @@ namespace embree
       cdepth[bestChild1]++; // bestChild1 was pushed down one level
       return 1+reduce_max(cdepth); 
     }
+
+    /*! Finds the subset of treelet leaves that should get grouped
+     *  below the inner node of the treelet. Returns the current
+     *  subset if no grouping with lower SAH cost exists. */
+    __noinline static size_t findBestTreeletGrouping(const BBox3fa* bounds, size_t numLeaves, size_t currentSet, size_t fixedSet, float currentCost)
+    {
+      /* without the inner node the treelet is always cheaper */
+      if (numLeaves <= 4)
+        return 0;
+
+      /* compute bounds and sizes of all subsets */
+      BBox3fa subsetBounds[size_t(1) << BVHNRotate<4>::MAX_TREELET_LEAVES];
+      size_t subsetSize[size_t(1) << BVHNRotate<4>::MAX_TREELET_LEAVES];
+      const size_t numSubsets = size_t(1) << numLeaves;
+      subsetBounds[0] = empty;
+      subsetSize[0] = 0;
+      for (size_t s=1; s<numSubsets; s++) {
+        subsetBounds[s] = merge(subsetBounds[s & (s-1)],bounds[bsf(s)]);
+        subsetSize[s] = subsetSize[s & (s-1)]+1;
+      }
+
+      /* the inner node has to get 2 to 4 leaves and the parent at most 3 remaining leaves */
+      size_t bestSet = currentSet;
+      float bestCost = currentCost;
+      for (size_t s=1; s<numSubsets; s++)
+      {
+        const size_t n = subsetSize[s];
+        if (n < 2 || n > 4 || numLeaves-n > 3) continue;
+        if (s & fixedSet) continue;
+        const float cost = halfArea(subsetBounds[s]);
+        if (cost < bestCost) {
+          bestCost = cost;
+          bestSet = s;
+        }
+      }
+      return bestSet;
+    }
+
+    size_t BVHNRotate<4>::restructure(NodeRef parentRef, double deadline, bool parallel, size_t depth)
+    {
+      /*! nothing to restructure if we reached a leaf node. */
+      if (parentRef.isBarrier()) return 0;
+      if (!parentRef.isAlignedNode()) return 0;
+      AlignedNode* parent = parentRef.alignedNode();
+
+      /*! restructure all children first */
+      size_t cdepth[4];
+      if (parallel && depth < PARALLEL_DEPTH)
+      {
+        parallel_for(size_t(0), size_t(4), [&] (const range<size_t>& r) {
+            for (size_t c=r.begin(); c<r.end(); c++)
+              cdepth[c] = restructure(parent->child(c),deadline,parallel,depth+1);
+          });
+      }
+      else
+      {
+        for (size_t c=0; c<4; c++)
+          cdepth[c] = restructure(parent->child(c),deadline,parallel,depth+1);
+      }
+      const size_t maxDepth = 1+max(max(cdepth[0],cdepth[1]),max(cdepth[2],cdepth[3]));
+
+      /*! the treelet gets formed by opening the inner child with largest surface area */
+      size_t innerChild = -1;
+      float innerArea = neg_inf;
+      for (size_t c=0; c<4; c++)
+      {
+        /*! ignore leaf nodes as we cannot descent into them */
+        if (parent->child(c).isBarrier()) continue;
+        if (!parent->child(c).isAlignedNode()) continue;
+        const float area = halfArea(parent->bounds(c));
+        if (area > innerArea) {
+          innerArea = area;
+          innerChild = c;
+        }
+      }
+      if (innerChild == size_t(-1)) return maxDepth;
+
+      /*! stop optimizing when the time budget is used up */
+      if (getSeconds() > deadline) return maxDepth;
+
+      /*! gather the leaves of the treelet */
+      NodeRef innerRef = parent->child(innerChild);
+      AlignedNode* inner = innerRef.alignedNode();
+      NodeRef refs[MAX_TREELET_LEAVES];
+      BBox3fa bounds[MAX_TREELET_LEAVES];
+      size_t heights[MAX_TREELET_LEAVES];
+      size_t numLeaves = 0;
+      size_t currentSet = 0;
+      for (size_t c=0; c<4; c++)
+      {
+        if (c == innerChild || parent->child(c) == BVH4::emptyNode) continue;
+        refs[numLeaves] = parent->child(c);
+        bounds[numLeaves] = parent->bounds(c);
+        heights[numLeaves++] = cdepth[c];
+      }
+      for (size_t c=0; c<4; c++)
+      {
+        if (inner->child(c) == BVH4::emptyNode) continue;
+        refs[numLeaves] = inner->child(c);
+        bounds[numLeaves] = inner->bounds(c);
+        heights[numLeaves] = cdepth[innerChild]-1;
+        currentSet |= size_t(1) << numLeaves++;
+      }
+
+      /*! only select groupings that fulfill depth constraints */
+      size_t fixedSet = 0;
+      for (size_t i=0; i<numLeaves; i++)
+        if (depth+1+heights[i] > BVH4::maxBuildDepth && !(currentSet & (size_t(1) << i)))
+          fixedSet |= size_t(1) << i;
+
+      const size_t bestSet = findBestTreeletGrouping(bounds,numLeaves,currentSet,fixedSet,innerArea);
+      if (bestSet == currentSet) return maxDepth;
+
+      /*! rebuild the treelet with the best grouping */
+      size_t newDepth = 0;
+      size_t numChildren = 0;
+      parent->clear();
+      if (bestSet)
+      {
+        size_t numInnerChildren = 0;
+        inner->clear();
+        for (size_t i=0; i<numLeaves; i++) {
+          if (!(bestSet & (size_t(1) << i))) continue;
+          inner->set(numInnerChildren++,refs[i],bounds[i]);
+          newDepth = max(newDepth,2+heights[i]);
+        }
+        parent->set(numChildren++,innerRef,inner->bounds());
+      }
+      for (size_t i=0; i<numLeaves; i++) {
+        if (bestSet & (size_t(1) << i)) continue;
+        parent->set(numChildren++,refs[i],bounds[i]);
+        newDepth = max(newDepth,1+heights[i]);
+      }
+      return newDepth;
+    }
   }
 }
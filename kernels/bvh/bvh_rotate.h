@@ -31,7 +31,7 @@ namespace embree
       static const bool enabled = false;
 
       static __forceinline size_t rotate(NodeRef parentRef, size_t depth = 1) { return 0; }
-      static __forceinline void restructure(NodeRef ref, size_t depth = 1) {}
+      static __forceinline size_t restructure(NodeRef parentRef, double deadline, bool parallel, size_t depth = 1) { return 0; }
     };
 
     /* BVH4 tree rotations */
@@ -43,8 +43,17 @@ namespace embree
       
     public:
       static const bool enabled = true;
+      static const size_t MAX_TREELET_LEAVES = 7;   //!< maximal number of subtrees a treelet gets restructured from
+      static const size_t PARALLEL_DEPTH = 4;       //!< depth up to which subtrees are restructured in parallel
 
       static size_t rotate(NodeRef parentRef, size_t depth = 1);
+
+      /*! Bottom-up treelet restructuring. Each node together with
+       *  its largest inner child forms a treelet of up to 7
+       *  subtrees, which get redistributed to minimize the SAH
+       *  cost. Nodes are left unchanged once the deadline (in
+       *  seconds as returned by getSeconds) passed. */
+      static size_t restructure(NodeRef parentRef, double deadline, bool parallel, size_t depth = 1);
     };
   }
 }
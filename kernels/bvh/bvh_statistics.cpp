@@ -44,6 +44,7 @@ namespace embree
     if (stat.statAlignedNodesMB4D.numNodes) stream << "  alignedNodesMB4D : "  << stat.statAlignedNodesMB4D.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (stat.statUnalignedNodesMB.numNodes) stream << "  unalignedNodesMB : "  << stat.statUnalignedNodesMB.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (stat.statQuantizedNodes.numNodes  ) stream << "  quantizedNodes   : "  << stat.statQuantizedNodes.toString(bvh,totalSAH,totalBytes) << std::endl;
+    if (stat.statHalfNodes.numNodes       ) stream << "  halfNodes        : "  << stat.statHalfNodes.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (true)                               stream << "  leaves           : "  << stat.statLeaf.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (true)                               stream << "    histogram      : "  << stat.statLeaf.histToString() << std::endl;
     return stream.str();
@@ -141,6 +142,20 @@ namespace embree
       s.statQuantizedNodes.nodeSAH += dt*A;
       s.depth++;
     }
+    else if (node.isHalfNode())
+    {
+      HalfNode* n = node.halfNode();
+      s = s + parallel_reduce(0,N,Statistics(),[&] ( const int i ) {
+          if (n->child(i) == BVH::emptyNode) return Statistics();
+          const double Ai = max(0.0f,halfArea(n->extent(i)));
+          Statistics s = statistics(n->child(i),Ai,t0t1); 
+          s.statHalfNodes.numChildren++;
+          return s;
+        }, Statistics::add);
+      s.statHalfNodes.numNodes++;
+      s.statHalfNodes.nodeSAH += dt*A;
+      s.depth++;
+    }
     else if (node.isLeaf())
     {
       size_t num; const char* tri = node.leaf(num);
@@ -168,7 +183,7 @@ namespace embree
     return s;
   } 
 
-#if defined(__AVX__)
+#if defined(__AVX__) || defined(EMBREE_BVH8_SIMD4)
   template class BVHNStatistics<8>;
 #endif
 
@@ -305,6 +305,22 @@ namespace embree
       return pointQuerySphereDistAndMask(query, dist, minX, maxX, minY, maxY, minZ, maxZ) & movemask(node->validMask());
     }
     
+    template<int N>
+    __forceinline size_t pointQueryNodeSphere(const typename BVHN<N>::HalfNode* node, const TravPointQuery<N>& query, vfloat<N>& dist)
+    {
+      const vfloat<N> scale(node->scale);
+      const vfloat<N> start_x(node->start.x);
+      const vfloat<N> minX = madd(node->template decode<N>((0*sizeof(vfloat<N>)) >> 1),scale,start_x);
+      const vfloat<N> maxX = madd(node->template decode<N>((1*sizeof(vfloat<N>)) >> 1),scale,start_x);
+      const vfloat<N> start_y(node->start.y);
+      const vfloat<N> minY = madd(node->template decode<N>((2*sizeof(vfloat<N>)) >> 1),scale,start_y);
+      const vfloat<N> maxY = madd(node->template decode<N>((3*sizeof(vfloat<N>)) >> 1),scale,start_y);
+      const vfloat<N> start_z(node->start.z);
+      const vfloat<N> minZ = madd(node->template decode<N>((4*sizeof(vfloat<N>)) >> 1),scale,start_z);
+      const vfloat<N> maxZ = madd(node->template decode<N>((5*sizeof(vfloat<N>)) >> 1),scale,start_z);
+      return pointQuerySphereDistAndMask(query, dist, minX, maxX, minY, maxY, minZ, maxZ) & movemask(node->validMask());
+    }
+
     template<int N>
     __forceinline size_t pointQueryNodeSphere(const typename BVHN<N>::QuantizedBaseNodeMB* node, const TravPointQuery<N>& query, const float time, vfloat<N>& dist)
     {
@@ -417,6 +433,22 @@ namespace embree
       return pointQueryAABBDistAndMask(query, dist, minX, maxX, minY, maxY, minZ, maxZ) & mvalid;
     }
     
+    template<int N>
+    __forceinline size_t pointQueryNodeAABB(const typename BVHN<N>::HalfNode* node, const TravPointQuery<N>& query, vfloat<N>& dist)
+    {
+      const vfloat<N> scale(node->scale);
+      const vfloat<N> start_x(node->start.x);
+      const vfloat<N> minX = madd(node->template decode<N>((0*sizeof(vfloat<N>)) >> 1),scale,start_x);
+      const vfloat<N> maxX = madd(node->template decode<N>((1*sizeof(vfloat<N>)) >> 1),scale,start_x);
+      const vfloat<N> start_y(node->start.y);
+      const vfloat<N> minY = madd(node->template decode<N>((2*sizeof(vfloat<N>)) >> 1),scale,start_y);
+      const vfloat<N> maxY = madd(node->template decode<N>((3*sizeof(vfloat<N>)) >> 1),scale,start_y);
+      const vfloat<N> start_z(node->start.z);
+      const vfloat<N> minZ = madd(node->template decode<N>((4*sizeof(vfloat<N>)) >> 1),scale,start_z);
+      const vfloat<N> maxZ = madd(node->template decode<N>((5*sizeof(vfloat<N>)) >> 1),scale,start_z);
+      return pointQueryAABBDistAndMask(query, dist, minX, maxX, minY, maxY, minZ, maxZ) & movemask(node->validMask());
+    }
+
     template<int N>
     __forceinline size_t pointQueryNodeAABB(const typename BVHN<N>::QuantizedBaseNodeMB* node, const TravPointQuery<N>& query, const float time, vfloat<N>& dist)
     {
@@ -476,7 +508,7 @@ namespace embree
       const vfloat4 tFarZ  = (vfloat4::load((float*)((const char*)&node->lower_x+ray.farZ )) - ray.org.z) * ray.rdir.z;
 #endif
       
-#if (defined(__aarch64__) && defined(BUILD_IOS)) || defined(__SSE4_1__) && !defined(__AVX512F__) // up to HSW
+#if defined(__NEON_NATIVE__) || defined(__SSE4_1__) && !defined(__AVX512F__) // up to HSW
       const vfloat4 tNear = maxi(tNearX,tNearY,tNearZ,ray.tnear);
       const vfloat4 tFar  = mini(tFarX ,tFarY ,tFarZ ,ray.tfar);
       const vbool4 vmask = asInt(tNear) > asInt(tFar);
@@ -496,8 +528,9 @@ namespace embree
       return mask;
     }
 
-#if defined(__AVX__)
+#if defined(__AVX__) || defined(EMBREE_BVH8_SIMD4)
 
+    /* without AVX vfloat8 is a pair of vfloat4 halves, thus this double-pumps the 4-wide box test */
     template<>
       __forceinline size_t intersectNode<8,8>(const typename BVH8::AlignedNode* node, const TravRay<8,8,false>& ray, vfloat8& dist)
     {
@@ -517,7 +550,7 @@ namespace embree
       const vfloat8 tFarZ  = (vfloat8::load((float*)((const char*)&node->lower_x+ray.farZ )) - ray.org.z) * ray.rdir.z;
 #endif
       
-#if defined(__AVX2__) && !defined(__AVX512F__) // HSW
+#if defined(__AVX2__) && !defined(__AVX512F__) || !defined(__AVX__) && (defined(__NEON_NATIVE__) || defined(__SSE4_1__)) // HSW
       const vfloat8 tNear = maxi(tNearX,tNearY,tNearZ,ray.tnear);
       const vfloat8 tFar  = mini(tFarX ,tFarY ,tFarZ ,ray.tfar);
       const vbool8 vmask = asInt(tNear) > asInt(tFar);
@@ -792,6 +825,64 @@ namespace embree
       return mask;
     }
 
+    //////////////////////////////////////////////////////////////////////////////////////
+    // Fast HalfNode intersection
+    //////////////////////////////////////////////////////////////////////////////////////
+
+    template<int N, int Nx, bool robust>
+      __forceinline size_t intersectNode(const typename BVHN<N>::HalfNode* node, const TravRay<N,Nx,robust>& ray, vfloat<Nx>& dist);
+
+    template<>
+      __forceinline size_t intersectNode<4,4>(const typename BVH4::HalfNode* node, const TravRay<4,4,false>& ray, vfloat4& dist)
+    {
+      const size_t mvalid  = movemask(node->validMask());
+      const vfloat4 scale(node->scale);
+      const vfloat4 start_x(node->start.x);
+      const vfloat4 lower_x = madd(node->decode<4>(ray.nearX >> 1),scale,start_x);
+      const vfloat4 upper_x = madd(node->decode<4>(ray.farX  >> 1),scale,start_x);
+      const vfloat4 start_y(node->start.y);
+      const vfloat4 lower_y = madd(node->decode<4>(ray.nearY >> 1),scale,start_y);
+      const vfloat4 upper_y = madd(node->decode<4>(ray.farY  >> 1),scale,start_y);
+      const vfloat4 start_z(node->start.z);
+      const vfloat4 lower_z = madd(node->decode<4>(ray.nearZ >> 1),scale,start_z);
+      const vfloat4 upper_z = madd(node->decode<4>(ray.farZ  >> 1),scale,start_z);
+
+#if defined(__AVX2__)
+      const vfloat4 tNearX = msub(lower_x, ray.rdir.x, ray.org_rdir.x);
+      const vfloat4 tNearY = msub(lower_y, ray.rdir.y, ray.org_rdir.y);
+      const vfloat4 tNearZ = msub(lower_z, ray.rdir.z, ray.org_rdir.z);
+      const vfloat4 tFarX  = msub(upper_x, ray.rdir.x, ray.org_rdir.x);
+      const vfloat4 tFarY  = msub(upper_y, ray.rdir.y, ray.org_rdir.y);
+      const vfloat4 tFarZ  = msub(upper_z, ray.rdir.z, ray.org_rdir.z);
+#else
+      const vfloat4 tNearX = (lower_x - ray.org.x) * ray.rdir.x;
+      const vfloat4 tNearY = (lower_y - ray.org.y) * ray.rdir.y;
+      const vfloat4 tNearZ = (lower_z - ray.org.z) * ray.rdir.z;
+      const vfloat4 tFarX  = (upper_x - ray.org.x) * ray.rdir.x;
+      const vfloat4 tFarY  = (upper_y - ray.org.y) * ray.rdir.y;
+      const vfloat4 tFarZ  = (upper_z - ray.org.z) * ray.rdir.z;
+#endif
+
+#if defined(__NEON_NATIVE__) || defined(__SSE4_1__) && !defined(__AVX512F__) // up to HSW
+      const vfloat4 tNear = maxi(tNearX,tNearY,tNearZ,ray.tnear);
+      const vfloat4 tFar  = mini(tFarX ,tFarY ,tFarZ ,ray.tfar);
+      const vbool4 vmask = asInt(tNear) > asInt(tFar);
+      const size_t mask = movemask(vmask) ^ ((1<<4)-1);
+#elif defined(__AVX512F__) && !defined(__AVX512ER__) // SKX
+      const vfloat4 tNear = maxi(tNearX,tNearY,tNearZ,ray.tnear);
+      const vfloat4 tFar  = mini(tFarX ,tFarY ,tFarZ ,ray.tfar);
+      const vbool4 vmask = asInt(tNear) <= asInt(tFar);
+      const size_t mask = movemask(vmask);
+#else
+      const vfloat4 tNear = max(tNearX,tNearY,tNearZ,ray.tnear);
+      const vfloat4 tFar  = min(tFarX ,tFarY ,tFarZ ,ray.tfar);
+      const vbool4 vmask = tNear <= tFar;
+      const size_t mask = movemask(vmask);
+#endif
+      dist = tNear;
+      return mask & mvalid;
+    }
+
     //////////////////////////////////////////////////////////////////////////////////////
     // Fast QuantizedBaseNode intersection
     //////////////////////////////////////////////////////////////////////////////////////
@@ -832,7 +923,7 @@ namespace embree
       const vfloat4 tFarZ  = (upper_z - ray.org.z) * ray.rdir.z;
 #endif
       
-#if (defined(__aarch64__) && defined(BUILD_IOS)) || defined(__SSE4_1__) && !defined(__AVX512F__) // up to HSW
+#if defined(__NEON_NATIVE__) || defined(__SSE4_1__) && !defined(__AVX512F__) // up to HSW
       const vfloat4 tNear = maxi(tNearX,tNearY,tNearZ,ray.tnear);
       const vfloat4 tFar  = mini(tFarX ,tFarY ,tFarZ ,ray.tfar);
       const vbool4 vmask = asInt(tNear) > asInt(tFar);
@@ -1388,6 +1479,17 @@ namespace embree
       }
     };
     
+    template<int N>
+    struct BVHNNodePointQuerySphere1<N, BVH_HN1>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        mask = pointQueryNodeSphere(node.halfNode(), query, dist);
+        return true;
+      }
+    };
+
     template<int N>
     struct BVHNQuantizedBaseNodePointQuerySphere1
     {
@@ -1486,6 +1588,17 @@ namespace embree
       }
     };
     
+    template<int N>
+    struct BVHNNodePointQueryAABB1<N, BVH_HN1>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        mask = pointQueryNodeAABB(node.halfNode(), query, dist);
+        return true;
+      }
+    };
+
     template<int N>
     struct BVHNQuantizedBaseNodePointQueryAABB1
     {
@@ -1669,6 +1782,17 @@ namespace embree
       }
     };
 
+    template<int N, int Nx>
+    struct BVHNNodeIntersector1<N, Nx, BVH_HN1, false>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const TravRay<N,Nx,false>& ray, float time, vfloat<Nx>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        mask = intersectNode(node.halfNode(), ray, dist);
+        return true;
+      }
+    };
+
     /*! Intersects N nodes with K rays */
     template<int N, int Nx, bool robust>
       struct BVHNQuantizedBaseNodeIntersector1;
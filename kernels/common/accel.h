@@ -25,6 +25,22 @@ namespace embree
 {
   class Scene;
 
+  /*! writes a plain value to a BVH cache stream */
+  template<typename T>
+  __forceinline void writeBinary(std::ostream& out, const T& v) {
+    out.write((const char*)&v,sizeof(T));
+  }
+
+  /*! reads a plain value from a BVH cache stream */
+  template<typename T>
+  __forceinline T readBinary(std::istream& in)
+  {
+    T v;
+    if (!in.read((char*)&v,sizeof(T)))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH cache file is truncated");
+    return v;
+  }
+
   /*! Base class for the acceleration structure data. */
   class AccelData : public RefCount 
   {
@@ -42,6 +58,21 @@ namespace embree
     /*! clears the acceleration structure data */
     virtual void clear() = 0;
 
+    /*! writes the acceleration structure data to a BVH cache stream */
+    virtual void save(std::ostream& out) const {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"acceleration structure does not support saving");
+    }
+
+    /*! restores the acceleration structure data from a BVH cache stream */
+    virtual void load(std::istream& in) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"acceleration structure does not support loading");
+    }
+
+    /*! returns the number of bytes of the acceleration structure that reside on 2MB pages */
+    virtual size_t getHugePageBytes() {
+      return 0;
+    }
+
     /*! returns normal bounds */
     __forceinline BBox3fa getBounds() const {
       return bounds.bounds();
@@ -83,6 +114,12 @@ namespace embree
                                   PointQuery* query,        /*!< point query for lookup */
                                   PointQueryContext* context); /*!< point query context */
 
+    /*! Type of point query function for multiple independent point queries */
+    typedef bool(*PointQueryFunc1M)(Intersectors* This,           /*!< this pointer to accel */
+                                    PointQuery** query,           /*!< point queries for lookup */
+                                    PointQueryContext** context,  /*!< point query context of each query */
+                                    size_t M);                    /*!< number of point queries */
+
     /*! Type of intersect function pointer for single rays. */
     typedef void (*IntersectFunc)(Intersectors* This,  /*!< this pointer to accel */
                                   RTCRayHit& ray,      /*!< ray to intersect */
@@ -161,13 +198,16 @@ namespace embree
     struct Intersector1
     {
       Intersector1 (ErrorFunc error = nullptr)
-      : intersect((IntersectFunc)error), occluded((OccludedFunc)error), name(nullptr) {}
+      : intersect((IntersectFunc)error), occluded((OccludedFunc)error), pointQuery1M(nullptr), name(nullptr) {}
       
       Intersector1 (IntersectFunc intersect, OccludedFunc occluded, const char* name)
-      : intersect(intersect), occluded(occluded), pointQuery(nullptr), name(name) {}
+      : intersect(intersect), occluded(occluded), pointQuery(nullptr), pointQuery1M(nullptr), name(name) {}
       
       Intersector1 (IntersectFunc intersect, OccludedFunc occluded, PointQueryFunc pointQuery, const char* name)
-      : intersect(intersect), occluded(occluded), pointQuery(pointQuery), name(name) {}
+      : intersect(intersect), occluded(occluded), pointQuery(pointQuery), pointQuery1M(nullptr), name(name) {}
+
+      Intersector1 (IntersectFunc intersect, OccludedFunc occluded, PointQueryFunc pointQuery, PointQueryFunc1M pointQuery1M, const char* name)
+      : intersect(intersect), occluded(occluded), pointQuery(pointQuery), pointQuery1M(pointQuery1M), name(name) {}
 
       operator bool() const { return name; }
 
@@ -176,6 +216,7 @@ namespace embree
       IntersectFunc intersect;
       OccludedFunc occluded;
       PointQueryFunc pointQuery;
+      PointQueryFunc1M pointQuery1M;
       const char* name;
     };
     
@@ -308,6 +349,18 @@ namespace embree
         return intersector1.pointQuery(this,query,context);
       }
 
+      /*! performs multiple point queries, traversed as packets if supported */
+      __forceinline bool pointQuery1M (PointQuery** query, PointQueryContext** context, size_t M)
+      {
+        if (intersector1.pointQuery1M)
+          return intersector1.pointQuery1M(this,query,context,M);
+
+        bool changed = false;
+        for (size_t i=0; i<M; i++)
+          changed |= pointQuery(query[i],context[i]);
+        return changed;
+      }
+
       /*! collides two scenes */
       __forceinline void collide (Accel* scene0, Accel* scene1, RTCCollideFunc callback, void* userPtr) {
         assert(collider.collide);
@@ -496,6 +549,7 @@ namespace embree
     return Accel::Intersector1((Accel::IntersectFunc )intersector::intersect, \
                                (Accel::OccludedFunc  )intersector::occluded,  \
                                (Accel::PointQueryFunc)intersector::pointQuery,\
+                               (Accel::PointQueryFunc1M)intersector::pointQuery1M,\
                                TOSTRING(isa) "::" TOSTRING(symbol));          \
   }
   
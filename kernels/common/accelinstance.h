@@ -37,6 +37,19 @@ namespace embree
       bounds = accel->bounds;
     }
 
+    void save(std::ostream& out) const {
+      accel->save(out);
+    }
+
+    void load(std::istream& in) {
+      accel->load(in);
+      bounds = accel->bounds;
+    }
+
+    size_t getHugePageBytes() {
+      return accel ? accel->getHugePageBytes() : 0;
+    }
+
     void deleteGeometry(size_t geomID) {
       if (accel  ) accel->deleteGeometry(geomID);
       if (builder) builder->deleteGeometry(geomID);
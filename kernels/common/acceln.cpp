@@ -54,6 +54,16 @@ namespace embree
     return changed;
   }
 
+  bool AccelN::pointQuery1M (Accel::Intersectors* This_in, PointQuery** query, PointQueryContext** context, size_t M)
+  {
+    bool changed = false;
+    AccelN* This = (AccelN*)This_in->ptr;
+    for (size_t i=0; i<This->accels.size(); i++)
+      if (!This->accels[i]->isEmpty())
+        changed |= This->accels[i]->intersectors.pointQuery1M(query,context,M);
+    return changed;
+  }
+
   void AccelN::intersect (Accel::Intersectors* This_in, RTCRayHit& ray, IntersectContext* context) 
   {
     AccelN* This = (AccelN*)This_in->ptr;
@@ -189,6 +199,58 @@ namespace embree
         accels[i]->build();
       });
 
+    accels_finalize();
+  }
+
+  /* identifies an intersector independent of the ISA it got compiled for */
+  static std::string intersectorID(const char* name)
+  {
+    if (name == nullptr) return "";
+    const char* sep = strstr(name,"::");
+    return sep ? std::string(sep+2) : std::string(name);
+  }
+
+  void AccelN::accels_save (std::ostream& out) const
+  {
+    writeBinary(out,(unsigned int)accels.size());
+    for (size_t i=0; i<accels.size(); i++)
+    {
+      /* the loading scene has to select the same traversal kernels */
+      const std::string id = intersectorID(accels[i]->intersectors.intersector1.name);
+      writeBinary(out,(unsigned int)id.size());
+      out.write(id.data(),id.size());
+      accels[i]->save(out);
+    }
+  }
+
+  void AccelN::accels_load (std::istream& in)
+  {
+    accels.shrink_to_fit();
+
+    if (readBinary<unsigned int>(in) != accels.size())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH cache file does not match scene acceleration structures");
+
+    for (size_t i=0; i<accels.size(); i++)
+    {
+      std::string id(readBinary<unsigned int>(in),'\0');
+      if (!in.read(&id[0],id.size()) || id != intersectorID(accels[i]->intersectors.intersector1.name))
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH cache file does not match scene acceleration structures");
+      accels[i]->load(in);
+    }
+
+    accels_finalize();
+  }
+
+  size_t AccelN::accels_hugePageBytes ()
+  {
+    size_t bytes = 0;
+    for (size_t i=0; i<accels.size(); i++)
+      bytes += accels[i]->getHugePageBytes();
+    return bytes;
+  }
+
+  void AccelN::accels_finalize ()
+  {
     /* create list of non-empty acceleration structures */
     bool valid1 = true;
     bool valid4 = true;
@@ -210,7 +272,7 @@ namespace embree
     {
       type = AccelData::TY_ACCELN;
       intersectors.ptr = this;
-      intersectors.intersector1  = Intersector1(&intersect,&occluded,&pointQuery,valid1 ? "AccelN::intersector1": nullptr);
+      intersectors.intersector1  = Intersector1(&intersect,&occluded,&pointQuery,&pointQuery1M,valid1 ? "AccelN::intersector1": nullptr);
       intersectors.intersector4  = Intersector4(&intersect4,&occluded4,valid4 ? "AccelN::intersector4" : nullptr);
       intersectors.intersector8  = Intersector8(&intersect8,&occluded8,valid8 ? "AccelN::intersector8" : nullptr);
       intersectors.intersector16 = Intersector16(&intersect16,&occluded16,valid16 ? "AccelN::intersector16": nullptr);
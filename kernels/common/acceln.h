@@ -33,6 +33,7 @@ namespace embree
 
   public:
     static bool pointQuery (Accel::Intersectors* This, PointQuery* query, PointQueryContext* context);
+    static bool pointQuery1M (Accel::Intersectors* This, PointQuery** query, PointQueryContext** context, size_t M);
 
   public:
     static void intersect (Accel::Intersectors* This, RTCRayHit& ray, IntersectContext* context);
@@ -52,9 +53,13 @@ namespace embree
     void accels_print(size_t ident);
     void accels_immutable();
     void accels_build ();
+    void accels_save (std::ostream& out) const;
+    void accels_load (std::istream& in);
+    size_t accels_hugePageBytes ();
     void accels_select(bool filter);
     void accels_deleteGeometry(size_t geomID);
     void accels_clear ();
+    void accels_finalize ();
 
   public:
     std::vector<Accel*> accels;
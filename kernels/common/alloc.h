@@ -198,8 +198,8 @@ namespace embree
 
     FastAllocator (Device* device, bool osAllocation) 
       : device(device), slotMask(0), usedBlocks(nullptr), freeBlocks(nullptr), use_single_mode(false), defaultBlockSize(PAGE_SIZE), estimatedSize(0),
-        growSize(PAGE_SIZE), maxGrowSize(maxAllocationSize), log2_grow_size_scale(0), bytesUsed(0), bytesFree(0), bytesWasted(0), atype(osAllocation ? EMBREE_OS_MALLOC : ALIGNED_MALLOC),
-        primrefarray(device,0)
+        growSize(PAGE_SIZE), maxGrowSize(maxAllocationSize), log2_grow_size_scale(0), bytesUsed(0), bytesFree(0), bytesWasted(0), contention(0), use_huge_pages(device && device->hugepages_bvh), atype(osAllocation || use_huge_pages ? EMBREE_OS_MALLOC : ALIGNED_MALLOC),
+        numNumaNodes(getNumberOfNumaNodes()), primrefarray(device,0)
     {
       for (size_t i=0; i<MAX_THREAD_USED_BLOCK_SLOTS; i++)
       {
@@ -235,7 +235,7 @@ namespace embree
 
     void setOSallocation(bool flag)
     {
-      atype = flag ? EMBREE_OS_MALLOC : ALIGNED_MALLOC;
+      atype = flag || use_huge_pages ? EMBREE_OS_MALLOC : ALIGNED_MALLOC;
     }
 
   private:
@@ -429,7 +429,7 @@ namespace embree
       slotMask = MAX_THREAD_USED_BLOCK_SLOTS-1; // FIXME: remove
       if (usedBlocks.load() || freeBlocks.load()) { reset(); return; }
       if (bytesReserve == 0) bytesReserve = bytesAllocate;
-      freeBlocks = Block::create(device,bytesAllocate,bytesReserve,nullptr,atype);
+      freeBlocks = Block::create(device,bytesAllocate,bytesReserve,nullptr,atype,use_huge_pages);
       estimatedSize = bytesEstimate;
       initGrowSizeAndNumSlots(bytesEstimate,true);
     }
@@ -464,6 +464,7 @@ namespace embree
       bytesUsed.store(0);
       bytesFree.store(0);
       bytesWasted.store(0);
+      contention.store(0);
 
       /* reset all used blocks and move them to begin of free block list */
       while (usedBlocks.load() != nullptr) {
@@ -495,6 +496,7 @@ namespace embree
       bytesUsed.store(0);
       bytesFree.store(0);
       bytesWasted.store(0);
+      contention.store(0);
       if (usedBlocks.load() != nullptr) usedBlocks.load()->clear_list(device); usedBlocks = nullptr;
       if (freeBlocks.load() != nullptr) freeBlocks.load()->clear_list(device); freeBlocks = nullptr;
       for (size_t i=0; i<MAX_THREAD_USED_BLOCK_SLOTS; i++) {
@@ -510,6 +512,44 @@ namespace embree
       return size_t(1) << min(size_t(16),scale);
     }
 
+  private:
+    struct Block;
+
+    /*! lock-free push of a block that is not yet visible to other threads onto a block list */
+    static __forceinline void push(std::atomic<Block*>& list, Block* block)
+    {
+      block->next = list.load();
+      while (!list.compare_exchange_weak(block->next,block));
+    }
+
+    /*! lock-free pop from the free block list. During a build only
+     *  blocks that were never in the free list before get pushed onto
+     *  it, and popped blocks only go back to it in reset(). Thus a
+     *  block cannot reappear at the head of the list while another
+     *  thread tries to pop it, which rules out the ABA problem. */
+    __forceinline Block* popFreeBlock()
+    {
+      Block* block = freeBlocks.load();
+      while (block && !freeBlocks.compare_exchange_weak(block,block->next));
+      return block;
+    }
+
+    /*! returns the block slot of the calling thread, threads of
+     *  different NUMA nodes use different slots such that the pages
+     *  of a block get first touched by a single NUMA node only */
+    __forceinline size_t getSlot() const
+    {
+      const size_t threadID = TaskScheduler::threadID();
+      if (likely(numNumaNodes < 2))
+        return threadID & slotMask;
+
+      const size_t slotsPerNode = max(size_t(1),(slotMask+1)/numNumaNodes);
+      const size_t node = getCurrentNumaNode();
+      return (node*slotsPerNode + threadID%slotsPerNode) & slotMask;
+    }
+
+  public:
+
     /*! thread safe allocation of memory */
     void* malloc(size_t& bytes, size_t align, bool partial)
     {
@@ -518,8 +558,7 @@ namespace embree
       while (true)
       {
         /* allocate using current block */
-        size_t threadID = TaskScheduler::threadID();
-        size_t slot = threadID & slotMask;
+        size_t slot = getSlot();
 	Block* myUsedBlocks = threadUsedBlocks[slot];
         if (myUsedBlocks) {
           void* ptr = myUsedBlocks->malloc(device,bytes,align,partial);
@@ -530,45 +569,43 @@ namespace embree
         if (bytes > maxAllocationSize)
           throw_RTCError(RTC_ERROR_UNKNOWN,"allocation is too large");
 
-        /* parallel block creation in case of no freeBlocks, avoids single global mutex */
-        if (likely(freeBlocks.load() == nullptr))
+        /* take the next free block without locking */
+        const bool hadFreeBlocks = freeBlocks.load() != nullptr;
+        if (Block* block = popFreeBlock())
         {
-#if defined(__aarch64__) && defined(BUILD_IOS)
-          std::scoped_lock lock(slotMutex[slot]);
-#else
-          Lock<SpinLock> lock(slotMutex[slot]);
-#endif
-          if (myUsedBlocks == threadUsedBlocks[slot]) {
-            const size_t alignedBytes = (bytes+(align-1)) & ~(align-1);
-            const size_t allocSize = max(min(growSize,maxGrowSize),alignedBytes);
-            assert(allocSize >= bytes);
-            threadBlocks[slot] = threadUsedBlocks[slot] = Block::create(device,allocSize,allocSize,threadBlocks[slot],atype); // FIXME: a large allocation might throw away a block here!
-            // FIXME: a direct allocation should allocate inside the block here, and not in the next loop! a different thread could do some allocation and make the large allocation fail.
-          }
+          push(threadBlocks[slot],block);
+          if (threadUsedBlocks[slot].compare_exchange_strong(myUsedBlocks,block))
+            continue;
+
+          /* on a lost race the block serves this allocation directly, as popped blocks cannot go back to the free list */
+          contention++;
+          void* ptr = block->malloc(device,bytes,align,partial);
+          if (ptr) return ptr;
           continue;
         }
 
-        /* if this fails allocate new block */
-        {
+        /* parallel block creation in case of no freeBlocks, avoids single global mutex */
 #if defined(__aarch64__) && defined(BUILD_IOS)
-            std::scoped_lock lock(mutex);
+        std::scoped_lock lock(slotMutex[slot]);
 #else
-            Lock<SpinLock> lock(mutex);
+        Lock<SpinLock> lock(slotMutex[slot]);
 #endif
-	  if (myUsedBlocks == threadUsedBlocks[slot])
-	  {
-            if (freeBlocks.load() != nullptr) {
-	      Block* nextFreeBlock = freeBlocks.load()->next;
-	      freeBlocks.load()->next = usedBlocks;
-	      __memory_barrier();
-	      usedBlocks = freeBlocks.load();
-              threadUsedBlocks[slot] = freeBlocks.load();
-	      freeBlocks = nextFreeBlock;
-	    } else {
-              const size_t allocSize = min(growSize*incGrowSizeScale(),maxGrowSize);
-	      usedBlocks = threadUsedBlocks[slot] = Block::create(device,allocSize,allocSize,usedBlocks,atype); // FIXME: a large allocation should get delivered directly, like above!
-	    }
-          }
+        if (myUsedBlocks != threadUsedBlocks[slot] || freeBlocks.load() != nullptr)
+          continue;
+
+        /* grow faster when other threads emptied the free list in between */
+        const size_t alignedBytes = (bytes+(align-1)) & ~(align-1);
+        const size_t growBytes = hadFreeBlocks ? min(growSize*incGrowSizeScale(),maxGrowSize) : min(growSize,maxGrowSize);
+        const size_t allocSize = max(growBytes,alignedBytes);
+        assert(allocSize >= bytes);
+        Block* block = Block::create(device,allocSize,allocSize,nullptr,atype,use_huge_pages);
+
+        /* a thread of this slot installed a popped block in between, the new block goes to the free list */
+        if (threadUsedBlocks[slot].compare_exchange_strong(myUsedBlocks,block))
+          push(threadBlocks[slot],block);
+        else {
+          contention++;
+          push(freeBlocks,block);
         }
       }
     }
@@ -576,17 +613,12 @@ namespace embree
     /*! add new block */
     void addBlock(void* ptr, ssize_t bytes)
     {
-#if defined(__aarch64__) && defined(BUILD_IOS)
-      std::scoped_lock lock(mutex);
-#else
-      Lock<SpinLock> lock(mutex);
-#endif
       const size_t sizeof_Header = offsetof(Block,data[0]);
       void* aptr = (void*) ((((size_t)ptr)+maxAlignment-1) & ~(maxAlignment-1));
       size_t ofs = (size_t) aptr - (size_t) ptr;
       bytes -= ofs;
       if (bytes < 4096) return; // ignore empty or very small blocks
-      freeBlocks = new (aptr) Block(SHARED,bytes-sizeof_Header,bytes-sizeof_Header,freeBlocks,ofs);
+      push(freeBlocks,new (aptr) Block(SHARED,bytes-sizeof_Header,bytes-sizeof_Header,nullptr,ofs));
     }
 
     /* special allocation only used from morton builder only a single time for each build */
@@ -657,6 +689,16 @@ namespace embree
       return bytesWasted;
     }
 
+    /*! returns the number of bytes allocated on 2MB pages */
+    size_t getHugePageBytes() {
+      return Statistics(this,EMBREE_OS_MALLOC,true).bytesAllocatedTotal();
+    }
+
+    /*! returns the number of lost races when installing blocks into thread slots */
+    size_t getContention() {
+      return contention;
+    }
+
     struct AllStatistics
     {
       AllStatistics (FastAllocator* alloc)
@@ -664,6 +706,7 @@ namespace embree
       : bytesUsed(alloc->bytesUsed),
         bytesFree(alloc->bytesFree),
         bytesWasted(alloc->bytesWasted),
+        contention(alloc->contention),
         stat_all(alloc,ANY_TYPE),
         stat_malloc(alloc,ALIGNED_MALLOC),
         stat_4K(alloc,EMBREE_OS_MALLOC,false),
@@ -673,6 +716,7 @@ namespace embree
       AllStatistics (size_t bytesUsed,
                      size_t bytesFree,
                      size_t bytesWasted,
+                     size_t contention,
                      Statistics stat_all,
                      Statistics stat_malloc,
                      Statistics stat_4K,
@@ -682,6 +726,7 @@ namespace embree
       : bytesUsed(bytesUsed),
         bytesFree(bytesFree),
         bytesWasted(bytesWasted),
+        contention(contention),
         stat_all(stat_all),
         stat_malloc(stat_malloc),
         stat_4K(stat_4K),
@@ -693,6 +738,7 @@ namespace embree
         return AllStatistics(a.bytesUsed+b.bytesUsed,
                              a.bytesFree+b.bytesFree,
                              a.bytesWasted+b.bytesWasted,
+                             a.contention+b.contention,
                              a.stat_all + b.stat_all,
                              a.stat_malloc + b.stat_malloc,
                              a.stat_4K + b.stat_4K,
@@ -725,12 +771,14 @@ namespace embree
         std::cout << "  2M    : " << stat_2M.str(numPrimitives) << std::endl;
         std::cout << "  malloc: " << stat_malloc.str(numPrimitives) << std::endl;
         std::cout << "  shared: " << stat_shared.str(numPrimitives) << std::endl;
+        std::cout << "  contention = " << contention << std::endl;
       }
 
     private:
       size_t bytesUsed;
       size_t bytesFree;
       size_t bytesWasted;
+      size_t contention;
       Statistics stat_all;
       Statistics stat_malloc;
       Statistics stat_4K;
@@ -755,7 +803,7 @@ namespace embree
 
     struct Block
     {
-      static Block* create(MemoryMonitorInterface* device, size_t bytesAllocate, size_t bytesReserve, Block* next, AllocationType atype)
+      static Block* create(MemoryMonitorInterface* device, size_t bytesAllocate, size_t bytesReserve, Block* next, AllocationType atype, bool huge_page_blocks = false)
       {
         /* We avoid using os_malloc for small blocks as this could
          * cause a risk of fragmenting the virtual address space and
@@ -768,10 +816,11 @@ namespace embree
         bytesAllocate = sizeof_Header+bytesAllocate;
         bytesReserve  = sizeof_Header+bytesReserve;
 
-        /* consume full 4k pages with using os_malloc */
+        /* consume full 4k pages with using os_malloc, or full 2MB pages in huge page mode */
         if (atype == EMBREE_OS_MALLOC) {
-          bytesAllocate = ((bytesAllocate+PAGE_SIZE-1) & ~(PAGE_SIZE-1));
-          bytesReserve  = ((bytesReserve +PAGE_SIZE-1) & ~(PAGE_SIZE-1));
+          const size_t pageSize = huge_page_blocks ? PAGE_SIZE_2M : PAGE_SIZE;
+          bytesAllocate = ((bytesAllocate+pageSize-1) & ~(pageSize-1));
+          bytesReserve  = ((bytesReserve +pageSize-1) & ~(pageSize-1));
         }
 
         /* either use alignedMalloc or os_malloc */
@@ -804,7 +853,7 @@ namespace embree
         else if (atype == EMBREE_OS_MALLOC)
         {
           if (device) device->memoryMonitor(bytesAllocate,false);
-          bool huge_pages; ptr = os_malloc(bytesReserve,huge_pages);
+          bool huge_pages; ptr = os_malloc(bytesReserve,huge_pages,huge_page_blocks);
           return new (ptr) Block(EMBREE_OS_MALLOC,bytesAllocate-sizeof_Header,bytesReserve-sizeof_Header,next,0,huge_pages);
         }
         else
@@ -982,7 +1031,6 @@ namespace embree
 
   private:
     Device* device;
-    SpinLock mutex;
     size_t slotMask;
     std::atomic<Block*> threadUsedBlocks[MAX_THREAD_USED_BLOCK_SLOTS];
     std::atomic<Block*> usedBlocks;
@@ -1004,6 +1052,7 @@ namespace embree
     std::atomic<size_t> bytesUsed;
     std::atomic<size_t> bytesFree;
     std::atomic<size_t> bytesWasted;
+    std::atomic<size_t> contention;   //!< number of lost races when installing blocks into thread slots
     static __thread ThreadLocal2* thread_local_allocator2;
     static SpinLock s_thread_local_allocators_lock;
     static std::vector<std::unique_ptr<ThreadLocal2>> s_thread_local_allocators;
@@ -1013,7 +1062,9 @@ namespace embree
     SpinLock thread_local_allocators_lock;
 #endif
     std::vector<ThreadLocal2*> thread_local_allocators;
+    bool use_huge_pages;               //!< allocate large blocks in multiples of 2MB from the OS
     AllocationType atype;
+    size_t numNumaNodes;               //!< number of NUMA nodes to distribute block slots over
     mvector<PrimRef> primrefarray;     //!< primrefarray used to allocate nodes
   };
 }
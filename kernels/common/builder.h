@@ -37,6 +37,9 @@ namespace embree
 
     /*! clears internal builder state */
     virtual void clear() = 0;
+
+    /*! returns the SAH cost of the last built hierarchy, or 0 if the builder does not track it */
+    virtual double getSAH() const { return 0.0; }
   };
 
   /*! virtual interface for progress monitor class */
@@ -41,6 +41,10 @@ namespace embree
     __forceinline bool isIncoherent() const {
       return embree::isIncoherent(user->flags);
     }
+
+    __forceinline bool isReorder() const {
+      return embree::isReorder(user->flags);
+    }
     
   public:
     Scene* scene;
@@ -54,6 +58,148 @@ namespace embree
     POINT_QUERY_TYPE_AABB = 2,
   };
 
+  enum PointQueryMode
+  {
+    POINT_QUERY_MODE_CALLBACK = 0, // invokes the point query callbacks for each primitive
+    POINT_QUERY_MODE_CLOSEST = 1,  // built-in closest point kernels for triangles, quads, and grids
+    POINT_QUERY_MODE_NEAREST = 2,  // built-in kernels collecting the k nearest primitives
+  };
+
+  /*! Bounded max-heap of the nearest primitives found so far, stored
+   *  in the hit buffer of the caller. Primitives found multiple times
+   *  (e.g. due to spatial splits) have the same distance and are only
+   *  stored once, a hash set of the stored primitives detects them. */
+  struct NearestPointHeap
+  {
+    /*! identifies a stored primitive in the hash set */
+    struct Key
+    {
+      __forceinline Key () {}
+
+      __forceinline Key (const RTCNearestPointHit& hit)
+        : primID(hit.primID), geomID(hit.geomID)
+      {
+        for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+          instID[l] = hit.instID[l];
+      }
+
+      __forceinline bool empty() const { return geomID == RTC_INVALID_GEOMETRY_ID; }
+
+      __forceinline bool operator== (const Key& other) const
+      {
+        if (primID != other.primID || geomID != other.geomID) return false;
+        for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+          if (instID[l] != other.instID[l]) return false;
+        return true;
+      }
+
+      __forceinline size_t hash() const
+      {
+        unsigned int h = primID*0x9E3779B1u ^ geomID*0x85EBCA77u;
+        for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+          h = (h ^ instID[l])*0xC2B2AE3Du;
+        return h ^ (h >> 16);
+      }
+
+      unsigned int primID;
+      unsigned int geomID;
+      unsigned int instID[RTC_MAX_INSTANCE_LEVEL_COUNT];
+    };
+
+    /*! number of hash set entries required for a heap of k primitives, keeps the load factor at most 1/2 */
+    static __forceinline size_t numKeys(unsigned int k)
+    {
+      size_t n = 4;
+      while (n < 2*size_t(k)+2) n *= 2;
+      return n;
+    }
+
+    __forceinline NearestPointHeap(RTCNearestPointHit* hits, unsigned int capacity, Key* keys, bool radiusSearch)
+      : hits(hits), keys(keys), keyMask(numKeys(capacity)-1), capacity(capacity), size(0), radiusSearch(radiusSearch), truncated(false)
+    {
+      for (size_t i=0; i<=keyMask; i++)
+        keys[i].geomID = RTC_INVALID_GEOMETRY_ID;
+    }
+
+    static __forceinline bool compare(const RTCNearestPointHit& a, const RTCNearestPointHit& b) {
+      return a.distance < b.distance;
+    }
+
+    __forceinline bool full() const { return size == capacity; }
+    __forceinline float maxDistance() const { return hits[0].distance; }
+
+    /* only k nearest searches cull with the distance of the k-th nearest primitive, radius searches keep the query radius */
+    __forceinline bool shrinksRadius() const { return !radiusSearch && full(); }
+
+    void insert(const RTCNearestPointHit& hit)
+    {
+      const Key key(hit);
+      if (!keys[findKey(key)].empty())
+        return;
+
+      if (size < capacity) {
+        keys[findKey(key)] = key;
+        hits[size++] = hit;
+        std::push_heap(hits,hits+size,compare);
+        return;
+      }
+
+      /* another primitive than the stored ones is within the query radius */
+      truncated = true;
+      if (!(hit.distance < maxDistance()))
+        return;
+
+      std::pop_heap(hits,hits+size,compare);
+      eraseKey(Key(hits[size-1]));
+      keys[findKey(key)] = key;
+      hits[size-1] = hit;
+      std::push_heap(hits,hits+size,compare);
+    }
+
+    /* sorts the hits by increasing distance and returns the number of hits, radius searches return k+1 if more than k primitives got found */
+    unsigned int finish()
+    {
+      std::sort_heap(hits,hits+size,compare);
+      return (radiusSearch && truncated) ? size+1 : size;
+    }
+
+  private:
+
+    /* returns the slot of the key, or the empty slot it has to get stored at */
+    __forceinline size_t findKey(const Key& key) const
+    {
+      size_t i = key.hash() & keyMask;
+      while (!keys[i].empty() && !(keys[i] == key))
+        i = (i+1) & keyMask;
+      return i;
+    }
+
+    /* removes a key and moves following keys of the probe sequence into the hole */
+    void eraseKey(const Key& key)
+    {
+      size_t i = findKey(key);
+      keys[i].geomID = RTC_INVALID_GEOMETRY_ID;
+      for (size_t j=(i+1) & keyMask; !keys[j].empty(); j=(j+1) & keyMask)
+      {
+        const size_t h = keys[j].hash() & keyMask;
+        const bool reachable = i <= j ? (i < h && h <= j) : (i < h || h <= j);
+        if (reachable) continue;
+        keys[i] = keys[j];
+        keys[j].geomID = RTC_INVALID_GEOMETRY_ID;
+        i = j;
+      }
+    }
+
+  public:
+    RTCNearestPointHit* hits;
+    Key* keys;
+    size_t keyMask;
+    unsigned int capacity;
+    unsigned int size;
+    bool radiusSearch;
+    bool truncated;
+  };
+
   typedef bool (*PointQueryFunction)(struct RTCPointQueryFunctionArguments* args);
   
   struct PointQueryContext
@@ -65,7 +211,8 @@ namespace embree
                                     PointQueryFunction func, 
                                     RTCPointQueryContext* userContext,
                                     float similarityScale,
-                                    void* userPtr)
+                                    void* userPtr,
+                                    PointQueryMode mode = POINT_QUERY_MODE_CALLBACK)
       : scene(scene)
       , query_ws(query_ws)
       , query_type(query_type)
@@ -73,6 +220,7 @@ namespace embree
       , userContext(userContext)
       , similarityScale(similarityScale)
       , userPtr(userPtr) 
+      , mode(mode)
       , primID(RTC_INVALID_GEOMETRY_ID)
       , geomID(RTC_INVALID_GEOMETRY_ID)
       , query_radius(query_ws->radius)
@@ -110,6 +258,7 @@ public:
     const float similarityScale;
 
     void* userPtr;
+    PointQueryMode mode;
 
     unsigned int primID;
     unsigned int geomID;
@@ -47,8 +47,31 @@ namespace embree
 
   static MutexSys g_mutex;
   static std::map<Device*,size_t> g_cache_size_map;
+  static std::map<Device*,size_t> g_cache_shards_map;
   static std::map<Device*,size_t> g_num_threads_map;
 
+  /* feedback parameters of the adaptive tessellation cache */
+  static const size_t CACHE_MIN_FRAME_LOOKUPS = 1024;     //!< commits with fewer cache lookups since the last update do not end a frame
+  static const size_t CACHE_SHRINK_FRAMES = 4;            //!< number of frames the cache has to be too large before shrinking
+  static const float  CACHE_GROW_CHURN = 0.5f;            //!< fraction of the cache evicted per frame that lets the cache grow
+  static const float  CACHE_GROW_HIT_RATE = 0.95f;        //!< the cache only grows when its hit rate is below this value
+
+  /*! tessellation cache statistics since the last update, the statistics may have been cleared in between */
+  static size_t cacheStatsDelta(size_t cur, size_t last) {
+    return cur >= last ? cur-last : cur;
+  }
+
+#if defined(TASKING_INTERNAL)
+  /*! work stealing statistics summed up over all thread indices */
+  static TaskScheduler::ThreadStatistics getTotalThreadStatistics()
+  {
+    TaskScheduler::ThreadStatistics total;
+    std::vector<TaskScheduler::ThreadStatistics> stats = TaskScheduler::getThreadStatistics();
+    for (size_t i=0; i<stats.size(); i++) total += stats[i];
+    return total;
+  }
+#endif
+
   Device::Device (const char* cfg)
   {
     /* check CPU */
@@ -73,7 +96,19 @@ namespace embree
 #endif
     State::hugepages_success &= os_init(State::hugepages,State::verbosity(3));
     
+    numRefitRebuilds = 0;
+    numIncrementalUpdates = 0;
+    hugePageBVHBytes = 0;
+
     /*! set tessellation cache size */
+    cacheHits = cacheMisses = cacheFlushes = cacheAllocatedBytes = 0;
+    cacheMaxFrameBytes = cacheShrinkFrames = 0;
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    cacheHits = SharedTessellationCacheStats::getHits();
+    cacheMisses = SharedTessellationCacheStats::getMisses();
+#endif
+    if (State::tessellation_cache_adaptive)
+      State::tessellation_cache_size = clamp(State::tessellation_cache_size,State::tessellation_cache_min_size,State::tessellation_cache_max_size);
     setCacheSize( State::tessellation_cache_size );
 
     /*! enable some floating point exceptions to catch bugs */
@@ -98,7 +133,7 @@ namespace embree
     /* register all algorithms */
     bvh4_factory = make_unique(new BVH4Factory(enabled_builder_cpu_features, enabled_cpu_features));
 
-#if defined(EMBREE_TARGET_SIMD8)
+#if defined(EMBREE_TARGET_SIMD8) || defined(EMBREE_BVH8_SIMD4)
     bvh8_factory = make_unique(new BVH8Factory(enabled_builder_cpu_features, enabled_cpu_features));
 #endif
 
@@ -314,6 +349,14 @@ namespace embree
       maxCacheSize = max(maxCacheSize, (*i).second);
     return maxCacheSize;
   }
+
+  size_t getMaxCacheShards()
+  {
+    size_t maxCacheShards = 1;
+    for (std::map<Device*,size_t>::iterator i=g_cache_shards_map.begin(); i!= g_cache_shards_map.end(); i++)
+      maxCacheShards = max(maxCacheShards, (*i).second);
+    return maxCacheShards;
+  }
  
   void Device::setCacheSize(size_t bytes) 
   {
@@ -321,15 +364,107 @@ namespace embree
     Lock<MutexSys> lock(g_mutex);
     if (bytes == 0) g_cache_size_map.erase(this);
     else            g_cache_size_map[this] = bytes;
+
+    if (bytes == 0) g_cache_shards_map.erase(this);
+    else            g_cache_shards_map[this] = State::tessellation_cache_shards;
     
     size_t maxCacheSize = getMaxCacheSize();
+    setTessellationCacheShards(getMaxCacheShards());
     resizeTessellationCache(maxCacheSize);
 #endif
   }
 
+  ssize_t Device::getCacheHitRate()
+  {
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    Lock<MutexSys> lock(g_mutex);
+    const size_t hits = cacheStatsDelta(SharedTessellationCacheStats::getHits(),cacheHits);
+    const size_t misses = cacheStatsDelta(SharedTessellationCacheStats::getMisses(),cacheMisses);
+    if (hits+misses == 0) return 0;
+    return (ssize_t) (1000*hits/(hits+misses));
+#else
+    return 0;
+#endif
+  }
+
+  void Device::updateCacheSize()
+  {
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    if (!State::tessellation_cache_adaptive)
+      return;
+
+    Lock<MutexSys> lock(g_mutex);
+
+    /* statistics of the frame ending with this commit */
+    const size_t hits = SharedTessellationCacheStats::getHits();
+    const size_t misses = SharedTessellationCacheStats::getMisses();
+    const size_t frameHits = cacheStatsDelta(hits,cacheHits);
+    const size_t frameMisses = cacheStatsDelta(misses,cacheMisses);
+    if (frameHits+frameMisses < CACHE_MIN_FRAME_LOOKUPS)
+      return;
+
+    const size_t flushes = SharedTessellationCacheStats::getFlushes();
+    const size_t allocatedBytes = SharedTessellationCacheStats::getAllocatedBytes();
+    const size_t frameFlushes = cacheStatsDelta(flushes,cacheFlushes);
+    const size_t frameBytes = cacheStatsDelta(allocatedBytes,cacheAllocatedBytes);
+    cacheHits = hits; cacheMisses = misses; cacheFlushes = flushes; cacheAllocatedBytes = allocatedBytes;
+    const float hitRate = float(frameHits)/float(frameHits+frameMisses);
+
+    if (g_cache_size_map.find(this) == g_cache_size_map.end())
+      return;
+
+    /* fraction of the cache that got evicted during the frame */
+    SharedLazyTessellationCache& cache = SharedLazyTessellationCache::sharedLazyTessellationCache;
+    const float churn = float(frameFlushes)/float(cache.getNumShards()*SharedLazyTessellationCache::NUM_CACHE_SEGMENTS);
+    cacheMaxFrameBytes = max(cacheMaxFrameBytes,frameBytes);
+
+    /* grow when thrashing, shrink when the data of each frame fits into a quarter of the cache for some frames */
+    const size_t size = g_cache_size_map[this];
+    size_t newSize = size;
+    if (churn >= CACHE_GROW_CHURN && hitRate < CACHE_GROW_HIT_RATE) {
+      newSize = min(2*size,State::tessellation_cache_max_size);
+      cacheShrinkFrames = 0;
+    }
+    else if (frameFlushes == 0 && cacheMaxFrameBytes <= size/4) {
+      if (++cacheShrinkFrames >= CACHE_SHRINK_FRAMES)
+        newSize = max(size/2,State::tessellation_cache_min_size);
+    }
+    else
+      cacheShrinkFrames = 0;
+
+    if (newSize == size)
+      return;
+
+    if (State::verbosity(2))
+      std::cout << "resizing tessellation cache from " << float(size)*1E-6 << " MB to " << float(newSize)*1E-6 << " MB"
+                << " (hit rate = " << 100.0f*hitRate << "%, churn = " << churn << ")" << std::endl;
+
+    /* resizing invalidates the cache, thus the next frame measures the full working set */
+    State::tessellation_cache_size = newSize;
+    g_cache_size_map[this] = newSize;
+    cacheMaxFrameBytes = cacheShrinkFrames = 0;
+    resizeTessellationCache(getMaxCacheSize());
+#endif
+  }
+
   void Device::initTaskingSystem(size_t numThreads) 
   {
     Lock<MutexSys> lock(g_mutex);
+
+#if defined(TASKING_INTERNAL)
+    /* a device with its own thread arena does not size the shared thread pool */
+    if (State::thread_arena)
+    {
+      g_num_threads_map[this] = 0;
+      TaskScheduler::create(getMaxNumThreads(),State::set_affinity,false);
+
+      const size_t arenaThreads = numThreads ? numThreads : getNumberOfLogicalThreads();
+      threadArena = make_unique(new TaskScheduler::ThreadPool(State::set_affinity,State::thread_arena_cpus,State::thread_arena_priority));
+      threadArena->setNumThreads(arenaThreads,State::start_threads);
+      return;
+    }
+#endif
+
     if (numThreads == 0) 
       g_num_threads_map[this] = std::numeric_limits<size_t>::max();
     else 
@@ -350,6 +485,11 @@ namespace embree
     Lock<MutexSys> lock(g_mutex);
     g_num_threads_map.erase(this);
 
+#if defined(TASKING_INTERNAL)
+    /* terminate the worker threads of the device */
+    threadArena.reset();
+#endif
+
     /* terminate tasking system */
     if (g_num_threads_map.size() == 0) {
       TaskScheduler::destroy();
@@ -520,6 +660,31 @@ namespace embree
     case RTC_DEVICE_PROPERTY_PARALLEL_COMMIT_SUPPORTED: return 0;
 #endif
 
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE: return SharedLazyTessellationCache::sharedLazyTessellationCache.getSize();
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HIT_RATE: return getCacheHitRate();
+#else
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE: return 0;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HIT_RATE: return 0;
+#endif
+
+    case RTC_DEVICE_PROPERTY_REFIT_REBUILD_COUNT: return numRefitRebuilds;
+    case RTC_DEVICE_PROPERTY_INCREMENTAL_UPDATE_COUNT: return numIncrementalUpdates;
+    case RTC_DEVICE_PROPERTY_HUGE_PAGE_BVH_BYTES: return hugePageBVHBytes;
+
+#if defined(TASKING_INTERNAL)
+    case RTC_DEVICE_PROPERTY_TASK_STEAL_COUNT: {
+      const TaskScheduler::ThreadStatistics stats = getTotalThreadStatistics();
+      return stats.steals[0]+stats.steals[1]+stats.steals[2];
+    }
+    case RTC_DEVICE_PROPERTY_TASK_FAILED_STEAL_COUNT: return getTotalThreadStatistics().failedSteals;
+    case RTC_DEVICE_PROPERTY_TASK_YIELD_COUNT: return getTotalThreadStatistics().yields;
+#else
+    case RTC_DEVICE_PROPERTY_TASK_STEAL_COUNT: return 0;
+    case RTC_DEVICE_PROPERTY_TASK_FAILED_STEAL_COUNT: return 0;
+    case RTC_DEVICE_PROPERTY_TASK_YIELD_COUNT: return 0;
+#endif
+
     default: throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "unknown readable property"); break;
     };
   }
@@ -61,6 +61,12 @@ namespace embree
     /*! sets the size of the software cache. */
     void setCacheSize(size_t bytes);
 
+    /*! adapts the size of the software cache to its hit rate and eviction churn since the last call */
+    void updateCacheSize();
+
+    /*! returns the hit rate of the software cache in units of 0.1 percent since the last cache size update */
+    ssize_t getCacheHitRate();
+
     /*! sets a property */
     void setProperty(const RTCDeviceProperty prop, ssize_t val);
 
@@ -75,6 +81,14 @@ namespace embree
     /*! shuts down the tasking system */
     void exitTaskingSystem();
 
+    /*! tessellation cache statistics at the last cache size update */
+    size_t cacheHits;
+    size_t cacheMisses;
+    size_t cacheFlushes;
+    size_t cacheAllocatedBytes;
+    size_t cacheMaxFrameBytes;             //!< largest number of bytes allocated during a frame since the last resize
+    size_t cacheShrinkFrames;              //!< number of consecutive frames the cache could have been smaller
+
     /*! some variables that can be set via rtcSetParameter1i for debugging purposes */
   public:
     static ssize_t debug_int0;
@@ -84,15 +98,28 @@ namespace embree
 
   public:
     std::unique_ptr<BVH4Factory> bvh4_factory;
-#if defined(EMBREE_TARGET_SIMD8)
+#if defined(EMBREE_TARGET_SIMD8) || defined(EMBREE_BVH8_SIMD4)
     std::unique_ptr<BVH8Factory> bvh8_factory;
 #endif
     
 #if USE_TASK_ARENA
     std::unique_ptr<tbb::task_arena> arena;
 #endif
+
+#if defined(TASKING_INTERNAL)
+    std::unique_ptr<TaskScheduler::ThreadPool> threadArena; //!< own worker threads of the device when thread_arena is enabled
+#endif
     
     /* ray streams filter */
     RayStreamFilterFuncs rayStreamFilters;
+
+    /*! number of rebuilds triggered by refit_rebuild_threshold */
+    std::atomic<size_t> numRefitRebuilds;
+
+    /*! number of top-level BVHs updated incrementally instead of getting rebuilt */
+    std::atomic<size_t> numIncrementalUpdates;
+
+    /*! BVH bytes of the last commit of each scene that got placed on huge pages */
+    std::atomic<size_t> hugePageBVHBytes;
   };
 }
@@ -264,6 +264,7 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_BEGIN;
     RTC_TRACE(rtcCommitScene);
     RTC_VERIFY_HANDLE(hscene);
+    scene->waitCommit();
     scene->commit(false);
     RTC_CATCH_END2(scene);
   }
@@ -274,18 +275,61 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_BEGIN;
     RTC_TRACE(rtcJoinCommitScene);
     RTC_VERIFY_HANDLE(hscene);
+    scene->waitCommit();
     scene->commit(true);
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcCommitSceneAsync (RTCScene hscene, RTCCommitCompleteFunction complete, void* userPtr) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcCommitSceneAsync);
+    RTC_VERIFY_HANDLE(hscene);
+    scene->commitAsync(complete,userPtr);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcWaitCommitScene (RTCScene hscene) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcWaitCommitScene);
+    RTC_VERIFY_HANDLE(hscene);
+    scene->waitCommit();
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcSaveSceneBVH (RTCScene hscene, const char* filename)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSaveSceneBVH);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(filename);
+    scene->saveBVH(filename);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcLoadSceneBVH (RTCScene hscene, const char* filename)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcLoadSceneBVH);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(filename);
+    scene->loadBVH(filename);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcGetSceneBounds(RTCScene hscene, RTCBounds* bounds_o)
   {
     Scene* scene = (Scene*) hscene;
     RTC_CATCH_BEGIN;
     RTC_TRACE(rtcGetSceneBounds);
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
-    BBox3fa bounds = scene->bounds.bounds();
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    BBox3fa bounds = scene->getCommittedBounds().bounds();
     bounds_o->lower_x = bounds.lower.x;
     bounds_o->lower_y = bounds.lower.y;
     bounds_o->lower_z = bounds.lower.z;
@@ -305,24 +349,25 @@ RTC_NAMESPACE_BEGIN;
     RTC_VERIFY_HANDLE(hscene);
     if (bounds_o == nullptr)
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"invalid destination pointer");
-    if (scene->isModified())
+    if (!scene->isCommitted())
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
-    
-    bounds_o->bounds0.lower_x = scene->bounds.bounds0.lower.x;
-    bounds_o->bounds0.lower_y = scene->bounds.bounds0.lower.y;
-    bounds_o->bounds0.lower_z = scene->bounds.bounds0.lower.z;
+
+    const LBBox3fa bounds = scene->getCommittedBounds();
+    bounds_o->bounds0.lower_x = bounds.bounds0.lower.x;
+    bounds_o->bounds0.lower_y = bounds.bounds0.lower.y;
+    bounds_o->bounds0.lower_z = bounds.bounds0.lower.z;
     bounds_o->bounds0.align0  = 0;
-    bounds_o->bounds0.upper_x = scene->bounds.bounds0.upper.x;
-    bounds_o->bounds0.upper_y = scene->bounds.bounds0.upper.y;
-    bounds_o->bounds0.upper_z = scene->bounds.bounds0.upper.z;
+    bounds_o->bounds0.upper_x = bounds.bounds0.upper.x;
+    bounds_o->bounds0.upper_y = bounds.bounds0.upper.y;
+    bounds_o->bounds0.upper_z = bounds.bounds0.upper.z;
     bounds_o->bounds0.align1  = 0;
-    bounds_o->bounds1.lower_x = scene->bounds.bounds1.lower.x;
-    bounds_o->bounds1.lower_y = scene->bounds.bounds1.lower.y;
-    bounds_o->bounds1.lower_z = scene->bounds.bounds1.lower.z;
+    bounds_o->bounds1.lower_x = bounds.bounds1.lower.x;
+    bounds_o->bounds1.lower_y = bounds.bounds1.lower.y;
+    bounds_o->bounds1.lower_z = bounds.bounds1.lower.z;
     bounds_o->bounds1.align0  = 0;
-    bounds_o->bounds1.upper_x = scene->bounds.bounds1.upper.x;
-    bounds_o->bounds1.upper_y = scene->bounds.bounds1.upper.y;
-    bounds_o->bounds1.upper_z = scene->bounds.bounds1.upper.z;
+    bounds_o->bounds1.upper_x = bounds.bounds1.upper.x;
+    bounds_o->bounds1.upper_y = bounds.bounds1.upper.y;
+    bounds_o->bounds1.upper_z = bounds.bounds1.upper.z;
     bounds_o->bounds1.align1  = 0;
     RTC_CATCH_END2(scene);
   }
@@ -336,18 +381,26 @@ RTC_NAMESPACE_BEGIN;
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene0);
     RTC_VERIFY_HANDLE(hscene1);
-    if (scene0->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
-    if (scene1->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene0->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene1->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (scene0->device != scene1->device) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes are from different devices");
     auto nUserPrims0 = scene0->getNumPrimitives (Geometry::MTY_USER_GEOMETRY, false);
     auto nUserPrims1 = scene1->getNumPrimitives (Geometry::MTY_USER_GEOMETRY, false);
-    if (scene0->numPrimitives() != nUserPrims0 && scene1->numPrimitives() != nUserPrims1) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes must only contain user geometries with a single timestep");
+    auto nTriPrims0  = scene0->getNumPrimitives (Geometry::MTY_TRIANGLE_MESH, false);
+    auto nTriPrims1  = scene1->getNumPrimitives (Geometry::MTY_TRIANGLE_MESH, false);
+    if ((scene0->numPrimitives() != nUserPrims0 && scene0->numPrimitives() != nTriPrims0) ||
+        (scene1->numPrimitives() != nUserPrims1 && scene1->numPrimitives() != nTriPrims1))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes must only contain user geometries or only triangle meshes with a single timestep");
 #endif
+    /* both scenes have to use the same BVH and leaf layout */
+    if (scene0->intersectors.collider.collide == nullptr || scene0->intersectors.collider.collide != scene1->intersectors.collider.collide)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes do not support collision detection against each other");
     scene0->intersectors.collide(scene0,scene1,callback,userPtr);
     RTC_CATCH_END(scene0->device);
   }
   
-  inline bool pointQuery(Scene* scene, RTCPointQuery* query, RTCPointQueryContext* userContext, RTCPointQueryFunction queryFunc, void* userPtr)
+  inline bool pointQuery(Scene* scene, RTCPointQuery* query, RTCPointQueryContext* userContext, RTCPointQueryFunction queryFunc, void* userPtr,
+                         PointQueryMode mode = POINT_QUERY_MODE_CALLBACK)
   {
     bool changed = false;
     if (userContext->instStackSize > 0)
@@ -365,18 +418,88 @@ RTC_NAMESPACE_BEGIN;
       
       PointQueryContext context_inst(scene, (PointQuery*)query,
         similtude ? POINT_QUERY_TYPE_SPHERE : POINT_QUERY_TYPE_AABB,
-        queryFunc, userContext, similarityScale, userPtr);
+        queryFunc, userContext, similarityScale, userPtr, mode);
       changed = scene->intersectors.pointQuery((PointQuery*)&query_inst, &context_inst);
     }
     else
     {
       PointQueryContext context(scene, (PointQuery*)query, 
-        POINT_QUERY_TYPE_SPHERE, queryFunc, userContext, 1.f, userPtr);
+        POINT_QUERY_TYPE_SPHERE, queryFunc, userContext, 1.f, userPtr, mode);
       changed = scene->intersectors.pointQuery((PointQuery*)query, &context);
     }
     return changed;
   }
 
+  /* performs multiple point queries that share the user context, such that the scene can traverse them as packets */
+  inline bool pointQuery1M(Scene* scene, RTCPointQuery** query, void** userPtr, size_t M, RTCPointQueryContext* userContext, RTCPointQueryFunction queryFunc,
+                           PointQueryMode mode = POINT_QUERY_MODE_CALLBACK)
+  {
+    static const size_t CHUNK_SIZE = 64;
+
+    /* all queries see the same instance transformation */
+    AffineSpace3fa transform = one;
+    float similarityScale = 1.f;
+    PointQueryType queryType = POINT_QUERY_TYPE_SPHERE;
+    const bool instanced = userContext->instStackSize > 0;
+    if (instanced)
+    {
+      transform = AffineSpace3fa_load_unaligned((AffineSpace3fa*)userContext->world2inst[userContext->instStackSize-1]);
+      similarityScale = 0.f;
+      const bool similtude = similarityTransform(transform, &similarityScale);
+      assert((similtude && similarityScale > 0) || (!similtude && similarityScale == 0.f));
+      queryType = similtude ? POINT_QUERY_TYPE_SPHERE : POINT_QUERY_TYPE_AABB;
+    }
+
+    bool changed = false;
+    PointQuery query_inst[CHUNK_SIZE];
+    PointQuery* queries[CHUNK_SIZE];
+    RTC_ALIGN(16) char contexts_storage[CHUNK_SIZE*sizeof(PointQueryContext)];
+    PointQueryContext* contexts[CHUNK_SIZE];
+    for (size_t i=0; i<M; i+=CHUNK_SIZE)
+    {
+      const size_t num = min(M-i,CHUNK_SIZE);
+      for (size_t j=0; j<num; j++)
+      {
+        RTCPointQuery* q = query[i+j];
+        if (instanced) {
+          query_inst[j].p = xfmPoint(transform, Vec3fa(q->x, q->y, q->z));
+          query_inst[j].radius = q->radius * similarityScale;
+          query_inst[j].time = q->time;
+          queries[j] = &query_inst[j];
+        } else {
+          queries[j] = (PointQuery*)q;
+        }
+        contexts[j] = new (&contexts_storage[j*sizeof(PointQueryContext)])
+          PointQueryContext(scene, (PointQuery*)q, queryType, queryFunc, userContext, similarityScale, userPtr ? userPtr[i+j] : nullptr, mode);
+      }
+      changed |= scene->intersectors.pointQuery1M(queries, contexts, num);
+    }
+    return changed;
+  }
+
+  /* performs the valid point queries of a packet */
+  template<int K>
+  inline bool pointQueryK(const int* valid, Scene* scene, PointQueryK<K>* queryK, RTCPointQueryContext* userContext, RTCPointQueryFunction queryFunc, void** userPtrN)
+  {
+    PointQuery query1[K];
+    RTCPointQuery* query[K];
+    void* userPtr[K];
+    size_t index[K];
+    size_t num = 0;
+    for (size_t i=0; i<K; i++) {
+      if (!valid[i]) continue;
+      queryK->get(i,query1[num]);
+      query[num] = (RTCPointQuery*)&query1[num];
+      userPtr[num] = userPtrN ? userPtrN[i] : nullptr;
+      index[num++] = i;
+    }
+
+    const bool changed = pointQuery1M(scene, query, userPtr, num, userContext, queryFunc);
+    for (size_t j=0; j<num; j++)
+      queryK->set(index[j],query1[j]);
+    return changed;
+  }
+
   RTC_API bool rtcPointQuery(RTCScene hscene, RTCPointQuery* query, RTCPointQueryContext* userContext, RTCPointQueryFunction queryFunc, void* userPtr)
   {
     Scene* scene = (Scene*) hscene;
@@ -385,7 +508,7 @@ RTC_NAMESPACE_BEGIN;
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
     RTC_VERIFY_HANDLE(userContext);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
     if (((size_t)userContext) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "context not aligned to 16 bytes");   
 #endif
@@ -402,23 +525,14 @@ RTC_NAMESPACE_BEGIN;
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
     if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(point_query.travs,cnt,cnt,cnt);
 
-    bool changed = false;
-    PointQuery4* query4 = (PointQuery4*)query;
-    PointQuery query1; 
-    for (size_t i=0; i<4; i++) {
-      if (!valid[i]) continue;
-      query4->get(i,query1);
-      changed |= pointQuery(scene, (RTCPointQuery*)&query1, userContext, queryFunc, userPtrN?userPtrN[i]:NULL);
-      query4->set(i,query1);
-    }
-    return changed;
+    return pointQueryK<4>(valid, scene, (PointQuery4*)query, userContext, queryFunc, userPtrN);
     RTC_CATCH_END2_FALSE(scene);
   }
   
@@ -430,23 +544,14 @@ RTC_NAMESPACE_BEGIN;
     
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
     if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(point_query.travs,cnt,cnt,cnt);
 
-    bool changed = false;
-    PointQuery8* query8 = (PointQuery8*)query;
-    PointQuery query1; 
-    for (size_t i=0; i<8; i++) {
-      if (!valid[i]) continue;
-      query8->get(i,query1);
-      changed |= pointQuery(scene, (RTCPointQuery*)&query1, userContext, queryFunc, userPtrN?userPtrN[i]:NULL);
-      query8->set(i,query1);
-    }
-    return changed;
+    return pointQueryK<8>(valid, scene, (PointQuery8*)query, userContext, queryFunc, userPtrN);
     RTC_CATCH_END2_FALSE(scene);
   }
 
@@ -458,26 +563,182 @@ RTC_NAMESPACE_BEGIN;
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
     if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(point_query.travs,cnt,cnt,cnt);
 
+    return pointQueryK<16>(valid, scene, (PointQuery16*)query, userContext, queryFunc, userPtrN);
+    RTC_CATCH_END2_FALSE(scene);
+  }
+
+  RTC_API bool rtcPointQuery1M (RTCScene hscene, RTCPointQuery* query, unsigned int M, size_t byteStride, struct RTCPointQueryContext* userContext, RTCPointQueryFunction queryFunc, void** userPtrN)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcPointQuery1M);
+
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(userContext);
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");
+    if (byteStride & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "stride not aligned to 16 bytes");
+#endif
+    STAT3(point_query.travs,M,M,M);
+
+    static const size_t CHUNK_SIZE = 256;
+    RTCPointQuery* queries[CHUNK_SIZE];
     bool changed = false;
-    PointQuery16* query16 = (PointQuery16*)query;
-    PointQuery query1; 
-    for (size_t i=0; i<16; i++) {
-      if (!valid[i]) continue;
-      PointQuery query1; query16->get(i,query1);
-      changed |= pointQuery(scene, (RTCPointQuery*)&query1, userContext, queryFunc, userPtrN?userPtrN[i]:NULL);
-      query16->set(i,query1);
+    for (size_t i=0; i<M; i+=CHUNK_SIZE)
+    {
+      const size_t num = min(size_t(M)-i,CHUNK_SIZE);
+      for (size_t j=0; j<num; j++)
+        queries[j] = (RTCPointQuery*)((char*)query + (i+j)*byteStride);
+      changed |= pointQuery1M(scene, queries, userPtrN ? userPtrN+i : nullptr, num, userContext, queryFunc);
     }
     return changed;
     RTC_CATCH_END2_FALSE(scene);
   }
 
+  __forceinline void initClosestPointHit(RTCClosestPointHit* hit)
+  {
+    hit->u = hit->v = 0.0f;
+    hit->primID = RTC_INVALID_GEOMETRY_ID;
+    hit->geomID = RTC_INVALID_GEOMETRY_ID;
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      hit->instID[l] = RTC_INVALID_GEOMETRY_ID;
+  }
+
+  RTC_API bool rtcClosestPoint(RTCScene hscene, RTCPointQuery* query, RTCPointQueryContext* userContext, RTCClosestPointHit* hit)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcClosestPoint);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(userContext);
+    RTC_VERIFY_HANDLE(hit);
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");
+    if (((size_t)hit) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "hit not aligned to 16 bytes");
+#endif
+
+    initClosestPointHit(hit);
+    return pointQuery(scene, query, userContext, nullptr, hit, POINT_QUERY_MODE_CLOSEST);
+    RTC_CATCH_END2_FALSE(scene);
+  }
+
+  RTC_API bool rtcClosestPoint1M (RTCScene hscene, RTCPointQuery* query, unsigned int M, size_t byteStride, struct RTCPointQueryContext* userContext, RTCClosestPointHit* hit)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcClosestPoint1M);
+
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(userContext);
+    RTC_VERIFY_HANDLE(hit);
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");
+    if (((size_t)hit) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "hit not aligned to 16 bytes");
+    if (byteStride & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "stride not aligned to 16 bytes");
+#endif
+    STAT3(point_query.travs,M,M,M);
+
+    static const size_t CHUNK_SIZE = 256;
+    RTCPointQuery* queries[CHUNK_SIZE];
+    void* hits[CHUNK_SIZE];
+    bool changed = false;
+    for (size_t i=0; i<M; i+=CHUNK_SIZE)
+    {
+      const size_t num = min(size_t(M)-i,CHUNK_SIZE);
+      for (size_t j=0; j<num; j++) {
+        queries[j] = (RTCPointQuery*)((char*)query + (i+j)*byteStride);
+        hits[j] = &hit[i+j];
+        initClosestPointHit(&hit[i+j]);
+      }
+      changed |= pointQuery1M(scene, queries, hits, num, userContext, nullptr, POINT_QUERY_MODE_CLOSEST);
+    }
+    return changed;
+    RTC_CATCH_END2_FALSE(scene);
+  }
+
+  RTC_API unsigned int rtcNearestPoints(RTCScene hscene, RTCPointQuery* query, RTCPointQueryContext* userContext, RTCNearestPointsMode mode, unsigned int k, RTCNearestPointHit* hits)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcNearestPoints);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(userContext);
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");
+    if (((size_t)hits) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "hits not aligned to 16 bytes");
+#endif
+
+    if (k == 0) return 0;
+
+    /* the kernels shrink the radius of the query they get passed, thus operate on a copy */
+    RTC_ALIGN(16) RTCPointQuery query1 = *query;
+
+    static const size_t MAX_LOCAL_KEYS = 64;
+    NearestPointHeap::Key local_keys[MAX_LOCAL_KEYS];
+    const size_t numKeys = NearestPointHeap::numKeys(k);
+    std::vector<NearestPointHeap::Key> keys(numKeys > MAX_LOCAL_KEYS ? numKeys : 0);
+    NearestPointHeap heap(hits,k,numKeys > MAX_LOCAL_KEYS ? keys.data() : local_keys,mode == RTC_NEAREST_POINTS_MODE_RADIUS);
+    pointQuery(scene, &query1, userContext, nullptr, &heap, POINT_QUERY_MODE_NEAREST);
+    return heap.finish();
+    RTC_CATCH_END2(scene);
+    return 0;
+  }
+
+  RTC_API void rtcNearestPoints1M (RTCScene hscene, RTCPointQuery* query, unsigned int M, size_t byteStride, struct RTCPointQueryContext* userContext, RTCNearestPointsMode mode, unsigned int k, RTCNearestPointHit* hits, unsigned int* numHits)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcNearestPoints1M);
+
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(userContext);
+    RTC_VERIFY_HANDLE(numHits);
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");
+    if (((size_t)hits) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "hits not aligned to 16 bytes");
+    if (byteStride & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "stride not aligned to 16 bytes");
+#endif
+    STAT3(point_query.travs,M,M,M);
+
+    if (k == 0) {
+      for (size_t i=0; i<M; i++) numHits[i] = 0;
+      return;
+    }
+
+    static const size_t CHUNK_SIZE = 64;
+    RTC_ALIGN(16) RTCPointQuery query1[CHUNK_SIZE];
+    RTCPointQuery* queries[CHUNK_SIZE];
+    void* heaps[CHUNK_SIZE];
+    RTC_ALIGN(16) char heaps_storage[CHUNK_SIZE*sizeof(NearestPointHeap)];
+    const size_t numKeys = NearestPointHeap::numKeys(k);
+    std::vector<NearestPointHeap::Key> keys(min(size_t(M),CHUNK_SIZE)*numKeys);
+    for (size_t i=0; i<M; i+=CHUNK_SIZE)
+    {
+      const size_t num = min(size_t(M)-i,CHUNK_SIZE);
+      for (size_t j=0; j<num; j++) {
+        query1[j] = *(RTCPointQuery*)((char*)query + (i+j)*byteStride);
+        queries[j] = &query1[j];
+        heaps[j] = new (&heaps_storage[j*sizeof(NearestPointHeap)]) NearestPointHeap(hits+(i+j)*k,k,&keys[j*numKeys],mode == RTC_NEAREST_POINTS_MODE_RADIUS);
+      }
+      pointQuery1M(scene, queries, heaps, num, userContext, nullptr, POINT_QUERY_MODE_NEAREST);
+      for (size_t j=0; j<num; j++)
+        numHits[i+j] = ((NearestPointHeap*)heaps[j])->finish();
+    }
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcIntersect1 (RTCScene hscene, RTCIntersectContext* user_context, RTCRayHit* rayhit) 
   {
     Scene* scene = (Scene*) hscene;
@@ -485,7 +746,7 @@ RTC_NAMESPACE_BEGIN;
     RTC_TRACE(rtcIntersect1);
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)rayhit) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
     STAT3(normal.travs,1,1,1);
@@ -505,7 +766,7 @@ RTC_NAMESPACE_BEGIN;
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
     if (((size_t)rayhit)   & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 16 bytes");   
 #endif
@@ -536,7 +797,7 @@ RTC_NAMESPACE_BEGIN;
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)valid) & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 32 bytes");   
     if (((size_t)rayhit)   & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 32 bytes");   
 #endif
@@ -569,7 +830,7 @@ RTC_NAMESPACE_BEGIN;
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)valid) & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 64 bytes");   
     if (((size_t)rayhit)   & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 64 bytes");   
 #endif
@@ -603,7 +864,7 @@ RTC_NAMESPACE_BEGIN;
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)rayhit ) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(normal.travs,M,M,M);
@@ -634,7 +895,7 @@ RTC_NAMESPACE_BEGIN;
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)rn) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(normal.travs,M,M,M);
@@ -665,7 +926,7 @@ RTC_NAMESPACE_BEGIN;
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)rayhit) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(normal.travs,N*M,N*M,N*M);
@@ -703,7 +964,7 @@ RTC_NAMESPACE_BEGIN;
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)rayhit->ray.org_x ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->ray.org_x not aligned to 4 bytes");   
     if (((size_t)rayhit->ray.org_y ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->ray.org_y not aligned to 4 bytes");   
     if (((size_t)rayhit->ray.org_z ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->ray.org_z not aligned to 4 bytes");   
@@ -740,7 +1001,7 @@ RTC_NAMESPACE_BEGIN;
     STAT3(shadow.travs,1,1,1);
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)ray) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
     IntersectContext context(scene,user_context);
@@ -756,7 +1017,7 @@ RTC_NAMESPACE_BEGIN;
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
     if (((size_t)ray)   & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
@@ -787,7 +1048,7 @@ RTC_NAMESPACE_BEGIN;
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)valid) & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 32 bytes");   
     if (((size_t)ray)   & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 32 bytes");   
 #endif
@@ -821,7 +1082,7 @@ RTC_NAMESPACE_BEGIN;
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)valid) & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 64 bytes");   
     if (((size_t)ray)   & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 64 bytes");   
 #endif
@@ -856,7 +1117,7 @@ RTC_NAMESPACE_BEGIN;
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)ray) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(shadow.travs,M,M,M);
@@ -885,7 +1146,7 @@ RTC_NAMESPACE_BEGIN;
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)ray) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(shadow.travs,M,M,M);
@@ -916,7 +1177,7 @@ RTC_NAMESPACE_BEGIN;
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
     if (byteStride < sizeof(RTCRayHit)) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"byteStride too small");
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)ray) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(shadow.travs,N*M,N*N,N*N);
@@ -954,7 +1215,7 @@ RTC_NAMESPACE_BEGIN;
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isCommitted()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)ray->org_x ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "org_x not aligned to 4 bytes");   
     if (((size_t)ray->org_y ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "org_y not aligned to 4 bytes");   
     if (((size_t)ray->org_z ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "org_z not aligned to 4 bytes");   
@@ -24,6 +24,7 @@
 
 #include "../builders/bvh_builder_sah.h"
 #include "../builders/bvh_builder_morton.h"
+#include "../builders/bvh_builder_ploc.h"
 
 namespace embree
 { 
@@ -87,65 +88,70 @@ namespace embree
           }
         });
 
-      /* start morton build */
-      std::pair<void*,BBox3fa> root = BVHBuilderMorton::build<std::pair<void*,BBox3fa>>(
-        
-        /* thread local allocator for fast allocations */
-        [&] () -> FastAllocator::CachedAllocator { 
-          return bvh->allocator.getCachedAllocator();
-        },
-        
-        /* lambda function that allocates BVH nodes */
-        [&] ( const FastAllocator::CachedAllocator& alloc, size_t N ) -> void* {
-          return createNode((RTCThreadLocalAllocator)&alloc, (unsigned int)N,userPtr);
-        },
-        
-        /* lambda function that sets bounds */
-        [&] (void* node, const std::pair<void*,BBox3fa>* children, size_t N) -> std::pair<void*,BBox3fa>
-        {
-          BBox3fa bounds = empty;
-          void* childptrs[BVHBuilderMorton::MAX_BRANCHING_FACTOR];
-          const RTCBounds* cbounds[BVHBuilderMorton::MAX_BRANCHING_FACTOR];
-          for (size_t i=0; i<N; i++) {
-            bounds.extend(children[i].second);
-            childptrs[i] = children[i].first;
-            cbounds[i] = (const RTCBounds*)&children[i].second;
-          }
-          setNodeBounds(node,cbounds,(unsigned int)N,userPtr);
-          setNodeChildren(node,childptrs, (unsigned int)N,userPtr);
-          return std::make_pair(node,bounds);
-        },
-        
-        /* lambda function that creates BVH leaves */
-        [&]( const range<unsigned>& current, const FastAllocator::CachedAllocator& alloc) -> std::pair<void*,BBox3fa>
+      /* thread local allocator for fast allocations */
+      auto createAllocator = [&] () -> FastAllocator::CachedAllocator {
+        return bvh->allocator.getCachedAllocator();
+      };
+
+      /* lambda function that allocates BVH nodes */
+      auto createNodeFunc = [&] ( const FastAllocator::CachedAllocator& alloc, size_t N ) -> void* {
+        return createNode((RTCThreadLocalAllocator)&alloc, (unsigned int)N,userPtr);
+      };
+
+      /* lambda function that sets bounds */
+      auto setBoundsFunc = [&] (void* node, const std::pair<void*,BBox3fa>* children, size_t N) -> std::pair<void*,BBox3fa>
+      {
+        BBox3fa bounds = empty;
+        void* childptrs[BVHBuilderMorton::MAX_BRANCHING_FACTOR];
+        const RTCBounds* cbounds[BVHBuilderMorton::MAX_BRANCHING_FACTOR];
+        for (size_t i=0; i<N; i++) {
+          bounds.extend(children[i].second);
+          childptrs[i] = children[i].first;
+          cbounds[i] = (const RTCBounds*)&children[i].second;
+        }
+        setNodeBounds(node,cbounds,(unsigned int)N,userPtr);
+        setNodeChildren(node,childptrs, (unsigned int)N,userPtr);
+        return std::make_pair(node,bounds);
+      };
+
+      /* lambda function that creates BVH leaves */
+      auto createLeafFunc = [&]( const range<unsigned>& current, const FastAllocator::CachedAllocator& alloc) -> std::pair<void*,BBox3fa>
+      {
+        RTCBuildPrimitive localBuildPrims[RTC_BUILD_MAX_PRIMITIVES_PER_LEAF];
+        BBox3fa bounds = empty;
+        for (size_t i=0;i<current.size();i++)
         {
-	  RTCBuildPrimitive localBuildPrims[RTC_BUILD_MAX_PRIMITIVES_PER_LEAF];
-	  BBox3fa bounds = empty;
-	  for (size_t i=0;i<current.size();i++)
-	    {
-	      const size_t id = morton_src[current.begin()+i].index;
-	      bounds.extend(prims[id].bounds());
-	      localBuildPrims[i] = prims_i[id];
-	    }
-          void* node = createLeaf((RTCThreadLocalAllocator)&alloc,localBuildPrims,current.size(),userPtr);
-          return std::make_pair(node,bounds);
-        },
-        
-        /* lambda that calculates the bounds for some primitive */
-        [&] (const BVHBuilderMorton::BuildPrim& morton) -> BBox3fa {
-          return prims[morton.index].bounds();
-        },
-        
-        /* progress monitor function */
-        [&] (size_t dn) {
-          if (!buildProgress) return true;
-          const size_t n = progress.fetch_add(dn)+dn;
-          const double f = std::min(1.0,double(n)/double(primitiveCount));
-          return buildProgress(userPtr,f);
-        },
-        
-        morton_src.data(),morton_tmp.data(),primitiveCount,
-        *arguments);
+          const size_t id = morton_src[current.begin()+i].index;
+          bounds.extend(prims[id].bounds());
+          localBuildPrims[i] = prims_i[id];
+        }
+        void* node = createLeaf((RTCThreadLocalAllocator)&alloc,localBuildPrims,current.size(),userPtr);
+        return std::make_pair(node,bounds);
+      };
+
+      /* lambda that calculates the bounds for some primitive */
+      auto calculateBounds = [&] (const BVHBuilderMorton::BuildPrim& morton) -> BBox3fa {
+        return prims[morton.index].bounds();
+      };
+
+      /* progress monitor function */
+      auto progressMonitor = [&] (size_t dn) {
+        if (!buildProgress) return true;
+        const size_t n = progress.fetch_add(dn)+dn;
+        const double f = std::min(1.0,double(n)/double(primitiveCount));
+        return buildProgress(userPtr,f);
+      };
+
+      /* start morton or PLOC build */
+      std::pair<void*,BBox3fa> root;
+      if (bvh->device->ploc_builder)
+        root = BVHBuilderPLOC::build<std::pair<void*,BBox3fa>>(
+          createAllocator,createNodeFunc,setBoundsFunc,createLeafFunc,calculateBounds,progressMonitor,
+          morton_src.data(),morton_tmp.data(),primitiveCount,*arguments);
+      else
+        root = BVHBuilderMorton::build<std::pair<void*,BBox3fa>>(
+          createAllocator,createNodeFunc,setBoundsFunc,createLeafFunc,calculateBounds,progressMonitor,
+          morton_src.data(),morton_tmp.data(),primitiveCount,*arguments);
 
       bvh->allocator.cleanup();
       return root.first;
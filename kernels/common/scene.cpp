@@ -29,13 +29,60 @@ namespace embree
   void invalid_rtcIntersect8()  { throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcIntersect8 and rtcOccluded8 not enabled"); }
   void invalid_rtcIntersect16() { throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcIntersect16 and rtcOccluded16 not enabled"); }
   void invalid_rtcIntersectN()  { throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcIntersectN and rtcOccludedN not enabled"); }
+  void invalid_rtcCollideAsync(){ throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcCollide not supported for asynchronously committed scenes"); }
+
+  void Scene::AccelBuffer::waitForReaders () const
+  {
+    for (size_t i=0; i<NUM_READER_SLOTS; i++)
+      while (readers[i].count.load() != 0)
+        pause_cpu();
+  }
+
+  struct Scene::FrontAccelsRef
+  {
+    __forceinline FrontAccelsRef (Scene* scene)
+      : slot(readerSlot())
+    {
+      /* register as reader and check that the buffer did not get replaced meanwhile,
+         as the next commit only waits for the readers of the replaced buffer */
+      while (true)
+      {
+        accel = scene->frontAccels.load();
+        accel->readers[slot].count++;
+        if (likely(scene->frontAccels.load() == accel)) break;
+        accel->readers[slot].count--;
+      }
+    }
+
+    __forceinline ~FrontAccelsRef () {
+      accel->readers[slot].count--;
+    }
+
+    __forceinline AccelBuffer* operator-> () const { return accel; }
+
+    /*! distributes the threads issuing queries over the reader slots */
+    static __forceinline size_t readerSlot()
+    {
+      static std::atomic<size_t> nextSlot(0);
+      static __thread size_t slot = 0;
+      if (unlikely(slot == 0))
+        slot = 1 + nextSlot++ % AccelBuffer::NUM_READER_SLOTS;
+      return slot-1;
+    }
+
+    const size_t slot;
+    AccelBuffer* accel;
+  };
 
   Scene::Scene (Device* device)
     : device(device),
       flags_modified(true), enabled_geometry_types(0),
       scene_flags(RTC_SCENE_FLAG_NONE),
       quality_flags(RTC_BUILD_QUALITY_MEDIUM),
-      is_build(false), modified(true),
+      hugePageBytes(0),
+      is_build(false), modified(true), bvhCache(nullptr),
+      accelsGeneration(0), createdGeneration(0), frontAccels(nullptr), backAccels(nullptr), commitThread(nullptr), commitRunning(false), commitThreadExit(false), backgroundCommit(false),
+      commitCompleteFunction(nullptr), commitCompletePtr(nullptr), commitError(RTC_ERROR_NONE),
       progressInterface(this), progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0)
   {
     device->refInc();
@@ -63,6 +110,11 @@ namespace embree
 
   Scene::~Scene ()
   {
+    exitCommitThread();
+    delete frontAccels.load(); frontAccels = nullptr;
+    delete backAccels; backAccels = nullptr;
+    device->hugePageBVHBytes -= hugePageBytes;
+
 #if defined(TASKING_TBB) || defined(TASKING_PPL)
     delete group; group = nullptr;
 #elif defined(TASKING_GCD)
@@ -188,6 +240,7 @@ namespace embree
     else if (device->tri_accel == "bvh4.triangle4v")      accels_add(device->bvh4_factory->BVH4Triangle4v(this));
     else if (device->tri_accel == "bvh4.triangle4i")      accels_add(device->bvh4_factory->BVH4Triangle4i(this));
     else if (device->tri_accel == "qbvh4.triangle4i")     accels_add(device->bvh4_factory->BVH4QuantizedTriangle4i(this));
+    else if (device->tri_accel == "hbvh4.triangle4")      accels_add(device->bvh4_factory->BVH4HalfTriangle4(this));
 
 #if defined (EMBREE_TARGET_SIMD8)
     else if (device->tri_accel == "bvh8.triangle4")       accels_add(device->bvh8_factory->BVH8Triangle4 (this));
@@ -195,6 +248,8 @@ namespace embree
     else if (device->tri_accel == "bvh8.triangle4i")      accels_add(device->bvh8_factory->BVH8Triangle4i(this));
     else if (device->tri_accel == "qbvh8.triangle4i")     accels_add(device->bvh8_factory->BVH8QuantizedTriangle4i(this));
     else if (device->tri_accel == "qbvh8.triangle4")      accels_add(device->bvh8_factory->BVH8QuantizedTriangle4(this));
+#elif defined (EMBREE_BVH8_SIMD4)
+    else if (device->tri_accel == "bvh8.triangle4")       accels_add(device->bvh8_factory->BVH8Triangle4 (this));
 #endif
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown triangle acceleration structure "+device->tri_accel);
 #endif
@@ -309,6 +364,7 @@ namespace embree
     else if (device->quad_accel == "bvh4.quad4v")       accels_add(device->bvh4_factory->BVH4Quad4v(this));
     else if (device->quad_accel == "bvh4.quad4i")       accels_add(device->bvh4_factory->BVH4Quad4i(this));
     else if (device->quad_accel == "qbvh4.quad4i")      accels_add(device->bvh4_factory->BVH4QuantizedQuad4i(this));
+    else if (device->quad_accel == "hbvh4.quad4v")      accels_add(device->bvh4_factory->BVH4HalfQuad4v(this));
 
 #if defined (EMBREE_TARGET_SIMD8)
     else if (device->quad_accel == "bvh8.quad4v")       accels_add(device->bvh8_factory->BVH8Quad4v(this));
@@ -649,6 +705,13 @@ namespace embree
       setModified ();
     }
     accels_deleteGeometry(unsigned(geomID));
+    if (frontAccels.load()) frontAccels.load()->accels_deleteGeometry(unsigned(geomID));
+    if (backAccels) {
+      backAccels->waitForReaders();
+      backAccels->accels_deleteGeometry(unsigned(geomID));
+      if (geomID < backAccels->geometryModCounters.size())
+        backAccels->geometryModCounters[geomID] = 0;
+    }
     id_pool.deallocate((unsigned)geomID);
     geometries[geomID] = null;
     vertices[geomID] = nullptr;
@@ -662,6 +725,10 @@ namespace embree
 
   void Scene::commit_task ()
   {
+    /* a commit ends the frame the tessellation cache got used for, commits of
+       instanced scenes without rendering since the last commit do not count as a frame */
+    device->updateCacheSize();
+
     checkIfModifiedAndSet ();
     if (!isModified()) {
       return;
@@ -694,9 +761,33 @@ namespace embree
 
     /* select acceleration structures to build */
     unsigned int new_enabled_geometry_types = world.enabledGeometryTypesMask();
-    if (flags_modified || new_enabled_geometry_types != enabled_geometry_types)
+    if (flags_modified || new_enabled_geometry_types != enabled_geometry_types) {
+      accelsGeneration++;
+      flags_modified = false;
+      enabled_geometry_types = new_enabled_geometry_types;
+    }
+
+    /* asynchronous commits build into the back buffer, which got last built two commits ago */
+    AccelN* accel = this;
+    bool recreate = false;
+    if (backAccels)
     {
-      accels_init();
+      backAccels->waitForReaders();
+      accel = backAccels;
+      std::swap(geometryModCounters_,backAccels->geometryModCounters);
+      const size_t numCounters = geometryModCounters_.size();
+      geometryModCounters_.resize(geometries.size());
+      for (size_t i=numCounters; i<geometries.size(); i++)
+        geometryModCounters_[i] = 0;
+      recreate = backAccels->generation != accelsGeneration;
+    }
+    else {
+      recreate = createdGeneration != accelsGeneration;
+    }
+
+    if (recreate)
+    {
+      accel->accels_init();
 
       /* we need to make all geometries modified, otherwise two level builder will
         not rebuild currently not modified geometries */
@@ -721,19 +812,30 @@ namespace embree
       if (getNumPrimitives(Geometry::MTY_INSTANCE_EXPENSIVE,false)) createInstanceExpensiveAccel();
       if (getNumPrimitives(Geometry::MTY_INSTANCE_EXPENSIVE,true)) createInstanceExpensiveMBAccel();
 
-      flags_modified = false;
-      enabled_geometry_types = new_enabled_geometry_types;
+      if (backAccels) {
+        backAccels->accels.swap(accels);
+        backAccels->generation = accelsGeneration;
+      }
+      else
+        createdGeneration = accelsGeneration;
     }
 
     /* select fast code path if no filter function is present */
-    accels_select(hasFilterFunction());
+    accel->accels_select(hasFilterFunction());
 
     /* build all hierarchies of this scene */
-	accels_build();
+    if (bvhCache) accel->accels_load(*bvhCache);
+    else          accel->accels_build();
+
+    /* replace the huge page memory of the previous commit in the statistics of the device */
+    const size_t newHugePageBytes = accel->accels_hugePageBytes();
+    device->hugePageBVHBytes += newHugePageBytes;
+    device->hugePageBVHBytes -= hugePageBytes;
+    hugePageBytes = newHugePageBytes;
 
     /* make static geometry immutable */
     if (!isDynamicAccel()) {
-      accels_immutable();
+      accel->accels_immutable();
       flags_modified = true; // in non-dynamic mode we have to re-create accels
     }
 
@@ -746,18 +848,90 @@ namespace embree
         }
       });
 
+    if (backAccels) {
+      backAccels->geometryModCounters = geometryModCounters_;
+      publishAsyncCommit();
+    }
+
     updateInterface();
 
     if (device->verbosity(2)) {
       std::cout << "created scene intersector" << std::endl;
-      accels_print(2);
+      accel->accels_print(2);
       std::cout << "selected scene intersector" << std::endl;
-      intersectors.print(2);
+      accel->intersectors.print(2);
+      std::cout << "huge page memory = " << 1E-6*double(hugePageBytes) << " MB" << std::endl;
     }
 
     setModified(false);
   }
 
+  static const char bvhCacheMagic[8] = { 'E','M','B','R','E','E','B','C' };
+
+  void Scene::saveBVH(const std::string& fileName)
+  {
+    if (isModified())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+
+    std::ofstream out(fileName.c_str(),std::ios::binary);
+    if (!out.is_open())
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"cannot open file " + fileName);
+
+    /* store the geometry bindings, the loading scene has to attach the same geometries */
+    out.write(bvhCacheMagic,sizeof(bvhCacheMagic));
+    writeBinary(out,(unsigned int)geometries.size());
+    for (size_t i=0; i<geometries.size(); i++)
+    {
+      const bool valid = geometries[i] && geometries[i]->isEnabled();
+      writeBinary(out,valid ? (unsigned int)geometries[i]->getType() : (unsigned int)-1);
+      writeBinary(out,valid ? (unsigned int)geometries[i]->size() : 0u);
+      writeBinary(out,valid ? geometries[i]->numTimeSteps : 0u);
+    }
+
+    if (frontAccels.load()) {
+      FrontAccelsRef front(this);
+      front->accels_save(out);
+    }
+    else
+      accels_save(out);
+    if (!out)
+      throw_RTCError(RTC_ERROR_UNKNOWN,"error writing file " + fileName);
+  }
+
+  void Scene::loadBVH(const std::string& fileName)
+  {
+    std::ifstream in(fileName.c_str(),std::ios::binary);
+    if (!in.is_open())
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"cannot open file " + fileName);
+
+    char magic[sizeof(bvhCacheMagic)];
+    if (!in.read(magic,sizeof(magic)) || memcmp(magic,bvhCacheMagic,sizeof(magic)))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"file " + fileName + " is not a BVH cache file");
+
+    bool match = readBinary<unsigned int>(in) == geometries.size();
+    for (size_t i=0; match && i<geometries.size(); i++)
+    {
+      const bool valid = geometries[i] && geometries[i]->isEnabled();
+      match &= readBinary<unsigned int>(in) == (valid ? (unsigned int)geometries[i]->getType() : (unsigned int)-1);
+      match &= readBinary<unsigned int>(in) == (valid ? (unsigned int)geometries[i]->size() : 0u);
+      match &= readBinary<unsigned int>(in) == (valid ? geometries[i]->numTimeSteps : 0u);
+    }
+    if (!match)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH cache file does not match scene geometries");
+
+    /* the commit restores the BVHs from the stream instead of building them */
+    bvhCache = &in;
+    setModified();
+    try {
+      commit(false);
+    }
+    catch (...) {
+      bvhCache = nullptr;
+      throw;
+    }
+    bvhCache = nullptr;
+  }
+
   void Scene::setBuildQuality(RTCBuildQuality quality_flags_i)
   {
     if (quality_flags == quality_flags_i) return;
@@ -793,7 +967,7 @@ namespace embree
       scheduler = this->scheduler;
       if (scheduler == null) {
         buildLock.lock();
-        this->scheduler = scheduler = new TaskScheduler;
+        this->scheduler = scheduler = new TaskScheduler(device->threadArena.get());
       }
     }
 
@@ -808,16 +982,32 @@ namespace embree
     }
 
     /* initiate build */
+    if (device->verbosity(2))
+      TaskScheduler::resetThreadStatistics();
+
     try {
       scheduler->spawn_root([&]() { commit_task(); Lock<MutexSys> lock(schedulerMutex); this->scheduler = nullptr; }, 1, !join);
     }
     catch (...) {
-      accels_clear();
-      updateInterface();
+      commitFailed();
       Lock<MutexSys> lock(schedulerMutex);
       this->scheduler = nullptr;
       throw;
     }
+
+    /* print work stealing statistics of the build */
+    if (device->verbosity(2))
+    {
+      std::vector<TaskScheduler::ThreadStatistics> stats = TaskScheduler::getThreadStatistics();
+      std::cout << "work stealing statistics:" << std::endl;
+      for (size_t i=0; i<stats.size(); i++)
+      {
+        std::cout << "  thread " << std::setw(3) << i << ": "
+                  << "steals (cluster/node/remote) = " << stats[i].steals[0] << "/" << stats[i].steals[1] << "/" << stats[i].steals[2]
+                  << ", failed steals = " << stats[i].failedSteals
+                  << ", yields = " << stats[i].yields << std::endl;
+      }
+    }
   }
 
 #endif
@@ -914,8 +1104,7 @@ namespace embree
       /* reset MXCSR register again */
       _mm_setcsr(mxcsr);
 
-      accels_clear();
-      updateInterface();
+      commitFailed();
       throw;
     }
   }
@@ -957,13 +1146,278 @@ namespace embree
       /* reset MXCSR register again */
       _mm_setcsr(mxcsr);
 
-      accels_clear();
-      updateInterface();
+      commitFailed();
       throw;
     }
   }
 #endif
 
+  void Scene::commitFailed ()
+  {
+    /* a failed asynchronous commit keeps the front buffer, but the back buffer has to get re-created */
+    if (backAccels) {
+      backAccels->accels_clear();
+      backAccels->generation = 0;
+    }
+    else
+      accels_clear();
+
+    updateInterface();
+  }
+
+  __thread Scene* Scene::commitThreadScene = nullptr;
+
+  void Scene::commitAsync (RTCCommitCompleteFunction complete, void* userPtr)
+  {
+    /* only a single asynchronous commit can run at a time */
+    waitCommit();
+    enableAsyncCommit();
+
+    Lock<MutexSys> lock(commitThreadMutex);
+    commitCompleteFunction = complete;
+    commitCompletePtr = userPtr;
+    commitRunning = true;
+    backgroundCommit = true;
+
+    /* the commit thread stays alive for later asynchronous commits of the scene */
+    if (!commitThread) commitThread = createThread(commitThreadFunc,this);
+    commitThreadCondition.notify_all();
+  }
+
+  void Scene::commitThreadFunc (void* ptr)
+  {
+    Scene* scene = (Scene*) ptr;
+    commitThreadScene = scene;
+
+    while (true)
+    {
+      {
+        Lock<MutexSys> lock(scene->commitThreadMutex);
+        scene->commitThreadCondition.wait(scene->commitThreadMutex, [&] () { return scene->commitRunning || scene->commitThreadExit; });
+        if (!scene->commitRunning) return;
+      }
+
+      scene->commitBackground();
+
+      /* the commit is finished before invoking the callback, thus the callback can wait for it, commit the scene again, or release it */
+      RTCCommitCompleteFunction complete = nullptr;
+      void* userPtr = nullptr;
+      {
+        Lock<MutexSys> lock(scene->commitThreadMutex);
+        complete = scene->commitCompleteFunction;
+        userPtr = scene->commitCompletePtr;
+        scene->commitRunning = false;
+        scene->commitThreadCondition.notify_all();
+      }
+
+      if (complete)
+        complete(userPtr,(RTCScene)scene);
+
+      /* the callback released the last reference to the scene */
+      if (commitThreadScene != scene)
+        return;
+    }
+  }
+
+  void Scene::commitBackground ()
+  {
+    /* the device error code is thread local, thus errors get stored in the scene and raised by waitCommit */
+    try {
+      commit(false);
+    }
+    catch (std::bad_alloc&) {
+      commitError = RTC_ERROR_OUT_OF_MEMORY;
+      commitErrorMessage = "out of memory";
+    }
+    catch (rtcore_error& e) {
+      commitError = e.error;
+      commitErrorMessage = e.what();
+    }
+    catch (std::exception& e) {
+      commitError = RTC_ERROR_UNKNOWN;
+      commitErrorMessage = e.what();
+    }
+    catch (...) {
+      commitError = RTC_ERROR_UNKNOWN;
+      commitErrorMessage = "unknown exception caught";
+    }
+  }
+
+  bool Scene::joinCommitThread ()
+  {
+    Lock<MutexSys> lock(commitThreadMutex);
+
+    /* callbacks invoked by the build, e.g. the progress monitor, cannot wait for the commit they are part of */
+    if (commitRunning && commitThreadScene == this)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene cannot get committed during its asynchronous commit");
+
+    commitThreadCondition.wait(commitThreadMutex, [&] () { return !commitRunning; });
+    if (!backgroundCommit) return false;
+    backgroundCommit = false;
+
+    /* the scene bounds used by instancing scenes only get updated by the thread waiting for the commit */
+    if (frontAccels.load())
+      bounds = frontAccels.load()->bounds;
+    return true;
+  }
+
+  void Scene::exitCommitThread ()
+  {
+    {
+      Lock<MutexSys> lock(commitThreadMutex);
+      commitThreadCondition.wait(commitThreadMutex, [&] () { return !commitRunning; });
+      commitThreadExit = true;
+      commitThreadCondition.notify_all();
+    }
+    if (!commitThread) return;
+
+    /* the completion callback released the scene, the commit thread cannot join itself */
+    if (commitThreadScene == this) {
+      commitThreadScene = nullptr;
+      detach(commitThread);
+    }
+    else
+      join(commitThread);
+    commitThread = nullptr;
+  }
+
+  void Scene::waitCommit ()
+  {
+    /* only the first thread waiting for the asynchronous commit raises its error */
+    if (!joinCommitThread())
+      return;
+
+    if (commitError != RTC_ERROR_NONE) {
+      const RTCError error = commitError;
+      commitError = RTC_ERROR_NONE;
+      throw_RTCError(error,commitErrorMessage);
+    }
+  }
+
+  void Scene::enableAsyncCommit ()
+  {
+    if (backAccels)
+      return;
+
+    backAccels = new AccelBuffer;
+
+    /* acceleration structures of a previous synchronous commit become the front buffer */
+    if (isBuild())
+    {
+      AccelBuffer* front = new AccelBuffer;
+      front->accels.swap(accels);
+      front->accels_finalize();
+      front->bounds = bounds;
+      front->generation = createdGeneration;
+      front->geometryModCounters = geometryModCounters_;
+      setAsyncIntersectors();
+      frontAccels = front;
+    }
+  }
+
+  void Scene::publishAsyncCommit ()
+  {
+    AccelBuffer* front = frontAccels.load();
+    if (!front)
+      setAsyncIntersectors();
+
+    /* queries might still use the old front buffer, the next commit waits for them before building into it */
+    frontAccels = backAccels;
+    backAccels = front ? front : new AccelBuffer;
+
+    /* queries read the bounds of the front buffer, thus only synchronous commits can update the scene bounds directly */
+    if (!backgroundCommit)
+      bounds = frontAccels.load()->bounds;
+  }
+
+  void Scene::setAsyncIntersectors ()
+  {
+    /* packets of 8 and 16 rays use the ray stream path as the front buffer may not support them */
+    type = AccelData::TY_ACCELN;
+    intersectors = Accel::Intersectors();
+    intersectors.ptr = this;
+    intersectors.collider      = Accel::Collider(invalid_rtcCollideAsync);
+    intersectors.intersector1  = Accel::Intersector1(&intersectAsync,&occludedAsync,&pointQueryAsync,&pointQuery1MAsync,"Scene::intersector1Async");
+    intersectors.intersector4  = Accel::Intersector4(&intersect4Async,&occluded4Async,"Scene::intersector4Async");
+    intersectors.intersectorN  = Accel::IntersectorN(&intersectNAsync,&occludedNAsync,"Scene::intersectorNAsync");
+  }
+
+  LBBox3fa Scene::getCommittedBounds()
+  {
+    if (!frontAccels.load())
+      return bounds;
+
+    FrontAccelsRef front(this);
+    return front->bounds;
+  }
+
+  bool Scene::pointQueryAsync (Accel::Intersectors* This, PointQuery* query, PointQueryContext* context) {
+    FrontAccelsRef front((Scene*)This->ptr);
+    return front->intersectors.pointQuery(query,context);
+  }
+
+  bool Scene::pointQuery1MAsync (Accel::Intersectors* This, PointQuery** query, PointQueryContext** context, size_t M) {
+    FrontAccelsRef front((Scene*)This->ptr);
+    return front->intersectors.pointQuery1M(query,context,M);
+  }
+
+  void Scene::intersectAsync (Accel::Intersectors* This, RTCRayHit& ray, IntersectContext* context) {
+    FrontAccelsRef front((Scene*)This->ptr);
+    front->intersectors.intersect(ray,context);
+  }
+
+  void Scene::intersect4Async (const void* valid_i, Accel::Intersectors* This, RTCRayHit4& ray, IntersectContext* context)
+  {
+    FrontAccelsRef front((Scene*)This->ptr);
+    if (likely(front->intersectors.intersector4)) {
+      front->intersectors.intersect4(valid_i,ray,context);
+      return;
+    }
+
+    /* the front buffer has no packet intersector if one of its acceleration structures lacks it */
+    const int* valid = (const int*) valid_i;
+    RayHit4* rayhit4 = (RayHit4*) &ray;
+    for (size_t i=0; i<4; i++) {
+      if (!valid[i]) continue;
+      RayHit ray1; rayhit4->get(i,ray1);
+      front->intersectors.intersect((RTCRayHit&)ray1,context);
+      rayhit4->set(i,ray1);
+    }
+  }
+
+  void Scene::intersectNAsync (Accel::Intersectors* This, RTCRayHitN** ray, const size_t N, IntersectContext* context) {
+    FrontAccelsRef front((Scene*)This->ptr);
+    front->intersectors.intersectN(ray,N,context);
+  }
+
+  void Scene::occludedAsync (Accel::Intersectors* This, RTCRay& ray, IntersectContext* context) {
+    FrontAccelsRef front((Scene*)This->ptr);
+    front->intersectors.occluded(ray,context);
+  }
+
+  void Scene::occluded4Async (const void* valid_i, Accel::Intersectors* This, RTCRay4& ray, IntersectContext* context)
+  {
+    FrontAccelsRef front((Scene*)This->ptr);
+    if (likely(front->intersectors.intersector4)) {
+      front->intersectors.occluded4(valid_i,ray,context);
+      return;
+    }
+
+    const int* valid = (const int*) valid_i;
+    Ray4* ray4 = (Ray4*) &ray;
+    for (size_t i=0; i<4; i++) {
+      if (!valid[i]) continue;
+      Ray ray1; ray4->get(i,ray1);
+      front->intersectors.occluded((RTCRay&)ray1,context);
+      ray4->set(i,ray1);
+    }
+  }
+
+  void Scene::occludedNAsync (Accel::Intersectors* This, RTCRayN** ray, const size_t N, IntersectContext* context) {
+    FrontAccelsRef front((Scene*)This->ptr);
+    front->intersectors.occludedN(ray,N,context);
+  }
+
   void Scene::setProgressMonitorFunction(RTCProgressMonitorFunction func, void* ptr)
   {
     progress_monitor_function = func;
@@ -20,6 +20,7 @@
 #include "device.h"
 #include "builder.h"
 #include "../../common/algorithms/parallel_any_of.h"
+#include "../../common/sys/condition.h"
 #include "scene_triangle_mesh.h"
 #include "scene_quad_mesh.h"
 #include "scene_user_geometry.h"
@@ -199,6 +200,58 @@ namespace embree
     void commit_task ();
     void build () {}
 
+    /*! commits the scene in the commit thread of the scene, queries keep using the previously committed acceleration structures until the build finished */
+    void commitAsync (RTCCommitCompleteFunction complete, void* userPtr);
+
+    /*! waits until a running asynchronous commit finished */
+    void waitCommit ();
+
+  private:
+    /*! entry function of the thread performing the asynchronous commits of a scene */
+    static void commitThreadFunc (void* ptr);
+
+    /*! performs an asynchronous commit in the commit thread, errors get stored in the scene */
+    void commitBackground ();
+
+    /*! switches the scene to double buffered acceleration structures */
+    void enableAsyncCommit ();
+
+    /*! makes the just built back buffer visible to queries */
+    void publishAsyncCommit ();
+
+    /*! cleans up after a commit raised an exception */
+    void commitFailed ();
+
+    /*! waits until a running asynchronous commit finished, returns true if there was one that was not waited for yet */
+    bool joinCommitThread ();
+
+    /*! terminates the commit thread of the scene */
+    void exitCommitThread ();
+
+    /*! redirects the scene intersectors to the front buffer */
+    void setAsyncIntersectors ();
+
+    /* query functions forwarding to the acceleration structures of the last asynchronous commit */
+    static bool pointQueryAsync (Accel::Intersectors* This, PointQuery* query, PointQueryContext* context);
+    static bool pointQuery1MAsync (Accel::Intersectors* This, PointQuery** query, PointQueryContext** context, size_t M);
+    static void intersectAsync (Accel::Intersectors* This, RTCRayHit& ray, IntersectContext* context);
+    static void intersect4Async (const void* valid, Accel::Intersectors* This, RTCRayHit4& ray, IntersectContext* context);
+    static void intersectNAsync (Accel::Intersectors* This, RTCRayHitN** ray, const size_t N, IntersectContext* context);
+    static void occludedAsync (Accel::Intersectors* This, RTCRay& ray, IntersectContext* context);
+    static void occluded4Async (const void* valid, Accel::Intersectors* This, RTCRay4& ray, IntersectContext* context);
+    static void occludedNAsync (Accel::Intersectors* This, RTCRayN** ray, const size_t N, IntersectContext* context);
+
+  public:
+
+    /*! returns the bounds of the acceleration structures queries currently use */
+    LBBox3fa getCommittedBounds();
+
+    /*! writes the BVHs of the committed scene to a BVH cache file */
+    void saveBVH(const std::string& fileName);
+
+    /*! commits the scene by restoring its BVHs from a BVH cache file instead of building them */
+    void loadBVH(const std::string& fileName);
+
     void updateInterface();
 
     /* return number of geometries */
@@ -297,6 +350,9 @@ namespace embree
     /* test if scene got already build */
     __forceinline bool isBuild() const { return is_build; }
 
+    /* test if queries can get performed, asynchronously committed scenes stay queryable during the next commit */
+    __forceinline bool isCommitted() const { return !isModified() || frontAccels.load() != nullptr; }
+
   public:
     IDPool<unsigned,0xFFFFFFFE> id_pool;
     vector<Ref<Geometry>> geometries; //!< list of all user geometries
@@ -312,6 +368,7 @@ namespace embree
 
     RTCSceneFlags scene_flags;
     RTCBuildQuality quality_flags;
+    size_t hugePageBytes;               //!< BVH bytes of the last commit placed on huge pages, accounted to the device
     MutexSys buildMutex;
 #if defined(__aarch64__) && defined(BUILD_IOS)
     std::mutex geometriesMutex;
@@ -321,6 +378,51 @@ namespace embree
     bool is_build;
   private:
     bool modified;                   //!< true if scene got modified
+    std::istream* bvhCache;          //!< BVH cache the next commit restores the BVHs from
+
+    /*! one buffer of the double buffered acceleration structures of asynchronously committed scenes */
+    struct AccelBuffer : public AccelN
+    {
+      static const size_t NUM_READER_SLOTS = 16;
+
+      /*! counts the queries in flight of some threads, padded to avoid false sharing between the slots */
+      struct ReaderSlot
+      {
+        ReaderSlot () : count(0) {}
+        std::atomic<size_t> count;
+        char align[64-sizeof(std::atomic<size_t>)];
+      };
+
+      AccelBuffer () : generation(0) {}
+      void build () {}
+      void clear () {}
+
+      /*! waits until all queries that use this buffer finished */
+      void waitForReaders () const;
+
+      unsigned int generation;                   //!< accelsGeneration the acceleration structures got created for
+      vector<unsigned int> geometryModCounters;  //!< geometry modification counters at the last build of this buffer
+      ReaderSlot readers[NUM_READER_SLOTS];      //!< queries in flight that use this buffer
+    };
+
+    /*! pins the front buffer for the duration of a query, thus the next commit cannot build into it */
+    struct FrontAccelsRef;
+
+    unsigned int accelsGeneration;             //!< incremented whenever the acceleration structures have to get re-created
+    unsigned int createdGeneration;            //!< accelsGeneration the acceleration structures of synchronous commits got created for
+    std::atomic<AccelBuffer*> frontAccels;     //!< acceleration structures used by queries of asynchronously committed scenes
+    AccelBuffer* backAccels;                   //!< acceleration structures the next asynchronous commit builds into
+    MutexSys commitThreadMutex;
+    ConditionSys commitThreadCondition;
+    thread_t commitThread;                     //!< thread performing the asynchronous commits of the scene, created by the first one
+    bool commitRunning;                        //!< true from the start of an asynchronous commit until its build finished
+    bool commitThreadExit;                     //!< tells the commit thread to terminate
+    bool backgroundCommit;                     //!< true from the start of an asynchronous commit until it got waited for
+    static __thread Scene* commitThreadScene;  //!< scene whose commit thread the calling thread is
+    RTCCommitCompleteFunction commitCompleteFunction;
+    void* commitCompletePtr;
+    RTCError commitError;                      //!< error raised by the last asynchronous commit
+    std::string commitErrorMessage;
 
   public:
 
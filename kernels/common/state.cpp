@@ -15,6 +15,7 @@
 // ======================================================================== //
 
 #include "state.h"
+#include "rtcore.h"
 #include "../../common/lexers/streamfilters.h"
 
 namespace embree
@@ -96,8 +97,15 @@ namespace embree
 
     max_spatial_split_replications = 1.2f;
     useSpatialPreSplits = false;
+    ploc_builder = false;
+    restructure_budget = 0.0f;
+    refit_rebuild_threshold = 0.0f;
 
     tessellation_cache_size = 128*1024*1024;
+    tessellation_cache_adaptive = false;
+    tessellation_cache_min_size = 16*1024*1024;
+    tessellation_cache_max_size = 1024*1024*1024;
+    tessellation_cache_shards = 1;
 
     subdiv_accel = "default";
     subdiv_accel_mb = "default";
@@ -132,6 +140,8 @@ namespace embree
     if (hasISA(AVX512KNL)) set_affinity = true;
 
     start_threads = false;
+    thread_arena = false;
+    thread_arena_priority = 0;
     enable_selockmemoryprivilege = false;
 #if defined(__LINUX__)
     hugepages = true;
@@ -139,6 +149,9 @@ namespace embree
     hugepages = false;
 #endif
     hugepages_success = true;
+    hugepages_bvh = false;
+    numa_replicate_bvh = false;
+    numa_replicas = 0;
 
     alloc_main_block_size = 0;
     alloc_num_main_slots = 0;
@@ -164,6 +177,10 @@ namespace embree
     /* verify that calculations stay in range */
     assert(rcp(min_rcp_input)*FLT_LARGE+FLT_LARGE < 0.01f*FLT_MAX);
 
+    /* the bounds of the adaptive tessellation cache have to form a range */
+    if (tessellation_cache_min_size > tessellation_cache_max_size)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"tessellation_cache_min_size has to be at most tessellation_cache_max_size");
+
     /* here we verify that CPP files compiled for a specific ISA only
      * call that same or lower ISA version of non-inlined class member
      * functions */
@@ -263,6 +280,21 @@ namespace embree
       
       else if (tok == Token::Id("start_threads")&& cin->trySymbol("=")) 
         start_threads = cin->get().Int();
+
+      else if (tok == Token::Id("thread_arena") && cin->trySymbol("="))
+        thread_arena = cin->get().Int();
+
+      else if (tok == Token::Id("thread_arena_cpus")) {
+        thread_arena_cpus.clear();
+        if (cin->trySymbol("=")) {
+          do {
+            thread_arena_cpus.push_back(cin->get().Int());
+          } while (cin->trySymbol("|"));
+        }
+      }
+
+      else if (tok == Token::Id("thread_arena_priority") && cin->trySymbol("="))
+        thread_arena_priority = cin->get().Int();
       
       else if (tok == Token::Id("isa") && cin->trySymbol("=")) {
         std::string isa = toLowerCase(cin->get().Identifier());
@@ -294,6 +326,17 @@ namespace embree
       else if (tok == Token::Id("hugepages") && cin->trySymbol("=")) {
         hugepages = cin->get().Int();
       }
+      else if (tok == Token::Id("hugepages_bvh") && cin->trySymbol("=")) {
+        hugepages_bvh = cin->get().Int();
+      }
+      else if (tok == Token::Id("numa_replicate_bvh") && cin->trySymbol("=")) {
+        numa_replicate_bvh = cin->get().Int();
+      }
+      else if (tok == Token::Id("numa_replicas") && cin->trySymbol("=")) {
+        const int replicas = cin->get().Int();
+        if (replicas < 0) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"numa_replicas has to be at least 0");
+        numa_replicas = min(replicas,64); // each replica gets built by its own thread
+      }
 
       else if (tok == Token::Id("ignore_config_files") && cin->trySymbol("="))
         ignore_config_files = cin->get().Int();
@@ -431,10 +474,30 @@ namespace embree
       else if (tok == Token::Id("presplits") && cin->trySymbol("="))
         useSpatialPreSplits = cin->get().Int() != 0 ? true : false;
 
+      else if (tok == Token::Id("ploc_builder") && cin->trySymbol("="))
+        ploc_builder = cin->get().Int() != 0 ? true : false;
+
+      else if (tok == Token::Id("restructure_budget") && cin->trySymbol("="))
+        restructure_budget = cin->get().Float();
+
+      else if (tok == Token::Id("refit_rebuild_threshold") && cin->trySymbol("="))
+        refit_rebuild_threshold = cin->get().Float();
+
       else if (tok == Token::Id("tessellation_cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
       else if (tok == Token::Id("cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
+      else if (tok == Token::Id("tessellation_cache_adaptive") && cin->trySymbol("="))
+        tessellation_cache_adaptive = cin->get().Int();
+      else if (tok == Token::Id("tessellation_cache_min_size") && cin->trySymbol("="))
+        tessellation_cache_min_size = size_t(cin->get().Float()*1024.0f*1024.0f);
+      else if (tok == Token::Id("tessellation_cache_max_size") && cin->trySymbol("="))
+        tessellation_cache_max_size = size_t(cin->get().Float()*1024.0f*1024.0f);
+      else if (tok == Token::Id("tessellation_cache_shards") && cin->trySymbol("=")) {
+        const int shards = cin->get().Int();
+        if (shards < 1) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"tessellation_cache_shards has to be at least 1");
+        tessellation_cache_shards = shards;
+      }
 
       else if (tok == Token::Id("alloc_main_block_size") && cin->trySymbol("="))
         alloc_main_block_size = cin->get().Int();
@@ -460,6 +523,11 @@ namespace embree
     std::cout << "  build user threads = " << numUserThreads   << std::endl;
     std::cout << "  start_threads      = " << start_threads << std::endl;
     std::cout << "  affinity           = " << set_affinity << std::endl;
+    std::cout << "  thread_arena       = " << thread_arena << std::endl;
+    std::cout << "  arena cpus         = ";
+    for (size_t i=0; i<thread_arena_cpus.size(); i++) std::cout << (i ? "|" : "") << thread_arena_cpus[i];
+    std::cout << std::endl;
+    std::cout << "  arena priority     = " << thread_arena_priority << std::endl;
     std::cout << "  frequency_level    = ";
     switch (frequency_level) {
     case FREQUENCY_SIMD128: std::cout << "simd128" << std::endl; break;
@@ -472,10 +540,20 @@ namespace embree
     if (!hugepages) std::cout << "disabled" << std::endl;
     else if (hugepages_success) std::cout << "enabled" << std::endl;
     else std::cout << "failed" << std::endl;
+    std::cout << "  hugepages_bvh      = " << hugepages_bvh << std::endl;
+    std::cout << "  numa_replicate_bvh = " << numa_replicate_bvh << std::endl;
+    std::cout << "  numa_replicas      = " << numa_replicas << std::endl;
 
     std::cout << "  verbosity          = " << verbose << std::endl;
     std::cout << "  cache_size         = " << float(tessellation_cache_size)*1E-6 << " MB" << std::endl;
+    std::cout << "  cache_adaptive     = " << tessellation_cache_adaptive;
+    if (tessellation_cache_adaptive) std::cout << " (" << float(tessellation_cache_min_size)*1E-6 << " MB - " << float(tessellation_cache_max_size)*1E-6 << " MB)";
+    std::cout << std::endl;
+    std::cout << "  cache_shards       = " << tessellation_cache_shards << std::endl;
     std::cout << "  max_spatial_split_replications = " << max_spatial_split_replications << std::endl;
+    std::cout << "  ploc_builder       = " << ploc_builder << std::endl;
+    std::cout << "  restructure_budget = " << restructure_budget << " ms" << std::endl;
+    std::cout << "  refit_rebuild_threshold = " << refit_rebuild_threshold << std::endl;
     
     std::cout << "triangles:" << std::endl;
     std::cout << "  accel              = " << tri_accel << std::endl;
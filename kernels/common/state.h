@@ -118,7 +118,14 @@ namespace embree
   public:
     float max_spatial_split_replications;  //!< maximally replications*N many primitives in accel for spatial splits
     bool useSpatialPreSplits;              //!< use spatial pre-splits instead of the full spatial split builder
+    bool ploc_builder;                     //!< use the agglomerative PLOC builder instead of the morton builder for low quality builds
+    float restructure_budget;              //!< time budget in milliseconds for treelet restructuring after BVH4 builds, 0 disables
+    float refit_rebuild_threshold;         //!< rebuild refitted BVHs once their SAH cost grew by this factor, 0 disables
     size_t tessellation_cache_size;        //!< size of the shared tessellation cache 
+    bool tessellation_cache_adaptive;      //!< grow and shrink the tessellation cache based on its hit rate and eviction churn
+    size_t tessellation_cache_min_size;    //!< minimal size of the adaptive tessellation cache
+    size_t tessellation_cache_max_size;    //!< maximal size of the adaptive tessellation cache
+    size_t tessellation_cache_shards;      //!< number of shards the tessellation cache gets split into
 
   public:
     size_t instancing_open_min;            //!< instancing opens tree to minimally that number of subtrees
@@ -140,6 +147,9 @@ namespace embree
     size_t numUserThreads;                 //!< number of user provided threads to use in builders
     bool set_affinity;                     //!< sets affinity for worker threads
     bool start_threads;                    //!< true when threads should be started at device creation time
+    bool thread_arena;                     //!< true if the device uses its own pool of worker threads
+    std::vector<size_t> thread_arena_cpus; //!< logical CPUs the worker threads of the device's own pool are restricted to
+    int thread_arena_priority;             //!< scheduling priority of the worker threads of the device's own pool (-1 low, 0 normal, 1 high)
     int enabled_cpu_features;              //!< CPU ISA features to use
     int enabled_builder_cpu_features;      //!< CPU ISA features to use for builders only
     enum FREQUENCY_LEVEL {
@@ -150,6 +160,9 @@ namespace embree
     bool enable_selockmemoryprivilege;     //!< configures the SeLockMemoryPrivilege under Windows to enable huge pages
     bool hugepages;                        //!< true if huge pages should get used
     bool hugepages_success;                //!< status for enabling huge pages
+    bool hugepages_bvh;                    //!< true if BVH node and leaf blocks should always get placed on 2MB pages
+    bool numa_replicate_bvh;               //!< true if the nodes of static instance level BVHs get replicated to each NUMA node
+    size_t numa_replicas;                  //!< number of BVH node replicas, 0 for one replica per NUMA node
 
   public:
     size_t alloc_main_block_size;          //!< main allocation block size (shared between threads)
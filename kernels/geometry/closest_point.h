@@ -0,0 +1,338 @@
+// ======================================================================== //
+// Copyright 2009-2020 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "primitive.h"
+#include "subgrid.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Computes the closest points of a point p to M triangles (a,b,c)
+     *  and returns the squared distances. The closest points are
+     *  returned as barycentric coordinates, such that the closest
+     *  point is a + u*(b-a) + v*(c-a). */
+    template<int M>
+    __forceinline vfloat<M> closestPointTriangle(const Vec3vf<M>& p, const Vec3vf<M>& a, const Vec3vf<M>& b, const Vec3vf<M>& c,
+                                                 vfloat<M>& u_o, vfloat<M>& v_o)
+    {
+      const Vec3vf<M> ab = b - a;
+      const Vec3vf<M> ac = c - a;
+      const Vec3vf<M> ap = p - a;
+      const Vec3vf<M> bp = p - b;
+      const Vec3vf<M> cp = p - c;
+
+      const vfloat<M> d1 = dot(ab,ap);
+      const vfloat<M> d2 = dot(ac,ap);
+      const vfloat<M> d3 = dot(ab,bp);
+      const vfloat<M> d4 = dot(ac,bp);
+      const vfloat<M> d5 = dot(ab,cp);
+      const vfloat<M> d6 = dot(ac,cp);
+
+      const vfloat<M> va = d3*d6 - d5*d4;
+      const vfloat<M> vb = d5*d2 - d1*d6;
+      const vfloat<M> vc = d1*d4 - d3*d2;
+
+      /* closest point inside the triangle */
+      const vfloat<M> denom = vfloat<M>(one) / (va + vb + vc);
+      vfloat<M> u = vb*denom;
+      vfloat<M> v = vc*denom;
+
+      /* the regions are tested in reverse order of priority, such that
+       * vertex regions win over edge regions and edge regions over the
+       * interior, the divisions of inactive regions get masked out */
+      const vbool<M> edgeBC = (va <= 0.0f) & (d4-d3 >= 0.0f) & (d5-d6 >= 0.0f);
+      const vfloat<M> w = (d4-d3) / ((d4-d3) + (d5-d6));
+      u = select(edgeBC,1.0f-w,u);
+      v = select(edgeBC,w,v);
+
+      const vbool<M> edgeAC = (vb <= 0.0f) & (d2 >= 0.0f) & (d6 <= 0.0f);
+      u = select(edgeAC,vfloat<M>(zero),u);
+      v = select(edgeAC,d2/(d2-d6),v);
+
+      const vbool<M> edgeAB = (vc <= 0.0f) & (d1 >= 0.0f) & (d3 <= 0.0f);
+      u = select(edgeAB,d1/(d1-d3),u);
+      v = select(edgeAB,vfloat<M>(zero),v);
+
+      const vbool<M> vertexC = (d6 >= 0.0f) & (d5 <= d6);
+      u = select(vertexC,vfloat<M>(zero),u);
+      v = select(vertexC,vfloat<M>(one),v);
+
+      const vbool<M> vertexB = (d3 >= 0.0f) & (d4 <= d3);
+      u = select(vertexB,vfloat<M>(one),u);
+      v = select(vertexB,vfloat<M>(zero),v);
+
+      const vbool<M> vertexA = (d1 <= 0.0f) & (d2 <= 0.0f);
+      u = select(vertexA,vfloat<M>(zero),u);
+      v = select(vertexA,vfloat<M>(zero),v);
+
+      u_o = u;
+      v_o = v;
+      const Vec3vf<M> q = madd(Vec3vf<M>(u),ab,madd(Vec3vf<M>(v),ac,a)) - p;
+      return dot(q,q);
+    }
+
+    /*! Computes the closest points of a point p to M quads (v0,v1,v2,v3)
+     *  and returns the squared distances. The closest points are
+     *  returned as quad uv coordinates, using the same triangle split
+     *  (v0,v1,v3) and (v2,v3,v1) as the quad intersectors. */
+    template<int M>
+    __forceinline vfloat<M> closestPointQuad(const Vec3vf<M>& p, const Vec3vf<M>& v0, const Vec3vf<M>& v1, const Vec3vf<M>& v2, const Vec3vf<M>& v3,
+                                             vfloat<M>& u_o, vfloat<M>& v_o)
+    {
+      vfloat<M> u0, w0; const vfloat<M> d0 = closestPointTriangle(p,v0,v1,v3,u0,w0);
+      vfloat<M> u1, w1; const vfloat<M> d1 = closestPointTriangle(p,v2,v3,v1,u1,w1);
+      const vbool<M> second = d1 < d0;
+      u_o = select(second,1.0f-u1,u0);
+      v_o = select(second,1.0f-w1,w0);
+      return select(second,d1,d0);
+    }
+
+    /*! Closest point queries against the vertices of M primitives of a
+     *  leaf, used by the built-in point query modes. Geometries that
+     *  have a point query callback set are handled by that callback. */
+    template<int M>
+    struct ClosestPointM
+    {
+      /* returns the lanes that are not handled by a point query callback */
+      static __forceinline vbool<M> builtin(const PointQueryContext* context, const vbool<M>& valid, const vuint<M>& geomID)
+      {
+        vbool<M> mask = valid;
+        size_t bits = movemask(valid);
+        while (bits)
+        {
+          const size_t i = bscf(bits);
+          if (context->scene->get(geomID[i])->pointQueryFunc)
+            mask &= vint<M>(step) != vint<M>(int(i));
+        }
+        return mask;
+      }
+
+      /* invokes the point query callbacks for all valid lanes */
+      static __forceinline bool callback(PointQuery* query, PointQueryContext* context, const vbool<M>& valid, const vuint<M>& geomID, const vuint<M>& primID)
+      {
+        bool changed = false;
+        size_t bits = movemask(valid);
+        while (bits)
+        {
+          const size_t i = bscf(bits);
+          AccelSet* accel = (AccelSet*)context->scene->get(geomID[i]);
+          context->geomID = geomID[i];
+          context->primID = primID[i];
+          changed |= accel->pointQuery(query, context);
+        }
+        return changed;
+      }
+
+      /* transforms the vertices into world space if the query is not a
+       * sphere in instance space, returns the query point to use */
+      static __forceinline Vec3vf<M> space(const PointQuery* query, const PointQueryContext* context, Vec3vf<M>* v, size_t numVertices)
+      {
+        if (likely(context->query_type == POINT_QUERY_TYPE_SPHERE))
+          return Vec3vf<M>(query->p);
+
+        const RTCPointQueryContext* userContext = context->userContext;
+        const AffineSpace3fa m = AffineSpace3fa_load_unaligned((AffineSpace3fa*)userContext->inst2world[userContext->instStackSize-1]);
+        const AffineSpace3vf<M> xfm(LinearSpace3<Vec3vf<M>>(Vec3vf<M>(m.l.vx.x,m.l.vx.y,m.l.vx.z),
+                                                            Vec3vf<M>(m.l.vy.x,m.l.vy.y,m.l.vy.z),
+                                                            Vec3vf<M>(m.l.vz.x,m.l.vz.y,m.l.vz.z)),
+                                    Vec3vf<M>(m.p.x,m.p.y,m.p.z));
+        for (size_t i=0; i<numVertices; i++)
+          v[i] = xfmPoint(xfm,v[i]);
+        return Vec3vf<M>(context->query_ws->p);
+      }
+
+      /* inserts all lanes within the query radius into the heap of nearest primitives */
+      static __forceinline bool nearest(PointQuery* query, PointQueryContext* context, const vbool<M>& valid,
+                                        const vfloat<M>& dist2, const vfloat<M>& u, const vfloat<M>& v,
+                                        const vuint<M>& geomID, const vuint<M>& primID)
+      {
+        NearestPointHeap* heap = (NearestPointHeap*)context->userPtr;
+        const RTCPointQueryContext* userContext = context->userContext;
+        const bool sphere = context->query_type == POINT_QUERY_TYPE_SPHERE;
+
+        bool changed = false;
+        size_t bits = movemask(valid);
+        while (bits)
+        {
+          const size_t i = bscf(bits);
+          const float dist = sqrt(dist2[i]);
+          const float dist_ws = sphere ? dist / context->similarityScale : dist;
+          if (!(dist_ws < context->query_ws->radius))
+            continue;
+
+          STAT3(point_query.trav_prim_hits,1,1,1);
+          RTCNearestPointHit hit;
+          hit.distance = dist_ws;
+          hit.u = u[i];
+          hit.v = v[i];
+          hit.primID = primID[i];
+          hit.geomID = geomID[i];
+          for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+            hit.instID[l] = l < userContext->instStackSize ? userContext->instID[l] : RTC_INVALID_GEOMETRY_ID;
+          heap->insert(hit);
+
+          /* only primitives closer than the k-th nearest one can enter a full heap of a k nearest search */
+          if (heap->shrinksRadius()) {
+            context->query_ws->radius = heap->maxDistance();
+            changed = true;
+          }
+        }
+
+        if (changed && userContext->instStackSize > 0)
+        {
+          if (sphere) query->radius = context->query_ws->radius * context->similarityScale;
+          else        context->updateAABB();
+        }
+        return changed;
+      }
+
+      /* updates the closest point hit with the closest of the lanes */
+      static __forceinline bool update(PointQuery* query, PointQueryContext* context, const vbool<M>& valid,
+                                       const vfloat<M>& dist2, const vfloat<M>& u, const vfloat<M>& v,
+                                       const vuint<M>& geomID, const vuint<M>& primID)
+      {
+        if (none(valid))
+          return false;
+
+        if (context->mode == POINT_QUERY_MODE_NEAREST)
+          return nearest(query,context,valid,dist2,u,v,geomID,primID);
+
+        const size_t i = select_min(valid,dist2);
+        STAT3(point_query.trav_prim_hits,1,1,1);
+
+        /* distances are computed in instance space for spheres and in world space otherwise */
+        const bool sphere = context->query_type == POINT_QUERY_TYPE_SPHERE;
+        const float dist = sqrt(dist2[i]);
+        const float dist_ws = sphere ? dist / context->similarityScale : dist;
+        if (!(dist_ws < context->query_ws->radius))
+          return false;
+
+        RTCClosestPointHit* hit = (RTCClosestPointHit*)context->userPtr;
+        const RTCPointQueryContext* userContext = context->userContext;
+        hit->u = u[i];
+        hit->v = v[i];
+        hit->primID = primID[i];
+        hit->geomID = geomID[i];
+        for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+          hit->instID[l] = l < userContext->instStackSize ? userContext->instID[l] : RTC_INVALID_GEOMETRY_ID;
+
+        /* shrink the world space query and the query of the current instance level */
+        context->query_ws->radius = dist_ws;
+        if (userContext->instStackSize > 0)
+        {
+          if (sphere) query->radius = dist;
+          else        context->updateAABB();
+        }
+        return true;
+      }
+
+      /* closest point queries for M triangles */
+      template<typename Primitive>
+      static __forceinline bool triangles(PointQuery* query, PointQueryContext* context, const Primitive& prim,
+                                          const Vec3vf<M>& v0, const Vec3vf<M>& v1, const Vec3vf<M>& v2)
+      {
+        const vbool<M> valid = prim.valid();
+        const vbool<M> vbuiltin = builtin(context,valid,prim.geomID());
+        bool changed = callback(query,context,valid & !vbuiltin,prim.geomID(),prim.primID());
+        if (none(vbuiltin))
+          return changed;
+
+        STAT3(point_query.trav_prims,1,1,1);
+        Vec3vf<M> v[3] = { v0, v1, v2 };
+        const Vec3vf<M> p = space(query,context,v,3);
+        vfloat<M> u, w;
+        const vfloat<M> dist2 = closestPointTriangle(p,v[0],v[1],v[2],u,w);
+        changed |= update(query,context,vbuiltin,dist2,u,w,prim.geomID(),prim.primID());
+        return changed;
+      }
+
+      /* closest point queries for M quads */
+      template<typename Primitive>
+      static __forceinline bool quads(PointQuery* query, PointQueryContext* context, const Primitive& prim,
+                                      const Vec3vf<M>& v0, const Vec3vf<M>& v1, const Vec3vf<M>& v2, const Vec3vf<M>& v3)
+      {
+        const vbool<M> valid = prim.valid();
+        const vbool<M> vbuiltin = builtin(context,valid,prim.geomID());
+        bool changed = callback(query,context,valid & !vbuiltin,prim.geomID(),prim.primID());
+        if (none(vbuiltin))
+          return changed;
+
+        STAT3(point_query.trav_prims,1,1,1);
+        Vec3vf<M> v[4] = { v0, v1, v2, v3 };
+        const Vec3vf<M> p = space(query,context,v,4);
+        vfloat<M> u, w;
+        const vfloat<M> dist2 = closestPointQuad(p,v[0],v[1],v[2],v[3],u,w);
+        changed |= update(query,context,vbuiltin,dist2,u,w,prim.geomID(),prim.primID());
+        return changed;
+      }
+    };
+
+    /*! Closest point queries for M point primitives, the distance is
+     *  measured to the center of the points */
+    template<int M>
+    struct ClosestPointPointM
+    {
+      template<typename Primitive>
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim, const Vec4vf<M>& v0)
+      {
+        const vbool<M> valid = prim.valid();
+        const vuint<M> geomID(prim.geomID());
+
+        STAT3(point_query.trav_prims,1,1,1);
+        Vec3vf<M> v[1] = { Vec3vf<M>(v0.x,v0.y,v0.z) };
+        const Vec3vf<M> p = ClosestPointM<M>::space(query,context,v,1);
+        const Vec3vf<M> d = v[0] - p;
+        return ClosestPointM<M>::update(query,context,valid,dot(d,d),vfloat<M>(zero),vfloat<M>(zero),geomID,prim.primID());
+      }
+    };
+
+    /*! Closest point queries for the up to 4 quads of a subgrid, the
+     *  uv coordinates are interpolated across the entire grid */
+    struct ClosestPointSubGrid
+    {
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const SubGrid& subgrid)
+      {
+        const vuint4 geomID(subgrid.geomID());
+        const vuint4 primID(subgrid.primID());
+        if (context->scene->get(subgrid.geomID())->pointQueryFunc)
+          return ClosestPointM<4>::callback(query,context,vbool4(true,false,false,false),geomID,primID);
+
+        /* quads 1 and 2 are invalid for subgrids of width 2, and quads 2 and 3 for subgrids of height 2 */
+        const bool invalidX = subgrid.invalid3x3X();
+        const bool invalidY = subgrid.invalid3x3Y();
+        const vbool4 valid(true,!invalidX,!invalidX && !invalidY,!invalidY);
+
+        STAT3(point_query.trav_prims,1,1,1);
+        const GridMesh* mesh = context->scene->get<GridMesh>(subgrid.geomID());
+        const GridMesh::Grid& g = mesh->grid(subgrid.primID());
+        Vec3vf4 v[4]; subgrid.gather(v[0],v[1],v[2],v[3],mesh,g);
+        const Vec3vf4 p = ClosestPointM<4>::space(query,context,v,4);
+        vfloat4 u, w;
+        const vfloat4 dist2 = closestPointQuad(p,v[0],v[1],v[2],v[3],u,w);
+
+        /* correct U,V interpolation across the entire grid */
+        const vfloat4 sx = vfloat4(vint4((int)subgrid.x()) + vint4(0,1,1,0));
+        const vfloat4 sy = vfloat4(vint4((int)subgrid.y()) + vint4(0,0,1,1));
+        u = (u + sx) / float(g.resX-1);
+        w = (w + sy) / float(g.resY-1);
+        return ClosestPointM<4>::update(query,context,valid,dist2,u,w,geomID,primID);
+      }
+    };
+  }
+}
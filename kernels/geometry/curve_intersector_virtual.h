@@ -40,6 +40,8 @@ namespace embree
     typedef void (*Intersect16Ty)(void* pre, void* ray, size_t k, IntersectContext* context, const void* primitive);
     typedef bool (*Occluded16Ty) (void* pre, void* ray, size_t k, IntersectContext* context, const void* primitive);
 
+    typedef bool (*PointQuery1Ty)(PointQuery* query, PointQueryContext* context, const void* primitive);
+
   public:
     struct Intersectors
     {
@@ -60,6 +62,7 @@ namespace embree
       Occluded8Ty  occluded8;
       Intersect16Ty intersect16;
       Occluded16Ty  occluded16;
+      PointQuery1Ty pointQuery1; //!< only set for point primitives, curves do not support point queries
     };
     
     Intersectors vtbl[Geometry::GTY_END];
@@ -107,6 +110,17 @@ namespace embree
         VirtualCurveIntersector::Intersectors& leafIntersector = ((VirtualCurveIntersector*) This->leafIntersector)->vtbl[ty];
         return leafIntersector.occluded<1>(&pre,&ray,context,prim);
       }
+
+      template<int N>
+        static __forceinline bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context, const Primitive* prim, size_t num, const TravPointQuery<N> &tquery, size_t& lazy_node)
+      {
+        assert(num == 1);
+        RTCGeometryType ty = (RTCGeometryType)(*prim);
+        assert(This->leafIntersector);
+        VirtualCurveIntersector::Intersectors& leafIntersector = ((VirtualCurveIntersector*) This->leafIntersector)->vtbl[ty];
+        if (!leafIntersector.pointQuery1) return false;
+        return leafIntersector.pointQuery1(query,context,prim);
+      }
     };
 
     template<int K>
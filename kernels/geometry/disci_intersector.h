@@ -19,6 +19,7 @@
 #include "disc_intersector.h"
 #include "intersector_epilog.h"
 #include "pointi.h"
+#include "closest_point.h"
 
 namespace embree
 {
@@ -55,6 +56,15 @@ namespace embree
         return DiscIntersector1<Mx>::intersect(
             valid, ray, pre, v0, Occluded1EpilogM<M, Mx, filter>(ray, context, Disc.geomID(), Disc.primID()));
       }
+
+      static __forceinline bool pointQuery(PointQuery* query,
+                                           PointQueryContext* context,
+                                           const Primitive& Disc)
+      {
+        Vec4vf<M> v0;
+        Disc.gather(v0, context->scene);
+        return ClosestPointPointM<M>::pointQuery(query, context, Disc, v0);
+      }
     };
 
     template<int M, int Mx, bool filter>
@@ -88,6 +98,15 @@ namespace embree
         return DiscIntersector1<Mx>::intersect(
             valid, ray, pre, v0, Occluded1EpilogM<M, Mx, filter>(ray, context, Disc.geomID(), Disc.primID()));
       }
+
+      static __forceinline bool pointQuery(PointQuery* query,
+                                           PointQueryContext* context,
+                                           const Primitive& Disc)
+      {
+        Vec4vf<M> v0;
+        Disc.gather(v0, context->scene, query->time);
+        return ClosestPointPointM<M>::pointQuery(query, context, Disc, v0);
+      }
     };
 
     template<int M, int Mx, int K, bool filter>
@@ -191,6 +210,15 @@ namespace embree
         return DiscIntersector1<Mx>::intersect(
             valid, ray, pre, v0, n0, Occluded1EpilogM<M, Mx, filter>(ray, context, Disc.geomID(), Disc.primID()));
       }
+
+      static __forceinline bool pointQuery(PointQuery* query,
+                                           PointQueryContext* context,
+                                           const Primitive& Disc)
+      {
+        Vec4vf<M> v0;
+        Disc.gather(v0, context->scene);
+        return ClosestPointPointM<M>::pointQuery(query, context, Disc, v0);
+      }
     };
 
     template<int M, int Mx, bool filter>
@@ -226,6 +254,15 @@ namespace embree
         return DiscIntersector1<Mx>::intersect(
             valid, ray, pre, v0, n0, Occluded1EpilogM<M, Mx, filter>(ray, context, Disc.geomID(), Disc.primID()));
       }
+
+      static __forceinline bool pointQuery(PointQuery* query,
+                                           PointQueryContext* context,
+                                           const Primitive& Disc)
+      {
+        Vec4vf<M> v0;
+        Disc.gather(v0, context->scene, query->time);
+        return ClosestPointPointM<M>::pointQuery(query, context, Disc, v0);
+      }
     };
 
     template<int M, int Mx, int K, bool filter>
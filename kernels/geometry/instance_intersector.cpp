@@ -137,7 +137,8 @@ namespace embree
           context->func, 
           context->userContext,
           similarityScale,
-          context->userPtr); 
+          context->userPtr,
+          context->mode);
 
         bool changed = instance->object->intersectors.pointQuery(&query_inst, &context_inst);
         popInstance(context->userContext);
@@ -225,7 +226,8 @@ namespace embree
           context->func, 
           context->userContext,
           similarityScale,
-          context->userPtr); 
+          context->userPtr,
+          context->mode);
 
         bool changed = instance->object->intersectors.pointQuery(&query_inst, &context_inst);
         popInstance(context->userContext);
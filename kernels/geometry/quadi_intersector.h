@@ -19,6 +19,7 @@
 #include "quadi.h"
 #include "quad_intersector_moeller.h"
 #include "quad_intersector_pluecker.h"
+#include "closest_point.h"
 
 namespace embree
 {
@@ -49,7 +50,11 @@ namespace embree
 
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& quad)
       {
-        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, quad);
+        if (likely(context->mode == POINT_QUERY_MODE_CALLBACK))
+          return PrimitivePointQuery1<Primitive>::pointQuery(query, context, quad);
+
+        Vec3vf<M> v0, v1, v2, v3; quad.gather(v0,v1,v2,v3,context->scene);
+        return ClosestPointM<M>::quads(query, context, quad, v0,v1,v2,v3);
       }
     };
 
@@ -137,7 +142,11 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& quad)
       {
-        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, quad);
+        if (likely(context->mode == POINT_QUERY_MODE_CALLBACK))
+          return PrimitivePointQuery1<Primitive>::pointQuery(query, context, quad);
+
+        Vec3vf<M> v0, v1, v2, v3; quad.gather(v0,v1,v2,v3,context->scene);
+        return ClosestPointM<M>::quads(query, context, quad, v0,v1,v2,v3);
       }
     };
 
@@ -225,7 +234,11 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& quad)
       {
-        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, quad);
+        if (likely(context->mode == POINT_QUERY_MODE_CALLBACK))
+          return PrimitivePointQuery1<Primitive>::pointQuery(query, context, quad);
+
+        Vec3vf<M> v0, v1, v2, v3; quad.gather(v0,v1,v2,v3,context->scene,query->time);
+        return ClosestPointM<M>::quads(query, context, quad, v0,v1,v2,v3);
       }
     };
 
@@ -305,7 +318,11 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& quad)
       {
-        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, quad);
+        if (likely(context->mode == POINT_QUERY_MODE_CALLBACK))
+          return PrimitivePointQuery1<Primitive>::pointQuery(query, context, quad);
+
+        Vec3vf<M> v0, v1, v2, v3; quad.gather(v0,v1,v2,v3,context->scene,query->time);
+        return ClosestPointM<M>::quads(query, context, quad, v0,v1,v2,v3);
       }
     };
 
@@ -19,6 +19,7 @@
 #include "quadv.h"
 #include "quad_intersector_moeller.h"
 #include "quad_intersector_pluecker.h"
+#include "closest_point.h"
 
 namespace embree
 {
@@ -47,7 +48,10 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& quad)
       {
-        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, quad);
+        if (likely(context->mode == POINT_QUERY_MODE_CALLBACK))
+          return PrimitivePointQuery1<Primitive>::pointQuery(query, context, quad);
+
+        return ClosestPointM<M>::quads(query, context, quad, quad.v0,quad.v1,quad.v2,quad.v3);
       }
     };
 
@@ -130,7 +134,10 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& quad)
       {
-        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, quad);
+        if (likely(context->mode == POINT_QUERY_MODE_CALLBACK))
+          return PrimitivePointQuery1<Primitive>::pointQuery(query, context, quad);
+
+        return ClosestPointM<M>::quads(query, context, quad, quad.v0,quad.v1,quad.v2,quad.v3);
       }
     };
 
@@ -18,6 +18,7 @@
 
 #include "intersector_epilog.h"
 #include "pointi.h"
+#include "closest_point.h"
 #include "sphere_intersector.h"
 
 namespace embree
@@ -60,7 +61,9 @@ namespace embree
                                            PointQueryContext* context,
                                            const Primitive& sphere)
       {
-        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, sphere);
+        Vec4vf<M> v0;
+        sphere.gather(v0, context->scene);
+        return ClosestPointPointM<M>::pointQuery(query, context, sphere, v0);
       }
     };
 
@@ -100,7 +103,9 @@ namespace embree
                                            PointQueryContext* context,
                                            const Primitive& sphere)
       {
-        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, sphere);
+        Vec4vf<M> v0;
+        sphere.gather(v0, context->scene, query->time);
+        return ClosestPointPointM<M>::pointQuery(query, context, sphere, v0);
       }
     };
 
@@ -19,6 +19,7 @@
 #include "subgrid.h"
 #include "subgrid_intersector_moeller.h"
 #include "subgrid_intersector_pluecker.h"
+#include "closest_point.h"
 
 namespace embree
 {
@@ -58,6 +59,9 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const SubGrid& subgrid)
       {
+        if (unlikely(context->mode != POINT_QUERY_MODE_CALLBACK))
+          return ClosestPointSubGrid::pointQuery(query, context, subgrid);
+
         STAT3(point_query.trav_prims,1,1,1);
         AccelSet* accel = (AccelSet*)context->scene->get(subgrid.geomID());
         assert(accel);
@@ -161,6 +165,9 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const SubGrid& subgrid)
       {
+        if (unlikely(context->mode != POINT_QUERY_MODE_CALLBACK))
+          return ClosestPointSubGrid::pointQuery(query, context, subgrid);
+
         STAT3(point_query.trav_prims,1,1,1);
         AccelSet* accel = (AccelSet*)context->scene->get(subgrid.geomID());
         context->geomID = subgrid.geomID();
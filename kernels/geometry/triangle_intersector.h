@@ -18,6 +18,7 @@
 
 #include "triangle.h"
 #include "triangle_intersector_moeller.h"
+#include "closest_point.h"
 
 namespace embree
 {
@@ -46,7 +47,10 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
-        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+        if (likely(context->mode == POINT_QUERY_MODE_CALLBACK))
+          return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+
+        return ClosestPointM<M>::triangles(query, context, tri, tri.v0,tri.v0-tri.e1,tri.v0+tri.e2);
       }
       
     };
@@ -19,6 +19,7 @@
 #include "trianglei.h"
 #include "triangle_intersector_moeller.h"
 #include "triangle_intersector_pluecker.h"
+#include "closest_point.h"
 
 namespace embree
 {
@@ -47,7 +48,11 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
-        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+        if (likely(context->mode == POINT_QUERY_MODE_CALLBACK))
+          return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+
+        Vec3vf<M> v0, v1, v2; tri.gather(v0,v1,v2,context->scene);
+        return ClosestPointM<M>::triangles(query, context, tri, v0,v1,v2);
       }
     };
 
@@ -128,7 +133,11 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
-        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+        if (likely(context->mode == POINT_QUERY_MODE_CALLBACK))
+          return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+
+        Vec3vf<M> v0, v1, v2; tri.gather(v0,v1,v2,context->scene);
+        return ClosestPointM<M>::triangles(query, context, tri, v0,v1,v2);
       }
     };
 
@@ -211,7 +220,11 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
-        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+        if (likely(context->mode == POINT_QUERY_MODE_CALLBACK))
+          return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+
+        Vec3vf<M> v0, v1, v2; tri.gather(v0,v1,v2,context->scene,query->time);
+        return ClosestPointM<M>::triangles(query, context, tri, v0,v1,v2);
       }
     };
 
@@ -291,7 +304,11 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
-        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+        if (likely(context->mode == POINT_QUERY_MODE_CALLBACK))
+          return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+
+        Vec3vf<M> v0, v1, v2; tri.gather(v0,v1,v2,context->scene,query->time);
+        return ClosestPointM<M>::triangles(query, context, tri, v0,v1,v2);
       }
     };
 
@@ -20,6 +20,7 @@
 #include "triangle_intersector_pluecker.h"
 #include "triangle_intersector_moeller.h"
 #include "triangle_intersector_woop.h"
+#include "closest_point.h"
 
 namespace embree
 {
@@ -48,7 +49,10 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
-        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+        if (likely(context->mode == POINT_QUERY_MODE_CALLBACK))
+          return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+
+        return ClosestPointM<M>::triangles(query, context, tri, tri.v0,tri.v1,tri.v2);
       }
     };
 
@@ -76,7 +80,10 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
-        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+        if (likely(context->mode == POINT_QUERY_MODE_CALLBACK))
+          return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+
+        return ClosestPointM<M>::triangles(query, context, tri, tri.v0,tri.v1,tri.v2);
       }
     };
 
@@ -158,7 +165,10 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
-        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+        if (likely(context->mode == POINT_QUERY_MODE_CALLBACK))
+          return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+
+        return ClosestPointM<M>::triangles(query, context, tri, tri.v0,tri.v1,tri.v2);
       }
     };
 
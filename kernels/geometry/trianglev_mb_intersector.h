@@ -18,6 +18,7 @@
 
 #include "triangle.h"
 #include "intersector_epilog.h"
+#include "closest_point.h"
 
 namespace embree
 {
@@ -54,7 +55,14 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
-        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+        if (likely(context->mode == POINT_QUERY_MODE_CALLBACK))
+          return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+
+        const Vec3vf<M> time(query->time);
+        const Vec3vf<M> v0 = madd(time,Vec3vf<M>(tri.dv0),Vec3vf<M>(tri.v0));
+        const Vec3vf<M> v1 = madd(time,Vec3vf<M>(tri.dv1),Vec3vf<M>(tri.v1));
+        const Vec3vf<M> v2 = madd(time,Vec3vf<M>(tri.dv2),Vec3vf<M>(tri.v2));
+        return ClosestPointM<M>::triangles(query, context, tri, v0,v1,v2);
       }
     };
     
@@ -153,7 +161,14 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
-        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+        if (likely(context->mode == POINT_QUERY_MODE_CALLBACK))
+          return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+
+        const Vec3vf<M> time(query->time);
+        const Vec3vf<M> v0 = madd(time,Vec3vf<M>(tri.dv0),Vec3vf<M>(tri.v0));
+        const Vec3vf<M> v1 = madd(time,Vec3vf<M>(tri.dv1),Vec3vf<M>(tri.v1));
+        const Vec3vf<M> v2 = madd(time,Vec3vf<M>(tri.dv2),Vec3vf<M>(tri.v2));
+        return ClosestPointM<M>::triangles(query, context, tri, v0,v1,v2);
       }
     };
     
@@ -34,6 +34,11 @@ namespace embree
       SharedLazyTessellationCache::sharedLazyTessellationCache.realloc(new_size);    
   }
 
+  void setTessellationCacheShards(size_t num_shards)
+  {
+    SharedLazyTessellationCache::sharedLazyTessellationCache.setNumShards(num_shards);
+  }
+
   void resetTessellationCache()
   {
     //SharedLazyTessellationCache::sharedLazyTessellationCache.addCurrentIndex(SharedLazyTessellationCache::NUM_CACHE_SEGMENTS);
@@ -46,14 +51,20 @@ namespace embree
     data = nullptr;
     hugepages = false;
     maxBlocks              = size/BLOCK_SIZE;
-    localTime              = NUM_CACHE_SEGMENTS;
-    next_block             = 0;
+    numShards              = 1;
+    requestedShards        = 1;
+    shardBytes             = 0;
+    segmentBlocks          = 0;
     numRenderThreads       = 0;
-#if FORCE_SIMPLE_FLUSH == 1
-    switch_block_threshold = maxBlocks;
-#else
-    switch_block_threshold = maxBlocks/NUM_CACHE_SEGMENTS;
-#endif
+    for (size_t i=0; i<MAX_CACHE_SHARDS; i++)
+    {
+      shards[i].localTime = NUM_CACHE_SEGMENTS;
+      shards[i].beginBlock = 0;
+      shards[i].numBlocks = 0;
+      shards[i].next_block = 0;
+      shards[i].switch_block_threshold = 0;
+      shards[i].flushes = 0;
+    }
     threadWorkState     = new ThreadWorkState[NUM_PREALLOC_THREAD_WORK_STATES];
 
     //reset_state.reset();
@@ -72,16 +83,50 @@ namespace embree
     delete[] threadWorkState;
   }
 
+  size_t SharedLazyTessellationCache::getShardOfThread(ThreadWorkState* t)
+  {
+    /* threads of too few clusters to use all shards get distributed evenly */
+    if (activeClusters.size() < numShards)
+      return t->id % numShards;
+
+    for (size_t i=0; i<activeClusters.size(); i++)
+      if (activeClusters[i] == t->cluster) return i*numShards/activeClusters.size();
+    return 0;
+  }
+
+  void SharedLazyTessellationCache::assignShards()
+  {
+    /* keep active clusters of the same NUMA node at neighbouring shards */
+    std::stable_sort(activeClusters.begin(),activeClusters.end(),[&] (unsigned int a, unsigned int b) {
+        return std::find(clusters.begin(),clusters.end(),a) < std::find(clusters.begin(),clusters.end(),b);
+      });
+
+    /* threads only allocate from their shard, thus changing it does not affect cached data */
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
+      t->shard = getShardOfThread(t);
+  }
+
   void SharedLazyTessellationCache::getNextRenderThreadWorkState() 
   {
     const size_t id = numRenderThreads.fetch_add(1); 
     if (id >= NUM_PREALLOC_THREAD_WORK_STATES) init_t_state = new ThreadWorkState(true);
     else                                       init_t_state = &threadWorkState[id];
+    init_t_state->id = id;
+    const unsigned int cluster = getCacheClusterOfCPU(getCurrentCPU());
+    init_t_state->cluster = cluster;
     
     /* critical section for updating link list with new thread state */
     linkedlist_mtx.lock();
     init_t_state->next = current_t_state;
     current_t_state = init_t_state;
+
+    /* the first thread of a cluster changes the assignment of clusters to shards */
+    if (std::find(activeClusters.begin(),activeClusters.end(),cluster) == activeClusters.end()) {
+      activeClusters.push_back(cluster);
+      assignShards();
+    }
+    else
+      init_t_state->shard = getShardOfThread(init_t_state);
     linkedlist_mtx.unlock();
   }
 
@@ -97,102 +142,111 @@ namespace embree
      }
    }
 
-  void SharedLazyTessellationCache::allocNextSegment() 
+  void SharedLazyTessellationCache::lockAllThreads()
+  {
+    /* lock the linked list of thread states */
+    linkedlist_mtx.lock();
+
+    /* block all threads */
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
+      if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
+        waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
+  }
+
+  void SharedLazyTessellationCache::unlockAllThreads()
+  {
+    /* release all blocked threads */
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
+      unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
+
+    /* unlock the linked list of thread states */
+    linkedlist_mtx.unlock();
+  }
+
+  void SharedLazyTessellationCache::resetSegment(Shard& shard)
   {
-    if (reset_state.try_lock())
-    {
-      if (next_block >= switch_block_threshold)
-      {
-        /* lock the linked list of thread states */
-        
-        linkedlist_mtx.lock();
-        
-        /* block all threads */
-        for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-          if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
-            waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
-        
-        /* switch to the next segment */
-        addCurrentIndex();
-        CACHE_STATS(PRINT("RESET TESS CACHE"));
-        
 #if FORCE_SIMPLE_FLUSH == 1
-        next_block = 0;
-        switch_block_threshold = maxBlocks;
+    shard.next_block = shard.beginBlock;
+    shard.switch_block_threshold = shard.beginBlock + shard.numBlocks;
 #else
-        const size_t region = localTime % NUM_CACHE_SEGMENTS;
-        next_block = region * (maxBlocks/NUM_CACHE_SEGMENTS);
-        switch_block_threshold = next_block + (maxBlocks/NUM_CACHE_SEGMENTS);
-        assert( switch_block_threshold <= maxBlocks );
+    const size_t region = shard.localTime % NUM_CACHE_SEGMENTS;
+    shard.next_block = shard.beginBlock + region * segmentBlocks;
+    shard.switch_block_threshold = shard.next_block + segmentBlocks;
+    assert( shard.switch_block_threshold <= shard.beginBlock + shard.numBlocks );
 #endif
+  }
+
+  void SharedLazyTessellationCache::waitForShardUsers(const size_t shardID)
+  {
+    const size_t mask = size_t(1) << shardID;
+    Lock<SpinLock> lock(linkedlist_mtx);
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
+    {
+      while (t->usedShards.load() & mask)
+      {
+        _mm_pause();
+        _mm_pause();
+        _mm_pause();
+        _mm_pause();
+      }
+    }
+  }
+
+  void SharedLazyTessellationCache::allocNextSegment(const size_t shardID) 
+  {
+    Shard& shard = shards[shardID];
+    if (shard.reset_state.try_lock())
+    {
+      if (shard.next_block >= shard.switch_block_threshold && shardID < numShards)
+      {
+        /* advancing the time of the shard invalidates the entries of
+         * the segment to switch to, threads marking the shard as used
+         * afterwards see them invalid, thus only threads that marked
+         * the shard before may still use data of that segment */
+        shard.localTime++;
+        waitForShardUsers(shardID);
+
+        /* switch to the next segment of this shard only */
+        CACHE_STATS(PRINT("RESET TESS CACHE"));
+        resetSegment(shard);
         
         CACHE_STATS(SharedTessellationCacheStats::cache_flushes++);
-        
-        /* release all blocked threads */
-        
-        for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-          unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
-        
-        /* unlock the linked list of thread states */
-        
-        linkedlist_mtx.unlock();
-	
-        
+        shard.flushes++;
       }
-      reset_state.unlock();
+      shard.reset_state.unlock();
     }
     else
-      reset_state.wait_until_unlocked();	   
+      shard.reset_state.wait_until_unlocked();	   
   }
   
-  
   void SharedLazyTessellationCache::reset()
   {
-    /* lock the reset_state */
-    reset_state.lock();
+    /* lock the reset_state of all shards */
+    for (size_t i=0; i<MAX_CACHE_SHARDS; i++)
+      shards[i].reset_state.lock();
 
-    /* lock the linked list of thread states */
-    linkedlist_mtx.lock();
-
-    /* block all threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
-        waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
-
-    /* reset to the first segment */
-    next_block = 0;
-#if FORCE_SIMPLE_FLUSH == 1
-    switch_block_threshold = maxBlocks;
-#else
-    switch_block_threshold = maxBlocks/NUM_CACHE_SEGMENTS;
-#endif
+    lockAllThreads();
 
-    /* reset local time */
-    localTime = NUM_CACHE_SEGMENTS;
-
-    /* release all blocked threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
+    /* reset local time and go to the first segment */
+    for (size_t i=0; i<numShards; i++) {
+      shards[i].localTime = NUM_CACHE_SEGMENTS;
+      resetSegment(shards[i]);
+    }
 
-    /* unlock the linked list of thread states */
-    linkedlist_mtx.unlock();	    
+    unlockAllThreads();
 
-    /* unlock the reset_state */
-    reset_state.unlock();
+    /* unlock the reset_state of all shards */
+    for (size_t i=0; i<MAX_CACHE_SHARDS; i++)
+      shards[i].reset_state.unlock();
   }
 
   void SharedLazyTessellationCache::realloc(const size_t new_size)
   {
-    /* lock the reset_state */
-    reset_state.lock();
+    /* lock the reset_state of all shards */
+    for (size_t i=0; i<MAX_CACHE_SHARDS; i++)
+      shards[i].reset_state.lock();
 
-    /* lock the linked list of thread states */
-    linkedlist_mtx.lock();
-
-    /* block all threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
-        waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
+    lockAllThreads();
 
     /* reallocate data */
     if (data) os_free(data,size,hugepages);
@@ -201,29 +255,79 @@ namespace embree
     if (size) data = (float*)os_malloc(size,hugepages);
     maxBlocks = size/BLOCK_SIZE;    
 
-    /* invalidate entire cache */
-    localTime += NUM_CACHE_SEGMENTS; 
+    partition();
+
+    unlockAllThreads();
+
+    /* unlock the reset_state of all shards */
+    for (size_t i=0; i<MAX_CACHE_SHARDS; i++)
+      shards[i].reset_state.unlock();
+  }
+
+  void SharedLazyTessellationCache::setNumShards(const size_t shards_in)
+  {
+    /* repartitioning invalidates the entire cache */
+    if (max(shards_in,size_t(1)) == requestedShards)
+      return;
+
+    /* lock the reset_state of all shards */
+    for (size_t i=0; i<MAX_CACHE_SHARDS; i++)
+      shards[i].reset_state.lock();
 
-    /* reset to the first segment */
+    lockAllThreads();
+
+    requestedShards = max(shards_in,size_t(1));
+    partition();
+
+    unlockAllThreads();
+
+    /* unlock the reset_state of all shards */
+    for (size_t i=0; i<MAX_CACHE_SHARDS; i++)
+      shards[i].reset_state.unlock();
+  }
+
+  void SharedLazyTessellationCache::partition()
+  {
+    /* get the cache clusters of the system, clusters of the same NUMA node map to neighbouring shards */
+    if (clusters.empty())
+    {
+      std::vector<std::pair<unsigned int,unsigned int>> nodeClusters;
+      for (unsigned int cpu=0; cpu<getNumberOfLogicalThreads(); cpu++)
+        nodeClusters.push_back(std::make_pair(getNumaNodeOfCPU(cpu),getCacheClusterOfCPU(cpu)));
+      std::sort(nodeClusters.begin(),nodeClusters.end());
+      nodeClusters.erase(std::unique(nodeClusters.begin(),nodeClusters.end()),nodeClusters.end());
+      for (size_t i=0; i<nodeClusters.size(); i++)
+        clusters.push_back(nodeClusters[i].second);
+    }
+
+    /* each segment of a shard needs at least one block */
+    numShards = min(requestedShards,MAX_CACHE_SHARDS,maxBlocks/NUM_CACHE_SEGMENTS);
+    numShards = max(numShards,size_t(1));
+    const size_t shardBlocks = maxBlocks/numShards;
+    shardBytes = shardBlocks*BLOCK_SIZE;
 #if FORCE_SIMPLE_FLUSH == 1
-    next_block = 0;
-    switch_block_threshold = maxBlocks;
+    segmentBlocks = shardBlocks;
 #else
-    const size_t region = localTime % NUM_CACHE_SEGMENTS;
-    next_block = region * (maxBlocks/NUM_CACHE_SEGMENTS);
-    switch_block_threshold = next_block + (maxBlocks/NUM_CACHE_SEGMENTS);
-    assert( switch_block_threshold <= maxBlocks );
+    segmentBlocks = shardBlocks/NUM_CACHE_SEGMENTS;
 #endif
 
-    /* release all blocked threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
+    /* invalidate entire cache by advancing all shards beyond the latest time */
+    size_t maxTime = 0;
+    for (size_t i=0; i<MAX_CACHE_SHARDS; i++)
+      maxTime = max(maxTime,shards[i].localTime.load());
 
-    /* unlock the linked list of thread states */
-    linkedlist_mtx.unlock();	    
+    for (size_t i=0; i<MAX_CACHE_SHARDS; i++)
+    {
+      Shard& shard = shards[i];
+      shard.localTime = maxTime + NUM_CACHE_SEGMENTS;
+      shard.beginBlock = i < numShards ? i*shardBlocks : 0;
+      shard.numBlocks = i < numShards ? shardBlocks : 0;
+      if (i < numShards) resetSegment(shard);
+      else shard.next_block = shard.switch_block_threshold = 0;
+    }
 
-    /* unlock the reset_state */
-    reset_state.unlock();
+    /* assign threads to the new shards */
+    assignShards();
   }
 
 
@@ -238,6 +342,61 @@ namespace embree
   SpinLock   SharedTessellationCacheStats::mtx;  
   size_t SharedTessellationCacheStats::cache_num_patches(0);
 
+  size_t SharedTessellationCacheStats::getNumShards() {
+    return SharedLazyTessellationCache::sharedLazyTessellationCache.getNumShards();
+  }
+
+  size_t SharedTessellationCacheStats::getShardHits(size_t shard)
+  {
+    size_t hits = 0;
+    SharedLazyTessellationCache::sharedLazyTessellationCache.forEachThreadState([&] (ThreadWorkState* t) { hits += t->hits[shard]; });
+    return hits;
+  }
+
+  size_t SharedTessellationCacheStats::getShardMisses(size_t shard)
+  {
+    size_t misses = 0;
+    SharedLazyTessellationCache::sharedLazyTessellationCache.forEachThreadState([&] (ThreadWorkState* t) { misses += t->misses[shard]; });
+    return misses;
+  }
+
+  size_t SharedTessellationCacheStats::getShardFlushes(size_t shard) {
+    return SharedLazyTessellationCache::sharedLazyTessellationCache.getShard(shard).flushes;
+  }
+
+  size_t SharedTessellationCacheStats::getHits()
+  {
+    size_t hits = 0;
+    SharedLazyTessellationCache::sharedLazyTessellationCache.forEachThreadState([&] (ThreadWorkState* t) {
+        for (size_t i=0; i<SharedLazyTessellationCache::MAX_CACHE_SHARDS; i++) hits += t->hits[i];
+      });
+    return hits;
+  }
+
+  size_t SharedTessellationCacheStats::getMisses()
+  {
+    size_t misses = 0;
+    SharedLazyTessellationCache::sharedLazyTessellationCache.forEachThreadState([&] (ThreadWorkState* t) {
+        for (size_t i=0; i<SharedLazyTessellationCache::MAX_CACHE_SHARDS; i++) misses += t->misses[i];
+      });
+    return misses;
+  }
+
+  size_t SharedTessellationCacheStats::getFlushes()
+  {
+    size_t flushes = 0;
+    for (size_t i=0; i<SharedLazyTessellationCache::MAX_CACHE_SHARDS; i++)
+      flushes += getShardFlushes(i);
+    return flushes;
+  }
+
+  size_t SharedTessellationCacheStats::getAllocatedBytes()
+  {
+    size_t bytes = 0;
+    SharedLazyTessellationCache::sharedLazyTessellationCache.forEachThreadState([&] (ThreadWorkState* t) { bytes += t->allocatedBytes; });
+    return bytes;
+  }
+
   void SharedTessellationCacheStats::printStats()
   {
     PRINT(cache_accesses);
@@ -247,6 +406,15 @@ namespace embree
     PRINT(100.0f * cache_hits / cache_accesses);
     assert(cache_hits + cache_misses == cache_accesses);
     PRINT(cache_num_patches);
+
+    for (size_t i=0; i<getNumShards(); i++)
+    {
+      const size_t hits = getShardHits(i);
+      const size_t misses = getShardMisses(i);
+      std::cout << "shard " << i << ": hits = " << hits << ", misses = " << misses << ", flushes = " << getShardFlushes(i);
+      if (hits+misses) std::cout << ", hit rate = " << 100.0f * hits / (hits+misses) << "%";
+      std::cout << std::endl;
+    }
   }
 
   void SharedTessellationCacheStats::clearStats()
@@ -255,6 +423,17 @@ namespace embree
     SharedTessellationCacheStats::cache_hits      = 0;
     SharedTessellationCacheStats::cache_misses    = 0;
     SharedTessellationCacheStats::cache_flushes   = 0;
+
+    SharedLazyTessellationCache& cache = SharedLazyTessellationCache::sharedLazyTessellationCache;
+    cache.forEachThreadState([&] (ThreadWorkState* t) {
+        for (size_t i=0; i<SharedLazyTessellationCache::MAX_CACHE_SHARDS; i++) {
+          t->hits[i] = 0;
+          t->misses[i] = 0;
+        }
+        t->allocatedBytes = 0;
+      });
+    for (size_t i=0; i<SharedLazyTessellationCache::MAX_CACHE_SHARDS; i++)
+      cache.getShard(i).flushes = 0;
   }
 
   struct cache_regression_test : public RegressionTest
@@ -307,17 +486,14 @@ namespace embree
       This->barrier.wait();
     }
     
-    bool run ()
+    void runThreads(size_t numThreads)
     {
-      numFailed.store(0);
-
-      size_t numThreads = getNumberOfLogicalThreads();
       barrier.init(numThreads+1);
 
-      /* create threads */
+      /* create threads, the threads exceeding the number of logical threads are not pinned */
       std::vector<thread_t> threads;
       for (size_t i=0; i<numThreads; i++)
-        threads.push_back(createThread((thread_func)thread_alloc,this,0,i));
+        threads.push_back(createThread((thread_func)thread_alloc,this,0,i < getNumberOfLogicalThreads() ? ssize_t(i) : ssize_t(-1)));
 
       /* run test */ 
       barrier.wait();
@@ -326,8 +502,39 @@ namespace embree
       /* destroy threads */
       for (size_t i=0; i<numThreads; i++)
         join(threads[i]);
+    }
+
+    bool run ()
+    {
+      SharedLazyTessellationCache& cache = SharedLazyTessellationCache::sharedLazyTessellationCache;
+      numFailed.store(0);
+
+      const size_t numThreads = getNumberOfLogicalThreads();
+      runThreads(numThreads);
+
+      /* force multiple shards, each shard has to switch segments */
+      const size_t numShards = cache.getNumShards();
+      cache.setNumShards(4);
+      if (cache.getNumShards() != 4) {
+        cache.setNumShards(numShards);
+        return false;
+      }
+
+      std::vector<size_t> misses(4), flushes(4);
+      for (size_t i=0; i<4; i++) {
+        misses[i] = SharedTessellationCacheStats::getShardMisses(i);
+        flushes[i] = SharedTessellationCacheStats::getShardFlushes(i);
+      }
+
+      runThreads(max(numThreads,size_t(8)));
+
+      size_t usedShards = 0;
+      for (size_t i=0; i<4; i++)
+        if (SharedTessellationCacheStats::getShardMisses(i) > misses[i] && SharedTessellationCacheStats::getShardFlushes(i) > flushes[i])
+          usedShards++;
 
-      return numFailed == 0;
+      cache.setNumShards(numShards);
+      return numFailed == 0 && usedShards > 1;
     }
   };
 
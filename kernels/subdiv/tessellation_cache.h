@@ -23,6 +23,9 @@
 
 #define THREAD_BLOCK_ATOMIC_ADD 4
 
+/* maximal number of independently managed parts of the cache */
+#define MAX_TESSELLATION_CACHE_SHARDS 16
+
 #if defined(DEBUG)
 #define CACHE_STATS(x) 
 #else
@@ -41,6 +44,18 @@ namespace embree
     static std::atomic<size_t> cache_flushes;                
     static size_t        cache_num_patches;
     __aligned(64) static SpinLock mtx;
+
+    /* per shard stats, hits and misses are accumulated over all threads */
+    static size_t getNumShards();
+    static size_t getShardHits(size_t shard);
+    static size_t getShardMisses(size_t shard);
+    static size_t getShardFlushes(size_t shard);
+
+    /* stats summed over all shards */
+    static size_t getHits();
+    static size_t getMisses();
+    static size_t getFlushes();
+    static size_t getAllocatedBytes();
     
     /* print stats for debugging */                 
     static void printStats();
@@ -48,6 +63,7 @@ namespace embree
   };
   
   void resizeTessellationCache(size_t new_size);
+  void setTessellationCacheShards(size_t num_shards);
   void resetTessellationCache();
   
  ////////////////////////////////////////////////////////////////////////////////
@@ -59,14 +75,38 @@ namespace embree
    ALIGNED_STRUCT_(64);
 
    std::atomic<size_t> counter;
+   std::atomic<size_t> usedShards;                             //!< bit mask of the shards whose data the thread may use while locked
    ThreadWorkState* next;
    bool allocated;
+   size_t id;                                                  //!< registration order of the thread
+   unsigned int cluster;                                       //!< cache cluster the thread was running on when registering
+   std::atomic<size_t> shard;                                  //!< shard the thread allocates from
+   std::atomic<size_t> hits[MAX_TESSELLATION_CACHE_SHARDS];    //!< cache hits of this thread per shard
+   std::atomic<size_t> misses[MAX_TESSELLATION_CACHE_SHARDS];  //!< entries constructed by this thread per shard
+   std::atomic<size_t> allocatedBytes;                         //!< bytes allocated by this thread
 
    __forceinline ThreadWorkState(bool allocated = false) 
-     : counter(0), next(nullptr), allocated(allocated) 
+     : counter(0), usedShards(0), next(nullptr), allocated(allocated), id(0), cluster(0), shard(0), allocatedBytes(0)
    {
      assert( ((size_t)this % 64) == 0 ); 
-   }   
+     for (size_t i=0; i<MAX_TESSELLATION_CACHE_SHARDS; i++) {
+       hits[i].store(0);
+       misses[i].store(0);
+     }
+   }
+
+   /*! the statistics counters are only written by the owning thread, thus need no atomic read-modify-write */
+   static __forceinline void count(std::atomic<size_t>& counter, const size_t n = 1) {
+     counter.store(counter.load(std::memory_order_relaxed)+n,std::memory_order_relaxed);
+   }
+
+   /*! marks the data of some shard as used, this has to happen before validating the time of the shard */
+   __forceinline void useShard(const size_t shard)
+   {
+     const size_t mask = size_t(1) << shard;
+     if (unlikely((usedShards.load(std::memory_order_relaxed) & mask) == 0))
+       usedShards.fetch_or(mask);
+   }
  };
 
  class __aligned(64) SharedLazyTessellationCache 
@@ -83,6 +123,7 @@ namespace embree
 #endif
    static const size_t MAX_TESSELLATION_CACHE_SIZE     = REF_TAG_MASK+1;
    static const size_t BLOCK_SIZE                      = 64;
+   static const size_t MAX_CACHE_SHARDS                = MAX_TESSELLATION_CACHE_SHARDS;
    
 
     /*! Per thread tessellation ref cache */
@@ -131,6 +172,7 @@ namespace embree
    };
 
    static __forceinline size_t extractCommitIndex(const int64_t v) { return v >> SharedLazyTessellationCache::COMMIT_INDEX_SHIFT; }
+   static __forceinline size_t extractOffset(const int64_t v) { return v & SharedLazyTessellationCache::REF_TAG_MASK; }
 
    struct CacheEntry
    {
@@ -138,19 +180,40 @@ namespace embree
      SpinLock mutex;
    };
 
+   /*! The cache can be split into shards. Each shard is a ring
+    *  buffer of NUM_CACHE_SEGMENTS segments with its own time, thus a
+    *  thread filling up its shard does not invalidate the segments of
+    *  the other shards, and switching segments only waits for the
+    *  threads using data of that shard. Shards get assigned to groups
+    *  of the cache clusters threads run on, such that the pages of a
+    *  shard get first touched on the NUMA node using it. */
+   struct Shard
+   {
+     __aligned(64) std::atomic<size_t> localTime;
+     size_t beginBlock;                                 //!< first block of the shard
+     size_t numBlocks;                                  //!< number of blocks of the shard
+     __aligned(64) std::atomic<size_t> next_block;
+     std::atomic<size_t> switch_block_threshold;
+     __aligned(64) SpinLock reset_state;
+     std::atomic<size_t> flushes;                       //!< number of segment switches
+   };
+
  private:
 
    float *data;
    bool hugepages;
    size_t size;
    size_t maxBlocks;
+   size_t numShards;
+   size_t requestedShards;
+   size_t shardBytes;
+   size_t segmentBlocks;
    ThreadWorkState *threadWorkState;
-      
-   __aligned(64) std::atomic<size_t> localTime;
-   __aligned(64) std::atomic<size_t> next_block;
-   __aligned(64) SpinLock   reset_state;
+   std::vector<unsigned int> clusters;                  //!< cache clusters of the system sorted by NUMA node
+   std::vector<unsigned int> activeClusters;            //!< cache clusters threads registered on, in the order of clusters
+
+   __aligned(64) Shard shards[MAX_CACHE_SHARDS];
    __aligned(64) SpinLock   linkedlist_mtx;
-   __aligned(64) std::atomic<size_t> switch_block_threshold;
    __aligned(64) std::atomic<size_t> numRenderThreads;
 
 
@@ -163,19 +226,47 @@ namespace embree
    void getNextRenderThreadWorkState();
 
    __forceinline size_t maxAllocSize() const {
-     return switch_block_threshold;
+     return segmentBlocks;
+   }
+
+   /*! returns the shard the data at some byte offset belongs to */
+   __forceinline size_t getShardOfOffset(const size_t offset) const {
+     if (likely(numShards == 1)) return 0;
+     return min(offset/shardBytes,numShards-1);
    }
 
-   __forceinline size_t getCurrentIndex() { return localTime.load(); }
-   __forceinline void   addCurrentIndex(const size_t i=1) { localTime.fetch_add(i); }
+   __forceinline size_t getShardTime(const size_t shard, const size_t globalTime) {
+     return shards[shard].localTime.load()+NUM_CACHE_SEGMENTS*globalTime;
+   }
 
+   /*! returns the time of the shard the calling thread allocates from */
    __forceinline size_t getTime(const size_t globalTime) {
-     return localTime.load()+NUM_CACHE_SEGMENTS*globalTime;
+     return getShardTime(threadState()->shard,globalTime);
+   }
+
+   /*! returns the time of the segment the data at some byte offset got allocated in */
+   __forceinline size_t getSegmentTime(const size_t offset, const size_t globalTime)
+   {
+     const size_t shardID = getShardOfOffset(offset);
+     const size_t time = getShardTime(shardID,globalTime);
+#if FORCE_SIMPLE_FLUSH == 1
+     return time;
+#else
+     const size_t region = (offset/BLOCK_SIZE - shards[shardID].beginBlock)/segmentBlocks;
+     return time - (time - region) % NUM_CACHE_SEGMENTS;
+#endif
    }
 
 
    __forceinline size_t lockThread  (ThreadWorkState *const t_state, const ssize_t plus=1) { return t_state->counter.fetch_add(plus);  }
-   __forceinline size_t unlockThread(ThreadWorkState *const t_state, const ssize_t plus=-1) { assert(isLocked(t_state)); return t_state->counter.fetch_add(plus); }
+   __forceinline size_t unlockThread(ThreadWorkState *const t_state, const ssize_t plus=-1)
+   {
+     assert(isLocked(t_state));
+     /* the thread does not use any cache data once its last lock is released */
+     if (plus == -1 && (t_state->counter.load() & (THREAD_BLOCK_ATOMIC_ADD-1)) == 1)
+       t_state->usedShards.store(0);
+     return t_state->counter.fetch_add(plus);
+   }
 
    __forceinline bool isLocked(ThreadWorkState *const t_state) { return t_state->counter.load() != 0; }
 
@@ -206,19 +297,23 @@ namespace embree
      }
    }
 
-   static __forceinline void* lookup(CacheEntry& entry, size_t globalTime)
+   static __forceinline void* lookup(CacheEntry& entry, size_t globalTime, ThreadWorkState* const t_state)
    {   
      const int64_t subdiv_patch_root_ref = entry.tag.get(); 
      CACHE_STATS(SharedTessellationCacheStats::cache_accesses++);
      
      if (likely(subdiv_patch_root_ref != 0)) 
      {
-       const size_t subdiv_patch_root = (subdiv_patch_root_ref & REF_TAG_MASK) + (size_t)sharedLazyTessellationCache.getDataPtr();
+       const size_t offset = extractOffset(subdiv_patch_root_ref);
+       const size_t subdiv_patch_root = offset + (size_t)sharedLazyTessellationCache.getDataPtr();
        const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
+       const size_t shard = sharedLazyTessellationCache.getShardOfOffset(offset);
+       t_state->useShard(shard);
        
-       if (likely( sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime) ))
+       if (likely( sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,shard,globalTime) ))
        {
          CACHE_STATS(SharedTessellationCacheStats::cache_hits++);
+         ThreadWorkState::count(t_state->hits[shard]);
          return (void*) subdiv_patch_root;
        }
      }
@@ -234,18 +329,22 @@ namespace embree
      while (true)
      {
        sharedLazyTessellationCache.lockThreadLoop(t_state);
-       void* patch = SharedLazyTessellationCache::lookup(entry,globalTime);
+       void* patch = SharedLazyTessellationCache::lookup(entry,globalTime,t_state);
        if (patch) return (decltype(constructor())) patch;
        
        if (entry.mutex.try_lock())
        {
          if (!validTag(entry.tag,globalTime)) 
          {
-           auto timeBefore = sharedLazyTessellationCache.getTime(globalTime);
+           auto timeBefore = sharedLazyTessellationCache.getShardTime(t_state->shard,globalTime);
            auto ret = constructor(); // thread is locked here!
            assert(ret);
            /* this should never return nullptr */
-           auto timeAfter = sharedLazyTessellationCache.getTime(globalTime);
+           const size_t offset = (size_t)ret - (size_t)sharedLazyTessellationCache.getDataPtr();
+           const size_t shard = sharedLazyTessellationCache.getShardOfOffset(offset);
+           /* the shard may have switched segments during construction, thus use the time of the segment holding the data */
+           auto timeAfter = sharedLazyTessellationCache.getSegmentTime(offset,globalTime);
+           ThreadWorkState::count(t_state->misses[shard]);
            auto time = before ? timeBefore : timeAfter;
            __memory_barrier();
            entry.tag = SharedLazyTessellationCache::Tag(ret,time);
@@ -259,12 +358,12 @@ namespace embree
      }
    }
    
-   __forceinline bool validCacheIndex(const size_t i, const size_t globalTime)
+   __forceinline bool validCacheIndex(const size_t i, const size_t shard, const size_t globalTime)
    {
 #if FORCE_SIMPLE_FLUSH == 1
-     return i == getTime(globalTime);
+     return i == getShardTime(shard,globalTime);
 #else
-     return i+(NUM_CACHE_SEGMENTS-1) >= getTime(globalTime);
+     return i+(NUM_CACHE_SEGMENTS-1) >= getShardTime(shard,globalTime);
 #endif
    }
 
@@ -279,20 +378,21 @@ namespace embree
       const int64_t subdiv_patch_root_ref = tag.get(); 
       if (subdiv_patch_root_ref == 0) return false;
       const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
-      return sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime);
+      const size_t shard = sharedLazyTessellationCache.getShardOfOffset(extractOffset(subdiv_patch_root_ref));
+      return sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,shard,globalTime);
     }
 
    void waitForUsersLessEqual(ThreadWorkState *const t_state,
 			      const unsigned int users);
     
-   __forceinline size_t alloc(const size_t blocks)
+   __forceinline size_t alloc(const size_t shardID, const size_t blocks)
    {
-     if (unlikely(blocks >= switch_block_threshold))
+     if (unlikely(blocks >= segmentBlocks))
        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"allocation exceeds size of tessellation cache segment");
 
-     assert(blocks < switch_block_threshold);
-     size_t index = next_block.fetch_add(blocks);
-     if (unlikely(index + blocks >= switch_block_threshold)) return (size_t)-1;
+     Shard& shard = shards[shardID];
+     size_t index = shard.next_block.fetch_add(blocks);
+     if (unlikely(index + blocks >= shard.switch_block_threshold)) return (size_t)-1;
      return index;
    }
 
@@ -300,18 +400,22 @@ namespace embree
    {
      size_t block_index = -1;
      ThreadWorkState *const t_state = threadState();
+     const size_t blocks = (bytes+BLOCK_SIZE-1)/BLOCK_SIZE;
      while (true)
      {
-       block_index = sharedLazyTessellationCache.alloc((bytes+BLOCK_SIZE-1)/BLOCK_SIZE);
+       const size_t shard = t_state->shard;
+       t_state->useShard(shard);
+       block_index = sharedLazyTessellationCache.alloc(shard,blocks);
        if (block_index == (size_t)-1)
        {
          sharedLazyTessellationCache.unlockThread(t_state);		  
-         sharedLazyTessellationCache.allocNextSegment();
+         sharedLazyTessellationCache.allocNextSegment(shard);
          sharedLazyTessellationCache.lockThread(t_state);
          continue; 
        }
        break;
      }
+     ThreadWorkState::count(t_state->allocatedBytes,blocks*BLOCK_SIZE);
      return sharedLazyTessellationCache.getBlockPtr(block_index);
    }
 
@@ -324,12 +428,34 @@ namespace embree
    }
 
    __forceinline void*  getDataPtr()      { return data; }
-   __forceinline size_t getNumUsedBytes() { return next_block * BLOCK_SIZE; }
    __forceinline size_t getMaxBlocks()    { return maxBlocks; }
    __forceinline size_t getSize()         { return size; }
+   __forceinline size_t getNumShards()    { return numShards; }
+   __forceinline Shard& getShard(size_t i) { return shards[i]; }
 
-   void allocNextSegment();
+   void allocNextSegment(const size_t shard);
    void realloc(const size_t newSize);
+   void setNumShards(const size_t shards);
+
+ private:
+   size_t getShardOfThread(ThreadWorkState* t);
+   void assignShards();
+   void partition();
+   void resetSegment(Shard& shard);
+   void waitForShardUsers(const size_t shard);
+   void lockAllThreads();
+   void unlockAllThreads();
+
+ public:
+
+   /*! iterates over the thread states of all threads that used the cache */
+   template<typename Closure>
+   void forEachThreadState(const Closure& closure)
+   {
+     Lock<SpinLock> lock(linkedlist_mtx);
+     for (ThreadWorkState *t=current_t_state; t!=nullptr; t=t->next)
+       closure(t);
+   }
 
    void reset();
 
@@ -15,29 +15,232 @@
 // ======================================================================== //
 
 #include "../common/tutorial/tutorial.h"
+#include "../common/math/closest_point.h"
 
 namespace embree
 {
   extern "C" {
     bool g_animate = false;
     bool g_userDefinedInstancing = false;
+    extern RTCDevice g_device;
   }
 
-  struct Tutorial : public TutorialApplication 
+  void error_handler(void* userPtr, RTCError code, const char* str = nullptr);
+
+  /* scene and result data used by the point query benchmark */
+  struct BenchmarkMesh
+  {
+    avector<Vec3fa> vertices;
+    std::vector<unsigned int> indices;
+  };
+
+  struct BenchmarkResult
+  {
+    BenchmarkResult() : primID(RTC_INVALID_GEOMETRY_ID) {}
+    unsigned int primID;
+  };
+
+  static BenchmarkMesh* g_benchmark_mesh = nullptr;
+
+  static bool benchmarkClosestPointFunc(RTCPointQueryFunctionArguments* args)
+  {
+    const unsigned int primID = args->primID;
+    const Vec3fa q(args->query->x, args->query->y, args->query->z);
+    const Vec3fa v0 = g_benchmark_mesh->vertices[g_benchmark_mesh->indices[3*primID+0]];
+    const Vec3fa v1 = g_benchmark_mesh->vertices[g_benchmark_mesh->indices[3*primID+1]];
+    const Vec3fa v2 = g_benchmark_mesh->vertices[g_benchmark_mesh->indices[3*primID+2]];
+    const float d = distance(q, closestPointTriangle(q, v0, v1, v2));
+    if (d < args->query->radius)
+    {
+      args->query->radius = d;
+      ((BenchmarkResult*)args->userPtr)->primID = primID;
+      return true;
+    }
+    return false;
+  }
+
+  struct Tutorial : public TutorialApplication
   {
     Tutorial()
-      : TutorialApplication("closest_point",FEATURE_RTCORE | FEATURE_STREAM) 
+      : TutorialApplication("closest_point",FEATURE_RTCORE | FEATURE_STREAM), benchmarkPointQueries(0)
     {
+      registerOption("benchmark-point-queries", [this] (Ref<ParseStream> cin, const FileName& path) {
+          benchmarkPointQueries = cin->getInt();
+        }, "--benchmark-point-queries <N>: measures single, packet, and stream point queries on a grid of N^3 query points and exits");
+
       camera.from = Vec3fa(8.74064f, 8.84506f, 7.48329f);
       camera.to = Vec3fa(-0.106665f, -1.8421f, -6.5347f);
       camera.fov  = 60;
     }
-    
+
     void drawGUI() override
     {
       ImGui::Checkbox  ("Animate", &g_animate);
       ImGui::Checkbox  ("User Defined Instancing", &g_userDefinedInstancing);
     }
+
+    /* creates a triangulated sphere of numPhi x 4*numPhi quads */
+    static void createSphere(BenchmarkMesh& mesh, const Vec3fa& p, float r, unsigned int numPhi)
+    {
+      const unsigned int numTheta = 4*numPhi;
+      const unsigned int base = (unsigned int) mesh.vertices.size();
+      for (unsigned int phi=0; phi<=numPhi; phi++)
+      {
+        for (unsigned int theta=0; theta<numTheta; theta++)
+        {
+          const float phif   = phi*float(pi)/float(numPhi);
+          const float thetaf = theta*2.0f*float(pi)/float(numTheta);
+          mesh.vertices.push_back(p + r*Vec3fa(sin(phif)*sin(thetaf),cos(phif),sin(phif)*cos(thetaf)));
+        }
+        if (phi == 0) continue;
+
+        for (unsigned int theta=1; theta<=numTheta; theta++)
+        {
+          const unsigned int p00 = base+(phi-1)*numTheta+theta-1;
+          const unsigned int p01 = base+(phi-1)*numTheta+theta%numTheta;
+          const unsigned int p10 = base+phi*numTheta+theta-1;
+          const unsigned int p11 = base+phi*numTheta+theta%numTheta;
+          const unsigned int tris[6] = { p10, p00, p01, p10, p01, p11 };
+          mesh.indices.insert(mesh.indices.end(), tris, tris+6);
+        }
+      }
+    }
+
+    /* measures the throughput of the single, packet, and stream point query APIs */
+    void benchmark()
+    {
+      /* create scene of 8x8 triangulated spheres */
+      BenchmarkMesh mesh;
+      for (int x=0; x<8; x++)
+        for (int z=0; z<8; z++)
+          createSphere(mesh, Vec3fa(2.0f*x-7.0f, 0.0f, 2.0f*z-7.0f), 0.8f, 32);
+      g_benchmark_mesh = &mesh;
+
+      RTCScene scene = rtcNewScene(g_device);
+      RTCGeometry geom = rtcNewGeometry(g_device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, mesh.vertices.data(), 0, sizeof(Vec3fa), mesh.vertices.size());
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, mesh.indices.data(), 0, 3*sizeof(unsigned int), mesh.indices.size()/3);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene, geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene(scene);
+
+      /* coherent query points on a regular grid around the spheres */
+      const size_t N = benchmarkPointQueries;
+      const size_t numQueries = N*N*N;
+      avector<RTCPointQuery> queries(numQueries);
+      for (size_t z=0, i=0; z<N; z++)
+        for (size_t y=0; y<N; y++)
+          for (size_t x=0; x<N; x++, i++)
+          {
+            const Vec3fa p = Vec3fa(-9.0f,-2.0f,-9.0f) + Vec3fa(18.0f,4.0f,18.0f)*Vec3fa(float(x),float(y),float(z))/float(max(N-1,size_t(1)));
+            queries[i].x = p.x; queries[i].y = p.y; queries[i].z = p.z;
+            queries[i].time = 0.0f;
+            queries[i].radius = inf;
+          }
+
+      std::cout << "point query benchmark: " << mesh.indices.size()/3 << " triangles, " << numQueries << " queries" << std::endl;
+
+      std::vector<BenchmarkResult> results(numQueries);
+      std::vector<void*> userPtr(numQueries);
+      for (size_t i=0; i<numQueries; i++) userPtr[i] = &results[i];
+      std::vector<float> reference(numQueries);
+
+      auto single = [&] (avector<RTCPointQuery>& query) {
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        for (size_t i=0; i<numQueries; i++)
+          rtcPointQuery(scene, &query[i], &context, benchmarkClosestPointFunc, userPtr[i]);
+      };
+
+      auto packet4 = [&] (avector<RTCPointQuery>& query) {
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        RTCPointQuery4 query4;
+        void* userPtr4[4];
+        RTC_ALIGN(16) int valid[4];
+        for (size_t i=0; i<numQueries; i+=4)
+        {
+          for (size_t j=0; j<4; j++)
+          {
+            const size_t k = min(i+j,numQueries-1);
+            valid[j] = i+j < numQueries ? -1 : 0;
+            query4.x[j] = query[k].x; query4.y[j] = query[k].y; query4.z[j] = query[k].z;
+            query4.time[j] = query[k].time; query4.radius[j] = query[k].radius;
+            userPtr4[j] = userPtr[k];
+          }
+          rtcPointQuery4(valid, scene, &query4, &context, benchmarkClosestPointFunc, userPtr4);
+          for (size_t j=0; j<4 && i+j<numQueries; j++)
+            query[i+j].radius = query4.radius[j];
+        }
+      };
+
+      auto stream = [&] (avector<RTCPointQuery>& query) {
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        rtcPointQuery1M(scene, query.data(), (unsigned int)numQueries, sizeof(RTCPointQuery), &context, benchmarkClosestPointFunc, userPtr.data());
+      };
+
+      /* measures the best of a few runs and compares the distances against the single query API */
+      auto measure = [&] (const char* name, const std::function<void(avector<RTCPointQuery>&)>& run, bool setReference)
+      {
+        double dt = inf;
+        size_t numErrors = 0;
+        for (size_t r=0; r<3; r++)
+        {
+          avector<RTCPointQuery> query = queries;
+          const double t0 = getSeconds();
+          run(query);
+          dt = min(dt,getSeconds()-t0);
+          for (size_t i=0; i<numQueries; i++) {
+            if (setReference) reference[i] = query[i].radius;
+            numErrors += query[i].radius != reference[i];
+          }
+        }
+        std::cout << "  " << std::setw(8) << name << ": " << std::fixed << std::setprecision(3)
+                  << double(numQueries)*1E-6/dt << " Mqueries/s";
+        if (numErrors) std::cout << " (" << numErrors << " mismatches)";
+        std::cout << std::endl;
+      };
+
+      measure("single",single,true);
+      measure("packet4",packet4,false);
+      measure("stream",stream,false);
+
+      rtcReleaseScene(scene);
+      g_benchmark_mesh = nullptr;
+    }
+
+    int main(int argc, char** argv) override try
+    {
+      /* parse command line options */
+      parseCommandLine(argc,argv);
+
+      /* callback */
+      postParseCommandLine();
+
+      /* create device */
+      g_device = rtcNewDevice(rtcore.c_str());
+      error_handler(nullptr,rtcGetDeviceError(g_device));
+
+      /* set error handler */
+      rtcSetDeviceErrorFunction(g_device,error_handler,nullptr);
+
+      /* run point query benchmark or start tutorial */
+      if (benchmarkPointQueries) benchmark();
+      else run(argc,argv);
+      return 0;
+    }
+    catch (const std::exception& e) {
+      std::cout << "Error: " << e.what() << std::endl;
+      return 1;
+    }
+    catch (...) {
+      std::cout << "Error: unknown exception caught." << std::endl;
+      return 1;
+    }
+
+    size_t benchmarkPointQueries;
   };
 
 }
@@ -315,6 +315,23 @@ collide2::CollisionConstraint * makeCollisionConstraint (RTCScene scene, unsigne
   return c;
 }
 
+void addClothConstraints (RTCScene scene, collide2::ClothModel & cloth, unsigned clothPrimID, unsigned cGeomID, unsigned cPrimID)
+{
+  // push back cloth vertex constraints if not fixed
+  if (cloth.m_inv_[cloth.tris_[clothPrimID].v0] != 0) {
+    auto c = makeCollisionConstraint (scene, cloth.tris_[clothPrimID].v0, cGeomID, cPrimID);
+    cloth.c_constraints_.push_back (c);
+  }
+  if (cloth.m_inv_[cloth.tris_[clothPrimID].v1] != 0) {
+    auto c = makeCollisionConstraint (scene, cloth.tris_[clothPrimID].v1, cGeomID, cPrimID);
+    cloth.c_constraints_.push_back (c);
+  }
+  if (cloth.m_inv_[cloth.tris_[clothPrimID].v2] != 0) {
+    auto c = makeCollisionConstraint (scene, cloth.tris_[clothPrimID].v2, cGeomID, cPrimID);
+    cloth.c_constraints_.push_back (c);
+  }
+}
+
 void addCollisionConstraints (RTCScene scene)
 {
   auto & cloth = (collide2::ClothModel &) (*meshes[clothID]);
@@ -327,21 +344,9 @@ void addCollisionConstraints (RTCScene scene)
     // throw out self collisions for now
     if (clothID == c0.first && clothID == c1.first) continue;
 
-    // push back cloth vertex constraints if not fixed
-    if (clothID == c1.first) {
-      if (cloth.m_inv_[cloth.tris_[c1.second].v0] != 0) {
-        auto c = makeCollisionConstraint (scene, cloth.tris_[c1.second].v0, c0.first, c0.second);
-        cloth.c_constraints_.push_back (c);
-      }
-      if (cloth.m_inv_[cloth.tris_[c1.second].v1] != 0) {
-        auto c = makeCollisionConstraint (scene, cloth.tris_[c1.second].v1, c0.first, c0.second);
-        cloth.c_constraints_.push_back (c);
-      }
-      if (cloth.m_inv_[cloth.tris_[c1.second].v2] != 0) {
-        auto c = makeCollisionConstraint (scene, cloth.tris_[c1.second].v2, c0.first, c0.second);
-        cloth.c_constraints_.push_back (c);
-      }
-    }
+    // rtcCollide(scene,scene) reports each colliding pair only once, thus the cloth may be on either side
+    if (clothID == c1.first) addClothConstraints (scene, cloth, c1.second, c0.first, c0.second);
+    if (clothID == c0.first) addClothConstraints (scene, cloth, c0.second, c1.first, c1.second);
   }
 }
 
@@ -20,7 +20,7 @@
 
 namespace embree
 {
-  Vec3fa closestPointTriangle(Vec3fa const& p, Vec3fa const& a, Vec3fa const& b, Vec3fa const& c)
+  inline Vec3fa closestPointTriangle(Vec3fa const& p, Vec3fa const& a, Vec3fa const& b, Vec3fa const& c)
   {
     const Vec3fa ab = b - a;
     const Vec3fa ac = c - a;
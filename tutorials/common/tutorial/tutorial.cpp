@@ -300,6 +300,11 @@ namespace embree
         g_iflags_coherent   = iflags_coherent   = RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
         g_iflags_incoherent = iflags_incoherent = RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
       }, "--incoherent: force using RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT hint when tracing rays");
+
+    registerOption("reorder", [this] (Ref<ParseStream> cin, const FileName& path) {
+        g_iflags_coherent   = iflags_coherent   = RTC_INTERSECT_CONTEXT_FLAG_REORDER;
+        g_iflags_incoherent = iflags_incoherent = RTC_INTERSECT_CONTEXT_FLAG_REORDER;
+      }, "--reorder: force tracing rays incoherently and using RTC_INTERSECT_CONTEXT_FLAG_REORDER hint to sort ray streams");
   }
 
   TutorialApplication::~TutorialApplication()
@@ -0,0 +1,169 @@
+// ======================================================================== //
+// Copyright 2009-2020 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+/* micro benchmark for the parallel radix sort, compares against a
+ * plain parallel LSD radix sort without digit skipping and write
+ * combining, and against std::sort */
+
+#include "../../common/algorithms/parallel_sort.h"
+#include "../../common/sys/sysinfo.h"
+#include "../../common/sys/alloc.h"
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <iomanip>
+
+namespace embree
+{
+  /* reference radix sort that performs one count and one scatter pass per digit */
+  template<typename Ty, typename Key>
+    void reference_radix_sort(Ty* const src, Ty* const tmp, const size_t N, const size_t blockSize = 8192)
+  {
+    static const size_t MAX_TASKS = 64;
+    static const size_t BITS = 8;
+    static const size_t BUCKETS = (1 << BITS);
+
+    if (N <= blockSize) {
+      std::sort(src,src+N,[] (const Ty& a, const Ty& b) { return (Key)a < (Key)b; });
+      return;
+    }
+
+    const size_t numTasks = min((N+blockSize-1)/blockSize,TaskScheduler::threadCount(),MAX_TASKS);
+    std::vector<std::vector<unsigned int>> radixCount(numTasks,std::vector<unsigned int>(BUCKETS));
+
+    Ty* in = src;
+    Ty* out = tmp;
+    for (size_t shift=0; shift<8*sizeof(Key); shift+=BITS)
+    {
+      parallel_for(numTasks,[&] (size_t t) {
+          std::fill(radixCount[t].begin(),radixCount[t].end(),0);
+          for (size_t i=t*N/numTasks; i<(t+1)*N/numTasks; i++)
+            radixCount[t][((size_t)(Key)in[i] >> shift) & (BUCKETS-1)]++;
+        });
+
+      parallel_for(numTasks,[&] (size_t t) {
+          unsigned int offset[BUCKETS];
+          unsigned int sum = 0;
+          for (size_t b=0; b<BUCKETS; b++) {
+            offset[b] = sum;
+            for (size_t j=0; j<numTasks; j++) sum += radixCount[j][b];
+            for (size_t j=0; j<t; j++) offset[b] += radixCount[j][b];
+          }
+          for (size_t i=t*N/numTasks; i<(t+1)*N/numTasks; i++)
+            out[offset[((size_t)(Key)in[i] >> shift) & (BUCKETS-1)]++] = in[i];
+        });
+      std::swap(in,out);
+    }
+  }
+
+  /* morton code with primitive ID as used by the morton builders */
+  struct KeyValue64
+  {
+    uint64_t key;
+    unsigned int value;
+    __forceinline operator uint64_t() const { return key; }
+  };
+
+  template<typename Ty, typename Key, typename Sort>
+    double measure(const std::vector<Ty>& input, const size_t numRuns, const Sort& sort)
+  {
+    const size_t N = input.size();
+    std::vector<Ty> src(N), tmp(N);
+    double best = inf;
+    for (size_t run=0; run<numRuns; run++)
+    {
+      std::copy(input.begin(),input.end(),src.begin());
+      const double t0 = getSeconds();
+      sort(src.data(),tmp.data(),N);
+      const double t1 = getSeconds();
+      best = min(best,t1-t0);
+
+      for (size_t i=1; i<N; i++) {
+        if ((Key)src[i-1] > (Key)src[i])
+          throw std::runtime_error("sort failed");
+      }
+    }
+    return double(N)*1E-6/best;
+  }
+
+  template<typename Ty, typename Key>
+    void benchmark(const std::string& name, const std::vector<Ty>& input, const size_t numRuns)
+  {
+    const double mref = measure<Ty,Key>(input,numRuns,[] (Ty* src, Ty* tmp, size_t N) { reference_radix_sort<Ty,Key>(src,tmp,N); });
+    const double mnew = measure<Ty,Key>(input,numRuns,[] (Ty* src, Ty* tmp, size_t N) { radix_sort<Ty,Key>(src,tmp,N); });
+    const double mstd = measure<Ty,Key>(input,numRuns,[] (Ty* src, Ty* tmp, size_t N) {
+        std::sort(src,src+N,[] (const Ty& a, const Ty& b) { return (Key)a < (Key)b; });
+      });
+
+    std::cout << std::setw(12) << name
+              << std::fixed << std::setprecision(1)
+              << "  reference = " << std::setw(7) << mref << " Mkeys/s"
+              << "  radix_sort = " << std::setw(7) << mnew << " Mkeys/s"
+              << "  std::sort = " << std::setw(7) << mstd << " Mkeys/s"
+              << "  speedup = " << std::setprecision(2) << mnew/mref << "x" << std::endl;
+  }
+
+  int main(int argc, char** argv)
+  {
+    size_t N = 10000000;
+    size_t numThreads = 0;
+    size_t numRuns = 5;
+    for (int i=1; i<argc; i++)
+    {
+      const std::string tag = argv[i];
+      if      (tag == "-n"       && i+1<argc) N = atol(argv[++i]);
+      else if (tag == "-threads" && i+1<argc) numThreads = atol(argv[++i]);
+      else if (tag == "-runs"    && i+1<argc) numRuns = atol(argv[++i]);
+      else {
+        std::cout << "usage: sortbench [-n items] [-threads threads] [-runs runs]" << std::endl;
+        return 1;
+      }
+    }
+
+    if (numThreads == 0) numThreads = getNumberOfLogicalThreads();
+    TaskScheduler::create(numThreads,false,true);
+    std::cout << "sorting " << N << " items using " << TaskScheduler::threadCount() << " threads" << std::endl;
+
+    std::vector<uint32_t> keys32(N);
+    std::vector<uint64_t> keys64(N);
+    std::vector<KeyValue64> morton(N);
+    for (size_t i=0; i<N; i++) {
+      keys32[i] = uint32_t(rand())*uint32_t(rand());
+      keys64[i] = uint64_t(rand())*uint64_t(rand())*uint64_t(rand());
+      morton[i].key = keys64[i] >> 1; // 63 bit morton codes
+      morton[i].value = unsigned(i);
+    }
+
+    benchmark<uint32_t,uint32_t>("u32",keys32,numRuns);
+    benchmark<uint64_t,uint64_t>("u64",keys64,numRuns);
+    benchmark<KeyValue64,uint64_t>("u64+payload",morton,numRuns);
+
+    TaskScheduler::destroy();
+    return 0;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  try {
+    return embree::main(argc, argv);
+  }
+  catch (const std::exception& e) {
+    std::cout << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
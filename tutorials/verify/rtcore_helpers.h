@@ -559,6 +559,7 @@ namespace embree
     VARIANT_OCCLUDED = 2,
     VARIANT_COHERENT = 0,
     VARIANT_INCOHERENT = 4,
+    VARIANT_REORDER = 8,
     VARIANT_INTERSECT_OCCLUDED_MASK = 3,
     VARIANT_COHERENT_INCOHERENT_MASK = 4,
     
@@ -569,6 +570,7 @@ namespace embree
     VARIANT_INTERSECT_OCCLUDED = 3,
     VARIANT_INTERSECT_OCCLUDED_COHERENT = 3, // intersect but verify if occluded also finds hit or not
     VARIANT_INTERSECT_OCCLUDED_INCOHERENT = 7, // intersect but verify if occluded also finds hit or not
+    VARIANT_INTERSECT_REORDER = 13, // intersect incoherent rays with ray stream reordering
   };
 
   inline std::string to_string(IntersectVariant ivariant)
@@ -580,6 +582,7 @@ namespace embree
     case VARIANT_OCCLUDED_INCOHERENT : return "OccludedIncoherent";
     case VARIANT_INTERSECT_OCCLUDED_COHERENT: return "IntersectOccludedCoherent";
     case VARIANT_INTERSECT_OCCLUDED_INCOHERENT : return "IntersectOccludedIncoherent";
+    case VARIANT_INTERSECT_REORDER : return "IntersectReorder";
     default: assert(false);
     }
     return "";
@@ -771,6 +774,7 @@ namespace embree
       context = &_context;
     }
     context->flags = ((ivariant & VARIANT_COHERENT_INCOHERENT_MASK) == VARIANT_COHERENT) ? RTC_INTERSECT_CONTEXT_FLAG_COHERENT :  RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
+    context->flags = (RTCIntersectContextFlags) (context->flags | ((ivariant & VARIANT_REORDER) ? RTC_INTERSECT_CONTEXT_FLAG_REORDER : RTC_INTERSECT_CONTEXT_FLAG_NONE));
 
     switch (mode) 
     {
@@ -24,8 +24,10 @@
 #include "../../kernels/common/context.h"
 #include "../../kernels/common/geometry.h"
 #include "../../kernels/common/scene.h"
+#include "../../kernels/geometry/triangle_triangle_intersector.h"
 #include <regex>
 #include <stack>
+#include <set>
 
 #if defined(__APPLE__)
 #include "TargetConditionals.h"
@@ -100,6 +102,13 @@ namespace embree
       throw std::runtime_error("Error "+string_of(expectedError)+" expected");
   }
 
+  /* memory monitor function that sums up the bytes in the std::atomic<ssize_t> passed as user pointer */
+  bool monitorMemory(void* userPtr, ssize_t bytes, bool post)
+  {
+    *(std::atomic<ssize_t>*)userPtr += bytes;
+    return true;
+  }
+
   typedef SceneGraph::TriangleMeshNode::Triangle Triangle;
 
   void addRandomSubdivFeatures(RandomSampler& sampler, Ref<SceneGraph::SubdivMeshNode> mesh, size_t numEdgeCreases, size_t numVertexCreases, size_t numHoles)
@@ -1226,6 +1235,529 @@ namespace embree
     }
   };
 
+  /* traces rays from a distance of 4 towards the center of a sphere of radius 1 and returns the number of rays not hitting it */
+  size_t checkSphereHits(RandomSampler& sampler, RTCScene scene, unsigned int geomID, size_t numRays = 1000, const Vec3fa& center = zero, IntersectMode mode = MODE_INTERSECT1)
+  {
+    size_t numFailures = 0;
+    for (size_t i=0; i<numRays; i++)
+    {
+      const Vec3fa dir = normalize(RandomSampler_get3D(sampler)-Vec3fa(0.5f));
+      RTCRayHit ray = makeRay(center+4.0f*dir,-4.0f*dir);
+      IntersectWithMode(mode,VARIANT_INTERSECT,scene,&ray,1);
+      numFailures += ray.hit.geomID != geomID || std::abs(ray.ray.tfar-0.75f) > 0.01f;
+    }
+    return numFailures;
+  }
+
+  struct HugePageBVHTest : public VerifyApplication::Test
+  {
+    HugePageBVHTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",hugepages_bvh=1";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      std::atomic<ssize_t> bytesUsed(0);
+      rtcSetDeviceMemoryMonitorFunction(device,monitorMemory,&bytesUsed);
+
+      /* large enough that the BVH gets allocated in 2MB blocks */
+      size_t numFailures = 0;
+      size_t hugePageBytes = 0;
+      {
+        VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+        unsigned geomID = scene.addSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,zero,1.0f,200).first;
+        rtcCommitScene (scene);
+        AssertNoError(device);
+        numFailures += checkSphereHits(sampler,scene,geomID);
+
+        /* explicit huge pages are only available when the system reserved some */
+        hugePageBytes = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_HUGE_PAGE_BVH_BYTES);
+        numFailures += hugePageBytes > size_t(bytesUsed);
+      }
+      AssertNoError(device);
+
+      /* all memory has to get returned when releasing the scene */
+      const size_t hugePageBytesLeaked = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_HUGE_PAGE_BVH_BYTES);
+      if (!silent) { printf(" (%zu failures, %zu bytes on huge pages, %zd bytes leaked)", numFailures, hugePageBytes, ssize_t(bytesUsed)); fflush(stdout); }
+      return (VerifyApplication::TestReturnValue)(numFailures == 0 && bytesUsed == 0 && hugePageBytesLeaked == 0);
+    }
+  };
+
+  struct NumaReplicationTest : public VerifyApplication::Test
+  {
+    NumaReplicationTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    /* builds a static scene of instanced spheres and traces the same rays with different modes through it */
+    static ssize_t traceInstances(const RTCDeviceRef& device, RandomSampler& sampler, std::atomic<ssize_t>& bytesUsed, std::vector<RTCRayHit>& hits)
+    {
+      VerifyScene object(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      object.addSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,zero,0.4f,10);
+      rtcCommitScene (object);
+
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      for (size_t i=0; i<64; i++)
+      {
+        const AffineSpace3fa xfm = AffineSpace3fa::translate(Vec3fa(float(i%8)-3.5f,0.0f,float(i/8)-3.5f));
+        RTCGeometry inst = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(inst,object);
+        rtcSetGeometryTransform(inst,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,(float*)&xfm);
+        rtcCommitGeometry(inst);
+        rtcAttachGeometry(scene,inst);
+        rtcReleaseGeometry(inst);
+      }
+      const ssize_t bytesBefore = bytesUsed;
+      rtcCommitScene (scene);
+      AssertNoError(device);
+      const ssize_t bytesScene = bytesUsed - bytesBefore;
+
+      const IntersectMode modes[] = { MODE_INTERSECT1, MODE_INTERSECT4, MODE_INTERSECT1M };
+      const size_t numRays = 256;
+      for (IntersectMode mode : modes)
+      {
+        RandomSampler_init(sampler,0);
+        avector<RTCRayHit> rays(numRays);
+        for (size_t i=0; i<numRays; i++) {
+          const Vec3fa org = 10.0f*RandomSampler_get3D(sampler)-Vec3fa(5.0f,-1.0f,5.0f);
+          const Vec3fa dir = RandomSampler_get3D(sampler)-Vec3fa(0.5f,1.0f,0.5f);
+          rays[i] = makeRay(org,dir);
+        }
+        IntersectWithMode(mode,VARIANT_INTERSECT,scene,rays.data(),unsigned(numRays));
+        hits.insert(hits.end(),rays.begin(),rays.end());
+      }
+      AssertNoError(device);
+      return bytesScene;
+    }
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      /* single threaded builds allocate the same BVH memory on both devices */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",threads=1";
+
+      /* a negative number of replicas is invalid */
+      RTCDevice invalid_device = rtcNewDevice((cfg+",numa_replicate_bvh=1,numa_replicas=-1").c_str());
+      if (invalid_device != nullptr || rtcGetDeviceError(nullptr) != RTC_ERROR_INVALID_ARGUMENT) {
+        if (invalid_device) rtcReleaseDevice(invalid_device);
+        return VerifyApplication::FAILED;
+      }
+
+      RTCDeviceRef device0 = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",numa_replicate_bvh=1,numa_replicas=2").c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+      std::atomic<ssize_t> bytesUsed0(0), bytesUsed1(0);
+      rtcSetDeviceMemoryMonitorFunction(device0,monitorMemory,&bytesUsed0);
+      rtcSetDeviceMemoryMonitorFunction(device1,monitorMemory,&bytesUsed1);
+
+      std::vector<RTCRayHit> hits0, hits1;
+      RandomSampler_init(sampler,0);
+      const ssize_t bytesScene0 = traceInstances(device0,sampler,bytesUsed0,hits0);
+      RandomSampler_init(sampler,0);
+      const ssize_t bytesScene1 = traceInstances(device1,sampler,bytesUsed1,hits1);
+
+      /* traversing the replicated nodes has to find the same hits */
+      size_t numFailures = 0;
+      for (size_t i=0; i<hits0.size(); i++)
+      {
+        numFailures += hits0[i].hit.geomID != hits1[i].hit.geomID;
+        numFailures += hits0[i].hit.instID[0] != hits1[i].hit.instID[0];
+        numFailures += hits0[i].ray.tfar != hits1[i].ray.tfar;
+      }
+
+      /* the replicas need additional memory, which has to get returned when releasing the scene */
+      const bool replicated = bytesScene1 > bytesScene0;
+      if (!silent) { printf(" (%zu failures, %zd bytes leaked)", numFailures, ssize_t(bytesUsed1)); fflush(stdout); }
+      return (VerifyApplication::TestReturnValue)(numFailures == 0 && replicated && bytesUsed0 == 0 && bytesUsed1 == 0);
+    }
+  };
+
+  struct BuildConfigTest : public VerifyApplication::Test
+  {
+    std::string config;
+    RTCBuildQuality quality;
+
+    BuildConfigTest (std::string name, int isa, std::string config, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), config(config), quality(quality) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+","+config;
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* build a scene with the builder selected by the device configuration */
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,quality));
+      unsigned geomID = scene.addSphere(sampler,quality,zero,1.0f,200).first;
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      const size_t numFailures = checkSphereHits(sampler,scene,geomID);
+      AssertNoError(device);
+
+      if (!silent) { printf(" (%zu failures)", numFailures); fflush(stdout); }
+      return (VerifyApplication::TestReturnValue)(numFailures == 0);
+    }
+  };
+
+  struct ThreadArenaTest : public VerifyApplication::Test
+  {
+    ThreadArenaTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    struct CommitJob
+    {
+      std::vector<RTCScene> scenes;
+      BarrierSys* barrier;
+    };
+
+    static void commitScenes(CommitJob* job)
+    {
+      job->barrier->wait();
+      for (size_t i=0; i<job->scenes.size(); i++)
+        rtcCommitScene(job->scenes[i]);
+    }
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      /* two devices with thread arenas of different size */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",thread_arena=1";
+      std::string cfg0 = cfg + ",threads=2";
+      std::string cfg1 = cfg + ",threads=4";
+      RTCDeviceRef device0 = rtcNewDevice(cfg0.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+      RTCDeviceRef device1 = rtcNewDevice(cfg1.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+
+      const size_t numScenes = 4;
+      std::vector<std::unique_ptr<VerifyScene>> scenes;
+      CommitJob jobs[2];
+      BarrierSys barrier(3);
+      for (size_t i=0; i<2*numScenes; i++)
+      {
+        const RTCDeviceRef& device = i < numScenes ? device0 : device1;
+        RTCBuildQuality quality = i%2 ? RTC_BUILD_QUALITY_LOW : RTC_BUILD_QUALITY_MEDIUM;
+        scenes.push_back(std::unique_ptr<VerifyScene>(new VerifyScene(device,SceneFlags(RTC_SCENE_FLAG_NONE,quality))));
+        scenes.back()->addSphere(sampler,quality,zero,1.0f,200);
+        jobs[i/numScenes].scenes.push_back(*scenes.back());
+        jobs[i/numScenes].barrier = &barrier;
+      }
+
+      /* commit the scenes of both devices at the same time */
+      thread_t thread0 = createThread((thread_func)commitScenes,&jobs[0]);
+      thread_t thread1 = createThread((thread_func)commitScenes,&jobs[1]);
+      barrier.wait();
+      join(thread0);
+      join(thread1);
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      size_t numFailures = 0;
+      for (size_t j=0; j<scenes.size(); j++)
+        numFailures += checkSphereHits(sampler,*scenes[j],0);
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      if (!silent) { printf(" (%zu failures)", numFailures); fflush(stdout); }
+      return (VerifyApplication::TestReturnValue)(numFailures == 0);
+    }
+  };
+
+  struct WorkStealingStatisticsTest : public VerifyApplication::Test
+  {
+    WorkStealingStatisticsTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    struct JoinCommitJob
+    {
+      RTCScene scene;
+      BarrierSys* barrier;
+    };
+
+    static void joinCommit(JoinCommitJob* job)
+    {
+      job->barrier->wait();
+      rtcJoinCommitScene(job->scene);
+    }
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* only the internal tasking system collects work stealing statistics */
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TASKING_SYSTEM) != 0)
+        return VerifyApplication::SKIPPED;
+
+      const size_t steals0 = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TASK_STEAL_COUNT);
+      const size_t failedSteals0 = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TASK_FAILED_STEAL_COUNT);
+      const size_t yields0 = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TASK_YIELD_COUNT);
+      AssertNoError(device);
+
+      /* threads joining the build have to steal tasks or at least try to, even without worker threads,
+       * the scheduler supports up to twice the number of logical threads including its worker threads */
+      const size_t numThreads = getNumberOfLogicalThreads()+1;
+      size_t numFailures = 0;
+      for (size_t i=0; i<4; i++)
+      {
+        VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+        unsigned geomID = scene.addSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,zero,1.0f,500).first;
+
+        BarrierSys barrier(numThreads);
+        JoinCommitJob job = { scene, &barrier };
+        std::vector<thread_t> threads;
+        for (size_t t=0; t<numThreads; t++)
+          threads.push_back(createThread((thread_func)joinCommit,&job));
+        for (size_t t=0; t<numThreads; t++)
+          join(threads[t]);
+        AssertNoError(device);
+        numFailures += checkSphereHits(sampler,scene,geomID);
+      }
+
+      const size_t steals1 = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TASK_STEAL_COUNT);
+      const size_t failedSteals1 = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TASK_FAILED_STEAL_COUNT);
+      const size_t yields1 = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TASK_YIELD_COUNT);
+      AssertNoError(device);
+
+      if (!silent) { printf(" (%zu steals, %zu failed steals, %zu yields)", steals1-steals0, failedSteals1-failedSteals0, yields1-yields0); fflush(stdout); }
+      const bool counted = steals1 >= steals0 && failedSteals1 >= failedSteals0 && yields1 >= yields0 && steals1+failedSteals1 > steals0+failedSteals0;
+      return (VerifyApplication::TestReturnValue)(numFailures == 0 && counted);
+    }
+  };
+
+  struct RefitRebuildTest : public VerifyApplication::Test
+  {
+    std::string config;
+    bool expectRebuild;
+
+    RefitRebuildTest (std::string name, int isa, std::string config, bool expectRebuild)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), config(config), expectRebuild(expectRebuild) {}
+
+    static void shuffle_vertices(RTCGeometry geom, Vec3fa* vertices, size_t numVertices)
+    {
+      Vec3fa* dst = (Vec3fa*) rtcGetGeometryBufferData(geom,RTC_BUFFER_TYPE_VERTEX,0);
+      for (size_t i=0; i<numVertices; i++)
+        dst[i] = vertices[(i*7919) % numVertices];
+      rtcUpdateGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0);
+      rtcCommitGeometry(geom);
+    }
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+","+config;
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      const size_t numPhi = 200;
+      const size_t numVertices = 2*numPhi*(numPhi+1);
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW));
+      unsigned geomID = scene.addSphere(sampler,RTC_BUILD_QUALITY_REFIT,zero,1.0f,numPhi).first;
+      RTCGeometry geom = rtcGetGeometry(scene,geomID);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      /* scrambling the vertices degrades the refitted BVH, restoring them degrades it again */
+      Vec3fa* vertices = (Vec3fa*) rtcGetGeometryBufferData(geom,RTC_BUFFER_TYPE_VERTEX,0);
+      std::vector<Vec3fa> original(vertices,vertices+numVertices);
+      shuffle_vertices(geom,original.data(),numVertices);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+      std::copy(original.begin(),original.end(),vertices);
+      rtcUpdateGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0);
+      rtcCommitGeometry(geom);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      const size_t numRebuilds = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_REFIT_REBUILD_COUNT);
+      AssertNoError(device);
+      if (!silent) { printf(" (%zu rebuilds)", numRebuilds); fflush(stdout); }
+      if ((numRebuilds != 0) != expectRebuild)
+        return VerifyApplication::FAILED;
+
+      const size_t numFailures = checkSphereHits(sampler,scene,geomID);
+      AssertNoError(device);
+
+      if (!silent) { printf(" (%zu failures)", numFailures); fflush(stdout); }
+      return (VerifyApplication::TestReturnValue)(numFailures == 0);
+    }
+  };
+
+  struct AsyncCommitTest : public VerifyApplication::Test
+  {
+    RTCBuildQuality quality;
+
+    AsyncCommitTest (std::string name, int isa, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), quality(quality) {}
+
+    static void commitComplete(void* userPtr, RTCScene scene) {
+      (*(std::atomic<size_t>*)userPtr)++;
+    }
+
+    struct CallbackState
+    {
+      CallbackState (RTCDevice device)
+        : device(device), numCompleted(0), numErrors(0), built(false), released(false), done(false) {}
+
+      RTCDevice device;
+      std::atomic<size_t> numCompleted;
+      std::atomic<size_t> numErrors;
+      std::atomic<bool> built;
+      std::atomic<bool> released;
+      std::atomic<bool> done;
+    };
+
+    /* waits for the commit from within its own callback and commits the scene again */
+    static void commitAgain(void* userPtr, RTCScene scene)
+    {
+      CallbackState* state = (CallbackState*) userPtr;
+      rtcWaitCommitScene(scene);
+      if (++state->numCompleted < 3) rtcCommitSceneAsync(scene,commitAgain,userPtr);
+      state->numErrors += rtcGetDeviceError(state->device) != RTC_ERROR_NONE;
+    }
+
+    /* releases the last reference to the scene from within the callback */
+    static void releaseScene(void* userPtr, RTCScene scene)
+    {
+      CallbackState* state = (CallbackState*) userPtr;
+      state->built = true;
+      while (!state->released) yield();
+      rtcReleaseScene(scene);
+      state->numErrors += rtcGetDeviceError(state->device) != RTC_ERROR_NONE;
+      state->done = true;
+    }
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      const size_t numPhi = 50;
+      const size_t numVertices = 2*numPhi*(numPhi+1);
+      const Vec3fa pos0(0,0,0), pos1(0,0,-10), pos2(10,0,0);
+      const RTCBuildQuality squality = quality == RTC_BUILD_QUALITY_REFIT ? RTC_BUILD_QUALITY_LOW : quality;
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,squality));
+      unsigned geom0 = scene.addSphere(sampler,quality,pos0,1.0f,numPhi).first;
+      unsigned geom1 = scene.addQuadSphere(sampler,quality,pos1,1.0f,numPhi).first;
+      AssertNoError(device);
+
+      /* first commit has to behave like a blocking commit once waited for */
+      std::atomic<size_t> numCompleted(0);
+      rtcCommitSceneAsync(scene,commitComplete,&numCompleted);
+      rtcWaitCommitScene(scene);
+      AssertNoError(device);
+      size_t numFailures = checkSphereHits(sampler,scene,geom0,100,pos0) + checkSphereHits(sampler,scene,geom1,100,pos1);
+
+      /* move the first sphere and trace the unmodified sphere while the commit runs */
+      Vec3fa* vertices = (Vec3fa*) rtcGetGeometryBufferData(rtcGetGeometry(scene,geom0),RTC_BUFFER_TYPE_VERTEX,0);
+      for (size_t i=0; i<numVertices; i++)
+        vertices[i] += pos2-pos0;
+      rtcUpdateGeometryBuffer(rtcGetGeometry(scene,geom0),RTC_BUFFER_TYPE_VERTEX,0);
+      rtcCommitGeometry(rtcGetGeometry(scene,geom0));
+      rtcCommitSceneAsync(scene,commitComplete,&numCompleted);
+      while (numCompleted < 2)
+        numFailures += checkSphereHits(sampler,scene,geom1,10,pos1);
+      rtcWaitCommitScene(scene);
+      AssertNoError(device);
+
+      /* queries and the scene bounds have to see the moved sphere after the commit completed */
+      numFailures += checkSphereHits(sampler,scene,geom0,100,pos2) + checkSphereHits(sampler,scene,geom1,100,pos1);
+      numFailures += checkSphereHits(sampler,scene,geom0,100,pos2,MODE_INTERSECT4) + checkSphereHits(sampler,scene,geom1,100,pos1,MODE_INTERSECT16);
+      RTCBounds bounds; rtcGetSceneBounds(scene,&bounds);
+      numFailures += bounds.upper_x < pos2.x+0.9f;
+      RTCRayHit ray = makeRay(pos0+Vec3fa(0,4,0),Vec3fa(0,-4,0));
+      IntersectWithMode(MODE_INTERSECT1,VARIANT_INTERSECT,scene,&ray,1);
+      numFailures += ray.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+
+      /* blocking commits keep working on asynchronously committed scenes */
+      rtcDetachGeometry(scene,geom1);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+      numFailures += checkSphereHits(sampler,scene,geom0,100,pos2);
+      ray = makeRay(pos1+Vec3fa(0,4,0),Vec3fa(0,-4,0));
+      IntersectWithMode(MODE_INTERSECT1,VARIANT_INTERSECT,scene,&ray,1);
+      numFailures += ray.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+
+      /* the completion callback can wait for the commit and start the next one */
+      CallbackState recommit(device);
+      rtcCommitSceneAsync(scene,commitAgain,&recommit);
+      while (recommit.numCompleted < 3) yield();
+      rtcWaitCommitScene(scene);
+      AssertNoError(device);
+      numFailures += checkSphereHits(sampler,scene,geom0,100,pos2) + recommit.numErrors;
+
+      /* the completion callback can release the last reference to the scene */
+      CallbackState release(device);
+      {
+        VerifyScene scene2(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+        scene2.addSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,pos0,1.0f,numPhi);
+        rtcRetainScene(scene2);
+        rtcCommitSceneAsync(scene2,releaseScene,&release);
+        while (!release.built) yield();
+      }
+      release.released = true;
+      while (!release.done) yield();
+      AssertNoError(device);
+      numFailures += release.numErrors;
+
+      if (!silent) { printf(" (%zu failures)", numFailures); fflush(stdout); }
+      return (VerifyApplication::TestReturnValue)(numFailures == 0 && numCompleted == 2);
+    }
+  };
+
+  struct BuildCancelTest : public VerifyApplication::Test
+  {
+    BuildCancelTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    static bool cancelProgress(void* userPtr, double n) {
+      (*(std::atomic<size_t>*)userPtr)++;
+      return false;
+    }
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      std::atomic<ssize_t> bytesUsed(0);
+      rtcSetDeviceMemoryMonitorFunction(device,monitorMemory,&bytesUsed);
+
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      scene.addSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,zero,1.0f,200);
+      AssertNoError(device);
+      const ssize_t bytesGeometry = bytesUsed;
+
+      /* cancel the build in the first progress monitor invokation */
+      std::atomic<size_t> numProgress(0);
+      rtcSetSceneProgressMonitorFunction(scene,cancelProgress,&numProgress);
+      rtcCommitScene (scene);
+      AssertError(device,RTC_ERROR_CANCELLED);
+
+      /* all memory of the cancelled build has to get released */
+      const ssize_t bytesLeaked = bytesUsed-bytesGeometry;
+
+      /* scene has to build properly afterwards */
+      rtcSetSceneProgressMonitorFunction(scene,nullptr,nullptr);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      size_t numFailures = 0;
+      for (size_t i=0; i<100; i++)
+      {
+        const Vec3fa org = 4.0f*normalize(random_Vec3fa()-Vec3fa(0.5f));
+        RTCRayHit ray = makeRay(org,-org);
+        IntersectWithMode(MODE_INTERSECT1,VARIANT_INTERSECT,scene,&ray,1);
+        numFailures += ray.hit.geomID == RTC_INVALID_GEOMETRY_ID;
+      }
+
+      if (!silent) { printf(" (%zu progress calls, %zd bytes leaked)", size_t(numProgress), bytesLeaked); fflush(stdout); }
+      return (VerifyApplication::TestReturnValue)(numFailures == 0 && bytesLeaked == 0);
+    }
+  };
+
   struct OverlappingGeometryTest : public VerifyApplication::Test
   {
     SceneFlags sflags;
@@ -1802,6 +2334,64 @@ namespace embree
     }
   };
 
+  struct IncrementalTwoLevelTest : public VerifyApplication::Test
+  {
+    IncrementalTwoLevelTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* the dynamic scene updates its top-level BVH incrementally, the static scene gets rebuilt */
+      VerifyScene scene0(device,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW));
+      VerifyScene scene1(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      const size_t numPhi = 5;
+      const size_t numVertices = 2*numPhi*(numPhi+1);
+      std::vector<RTCGeometry> geometries;
+      for (size_t i=0; i<64; i++) {
+        const Vec3fa pos(float(i%8)-3.5f,0.0f,float(i/8)-3.5f);
+        const unsigned int geomID = scene0.addSphere(sampler,RTC_BUILD_QUALITY_LOW,pos,0.4f,numPhi).first;
+        geometries.push_back(rtcGetGeometry(scene0,geomID));
+        rtcAttachGeometryByID(scene1,geometries.back(),geomID);
+      }
+      AssertNoError(device);
+
+      size_t numFailures = 0;
+      for (size_t frame=0; frame<40; frame++) 
+      {
+        for (size_t i=0; i<3; i++) {
+          Vec3fa ds = 0.5f*random_Vec3fa()-Vec3fa(0.25f);
+          UpdateTest::move_mesh(geometries[random_int()%geometries.size()],numVertices,ds);
+        }
+        rtcCommitScene (scene0);
+        rtcCommitScene (scene1);
+        AssertNoError(device);
+
+        for (size_t i=0; i<100; i++)
+        {
+          Vec3fa org = 10.0f*random_Vec3fa()-Vec3fa(5.0f);
+          Vec3fa dir = 2.0f*random_Vec3fa()-Vec3fa(1.0f);
+          RTCRayHit ray0 = makeRay(org,dir);
+          RTCRayHit ray1 = ray0;
+          IntersectWithMode(MODE_INTERSECT1,VARIANT_INTERSECT,scene0,&ray0,1);
+          IntersectWithMode(MODE_INTERSECT1,VARIANT_INTERSECT,scene1,&ray1,1);
+          numFailures += ray0.hit.geomID != ray1.hit.geomID || std::abs(ray0.ray.tfar-ray1.ray.tfar) > 1E-4f*max(1.0f,std::abs(ray0.ray.tfar));
+        }
+      }
+      AssertNoError(device);
+
+      /* most commits of the dynamic scene have to update the top-level BVH incrementally */
+      const size_t numUpdates = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_INCREMENTAL_UPDATE_COUNT);
+      AssertNoError(device);
+
+      if (!silent) { printf(" (%zu failures, %zu incremental updates)", numFailures, numUpdates); fflush(stdout); }
+      return (VerifyApplication::TestReturnValue)(numFailures == 0 && numUpdates >= 20);
+    }
+  };
+
   struct GarbageGeometryTest : public VerifyApplication::Test
   {
     GarbageGeometryTest (std::string name, int isa)
@@ -2344,11 +2934,84 @@ namespace embree
     }
   };
 
-  /////////////////////////////////////////////////////////////////////////////////
-  /////////////////////////////////////////////////////////////////////////////////
-  /////////////////////////////////////////////////////////////////////////////////
-  /////////////////////////////////////////////////////////////////////////////////
-
+  struct AdaptiveTessellationCacheTest : public VerifyApplication::Test
+  {
+    AdaptiveTessellationCacheTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    static void displacementFunction(const RTCDisplacementFunctionNArguments* args)
+    {
+      for (unsigned int i=0; i<args->N; i++) {
+        const float d = 0.05f*sinf(10.0f*args->u[i])*sinf(10.0f*args->v[i]);
+        args->P_x[i] += d*args->Ng_x[i];
+        args->P_y[i] += d*args->Ng_y[i];
+        args->P_z[i] += d*args->Ng_z[i];
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* the bounds of the adaptive cache have to form a range */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      std::string invalid_cfg = cfg + ",tessellation_cache_adaptive=1,tessellation_cache_min_size=256,tessellation_cache_max_size=128";
+      RTCDevice invalid_device = rtcNewDevice(invalid_cfg.c_str());
+      if (invalid_device != nullptr || rtcGetDeviceError(nullptr) != RTC_ERROR_INVALID_ARGUMENT) {
+        if (invalid_device) rtcReleaseDevice(invalid_device);
+        return VerifyApplication::FAILED;
+      }
+
+      /* the cache is shared by all devices and sized for the largest one, thus use sizes above the default of 128 MB */
+      const size_t minSize = 160*1024*1024;
+      const size_t maxSize = 1024*1024*1024;
+      cfg += ",tessellation_cache_adaptive=1,tessellation_cache_size=512,tessellation_cache_min_size=160,tessellation_cache_max_size=1024";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      unsigned geomID = scene.addSubdivSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,zero,1.0f,10,4).first;
+      RTCGeometry geom = rtcGetGeometry(scene,geomID);
+      rtcSetGeometryDisplacementFunction(geom,displacementFunction);
+      rtcCommitGeometry(geom);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      const size_t initialSize = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE);
+      bool passed = initialSize >= minSize && initialSize <= maxSize;
+
+      /* each frame interpolates at the hit points and ends with a commit, the working set fits into a quarter of the cache, thus the cache has to shrink */
+      size_t size = initialSize;
+      ssize_t hitRate = 0;
+      size_t numMisses = 0;
+      for (size_t frame=0; frame<12; frame++)
+      {
+        for (size_t i=0; i<2048; i++)
+        {
+          const Vec3fa org = 4.0f*normalize(random_Vec3fa()-Vec3fa(0.5f));
+          RTCRayHit ray = makeRay(org,-org);
+          IntersectWithMode(MODE_INTERSECT1,VARIANT_INTERSECT,scene,&ray,1);
+          if (ray.hit.geomID != geomID) { numMisses++; continue; }
+          float P[3];
+          rtcInterpolate1(geom,ray.hit.primID,ray.hit.u,ray.hit.v,RTC_BUFFER_TYPE_VERTEX,0,P,nullptr,nullptr,3);
+        }
+        hitRate = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HIT_RATE);
+        passed &= hitRate > 0 && hitRate <= 1000;
+
+        rtcCommitScene (scene);
+        size = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE);
+        passed &= size >= minSize && size <= maxSize;
+      }
+      AssertNoError(device);
+
+      if (!silent) { printf(" (%zu MB -> %zu MB, hit rate = %3.1f%%)", initialSize/(1024*1024), size/(1024*1024), 0.1f*float(hitRate)); fflush(stdout); }
+      return (VerifyApplication::TestReturnValue) (passed && numMisses == 0 && size < initialSize);
+    }
+  };
+
+  /////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////////////////////////////////////////////////////////////
+
   struct TriangleHitTest : public VerifyApplication::IntersectTest
   {
     SceneFlags sflags; 
@@ -2908,6 +3571,238 @@ namespace embree
     }
   };
 
+  struct SparseRaysTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    static const size_t N = 10;
+    static const size_t maxStreamSize = 100;
+    
+    SparseRaysTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+   
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      Vec3fa pos = zero;
+      VerifyScene scene(device,sflags);
+      scene.addGeometry(quality,SceneGraph::createTriangleSphere(pos,2.0f,50));
+      scene.addGeometry(quality,SceneGraph::createTriangleSphere(pos+Vec3fa(1.0f,0.5f,0.0f),1.0f,20));
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      RTCRayHit invalid_ray; clearRay(invalid_ray);
+      invalid_ray.ray.tnear = pos_inf;
+      invalid_ray.ray.tfar  = 0.0f;
+
+      /* only few rays of each packet are active, which makes the packet
+       * traversal switch to single ray traversal, the result has to
+       * match single ray queries */
+      size_t numTests = 0;
+      size_t numFailures = 0;
+      for (size_t i=0; i<size_t(N*state->intensity); i++) 
+      {
+        for (unsigned int M=1; M<maxStreamSize; M++)
+        {
+          bool valid[maxStreamSize];
+          __aligned(16) RTCRayHit rays[maxStreamSize];
+          __aligned(16) RTCRayHit rays1[maxStreamSize];
+          unsigned int M1 = 0;
+          for (unsigned int j=0; j<M; j++) 
+          {
+            valid[j] = rand()%4 == 0;
+            if (valid[j]) {
+              Vec3fa org = 6.0f*random_Vec3fa()-Vec3fa(3.0f);
+              Vec3fa dir = 2.0f*random_Vec3fa()-Vec3fa(1.0f);
+              const float tnear = rand()%2 ? 0.0f : random_float();
+              const float tfar  = rand()%2 ? float(inf) : tnear+4.0f*random_float();
+              rays[j] = rays1[M1++] = makeRay(pos+org,dir,tnear,tfar);
+            } else {
+              rays[j] = invalid_ray;
+            }
+          }
+          IntersectWithMode(imode,ivariant,scene,rays,M);
+          IntersectWithMode(MODE_INTERSECT1,IntersectVariant(ivariant & VARIANT_INTERSECT_OCCLUDED_MASK),scene,rays1,M1);
+
+          for (unsigned int j=0, j1=0; j<M; j++)
+          {
+            if (!valid[j]) {
+              numFailures += neq_ray_special(rays[j],invalid_ray);
+              continue;
+            }
+            const RTCRayHit& ray0 = rays[j];
+            const RTCRayHit& ray1 = rays1[j1++];
+            numTests++;
+            if (ivariant & VARIANT_INTERSECT) {
+              bool failed = ray0.hit.geomID != ray1.hit.geomID;
+              failed |= std::abs(ray0.ray.tfar-ray1.ray.tfar) > 1E-4f*max(1.0f,std::abs(ray1.ray.tfar));
+              numFailures += failed;
+            } else {
+              numFailures += (ray0.ray.tfar == float(neg_inf)) != (ray1.ray.tfar == float(neg_inf));
+            }
+          }
+        }
+      }
+      AssertNoError(device);
+
+      double failRate = double(numFailures) / double(max(numTests,size_t(1)));
+      bool failed = failRate > 0.00002;
+      if (!silent) { printf(" (%f%%)", 100.0f*failRate); fflush(stdout); }
+      return (VerifyApplication::TestReturnValue)(!failed);
+    }
+  };
+
+  struct SaveLoadBVHTest : public VerifyApplication::Test
+  {
+    std::string accel;
+    bool quads;
+    SceneFlags sflags;
+    
+    SaveLoadBVHTest (std::string name, int isa, std::string accel, bool quads, SceneFlags sflags = SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM))
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), accel(accel), quads(quads), sflags(sflags) {}
+   
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+","+accel;
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      const std::string fileName = "verify_"+name+".bvh";
+
+      Vec3fa pos = zero;
+      Ref<SceneGraph::Node> node0 = quads ? SceneGraph::createQuadSphere(pos,2.0f,50) : SceneGraph::createTriangleSphere(pos,2.0f,50);
+      Ref<SceneGraph::Node> node1 = quads ? SceneGraph::createQuadSphere(pos+Vec3fa(1.0f,0.5f,0.0f),1.0f,20) : SceneGraph::createTriangleSphere(pos+Vec3fa(1.0f,0.5f,0.0f),1.0f,20);
+
+      VerifyScene scene0(device,sflags);
+      scene0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,node0);
+      scene0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,node1);
+      rtcCommitScene (scene0);
+      AssertNoError(device);
+      rtcSaveSceneBVH (scene0,fileName.c_str());
+      AssertNoError(device);
+
+      /* a scene with different geometries has to reject the file */
+      VerifyScene scene1(device,sflags);
+      scene1.addGeometry(RTC_BUILD_QUALITY_MEDIUM,node0);
+      rtcLoadSceneBVH (scene1,fileName.c_str());
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+
+      VerifyScene scene2(device,sflags);
+      scene2.addGeometry(RTC_BUILD_QUALITY_MEDIUM,node0);
+      scene2.addGeometry(RTC_BUILD_QUALITY_MEDIUM,node1);
+      rtcLoadSceneBVH (scene2,fileName.c_str());
+      AssertNoError(device);
+      remove(fileName.c_str());
+
+      /* the loaded BVH has to find exactly the same hits as the built one */
+      size_t numFailures = 0;
+      for (size_t i=0; i<size_t(1000*state->intensity); i++) 
+      {
+        Vec3fa org = 6.0f*random_Vec3fa()-Vec3fa(3.0f);
+        Vec3fa dir = 2.0f*random_Vec3fa()-Vec3fa(1.0f);
+        RTCRayHit ray0 = makeRay(pos+org,dir);
+        RTCRayHit ray1 = ray0;
+        IntersectWithMode(MODE_INTERSECT1,VARIANT_INTERSECT,scene0,&ray0,1);
+        IntersectWithMode(MODE_INTERSECT1,VARIANT_INTERSECT,scene2,&ray1,1);
+        numFailures += ray0.hit.geomID != ray1.hit.geomID || ray0.hit.primID != ray1.hit.primID || ray0.ray.tfar != ray1.ray.tfar;
+      }
+      AssertNoError(device);
+
+      if (!silent) { printf(" (%zu failures)", numFailures); fflush(stdout); }
+      return (VerifyApplication::TestReturnValue)(numFailures == 0);
+    }
+  };
+
+  struct AccelCompareTest : public VerifyApplication::IntersectTest
+  {
+    std::string accel;
+    bool quads;
+    static const size_t N = 10;
+    static const size_t maxStreamSize = 100;
+    
+    AccelCompareTest (std::string name, int isa, std::string accel, bool quads, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), accel(accel), quads(quads) {}
+   
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+","+accel).c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+      if (!supportsIntersectMode(device1,imode))
+        return VerifyApplication::SKIPPED;
+
+      Vec3fa pos = zero;
+      SceneFlags sflags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM);
+      VerifyScene scene0(device0,sflags);
+      VerifyScene scene1(device1,sflags);
+      for (VerifyScene* scene : { &scene0, &scene1 }) {
+        if (quads) {
+          scene->addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createQuadSphere(pos,2.0f,50));
+          scene->addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createQuadSphere(pos+Vec3fa(1.0f,0.5f,0.0f),1.0f,20));
+        } else {
+          scene->addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(pos,2.0f,50));
+          scene->addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(pos+Vec3fa(1.0f,0.5f,0.0f),1.0f,20));
+        }
+      }
+      rtcCommitScene (scene0);
+      AssertNoError(device0);
+      
+      /* some acceleration structures are not available in every build, e.g. BVH8 without an AVX target */
+      rtcCommitScene (scene1);
+      if (rtcGetDeviceError(device1) == RTC_ERROR_INVALID_ARGUMENT)
+        return VerifyApplication::SKIPPED;
+
+      /* the tested acceleration structure has to find the same hits as the default one */
+      size_t numTests = 0;
+      size_t numFailures = 0;
+      for (size_t i=0; i<size_t(N*state->intensity); i++) 
+      {
+        for (unsigned int M=1; M<maxStreamSize; M++)
+        {
+          __aligned(16) RTCRayHit rays0[maxStreamSize];
+          __aligned(16) RTCRayHit rays1[maxStreamSize];
+          for (unsigned int j=0; j<M; j++) 
+          {
+            Vec3fa org = 6.0f*random_Vec3fa()-Vec3fa(3.0f);
+            Vec3fa dir = 2.0f*random_Vec3fa()-Vec3fa(1.0f);
+            const float tnear = rand()%2 ? 0.0f : random_float();
+            const float tfar  = rand()%2 ? float(inf) : tnear+4.0f*random_float();
+            rays0[j] = rays1[j] = makeRay(pos+org,dir,tnear,tfar);
+          }
+          IntersectWithMode(MODE_INTERSECT1,IntersectVariant(ivariant & VARIANT_INTERSECT_OCCLUDED_MASK),scene0,rays0,M);
+          IntersectWithMode(imode,ivariant,scene1,rays1,M);
+
+          for (unsigned int j=0; j<M; j++)
+          {
+            const RTCRayHit& ray0 = rays0[j];
+            const RTCRayHit& ray1 = rays1[j];
+            numTests++;
+            if (ivariant & VARIANT_INTERSECT) {
+              bool failed = ray0.hit.geomID != ray1.hit.geomID;
+              failed |= std::abs(ray0.ray.tfar-ray1.ray.tfar) > 1E-4f*max(1.0f,std::abs(ray0.ray.tfar));
+              numFailures += failed;
+            } else {
+              numFailures += (ray0.ray.tfar == float(neg_inf)) != (ray1.ray.tfar == float(neg_inf));
+            }
+          }
+        }
+      }
+      AssertNoError(device1);
+
+      double failRate = double(numFailures) / double(max(numTests,size_t(1)));
+      bool failed = failRate > 0.00002;
+      if (!silent) { printf(" (%f%%)", 100.0f*failRate); fflush(stdout); }
+      return (VerifyApplication::TestReturnValue)(!failed);
+    }
+  };
+
   struct WatertightTest : public VerifyApplication::IntersectTest
   {
     ALIGNED_STRUCT_(16);
@@ -3627,6 +4522,556 @@ namespace embree
     }
   };
 
+  struct PointQueryPacketTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    bool mblur;
+    bool instancing;
+
+    PointQueryPacketTest (std::string name, int isa, SceneFlags sflags, bool mblur, bool instancing)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), mblur(mblur), instancing(instancing) {}
+
+    struct UserData
+    {
+      Vec3f* vertices[2];
+      Triangle* triangles;
+      float dist = inf;
+      unsigned int primID = RTC_INVALID_GEOMETRY_ID;
+    };
+
+    static bool closestPointFunc(RTCPointQueryFunctionArguments* args)
+    {
+      UserData* data = (UserData*)args->userPtr;
+      const float time = args->query->time;
+      Triangle const& t = data->triangles[args->primID];
+      Vec3fa v0 = lerp(Vec3fa(data->vertices[0][t.v0]),Vec3fa(data->vertices[1][t.v0]),time);
+      Vec3fa v1 = lerp(Vec3fa(data->vertices[0][t.v1]),Vec3fa(data->vertices[1][t.v1]),time);
+      Vec3fa v2 = lerp(Vec3fa(data->vertices[0][t.v2]),Vec3fa(data->vertices[1][t.v2]),time);
+
+      /* compute distances in world space */
+      if (args->context->instStackSize > 0) {
+        const AffineSpace3fa inst2world = AffineSpace3fa_load_unaligned((AffineSpace3fa*)args->context->inst2world[args->context->instStackSize-1]);
+        v0 = xfmPoint(inst2world,v0);
+        v1 = xfmPoint(inst2world,v1);
+        v2 = xfmPoint(inst2world,v2);
+      }
+      const Vec3fa q(args->query->x, args->query->y, args->query->z);
+      const float d = distance(q, closestPointTriangle(q, v0, v1, v2));
+      if (d < args->query->radius) {
+        args->query->radius = d;
+        data->dist = d;
+        data->primID = args->primID;
+        return true;
+      }
+      return false;
+    }
+
+    static size_t countFailures(const std::vector<UserData>& result, const std::vector<UserData>& expected)
+    {
+      size_t numFailures = 0;
+      for (size_t i=0; i<result.size(); i++)
+        numFailures += result[i].primID != expected[i].primID && abs(result[i].dist-expected[i].dist) > 1E-5f;
+      return numFailures;
+    }
+
+    template<int K, typename Packet>
+    static size_t testPacket(RTCScene scene, const avector<RTCPointQuery>& queries, const std::vector<UserData>& expected, const UserData& base,
+                             bool (*pointQueryK)(const int*, RTCScene, Packet*, RTCPointQueryContext*, RTCPointQueryFunction, void**))
+    {
+      const size_t numQueries = queries.size();
+      std::vector<UserData> result(numQueries,base);
+      for (size_t i=0; i<numQueries; i+=K)
+      {
+        Packet packet;
+        RTC_ALIGN(64) int valid[K];
+        void* userPtr[K];
+        for (size_t k=0; k<K; k++) {
+          const size_t j = min(i+k,numQueries-1);
+          valid[k] = (i+k < numQueries && (i+k)%7 != 3) ? -1 : 0;
+          packet.x[k] = queries[j].x; packet.y[k] = queries[j].y; packet.z[k] = queries[j].z;
+          packet.time[k] = queries[j].time; packet.radius[k] = queries[j].radius;
+          userPtr[k] = &result[j];
+        }
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        pointQueryK(valid, scene, &packet, &context, closestPointFunc, userPtr);
+
+        /* disabled queries must not get processed */
+        for (size_t k=0; k<K; k++)
+          if (!valid[k] && i+k < numQueries && result[i+k].primID == RTC_INVALID_GEOMETRY_ID)
+            result[i+k] = expected[i+k];
+      }
+      return countFailures(result,expected);
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      const size_t numTriangles = 1000;
+      RTCGeometry geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetGeometryBuildQuality(geom,sflags.qflags);
+      rtcSetGeometryTimeStepCount(geom,mblur ? 2 : 1);
+
+      UserData base;
+      base.vertices[0] = (Vec3f*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vec3f), 3*numTriangles);
+      base.vertices[1] = mblur ? (Vec3f*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 1, RTC_FORMAT_FLOAT3, sizeof(Vec3f), 3*numTriangles) : base.vertices[0];
+      base.triangles = (Triangle*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, sizeof(Triangle), numTriangles);
+      for (size_t i=0; i<numTriangles; i++)
+      {
+        const Vec3fa p = 10.0f*random_Vec3fa();
+        const Vec3fa motion = mblur ? random_Vec3fa() : Vec3fa(zero);
+        for (size_t j=0; j<3; j++) {
+          base.vertices[0][3*i+j] = Vec3f(p + 0.5f*random_Vec3fa());
+          base.vertices[1][3*i+j] = Vec3f(Vec3fa(base.vertices[0][3*i+j]) + motion);
+        }
+        base.triangles[i] = Triangle(unsigned(3*i+0),unsigned(3*i+1),unsigned(3*i+2));
+      }
+      rtcCommitGeometry(geom);
+
+      RTCSceneRef object = rtcNewScene(device);
+      rtcSetSceneFlags(object,sflags.sflags);
+      rtcSetSceneBuildQuality(object,sflags.qflags);
+      rtcAttachGeometry(object,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene (object);
+      AssertNoError(device);
+
+      RTCSceneRef instances = nullptr;
+      RTCScene scene = object;
+      if (instancing)
+      {
+        scene = instances = rtcNewScene(device);
+        RTCGeometry inst = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(inst,object);
+        const AffineSpace3fa xfm = AffineSpace3fa::translate(Vec3fa(1,2,3)) * AffineSpace3fa::scale(Vec3fa(1.0f,2.0f,0.5f));
+        rtcSetGeometryTransform(inst,0,RTC_FORMAT_FLOAT3X4_COLUMN_MAJOR,(float*)&xfm);
+        rtcCommitGeometry(inst);
+        rtcAttachGeometry(scene,inst);
+        rtcReleaseGeometry(inst);
+        rtcCommitScene (scene);
+        AssertNoError(device);
+      }
+
+      /* coherent query points along a random walk, as well as incoherent ones */
+      const size_t numQueries = 256;
+      avector<RTCPointQuery> queries(numQueries);
+      Vec3fa p = 10.0f*random_Vec3fa();
+      for (size_t i=0; i<numQueries; i++)
+      {
+        p = i < numQueries/2 ? p + 0.2f*(random_Vec3fa()-Vec3fa(0.5f)) : 12.0f*random_Vec3fa()-Vec3fa(1.0f);
+        queries[i].x = p.x; queries[i].y = p.y; queries[i].z = p.z;
+        queries[i].time = mblur ? random_float() : 0.0f;
+        queries[i].radius = (i%3) ? inf : 1.0f;
+      }
+
+      /* reference results using single point queries */
+      std::vector<UserData> expected(numQueries,base);
+      for (size_t i=0; i<numQueries; i++) {
+        RTCPointQuery query = queries[i];
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        rtcPointQuery(scene, &query, &context, closestPointFunc, &expected[i]);
+      }
+      AssertNoError(device);
+
+      /* packets of size 4, 8 and 16 */
+      size_t numFailures = 0;
+      numFailures += testPacket<4>(scene,queries,expected,base,rtcPointQuery4);
+      numFailures += testPacket<8>(scene,queries,expected,base,rtcPointQuery8);
+      numFailures += testPacket<16>(scene,queries,expected,base,rtcPointQuery16);
+      AssertNoError(device);
+
+      /* query stream */
+      {
+        std::vector<UserData> result(numQueries,base);
+        std::vector<void*> userPtr(numQueries);
+        for (size_t i=0; i<numQueries; i++) userPtr[i] = &result[i];
+        avector<RTCPointQuery> stream = queries;
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        rtcPointQuery1M(scene, stream.data(), unsigned(numQueries), sizeof(RTCPointQuery), &context, closestPointFunc, userPtr.data());
+        AssertNoError(device);
+        numFailures += countFailures(result,expected);
+      }
+
+      if (!silent) { printf(" (%zu failures)", numFailures); fflush(stdout); }
+      return (VerifyApplication::TestReturnValue) (numFailures == 0);
+    }
+  };
+
+  struct ClosestPointTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCGeometryType gtype;
+    bool mblur;
+    int instancing; // 0 = none, 1 = similarity transform, 2 = non-uniform scaling
+
+    ClosestPointTest (std::string name, int isa, SceneFlags sflags, RTCGeometryType gtype, bool mblur, int instancing)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gtype(gtype), mblur(mblur), instancing(instancing) {}
+
+    static const unsigned int GRID_RES = 9;
+    typedef SceneGraph::QuadMeshNode::Quad Quad;
+
+    Vec3f* vertices[2];
+    unsigned int* indices;
+    size_t numPrimitives;
+    AffineSpace3fa xfm;
+
+    Vec3fa vertex(unsigned int i, float time) const {
+      return xfmPoint(xfm,lerp(Vec3fa(vertices[0][i]),Vec3fa(vertices[1][i]),time));
+    }
+
+    /* returns the 4 vertices of a quad, or of a grid cell in the order v00, v10, v11, v01 */
+    void quad(unsigned int primID, unsigned int x, unsigned int y, float time, Vec3fa v[4]) const
+    {
+      if (gtype == RTC_GEOMETRY_TYPE_GRID) {
+        const unsigned int base = primID*GRID_RES*GRID_RES + y*GRID_RES + x;
+        v[0] = vertex(base,time); v[1] = vertex(base+1,time);
+        v[2] = vertex(base+GRID_RES+1,time); v[3] = vertex(base+GRID_RES,time);
+      } else {
+        for (size_t i=0; i<4; i++) v[i] = vertex(indices[4*primID+i],time);
+      }
+    }
+
+    /* brute force reference distance */
+    float closestDistance(const Vec3fa& q, float time) const
+    {
+      float dist = inf;
+      for (unsigned int primID=0; primID<numPrimitives; primID++)
+      {
+        if (gtype == RTC_GEOMETRY_TYPE_TRIANGLE) {
+          const Vec3fa v0 = vertex(indices[3*primID+0],time);
+          const Vec3fa v1 = vertex(indices[3*primID+1],time);
+          const Vec3fa v2 = vertex(indices[3*primID+2],time);
+          dist = min(dist,distance(q,closestPointTriangle(q,v0,v1,v2)));
+          continue;
+        }
+        const unsigned int numCells = gtype == RTC_GEOMETRY_TYPE_GRID ? GRID_RES-1 : 1;
+        for (unsigned int y=0; y<numCells; y++)
+          for (unsigned int x=0; x<numCells; x++)
+          {
+            Vec3fa v[4]; quad(primID,x,y,time,v);
+            dist = min(dist,distance(q,closestPointTriangle(q,v[0],v[1],v[3])));
+            dist = min(dist,distance(q,closestPointTriangle(q,v[2],v[3],v[1])));
+          }
+      }
+      return dist;
+    }
+
+    /* reconstructs the closest point from the barycentric coordinates of the hit */
+    Vec3fa closestPoint(const RTCClosestPointHit& hit, float time) const
+    {
+      if (gtype == RTC_GEOMETRY_TYPE_TRIANGLE) {
+        const Vec3fa v0 = vertex(indices[3*hit.primID+0],time);
+        const Vec3fa v1 = vertex(indices[3*hit.primID+1],time);
+        const Vec3fa v2 = vertex(indices[3*hit.primID+2],time);
+        return v0 + hit.u*(v1-v0) + hit.v*(v2-v0);
+      }
+      float u = hit.u, v = hit.v;
+      unsigned int x = 0, y = 0;
+      if (gtype == RTC_GEOMETRY_TYPE_GRID) {
+        u *= float(GRID_RES-1); x = min((unsigned int)max(floor(u),0.0f),GRID_RES-2); u -= float(x);
+        v *= float(GRID_RES-1); y = min((unsigned int)max(floor(v),0.0f),GRID_RES-2); v -= float(y);
+      }
+      Vec3fa p[4]; quad(hit.primID,x,y,time,p);
+      if (u+v <= 1.0f) return p[0] + u*(p[1]-p[0]) + v*(p[3]-p[0]);
+      else             return p[2] + (1.0f-u)*(p[3]-p[2]) + (1.0f-v)*(p[1]-p[2]);
+    }
+
+    size_t countFailures(const RTCPointQuery& query, const RTCPointQuery& result, const RTCClosestPointHit& hit, bool found) const
+    {
+      const Vec3fa q(query.x,query.y,query.z);
+      const float expected = closestDistance(q,query.time);
+      const float eps = 1E-3f*(1.0f+expected);
+      if (!(expected < query.radius - eps)) {
+        if (expected > query.radius + eps && (found || hit.primID != RTC_INVALID_GEOMETRY_ID || result.radius != query.radius)) return 1;
+        return 0;
+      }
+      if (!found || hit.primID >= numPrimitives || hit.geomID != 0) return 1;
+      if (hit.instID[0] != (instancing ? 0 : RTC_INVALID_GEOMETRY_ID)) return 1;
+      if (abs(result.radius-expected) > eps) return 1;
+      if (abs(distance(q,closestPoint(hit,query.time))-result.radius) > eps) return 1;
+      return 0;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      const unsigned int numVerticesPerPrim = gtype == RTC_GEOMETRY_TYPE_TRIANGLE ? 3 : gtype == RTC_GEOMETRY_TYPE_QUAD ? 4 : GRID_RES*GRID_RES;
+      numPrimitives = gtype == RTC_GEOMETRY_TYPE_GRID ? 16 : 500;
+      const size_t numVertices = numVerticesPerPrim*numPrimitives;
+
+      RTCGeometry geom = rtcNewGeometry (device, gtype);
+      rtcSetGeometryBuildQuality(geom,sflags.qflags);
+      rtcSetGeometryTimeStepCount(geom,mblur ? 2 : 1);
+      vertices[0] = (Vec3f*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vec3f), numVertices);
+      vertices[1] = mblur ? (Vec3f*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 1, RTC_FORMAT_FLOAT3, sizeof(Vec3f), numVertices) : vertices[0];
+      indices = nullptr;
+      RTCGrid* grids = nullptr;
+      if (gtype == RTC_GEOMETRY_TYPE_TRIANGLE)
+        indices = (unsigned int*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, sizeof(Triangle), numPrimitives);
+      else if (gtype == RTC_GEOMETRY_TYPE_QUAD)
+        indices = (unsigned int*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT4, sizeof(Quad), numPrimitives);
+      else
+        grids = (RTCGrid*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_GRID, 0, RTC_FORMAT_GRID, sizeof(RTCGrid), numPrimitives);
+
+      for (unsigned int i=0; i<numPrimitives; i++)
+      {
+        const Vec3fa p = 10.0f*random_Vec3fa();
+        const Vec3fa motion = mblur ? random_Vec3fa() : Vec3fa(zero);
+        for (unsigned int j=0; j<numVerticesPerPrim; j++)
+        {
+          const unsigned int k = i*numVerticesPerPrim+j;
+          if (grids) vertices[0][k] = Vec3f(p + Vec3fa(float(j%GRID_RES)/GRID_RES,0.2f*random_float(),float(j/GRID_RES)/GRID_RES));
+          else       vertices[0][k] = Vec3f(p + 0.5f*random_Vec3fa());
+          vertices[1][k] = Vec3f(Vec3fa(vertices[0][k]) + motion);
+          if (indices) indices[k] = k;
+        }
+        if (grids) {
+          grids[i].startVertexID = i*numVerticesPerPrim;
+          grids[i].stride = GRID_RES;
+          grids[i].width = grids[i].height = GRID_RES;
+        }
+      }
+      rtcCommitGeometry(geom);
+
+      RTCSceneRef object = rtcNewScene(device);
+      rtcSetSceneFlags(object,sflags.sflags);
+      rtcSetSceneBuildQuality(object,sflags.qflags);
+      rtcAttachGeometry(object,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene (object);
+      AssertNoError(device);
+
+      xfm = one;
+      RTCSceneRef instances = nullptr;
+      RTCScene scene = object;
+      if (instancing)
+      {
+        if (instancing == 1) xfm = AffineSpace3fa::translate(Vec3fa(1,2,3)) * AffineSpace3fa::rotate(Vec3fa(1,1,0),0.7f) * AffineSpace3fa::scale(Vec3fa(2.0f));
+        else                 xfm = AffineSpace3fa::translate(Vec3fa(1,2,3)) * AffineSpace3fa::scale(Vec3fa(1.0f,2.0f,0.5f));
+        scene = instances = rtcNewScene(device);
+        RTCGeometry inst = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(inst,object);
+        rtcSetGeometryTransform(inst,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,(float*)&xfm);
+        rtcCommitGeometry(inst);
+        rtcAttachGeometry(scene,inst);
+        rtcReleaseGeometry(inst);
+        rtcCommitScene (scene);
+        AssertNoError(device);
+      }
+
+      /* coherent query points along a random walk, as well as incoherent ones */
+      const size_t numQueries = 128;
+      avector<RTCPointQuery> queries(numQueries);
+      Vec3fa p = xfmPoint(xfm,10.0f*random_Vec3fa());
+      for (size_t i=0; i<numQueries; i++)
+      {
+        p = i < numQueries/2 ? p + 0.2f*(random_Vec3fa()-Vec3fa(0.5f)) : xfmPoint(xfm,12.0f*random_Vec3fa()-Vec3fa(1.0f));
+        queries[i].x = p.x; queries[i].y = p.y; queries[i].z = p.z;
+        queries[i].time = mblur ? random_float() : 0.0f;
+        queries[i].radius = (i%3) ? inf : 0.5f;
+      }
+
+      /* single queries */
+      size_t numFailures = 0;
+      for (size_t i=0; i<numQueries; i++)
+      {
+        RTCPointQuery query = queries[i];
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        RTCClosestPointHit hit;
+        const bool found = rtcClosestPoint(scene, &query, &context, &hit);
+        numFailures += countFailures(queries[i],query,hit,found);
+      }
+      AssertNoError(device);
+
+      /* query stream */
+      {
+        avector<RTCPointQuery> stream = queries;
+        avector<RTCClosestPointHit> hits(numQueries);
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        rtcClosestPoint1M(scene, stream.data(), unsigned(numQueries), sizeof(RTCPointQuery), &context, hits.data());
+        AssertNoError(device);
+        for (size_t i=0; i<numQueries; i++)
+          numFailures += countFailures(queries[i],stream[i],hits[i],hits[i].primID != RTC_INVALID_GEOMETRY_ID);
+      }
+
+      if (!silent) { printf(" (%zu failures)", numFailures); fflush(stdout); }
+      return (VerifyApplication::TestReturnValue) (numFailures == 0);
+    }
+  };
+
+  struct NearestPointsTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCGeometryType gtype;
+    bool mblur;
+    bool instancing;
+
+    NearestPointsTest (std::string name, int isa, SceneFlags sflags, RTCGeometryType gtype, bool mblur, bool instancing)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gtype(gtype), mblur(mblur), instancing(instancing) {}
+
+    avector<Vec3fa> vertices[2];
+    size_t numPrimitives;
+    AffineSpace3fa xfm;
+
+    bool isPoint() const { return gtype != RTC_GEOMETRY_TYPE_TRIANGLE; }
+
+    Vec3fa vertex(size_t i, float time) const {
+      return xfmPoint(xfm,lerp(vertices[0][i],vertices[1][i],time));
+    }
+
+    /* brute force reference distance to a primitive, point primitives are measured to their center */
+    float primitiveDistance(const Vec3fa& q, size_t primID, float time) const
+    {
+      if (isPoint()) return distance(q,vertex(primID,time));
+      return distance(q,closestPointTriangle(q,vertex(3*primID+0,time),vertex(3*primID+1,time),vertex(3*primID+2,time)));
+    }
+
+    size_t countFailures(const RTCPointQuery& query, RTCNearestPointsMode mode, unsigned int k, const RTCNearestPointHit* hits, unsigned int numHits) const
+    {
+      const Vec3fa q(query.x,query.y,query.z);
+      std::vector<float> expected;
+      for (size_t i=0; i<numPrimitives; i++) {
+        const float d = primitiveDistance(q,i,query.time);
+        if (d < query.radius) expected.push_back(d);
+      }
+      std::sort(expected.begin(),expected.end());
+
+      /* radius searches report with k+1 hits that not all primitives within the radius got returned */
+      if (mode == RTC_NEAREST_POINTS_MODE_RADIUS && expected.size() > k) {
+        if (numHits != k+1) return 1;
+        numHits = k;
+      }
+      else if (numHits != min(size_t(k),expected.size())) return 1;
+
+      std::set<unsigned int> found;
+      for (unsigned int i=0; i<numHits; i++)
+      {
+        const float eps = 1E-4f*(1.0f+expected[i]);
+        if (abs(hits[i].distance-expected[i]) > eps) return 1;
+        if (hits[i].primID >= numPrimitives || hits[i].geomID != 0) return 1;
+        if (hits[i].instID[0] != (instancing ? 0 : RTC_INVALID_GEOMETRY_ID)) return 1;
+        if (abs(primitiveDistance(q,hits[i].primID,query.time)-hits[i].distance) > eps) return 1;
+        if (!found.insert(hits[i].primID).second) return 1; // every primitive only once
+      }
+      return 0;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      numPrimitives = 1000;
+      const size_t numVertices = isPoint() ? numPrimitives : 3*numPrimitives;
+      for (size_t t=0; t<2; t++) vertices[t].resize(numVertices);
+      for (size_t i=0; i<numPrimitives; i++)
+      {
+        const Vec3fa p = 10.0f*random_Vec3fa();
+        const Vec3fa motion = mblur ? random_Vec3fa() : Vec3fa(zero);
+        const size_t n = isPoint() ? 1 : 3;
+        for (size_t j=0; j<n; j++) {
+          vertices[0][n*i+j] = isPoint() ? p : p + 0.5f*random_Vec3fa();
+          vertices[0][n*i+j].w = 0.05f;
+          vertices[1][n*i+j] = vertices[0][n*i+j] + motion;
+        }
+      }
+
+      RTCGeometry geom = rtcNewGeometry (device, gtype);
+      rtcSetGeometryBuildQuality(geom,sflags.qflags);
+      rtcSetGeometryTimeStepCount(geom,mblur ? 2 : 1);
+      for (unsigned int t=0; t<(mblur ? 2u : 1u); t++)
+        rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, t, isPoint() ? RTC_FORMAT_FLOAT4 : RTC_FORMAT_FLOAT3, vertices[t].data(), 0, sizeof(Vec3fa), numVertices);
+      if (!isPoint()) {
+        Triangle* triangles = (Triangle*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, sizeof(Triangle), numPrimitives);
+        for (size_t i=0; i<numPrimitives; i++)
+          triangles[i] = Triangle(unsigned(3*i+0),unsigned(3*i+1),unsigned(3*i+2));
+      }
+      rtcCommitGeometry(geom);
+
+      RTCSceneRef object = rtcNewScene(device);
+      rtcSetSceneFlags(object,sflags.sflags);
+      rtcSetSceneBuildQuality(object,sflags.qflags);
+      rtcAttachGeometry(object,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene (object);
+      AssertNoError(device);
+
+      xfm = one;
+      RTCSceneRef instances = nullptr;
+      RTCScene scene = object;
+      if (instancing)
+      {
+        xfm = AffineSpace3fa::translate(Vec3fa(1,2,3)) * AffineSpace3fa::rotate(Vec3fa(0,1,1),0.3f) * AffineSpace3fa::scale(Vec3fa(0.5f));
+        scene = instances = rtcNewScene(device);
+        RTCGeometry inst = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(inst,object);
+        rtcSetGeometryTransform(inst,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,(float*)&xfm);
+        rtcCommitGeometry(inst);
+        rtcAttachGeometry(scene,inst);
+        rtcReleaseGeometry(inst);
+        rtcCommitScene (scene);
+        AssertNoError(device);
+      }
+
+      /* k-nearest queries with unbounded radius, radius searches, and k-nearest queries within a radius */
+      const size_t numQueries = 96;
+      const unsigned int K = 16;
+      avector<RTCPointQuery> queries(numQueries);
+      std::vector<unsigned int> ks(numQueries);
+      for (size_t i=0; i<numQueries; i++)
+      {
+        const Vec3fa p = xfmPoint(xfm,12.0f*random_Vec3fa()-Vec3fa(1.0f));
+        queries[i].x = p.x; queries[i].y = p.y; queries[i].z = p.z;
+        queries[i].time = mblur ? random_float() : 0.0f;
+        queries[i].radius = (i%3 == 0) ? inf : (instancing ? 0.75f : 1.5f);
+        ks[i] = (i%3 == 1) ? K : 1+random_int()%K;
+      }
+
+      size_t numFailures = 0;
+      avector<RTCNearestPointHit> hits(numQueries*K);
+      for (size_t i=0; i<numQueries; i++)
+      {
+        const RTCNearestPointsMode mode = (i%3 == 1) ? RTC_NEAREST_POINTS_MODE_RADIUS : RTC_NEAREST_POINTS_MODE_KNN;
+        const float radius = queries[i].radius;
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        const unsigned int numHits = rtcNearestPoints(scene, &queries[i], &context, mode, ks[i], &hits[i*K]);
+        numFailures += queries[i].radius != radius; // the query radius is not modified
+        numFailures += countFailures(queries[i],mode,ks[i],&hits[i*K],numHits);
+      }
+      AssertNoError(device);
+
+      /* query streams with a fixed k */
+      for (RTCNearestPointsMode mode : { RTC_NEAREST_POINTS_MODE_KNN, RTC_NEAREST_POINTS_MODE_RADIUS })
+      {
+        avector<RTCPointQuery> stream = queries;
+        std::vector<unsigned int> numHits(numQueries);
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        rtcNearestPoints1M(scene, stream.data(), unsigned(numQueries), sizeof(RTCPointQuery), &context, mode, K, hits.data(), numHits.data());
+        AssertNoError(device);
+        for (size_t i=0; i<numQueries; i++) {
+          numFailures += stream[i].radius != queries[i].radius;
+          numFailures += countFailures(queries[i],mode,K,&hits[i*K],numHits[i]);
+        }
+      }
+
+      if (!silent) { printf(" (%zu failures)", numFailures); fflush(stdout); }
+      return (VerifyApplication::TestReturnValue) (numFailures == 0);
+    }
+  };
+
   struct PointQueryMotionBlurTest : public VerifyApplication::Test
   {
     SceneFlags sflags; 
@@ -3776,6 +5221,171 @@ namespace embree
     }
   };
 
+  struct CollideTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    bool userGeometry;
+    bool selfCollision;
+    std::string tri_accel;
+
+    CollideTest (std::string name, int isa, SceneFlags sflags, bool userGeometry, bool selfCollision, std::string tri_accel = "")
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), userGeometry(userGeometry), selfCollision(selfCollision), tri_accel(tri_accel) {}
+
+    typedef std::pair<unsigned int,unsigned int> Pair;
+
+    struct Mesh
+    {
+      avector<Vec3fa> vertices;
+      std::vector<Triangle> triangles;
+
+      bool intersect(size_t primID0, const Mesh& other, size_t primID1) const
+      {
+        const Triangle& t0 = triangles[primID0];
+        const Triangle& t1 = other.triangles[primID1];
+
+        /* triangles of the same mesh that share a vertex do not collide */
+        if (this == &other) {
+          const unsigned int v0[3] = { t0.v0, t0.v1, t0.v2 };
+          const unsigned int v1[3] = { t1.v0, t1.v1, t1.v2 };
+          for (size_t i=0; i<3; i++)
+            for (size_t j=0; j<3; j++)
+              if (v0[i] == v1[j]) return false;
+        }
+        return isa::TriangleTriangleIntersector::intersect_triangle_triangle(vertices[t0.v0],vertices[t0.v1],vertices[t0.v2],
+                                                                               other.vertices[t1.v0],other.vertices[t1.v1],other.vertices[t1.v2]);
+      }
+    };
+
+    struct CollideData
+    {
+      SpinLock mutex;
+      std::vector<Pair> pairs;
+      bool invalid = false;
+    };
+
+    static void boundsFunc(const RTCBoundsFunctionArguments* args)
+    {
+      const Mesh* mesh = (const Mesh*) args->geometryUserPtr;
+      const Triangle& tri = mesh->triangles[args->primID];
+      BBox3fa bounds = empty;
+      bounds.extend(mesh->vertices[tri.v0]);
+      bounds.extend(mesh->vertices[tri.v1]);
+      bounds.extend(mesh->vertices[tri.v2]);
+      *(BBox3fa*) args->bounds_o = bounds;
+    }
+
+    static void collideFunc(void* userPtr, RTCCollision* collisions, unsigned int num_collisions)
+    {
+      CollideData* data = (CollideData*) userPtr;
+      Lock<SpinLock> lock(data->mutex);
+      for (unsigned int i=0; i<num_collisions; i++) {
+        if (collisions[i].geomID0 != 0 || collisions[i].geomID1 != 0) data->invalid = true;
+        data->pairs.push_back(Pair(collisions[i].primID0,collisions[i].primID1));
+      }
+    }
+
+    RTCScene createScene(RTCDevice device, Mesh& mesh)
+    {
+      const size_t numTriangles = 2000;
+      for (size_t i=0; i<numTriangles; i++)
+      {
+        const Vec3fa p = 10.0f*random_Vec3fa();
+        const unsigned int base = (unsigned int) mesh.vertices.size();
+        for (size_t j=0; j<3; j++)
+          mesh.vertices.push_back(p + 0.5f*random_Vec3fa());
+        mesh.triangles.push_back(Triangle(base+0,base+1,base+2));
+      }
+
+      /* a crumpled grid whose neighbouring triangles share vertices */
+      const unsigned int R = 16;
+      const unsigned int base = (unsigned int) mesh.vertices.size();
+      for (unsigned int y=0; y<=R; y++)
+        for (unsigned int x=0; x<=R; x++)
+          mesh.vertices.push_back(Vec3fa(0.5f*x,0.5f*y,0.0f) + 0.3f*random_Vec3fa());
+      for (unsigned int y=0; y<R; y++)
+      {
+        for (unsigned int x=0; x<R; x++)
+        {
+          const unsigned int p00 = base+y*(R+1)+x, p01 = p00+1, p10 = p00+R+1, p11 = p10+1;
+          mesh.triangles.push_back(Triangle(p00,p01,p10));
+          mesh.triangles.push_back(Triangle(p01,p11,p10));
+        }
+      }
+      const size_t numPrimitives = mesh.triangles.size();
+
+      RTCGeometry geom;
+      if (userGeometry)
+      {
+        geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_USER);
+        rtcSetGeometryUserPrimitiveCount(geom,(unsigned int)numPrimitives);
+        rtcSetGeometryUserData(geom,&mesh);
+        rtcSetGeometryBoundsFunction(geom,boundsFunc,nullptr);
+      }
+      else
+      {
+        geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_TRIANGLE);
+        rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, mesh.vertices.data(), 0, sizeof(Vec3fa), mesh.vertices.size());
+        rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, mesh.triangles.data(), 0, sizeof(Triangle), mesh.triangles.size());
+      }
+      rtcSetGeometryBuildQuality(geom,sflags.qflags);
+      rtcCommitGeometry(geom);
+
+      RTCScene scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene (scene);
+      return scene;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa) + (tri_accel != "" ? ",tri_accel="+tri_accel : "");
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      Mesh mesh0, mesh1;
+      RTCSceneRef scene0 = createScene(device,mesh0);
+
+      /* some acceleration structures are not available in every build, e.g. BVH8 without an AVX target */
+      if (tri_accel != "" && rtcGetDeviceError(device) == RTC_ERROR_INVALID_ARGUMENT)
+        return VerifyApplication::SKIPPED;
+      RTCSceneRef scene1 = selfCollision ? nullptr : createScene(device,mesh1);
+      const Mesh& other = selfCollision ? mesh0 : mesh1;
+      AssertNoError(device);
+
+      CollideData data;
+      rtcCollide(scene0,selfCollision ? scene0 : scene1,collideFunc,&data);
+      AssertNoError(device);
+      if (data.invalid) return VerifyApplication::FAILED;
+
+      /* every pair is only reported once, except for spatial splits that can place a triangle into multiple leaves,
+         self collisions report only one of the two symmetric pairs */
+      std::set<Pair> found;
+      for (const Pair& p : data.pairs)
+      {
+        if (selfCollision && p.first == p.second) return VerifyApplication::FAILED;
+        const Pair q = selfCollision ? Pair(min(p.first,p.second),max(p.first,p.second)) : p;
+        if (!found.insert(q).second && sflags.qflags != RTC_BUILD_QUALITY_HIGH)
+          return VerifyApplication::FAILED;
+      }
+
+      /* the triangle collider reports exactly the intersecting triangles, user geometries report a superset */
+      for (size_t i=0; i<mesh0.triangles.size(); i++)
+      {
+        for (size_t j=selfCollision ? i+1 : 0; j<other.triangles.size(); j++)
+        {
+          const bool expected = mesh0.intersect(i,other,j);
+          const bool reported = found.find(Pair((unsigned int)i,(unsigned int)j)) != found.end();
+          if (expected && !reported) return VerifyApplication::FAILED;
+          if (!expected && reported && !userGeometry) return VerifyApplication::FAILED;
+        }
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct GeometryStateTest : public VerifyApplication::Test
   {
     GeometryStateTest (std::string name, int isa)
@@ -4769,6 +6379,7 @@ namespace embree
       RTCIntersectContext context;
       rtcInitIntersectContext(&context);
       context.flags = ((ivariant & VARIANT_COHERENT_INCOHERENT_MASK) == VARIANT_COHERENT) ? RTC_INTERSECT_CONTEXT_FLAG_COHERENT :  RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
+      context.flags = (RTCIntersectContextFlags) (context.flags | ((ivariant & VARIANT_REORDER) ? RTC_INTERSECT_CONTEXT_FLAG_REORDER : RTC_INTERSECT_CONTEXT_FLAG_NONE));
 
       switch (imode) 
       {
@@ -4938,6 +6549,7 @@ namespace embree
       RTCIntersectContext context;
       rtcInitIntersectContext(&context);
       context.flags = ((ivariant & VARIANT_COHERENT_INCOHERENT_MASK) == VARIANT_COHERENT) ? RTC_INTERSECT_CONTEXT_FLAG_COHERENT :  RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
+      context.flags = (RTCIntersectContextFlags) (context.flags | ((ivariant & VARIANT_REORDER) ? RTC_INTERSECT_CONTEXT_FLAG_REORDER : RTC_INTERSECT_CONTEXT_FLAG_NONE));
 
       RandomSampler sampler;
       RandomSampler_init(sampler, (int)i);
@@ -5246,6 +6858,7 @@ namespace embree
     intersectVariants.push_back(VARIANT_INTERSECT_INCOHERENT);
     intersectVariants.push_back(VARIANT_OCCLUDED_INCOHERENT);
     intersectVariants.push_back(VARIANT_INTERSECT_OCCLUDED_COHERENT);
+    intersectVariants.push_back(VARIANT_INTERSECT_REORDER);
 
     /* create list of all scene flags to test */
     sceneFlags.push_back(SceneFlags(RTC_SCENE_FLAG_NONE,       RTC_BUILD_QUALITY_MEDIUM));
@@ -5337,6 +6950,19 @@ namespace embree
       push(new TestGroup("build",true,true));
       for (auto sflags : sceneFlags) 
         groups.top()->add(new BuildTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
+      groups.top()->add(new HugePageBVHTest("hugepages_bvh",isa));
+      groups.top()->add(new NumaReplicationTest("numa_replicate_bvh",isa));
+      groups.top()->add(new BuildCancelTest("cancel",isa));
+      groups.top()->add(new BuildConfigTest("ploc",isa,"ploc_builder=1",RTC_BUILD_QUALITY_LOW));
+      groups.top()->add(new BuildConfigTest("restructure_morton",isa,"restructure_budget=1000",RTC_BUILD_QUALITY_LOW));
+      groups.top()->add(new BuildConfigTest("restructure_sah",isa,"restructure_budget=1000",RTC_BUILD_QUALITY_MEDIUM));
+      groups.top()->add(new ThreadArenaTest("thread_arena",isa));
+      groups.top()->add(new WorkStealingStatisticsTest("work_stealing_statistics",isa));
+      groups.top()->add(new RefitRebuildTest("refit_rebuild",isa,"refit_rebuild_threshold=1.5",true));
+      groups.top()->add(new RefitRebuildTest("refit_no_rebuild",isa,"refit_rebuild_threshold=0",false));
+      groups.top()->add(new AsyncCommitTest("async_commit_low",isa,RTC_BUILD_QUALITY_LOW));
+      groups.top()->add(new AsyncCommitTest("async_commit_medium",isa,RTC_BUILD_QUALITY_MEDIUM));
+      groups.top()->add(new AsyncCommitTest("async_commit_refit",isa,RTC_BUILD_QUALITY_REFIT));
       groups.pop();
       
       push(new TestGroup("overlapping_primitives",true,false));
@@ -5370,6 +6996,7 @@ namespace embree
           }
         }
       }
+      groups.top()->add(new IncrementalTwoLevelTest("incremental_toplevel",isa));
       groups.pop();
 
 #if !defined(TASKING_PPL) // FIXME: PPL has some issues here!
@@ -5421,6 +7048,8 @@ namespace embree
         groups.top()->add(new InterpolateHairTest(std::to_string((long long)(s)),isa,s));
       groups.pop();
 
+      groups.top()->add(new AdaptiveTessellationCacheTest("adaptive_cache",isa));
+
       groups.pop();
       
       /**************************************************************************/
@@ -5505,6 +7134,39 @@ namespace embree
                 if (imode != MODE_INTERSECT1) // INTERSECT1 does not support disabled rays
                   groups.top()->add(new InactiveRaysTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
       groups.pop();
+
+      push(new TestGroup("sparse_rays",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+              if (imode != MODE_INTERSECT1)
+                groups.top()->add(new SparseRaysTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
+      groups.pop();
+
+      push(new TestGroup("bvh8_triangles",true,true));
+      for (auto imode : intersectModes) 
+        for (auto ivariant : intersectVariants)
+          if (has_variant(imode,ivariant))
+            groups.top()->add(new AccelCompareTest(to_string(imode,ivariant),isa,"tri_accel=bvh8.triangle4",false,imode,ivariant));
+      groups.pop();
+
+      /* half precision BVH only provides single ray traversal */
+      push(new TestGroup("hbvh4",true,true));
+      for (auto ivariant : intersectVariants)
+        if (has_variant(MODE_INTERSECT1,ivariant)) {
+          groups.top()->add(new AccelCompareTest("triangles."+to_string(MODE_INTERSECT1,ivariant),isa,"tri_accel=hbvh4.triangle4",false,MODE_INTERSECT1,ivariant));
+          groups.top()->add(new AccelCompareTest("quads."+to_string(MODE_INTERSECT1,ivariant),isa,"quad_accel=hbvh4.quad4v",true,MODE_INTERSECT1,ivariant));
+        }
+      groups.pop();
+      
+      push(new TestGroup("bvh_cache",true,true));
+      groups.top()->add(new SaveLoadBVHTest("triangles",isa,"",false));
+      groups.top()->add(new SaveLoadBVHTest("quads",isa,"",true));
+      groups.top()->add(new SaveLoadBVHTest("triangles_two_level",isa,"",false,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW)));
+      groups.top()->add(new SaveLoadBVHTest("hbvh4.triangles",isa,"tri_accel=hbvh4.triangle4",false));
+      groups.top()->add(new SaveLoadBVHTest("hbvh4.quads",isa,"quad_accel=hbvh4.quad4v",true));
+      groups.pop();
       
       push(new TestGroup("watertight_triangles",true,true)); {
         std::string watertightModels [] = {"sphere.triangles", "plane.triangles"};
@@ -5634,10 +7296,41 @@ namespace embree
         groups.top()->add(new PointQueryTest(to_string(sflags),isa,sflags));
       }
 
+      groups.top()->add(new PointQueryPacketTest("point_query_packet",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),false,false));
+      groups.top()->add(new PointQueryPacketTest("point_query_packet_dynamic",isa,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW),false,false));
+      groups.top()->add(new PointQueryPacketTest("point_query_packet_motion_blur",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),true,false));
+      groups.top()->add(new PointQueryPacketTest("point_query_packet_instancing",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),false,true));
+      groups.top()->add(new ClosestPointTest("closest_point_triangles",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_GEOMETRY_TYPE_TRIANGLE,false,0));
+      groups.top()->add(new ClosestPointTest("closest_point_triangles_dynamic",isa,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW),RTC_GEOMETRY_TYPE_TRIANGLE,false,0));
+      groups.top()->add(new ClosestPointTest("closest_point_triangles_motion_blur",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_GEOMETRY_TYPE_TRIANGLE,true,0));
+      groups.top()->add(new ClosestPointTest("closest_point_quads",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_GEOMETRY_TYPE_QUAD,false,0));
+      groups.top()->add(new ClosestPointTest("closest_point_quads_motion_blur",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_GEOMETRY_TYPE_QUAD,true,0));
+      groups.top()->add(new ClosestPointTest("closest_point_grids",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_GEOMETRY_TYPE_GRID,false,0));
+      groups.top()->add(new ClosestPointTest("closest_point_triangles_instancing",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_GEOMETRY_TYPE_TRIANGLE,false,1));
+      groups.top()->add(new ClosestPointTest("closest_point_quads_instancing",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_GEOMETRY_TYPE_QUAD,false,2));
+      groups.top()->add(new ClosestPointTest("closest_point_grids_instancing",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_GEOMETRY_TYPE_GRID,false,1));
+      groups.top()->add(new NearestPointsTest("nearest_points_triangles",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_GEOMETRY_TYPE_TRIANGLE,false,false));
+      groups.top()->add(new NearestPointsTest("nearest_points_triangles_high_quality",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_HIGH),RTC_GEOMETRY_TYPE_TRIANGLE,false,false));
+      groups.top()->add(new NearestPointsTest("nearest_points_triangles_instancing",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_GEOMETRY_TYPE_TRIANGLE,false,true));
+      groups.top()->add(new NearestPointsTest("nearest_points_sphere_points",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_GEOMETRY_TYPE_SPHERE_POINT,false,false));
+      groups.top()->add(new NearestPointsTest("nearest_points_sphere_points_motion_blur",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_GEOMETRY_TYPE_SPHERE_POINT,true,false));
+      groups.top()->add(new NearestPointsTest("nearest_points_disc_points_instancing",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_GEOMETRY_TYPE_DISC_POINT,false,true));
       groups.top()->add(new PointQueryMotionBlurTest("point_query_motion_blur_aligned_node",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),"bvh4.triangle4i"));
       groups.top()->add(new PointQueryMotionBlurTest("point_query_motion_blur_quantized_node",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),"qbvh4.triangle4i"));
       groups.top()->add(new PointQueryMotionBlurTest("point_query_motion_blur_quantized_node",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM)));
       groups.pop();
+
+      push(new TestGroup("collide",true,true));
+      groups.top()->add(new CollideTest("collide_triangles",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),false,false));
+      groups.top()->add(new CollideTest("collide_triangles_dynamic",isa,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW),false,false));
+      groups.top()->add(new CollideTest("collide_triangles_high_quality",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_HIGH),false,false));
+      groups.top()->add(new CollideTest("collide_triangles_self",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),false,true));
+      groups.top()->add(new CollideTest("collide_triangles_self_dynamic",isa,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW),false,true));
+      groups.top()->add(new CollideTest("collide_triangles_bvh8",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),false,false,"bvh8.triangle4"));
+      groups.top()->add(new CollideTest("collide_triangles_self_bvh8",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),false,true,"bvh8.triangle4"));
+      groups.top()->add(new CollideTest("collide_user_geometry",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),true,false));
+      groups.top()->add(new CollideTest("collide_user_geometry_self",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),true,true));
+      groups.pop();
     
       /**************************************************************************/
       /*                  Randomized Stress Testing                             */
@@ -5687,6 +7380,7 @@ namespace embree
       benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT16,VARIANT_OCCLUDED));
       benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT1M,VARIANT_INTERSECT_INCOHERENT));
       benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT1M,VARIANT_OCCLUDED_INCOHERENT));
+      benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT1M,VARIANT_INTERSECT_REORDER));
 
       GeometryType benchmark_gtypes[] = { 
         TRIANGLE_MESH, 
@@ -5765,6 +7459,11 @@ namespace embree
             groups.top()->add(new CreateGeometryBenchmark("update."+to_string(gtype)+"_"+std::get<0>(num_prims)+"."+to_string(sflags.first,sflags.second),
                                                           isa,gtype,sflags.first,sflags.second,std::get<1>(num_prims),std::get<2>(num_prims),true,true));
 
+      /* rebuilds of a single large mesh, all build threads take the blocks of the previous build from the free list of one allocator */
+      const SceneFlags alloc_contention_sflags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM);
+      groups.top()->add(new CreateGeometryBenchmark("alloc_contention."+to_string(TRIANGLE_MESH)+"_1000k_1."+to_string(alloc_contention_sflags,RTC_BUILD_QUALITY_MEDIUM),
+                                                    isa,TRIANGLE_MESH,alloc_contention_sflags,RTC_BUILD_QUALITY_MEDIUM,501,1,true,true));
+
       groups.pop(); // benchmarks
 
       /**************************************************************************/